@@ -1403,6 +1403,10 @@ public:
   /// code 1 if error is fatal.
   void logBOLTErrorsAndQuitOnFatal(Error E);
 
+  /// Print the heap usage and the memory held by MCInst storage of all
+  /// functions at the end of \p Phase.
+  void printMemoryStats(StringRef Phase) const;
+
   std::string generateBugReportMessage(StringRef Message,
                                        const BinaryFunction &Function) const;
 
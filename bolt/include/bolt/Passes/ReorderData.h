@@ -31,6 +31,11 @@ private:
   std::pair<DataOrder, unsigned>
   sortedByCount(BinaryContext &BC, const BinarySection &Section) const;
 
+  /// Cluster symbols that are accessed together into cache-line sized groups
+  /// and order the groups by access density.
+  std::pair<DataOrder, unsigned>
+  sortedByAffinity(BinaryContext &BC, const BinarySection &Section) const;
+
   std::pair<DataOrder, unsigned>
   sortedByFunc(BinaryContext &BC, const BinarySection &Section,
                std::map<uint64_t, BinaryFunction> &BFs) const;
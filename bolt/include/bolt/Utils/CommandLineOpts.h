@@ -48,6 +48,7 @@ extern llvm::cl::opt<bool> Instrument;
 extern llvm::cl::opt<std::string> OutputFilename;
 extern llvm::cl::opt<std::string> PerfData;
 extern llvm::cl::opt<bool> PrintCacheMetrics;
+extern llvm::cl::opt<bool> PrintMemoryStats;
 extern llvm::cl::opt<bool> PrintSections;
 
 // The format to use with -o in aggregation mode (perf2bolt)
@@ -34,6 +34,7 @@
 #include "llvm/MC/MCSymbol.h"
 #include "llvm/Support/CommandLine.h"
 #include "llvm/Support/Error.h"
+#include "llvm/Support/Process.h"
 #include "llvm/Support/Regex.h"
 #include <algorithm>
 #include <functional>
@@ -121,6 +122,47 @@ void BinaryContext::logBOLTErrorsAndQuitOnFatal(Error E) {
   });
 }
 
+void BinaryContext::printMemoryStats(StringRef Phase) const {
+  // Size of the inline operand storage of MCInst, a SmallVector<MCOperand, 6>.
+  // Operands of instructions with more than this many live on the heap.
+  constexpr unsigned NumInlineOperands = 6;
+
+  uint64_t NumInstructions = 0;
+  uint64_t NumOperands = 0;
+  uint64_t NumAnnotations = 0;
+  uint64_t NumOutOfLineOperands = 0;
+  auto CountInstruction = [&](const MCInst &Inst) {
+    ++NumInstructions;
+    NumOperands += Inst.getNumOperands();
+    if (Inst.getNumOperands() > NumInlineOperands)
+      NumOutOfLineOperands += Inst.getNumOperands();
+    // Annotations follow an empty instruction operand, see
+    // MCPlusBuilder::getAnnotationInstOp().
+    const auto *AnnotationOp =
+        llvm::find_if(Inst, [](const MCOperand &Op) { return Op.isInst(); });
+    if (AnnotationOp != Inst.end())
+      NumAnnotations += std::distance(AnnotationOp, Inst.end()) - 1;
+  };
+
+  for (const auto &BFI : BinaryFunctions) {
+    const BinaryFunction &BF = BFI.second;
+    for (const auto &OffsetInst : BF.Instructions)
+      CountInstruction(OffsetInst.second);
+    for (const BinaryBasicBlock &BB : BF)
+      for (const MCInst &Inst : BB)
+        CountInstruction(Inst);
+  }
+
+  const uint64_t InstBytes = NumInstructions * sizeof(MCInst) +
+                             NumOutOfLineOperands * sizeof(MCOperand);
+  this->outs() << "BOLT-INFO: memory after " << Phase << ": "
+               << sys::Process::GetMallocUsage() / (1024 * 1024)
+               << " MB heap, " << NumInstructions << " instructions with "
+               << NumOperands << " operands (" << NumAnnotations
+               << " annotations) using " << InstBytes / (1024 * 1024)
+               << " MB\n";
+}
+
 BinaryContext::BinaryContext(std::unique_ptr<MCContext> Ctx,
                              std::unique_ptr<DWARFContext> DwCtx,
                              std::unique_ptr<Triple> TheTriple,
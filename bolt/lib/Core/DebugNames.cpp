@@ -8,6 +8,7 @@
 
 #include "bolt/Core/DebugNames.h"
 #include "bolt/Core/BinaryContext.h"
+#include "bolt/Core/ParallelUtilities.h"
 #include "llvm/DebugInfo/DWARF/DWARFExpression.h"
 #include "llvm/DebugInfo/DWARF/DWARFTypeUnit.h"
 #include "llvm/Support/EndianStream.h"
@@ -408,15 +409,35 @@ void DWARF5AcceleratorTable::finalize() {
 
   // Sort the contents of the buckets by hash value so that hash collisions end
   // up together. Stable sort makes testing easier and doesn't cost much more.
-  for (HashList &Bucket : Buckets) {
-    llvm::stable_sort(Bucket, [](const HashData *LHS, const HashData *RHS) {
-      return LHS->HashValue < RHS->HashValue;
-    });
-    for (HashData *H : Bucket)
-      llvm::stable_sort(H->Values, [](const BOLTDWARF5AccelTableData *LHS,
-                                      const BOLTDWARF5AccelTableData *RHS) {
-        return LHS->getDieOffset() < RHS->getDieOffset();
+  // Buckets are independent, so large tables are sorted in parallel without
+  // affecting the output.
+  auto SortBuckets = [](MutableArrayRef<HashList> Range) {
+    for (HashList &Bucket : Range) {
+      llvm::stable_sort(Bucket, [](const HashData *LHS, const HashData *RHS) {
+        return LHS->HashValue < RHS->HashValue;
       });
+      for (HashData *H : Bucket)
+        llvm::stable_sort(H->Values, [](const BOLTDWARF5AccelTableData *LHS,
+                                        const BOLTDWARF5AccelTableData *RHS) {
+          return LHS->getDieOffset() < RHS->getDieOffset();
+        });
+    }
+  };
+  constexpr size_t MinBucketsPerTask = 1024;
+  if (opts::NoThreads || Buckets.size() <= MinBucketsPerTask) {
+    SortBuckets(Buckets);
+  } else {
+    ThreadPoolInterface &Pool = ParallelUtilities::getThreadPool();
+    const size_t NumTasks = Pool.getMaxConcurrency() * opts::TaskCount;
+    const size_t TaskSize =
+        std::max(MinBucketsPerTask, divideCeil(Buckets.size(), NumTasks));
+    MutableArrayRef<HashList> Remaining(Buckets);
+    while (!Remaining.empty()) {
+      const size_t Size = std::min(TaskSize, Remaining.size());
+      Pool.async(SortBuckets, Remaining.take_front(Size));
+      Remaining = Remaining.drop_front(Size);
+    }
+    Pool.wait();
   }
 
   CUIndexForm = DIEInteger::BestForm(/*IsSigned*/ false, CUList.size() - 1);
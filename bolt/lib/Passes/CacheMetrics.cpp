@@ -27,6 +27,10 @@ namespace {
 /// The constants do not affect the code layout algorithms.
 constexpr unsigned ITLBPageSize = 4096;
 constexpr unsigned ITLBEntries = 16;
+/// The same estimate for hot code mapped with 2MB pages (e.g. by -hugify),
+/// using the typical number of 2MB i-TLB entries.
+constexpr unsigned ITLBHugePageSize = 2 << 20;
+constexpr unsigned ITLBHugePageEntries = 8;
 
 /// Initialize and return a position map for binary basic blocks
 void extractBasicBlockInfo(
@@ -142,7 +146,8 @@ extractFunctionCalls(const std::vector<BinaryFunction *> &BinaryFunctions) {
 double expectedCacheHitRatio(
     const std::vector<BinaryFunction *> &BinaryFunctions,
     const std::unordered_map<BinaryBasicBlock *, uint64_t> &BBAddr,
-    const std::unordered_map<BinaryBasicBlock *, uint64_t> &BBSize) {
+    const std::unordered_map<BinaryBasicBlock *, uint64_t> &BBSize,
+    uint64_t PageSize = ITLBPageSize, unsigned Entries = ITLBEntries) {
   std::unordered_map<const BinaryFunction *, Predecessors> Calls =
       extractFunctionCalls(BinaryFunctions);
   // Compute 'hotness' of the functions
@@ -164,7 +169,7 @@ double expectedCacheHitRatio(
       continue;
     auto BBAddrIt = BBAddr.find(BF->getLayout().block_front());
     assert(BBAddrIt != BBAddr.end());
-    const uint64_t Page = BBAddrIt->second / ITLBPageSize;
+    const uint64_t Page = BBAddrIt->second / PageSize;
 
     auto FunctionSamplesIt = FunctionSamples.find(BF);
     assert(FunctionSamplesIt != FunctionSamples.end());
@@ -183,10 +188,10 @@ double expectedCacheHitRatio(
 
     auto BBAddrIt = BBAddr.find(BF->getLayout().block_front());
     assert(BBAddrIt != BBAddr.end());
-    const uint64_t Page = BBAddrIt->second / ITLBPageSize;
+    const uint64_t Page = BBAddrIt->second / PageSize;
     // The probability that the page is not present in the cache
     const double MissProb =
-        pow(1.0 - PageSamples[Page] / TotalSamples, ITLBEntries);
+        pow(1.0 - PageSamples[Page] / TotalSamples, Entries);
 
     // Processing all callers of the function
     for (std::pair<BinaryFunction *, uint64_t> Pair : Calls[BF]) {
@@ -194,7 +199,7 @@ double expectedCacheHitRatio(
 
       BBAddrIt = BBAddr.find(SrcFunction->getLayout().block_front());
       assert(BBAddrIt != BBAddr.end());
-      const uint64_t SrcPage = BBAddrIt->second / ITLBPageSize;
+      const uint64_t SrcPage = BBAddrIt->second / PageSize;
       // Is this a 'long' or a 'short' call?
       if (Page != SrcPage) {
         // This is a miss
@@ -256,14 +261,24 @@ void CacheMetrics::printAll(raw_ostream &OS,
                100.0 * NumHotBlocks / NumBlocks);
 
   assert(TotalCodeMinAddr <= TotalCodeMaxAddr && "incorrect output addresses");
-  size_t HotCodeSize = HotCodeMaxAddr - HotCodeMinAddr;
+  // The address bounds are only set if there are hot blocks.
+  size_t HotCodeSize = NumHotBlocks ? HotCodeMaxAddr - HotCodeMinAddr : 0;
   size_t TotalCodeSize = TotalCodeMaxAddr - TotalCodeMinAddr;
 
   size_t HugePage2MB = 2 << 20;
-  OS << format("  Hot code takes %.2lf%% of binary (%zu bytes out of %zu, "
-               "%.2lf huge pages)\n",
-               100.0 * HotCodeSize / TotalCodeSize, HotCodeSize, TotalCodeSize,
-               double(HotCodeSize) / HugePage2MB);
+  if (HotCodeSize) {
+    OS << format("  Hot code takes %.2lf%% of binary (%zu bytes out of %zu, "
+                 "%.2lf huge pages)\n",
+                 100.0 * HotCodeSize / TotalCodeSize, HotCodeSize,
+                 TotalCodeSize, double(HotCodeSize) / HugePage2MB);
+    // Hot code that straddles huge page boundaries needs more i-TLB entries
+    // than its size requires.
+    const size_t SpannedHugePages =
+        (HotCodeMaxAddr - 1) / HugePage2MB - HotCodeMinAddr / HugePage2MB + 1;
+    OS << format("  Hot code spans %zu huge pages (%zu when aligned)\n",
+                 SpannedHugePages,
+                 static_cast<size_t>(divideCeil(HotCodeSize, HugePage2MB)));
+  }
 
   // Stats related to expected cache performance
   std::unordered_map<BinaryBasicBlock *, uint64_t> BBAddr;
@@ -272,6 +287,10 @@ void CacheMetrics::printAll(raw_ostream &OS,
 
   OS << "  Expected i-TLB cache hit ratio: "
      << format("%.2lf%%\n", expectedCacheHitRatio(BFs, BBAddr, BBSize));
+  OS << "  Expected i-TLB cache hit ratio with 2MB pages: "
+     << format("%.2lf%%\n",
+               expectedCacheHitRatio(BFs, BBAddr, BBSize, ITLBHugePageSize,
+                                     ITLBHugePageEntries));
 
   auto Stats = calcTSPScore(BFs, BBAddr, BBSize);
   OS << "  TSP score: "
@@ -65,6 +65,16 @@ cl::opt<bool> InstrumentationNoCountersClear(
              "(use with instrumentation-sleep-time option)"),
     cl::init(false), cl::Optional, cl::cat(BoltInstrCategory));
 
+cl::opt<std::string> InstrumentationCountersFile(
+    "instrumentation-counters-file",
+    cl::desc("back the instrumentation counters with this file, suffixed "
+             "with the PID of the process, so that an external agent can map "
+             "it and snapshot the raw counters while the program runs. Forks "
+             "share the counters, so this cannot be combined with "
+             "instrumentation-file-append-pid (default: empty = anonymous "
+             "memory)"),
+    cl::Optional, cl::cat(BoltInstrCategory));
+
 cl::opt<bool> InstrumentationWaitForks(
     "instrumentation-wait-forks",
     cl::desc("Wait until all forks of instrumented process will finish "
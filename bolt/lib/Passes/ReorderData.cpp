@@ -16,6 +16,8 @@
 // - estimate temporal locality by looking at CFG?
 
 #include "bolt/Passes/ReorderData.h"
+#include "llvm/ADT/DenseSet.h"
+#include "llvm/ADT/EquivalenceClasses.h"
 #include "llvm/ADT/MapVector.h"
 #include <algorithm>
 
@@ -44,7 +46,8 @@ ReorderData("reorder-data",
 
 enum ReorderAlgo : char {
   REORDER_COUNT         = 0,
-  REORDER_FUNCS         = 1
+  REORDER_FUNCS         = 1,
+  REORDER_AFFINITY      = 2
 };
 
 static cl::opt<ReorderAlgo>
@@ -57,7 +60,10 @@ ReorderAlgorithm("reorder-data-algo",
       "sort hot data by read counts"),
     clEnumValN(REORDER_FUNCS,
       "funcs",
-      "sort hot data by hot function usage and count")),
+      "sort hot data by hot function usage and count"),
+    clEnumValN(REORDER_AFFINITY,
+      "affinity",
+      "cluster hot data accessed from the same basic blocks")),
   cl::ZeroOrMore,
   cl::cat(BoltOptCategory));
 
@@ -67,6 +73,12 @@ static cl::opt<unsigned>
                           cl::init(std::numeric_limits<unsigned>::max()),
                           cl::cat(BoltOptCategory));
 
+static cl::opt<unsigned> ReorderDataClusterSize(
+    "reorder-data-cluster-size",
+    cl::desc("maximum size in bytes of a cluster of data objects that are "
+             "placed together by -reorder-data-algo=affinity"),
+    cl::init(64), cl::cat(BoltOptCategory));
+
 static cl::opt<unsigned> ReorderDataMaxBytes(
     "reorder-data-max-bytes", cl::desc("maximum number of bytes to reorder"),
     cl::init(std::numeric_limits<unsigned>::max()), cl::cat(BoltOptCategory));
@@ -327,6 +339,126 @@ ReorderData::sortedByCount(BinaryContext &BC,
   return std::make_pair(Order, SplitPoint);
 }
 
+/// Cluster hot data objects that are accessed from the same hot basic blocks,
+/// so that objects used together share cache lines, and order the clusters by
+/// access density. This mirrors what function reordering does for code, with
+/// the basic blocks acting as the edges between data objects.
+std::pair<DataOrder, unsigned>
+ReorderData::sortedByAffinity(BinaryContext &BC,
+                              const BinarySection &Section) const {
+  DataOrder Order = baseOrder(BC, Section);
+
+  // Index the hot objects. Cold ones keep their original order at the end.
+  DenseMap<const BinaryData *, unsigned> HotIndex;
+  DataOrder Hot, Cold;
+  for (const DataOrder::value_type &Entry : Order) {
+    if (Entry.second) {
+      HotIndex[Entry.first] = Hot.size();
+      Hot.push_back(Entry);
+    } else {
+      Cold.push_back(Entry);
+    }
+  }
+
+  // Affinity of two objects is the execution count of the blocks accessing
+  // both. Blocks touching many objects are capped to keep this linear.
+  constexpr unsigned MaxObjectsPerBlock = 16;
+  DenseMap<std::pair<unsigned, unsigned>, uint64_t> Affinity;
+  for (auto &BFI : BC.getBinaryFunctions()) {
+    const BinaryFunction &BF = BFI.second;
+    if (!BF.hasMemoryProfile())
+      continue;
+
+    for (const BinaryBasicBlock &BB : BF) {
+      const uint64_t BBCount = BB.getKnownExecutionCount();
+      if (!BBCount)
+        continue;
+
+      SmallVector<unsigned, MaxObjectsPerBlock> Used;
+      for (const MCInst &Inst : BB) {
+        auto ErrorOrMemAccessProfile =
+            BC.MIB->tryGetAnnotationAs<MemoryAccessProfile>(
+                Inst, "MemoryAccessProfile");
+        if (!ErrorOrMemAccessProfile)
+          continue;
+
+        for (const AddressAccess &AccessInfo :
+             ErrorOrMemAccessProfile.get().AddressAccessInfo) {
+          if (!AccessInfo.MemoryObject)
+            continue;
+          auto It = HotIndex.find(AccessInfo.MemoryObject->getAtomicRoot());
+          if (It != HotIndex.end() && !llvm::is_contained(Used, It->second) &&
+              Used.size() < MaxObjectsPerBlock)
+            Used.push_back(It->second);
+        }
+      }
+
+      for (unsigned I = 0; I < Used.size(); ++I)
+        for (unsigned J = I + 1; J < Used.size(); ++J)
+          Affinity[std::minmax(Used[I], Used[J])] += BBCount;
+    }
+  }
+
+  // Greedily merge the objects with the strongest affinity while the cluster
+  // still fits into the target size.
+  std::vector<std::pair<std::pair<unsigned, unsigned>, uint64_t>> Edges(
+      Affinity.begin(), Affinity.end());
+  llvm::sort(Edges, [](const auto &A, const auto &B) {
+    return A.second > B.second || (A.second == B.second && A.first < B.first);
+  });
+
+  EquivalenceClasses<unsigned> Clusters;
+  std::vector<uint64_t> ClusterSize(Hot.size());
+  for (unsigned I = 0; I < Hot.size(); ++I) {
+    Clusters.insert(I);
+    ClusterSize[I] = Hot[I].first->getSize();
+  }
+  for (const auto &[Edge, Weight] : Edges) {
+    const unsigned A = Clusters.getLeaderValue(Edge.first);
+    const unsigned B = Clusters.getLeaderValue(Edge.second);
+    const uint64_t Size = ClusterSize[A] + ClusterSize[B];
+    if (A == B || Size > opts::ReorderDataClusterSize)
+      continue;
+    ClusterSize[*Clusters.unionSets(A, B)] = Size;
+  }
+
+  // Order clusters by access density, and objects in a cluster by count.
+  std::vector<std::pair<double, DataOrder>> Sorted;
+  for (auto I = Clusters.begin(), E = Clusters.end(); I != E; ++I) {
+    if (!I->isLeader())
+      continue;
+    DataOrder Members;
+    uint64_t Count = 0;
+    for (auto MI = Clusters.member_begin(I), ME = Clusters.member_end();
+         MI != ME; ++MI) {
+      Members.push_back(Hot[*MI]);
+      Count += Hot[*MI].second;
+    }
+    llvm::sort(Members, [](const DataOrder::value_type &A,
+                           const DataOrder::value_type &B) {
+      return A.second > B.second ||
+             (A.second == B.second &&
+              A.first->getAddress() < B.first->getAddress());
+    });
+    const double Density =
+        double(Count) / std::max<uint64_t>(ClusterSize[I->getData()], 1);
+    Sorted.emplace_back(Density, std::move(Members));
+  }
+  llvm::stable_sort(Sorted, [](const auto &A, const auto &B) {
+    if (A.first != B.first)
+      return A.first > B.first;
+    return A.second.front().first->getAddress() <
+           B.second.front().first->getAddress();
+  });
+
+  Order.clear();
+  for (auto &Cluster : Sorted)
+    llvm::append_range(Order, Cluster.second);
+  const unsigned SplitPoint = Order.size();
+  llvm::append_range(Order, Cold);
+  return std::make_pair(Order, SplitPoint);
+}
+
 // TODO
 // add option for cache-line alignment (or just use cache-line when section
 // is writable)?
@@ -347,6 +479,17 @@ void ReorderData::setSectionOrder(BinaryContext &BC,
   LLVM_DEBUG(dbgs() << "BOLT-DEBUG: setSectionOrder for "
                     << OutputSection.getName() << "\n");
 
+  // Estimate the D-cache and D-TLB footprint of the hot data before and after
+  // reordering by counting the cache lines and pages that it spans.
+  constexpr uint64_t CacheLineSize = 64;
+  constexpr uint64_t PageSize = 4096;
+  DenseSet<uint64_t> OldLines, NewLines, OldPages, NewPages;
+  auto AddRange = [](DenseSet<uint64_t> &Set, uint64_t Start, uint64_t Size,
+                     uint64_t Granule) {
+    for (uint64_t I = Start / Granule; I <= (Start + Size - 1) / Granule; ++I)
+      Set.insert(I);
+  };
+
   for (; Begin != End; ++Begin) {
     BinaryData *BD = Begin->first;
 
@@ -389,6 +532,13 @@ void ReorderData::setSectionOrder(BinaryContext &BC,
       }
     }
 
+    if (Begin->second && BD->getSize()) {
+      AddRange(OldLines, BD->getAddress(), BD->getSize(), CacheLineSize);
+      AddRange(OldPages, BD->getAddress(), BD->getSize(), PageSize);
+      AddRange(NewLines, Offset, BD->getSize(), CacheLineSize);
+      AddRange(NewPages, Offset, BD->getSize(), PageSize);
+    }
+
     Offset += BD->getSize();
     Count += Begin->second;
     NewOrder.push_back(BD);
@@ -399,6 +549,9 @@ void ReorderData::setSectionOrder(BinaryContext &BC,
   BC.outs() << "BOLT-INFO: reorder-data: " << Count << "/" << TotalCount
             << format(" (%.1f%%)", 100.0 * Count / TotalCount) << " events, "
             << Offset << " hot bytes\n";
+  BC.outs() << "BOLT-INFO: reorder-data: hot data spans " << OldLines.size()
+            << " -> " << NewLines.size() << " cache lines, " << OldPages.size()
+            << " -> " << NewPages.size() << " pages\n";
 }
 
 bool ReorderData::markUnmoveableSymbols(BinaryContext &BC,
@@ -486,6 +639,9 @@ Error ReorderData::runOnFunctions(BinaryContext &BC) {
     if (opts::ReorderAlgorithm == opts::ReorderAlgo::REORDER_COUNT) {
       BC.outs() << "BOLT-INFO: reorder-sections: ordering data by count\n";
       std::tie(Order, SplitPointIdx) = sortedByCount(BC, *Section);
+    } else if (opts::ReorderAlgorithm == opts::ReorderAlgo::REORDER_AFFINITY) {
+      BC.outs() << "BOLT-INFO: reorder-sections: ordering data by affinity\n";
+      std::tie(Order, SplitPointIdx) = sortedByAffinity(BC, *Section);
     } else {
       BC.outs() << "BOLT-INFO: reorder-sections: ordering data by funcs\n";
       std::tie(Order, SplitPointIdx) =
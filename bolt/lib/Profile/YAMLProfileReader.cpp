@@ -14,6 +14,7 @@
 #include "bolt/Utils/Utils.h"
 #include "llvm/ADT/STLExtras.h"
 #include "llvm/Support/CommandLine.h"
+#include <unordered_map>
 
 using namespace llvm;
 
@@ -28,6 +29,19 @@ static llvm::cl::opt<bool>
                cl::desc("ignore hash while reading function profile"),
                cl::Hidden, cl::cat(BoltOptCategory));
 
+static llvm::cl::opt<bool> MatchProfileWithFunctionHash(
+    "match-profile-with-function-hash",
+    cl::desc("match profiles that have no function with the same name to "
+             "functions with an identical hash, e.g. after a rename"),
+    cl::Hidden, cl::cat(BoltOptCategory));
+
+static llvm::cl::opt<unsigned> NameSimilarityFunctionMatchingThreshold(
+    "name-similarity-function-matching-threshold",
+    cl::desc("match remaining profiles to functions with the same number of "
+             "basic blocks whose names are within this edit distance "
+             "(default: 0 = disabled)"),
+    cl::init(0), cl::Hidden, cl::cat(BoltOptCategory));
+
 llvm::cl::opt<bool> ProfileUseDFS("profile-use-dfs",
                                   cl::desc("use DFS order for YAML profile"),
                                   cl::Hidden, cl::cat(BoltOptCategory));
@@ -415,6 +429,65 @@ Error YAMLProfileReader::readProfile(BinaryContext &BC) {
     if (!YamlBF.Used && BF && !ProfiledFunctions.count(BF))
       matchProfileToFunction(YamlBF, *BF);
 
+  // Use the remaining functions as anchors for profiles whose name no longer
+  // exists in the binary: first by an exact hash match, then by the closest
+  // name among functions of the same size.
+  if (opts::MatchProfileWithFunctionHash ||
+      opts::NameSimilarityFunctionMatchingThreshold) {
+    std::unordered_map<uint64_t, BinaryFunction *> HashToBF;
+    std::unordered_map<size_t, std::vector<BinaryFunction *>> SizeToBFs;
+    for (auto &BFI : BC.getBinaryFunctions()) {
+      BinaryFunction &BF = BFI.second;
+      if (ProfiledFunctions.count(&BF) || !BF.hasCFG())
+        continue;
+      if (opts::MatchProfileWithFunctionHash)
+        HashToBF.emplace(BF.computeHash(YamlBP.Header.IsDFSOrder,
+                                        YamlBP.Header.HashFunction),
+                         &BF);
+      if (opts::NameSimilarityFunctionMatchingThreshold)
+        SizeToBFs[BF.size()].push_back(&BF);
+    }
+
+    uint64_t NumMatchedByHash = 0;
+    uint64_t NumMatchedByName = 0;
+    for (yaml::bolt::BinaryFunctionProfile &YamlBF : YamlBP.Functions) {
+      if (YamlBF.Used)
+        continue;
+      auto It = HashToBF.find(YamlBF.Hash);
+      if (It != HashToBF.end() && !ProfiledFunctions.count(It->second)) {
+        matchProfileToFunction(YamlBF, *It->second);
+        ++NumMatchedByHash;
+        continue;
+      }
+
+      auto SizeIt = SizeToBFs.find(YamlBF.NumBasicBlocks);
+      if (SizeIt == SizeToBFs.end())
+        continue;
+      const unsigned Threshold = opts::NameSimilarityFunctionMatchingThreshold;
+      BinaryFunction *Closest = nullptr;
+      unsigned MinDistance = Threshold + 1;
+      for (BinaryFunction *BF : SizeIt->second) {
+        if (ProfiledFunctions.count(BF))
+          continue;
+        const unsigned Distance = StringRef(YamlBF.Name).edit_distance(
+            BF->getOneName(), /*AllowReplacements=*/true, Threshold);
+        if (Distance < MinDistance) {
+          MinDistance = Distance;
+          Closest = BF;
+        }
+      }
+      if (Closest) {
+        matchProfileToFunction(YamlBF, *Closest);
+        ++NumMatchedByName;
+      }
+    }
+
+    if (opts::Verbosity >= 1)
+      outs() << "BOLT-INFO: matched " << NumMatchedByHash
+             << " functions by hash and " << NumMatchedByName
+             << " functions by name similarity\n";
+  }
+
   for (yaml::bolt::BinaryFunctionProfile &YamlBF : YamlBP.Functions)
     if (!YamlBF.Used && opts::Verbosity >= 1)
       errs() << "BOLT-WARNING: profile ignored for function " << YamlBF.Name
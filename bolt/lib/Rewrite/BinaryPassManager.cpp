@@ -317,6 +317,9 @@ Error BinaryFunctionPassManager::runPasses() {
     if (opts::Verbosity > 0)
       BC.outs() << "BOLT-INFO: Finished pass: " << Pass->getName() << "\n";
 
+    if (opts::PrintMemoryStats)
+      BC.printMemoryStats(Pass->getName());
+
     if (!opts::PrintAll && !opts::DumpDotAll && !Pass->printPass())
       continue;
 
@@ -568,9 +568,14 @@ Error RewriteInstance::discoverStorage() {
         !(opts::AggregateOnly && BAT->enabledFor(InputFile)) &&
         (SectionName.starts_with(getOrgSecPrefix()) ||
          SectionName == getBOLTTextSectionName()))
+      // Re-optimizing in place would need the original layout of every
+      // function that is not rewritten again, which BAT only preserves in the
+      // form of address ranges. Point users at the supported workflow instead.
       return createStringError(
           errc::function_not_supported,
-          "BOLT-ERROR: input file was processed by BOLT. Cannot re-optimize");
+          "BOLT-ERROR: input file was processed by BOLT. Cannot re-optimize. "
+          "To update the layout, aggregate the new profile against this file "
+          "with perf2bolt and run BOLT on the original input binary");
   }
 
   if (!NextAvailableAddress || !NextAvailableOffset)
@@ -684,10 +689,14 @@ Error RewriteInstance::run() {
   readDebugInfo();
 
   disassembleFunctions();
+  if (opts::PrintMemoryStats)
+    BC->printMemoryStats("disassembly");
 
   processMetadataPreCFG();
 
   buildFunctionsCFG();
+  if (opts::PrintMemoryStats)
+    BC->printMemoryStats("CFG construction");
 
   processProfileData();
 
@@ -696,6 +705,8 @@ Error RewriteInstance::run() {
     BAT->saveMetadata(*BC);
 
   postProcessFunctions();
+  if (opts::PrintMemoryStats)
+    BC->printMemoryStats("post-processing");
 
   processMetadataPostCFG();
 
@@ -705,10 +716,14 @@ Error RewriteInstance::run() {
   preregisterSections();
 
   runOptimizationPasses();
+  if (opts::PrintMemoryStats)
+    BC->printMemoryStats("optimizations");
 
   finalizeMetadataPreEmit();
 
   emitAndLink();
+  if (opts::PrintMemoryStats)
+    BC->printMemoryStats("emission");
 
   updateMetadata();
 
@@ -3216,6 +3231,16 @@ void RewriteInstance::processProfileData() {
 void RewriteInstance::disassembleFunctions() {
   NamedRegionTimer T("disassembleFunctions", "disassemble functions",
                      TimerGroupName, TimerGroupDesc, opts::TimeRewrite);
+  // FIXME: unlike buildFunctionsCFG(), this loop is serial. Disassembly
+  // creates temporary and global symbols and MCExprs in the shared MCContext,
+  // registers interprocedural references, jump tables and secondary entry
+  // points in BinaryContext, and allocates annotations with the default
+  // allocator. Running it with ParallelUtilities requires moving all of these
+  // behind BC->scopeLock() (callers already hold it around
+  // getOrCreateGlobalSymbol(), so the lock cannot simply be taken there) and
+  // giving each worker its own annotation allocator.
+  const auto *FileBegin =
+      reinterpret_cast<const uint8_t *>(InputFile->getData().data());
   for (auto &BFI : BC->getBinaryFunctions()) {
     BinaryFunction &Function = BFI.second;
 
@@ -3233,8 +3258,6 @@ void RewriteInstance::disassembleFunctions() {
     }
 
     // Offset of the function in the file.
-    const auto *FileBegin =
-        reinterpret_cast<const uint8_t *>(InputFile->getData().data());
     Function.setFileOffset(FunctionData->begin() - FileBegin);
 
     if (!shouldDisassemble(Function)) {
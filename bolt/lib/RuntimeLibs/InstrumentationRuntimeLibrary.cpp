@@ -33,6 +33,7 @@ extern cl::opt<bool> InstrumentationFileAppendPID;
 extern cl::opt<bool> ConservativeInstrumentation;
 extern cl::opt<std::string> InstrumentationFilename;
 extern cl::opt<std::string> InstrumentationBinpath;
+extern cl::opt<std::string> InstrumentationCountersFile;
 extern cl::opt<uint32_t> InstrumentationSleepTime;
 extern cl::opt<bool> InstrumentationNoCountersClear;
 extern cl::opt<bool> InstrumentationWaitForks;
@@ -74,6 +75,15 @@ void InstrumentationRuntimeLibrary::adjustCommandLineOptions(
            "the end of process when instrumentation-file-append-pid is used.\n";
     exit(1);
   }
+
+  if (!opts::InstrumentationCountersFile.empty() &&
+      opts::InstrumentationFileAppendPID) {
+    errs() << "BOLT-ERROR: instrumentation-counters-file is not compatible "
+              "with instrumentation-file-append-pid. Forks share the "
+              "file-backed counters, so per-process profiles would count the "
+              "hits of the parent and of other forks.\n";
+    exit(1);
+  }
 }
 
 void InstrumentationRuntimeLibrary::emitBinary(BinaryContext &BC,
@@ -183,6 +193,7 @@ void InstrumentationRuntimeLibrary::emitBinary(BinaryContext &BC,
   emitIntValue("__bolt_instr_num_funcs", Summary->FunctionDescriptions.size());
   emitString("__bolt_instr_filename", opts::InstrumentationFilename);
   emitString("__bolt_instr_binpath", opts::InstrumentationBinpath);
+  emitString("__bolt_instr_counters_file", opts::InstrumentationCountersFile);
   emitIntValue("__bolt_instr_use_pid", !!opts::InstrumentationFileAppendPID, 1);
 
   if (BC.isMachO()) {
@@ -149,6 +149,11 @@ cl::opt<bool> PrintCacheMetrics(
     cl::desc("calculate and print various metrics for instruction cache"),
     cl::cat(BoltOptCategory));
 
+cl::opt<bool> PrintMemoryStats(
+    "print-memory-stats",
+    cl::desc("print heap usage and instruction storage after each phase"),
+    cl::Hidden, cl::cat(BoltCategory));
+
 cl::opt<bool> PrintSections("print-sections",
                             cl::desc("print all registered sections"),
                             cl::Hidden, cl::cat(BoltCategory));
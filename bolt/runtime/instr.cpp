@@ -93,6 +93,8 @@ extern bool __bolt_instr_wait_forks;
 extern char __bolt_instr_filename[];
 // Instumented binary file path
 extern char __bolt_instr_binpath[];
+// File backing the counters, so that they can be read while the program runs
+extern char __bolt_instr_counters_file[];
 // If true, append current PID to the fdata filename when creating it so
 // different invocations of the same program can be differentiated.
 extern bool __bolt_instr_use_pid;
@@ -1626,9 +1628,32 @@ extern "C" void __attribute((force_align_arg_pointer)) __bolt_instr_setup() {
   const bool Shared = !__bolt_instr_use_pid;
   const uint64_t MapPrivateOrShared = Shared ? MAP_SHARED : MAP_PRIVATE;
 
-  void *Ret =
-      __mmap(CountersStart, CountersEnd - CountersStart, PROT_READ | PROT_WRITE,
-             MAP_ANONYMOUS | MapPrivateOrShared | MAP_FIXED, -1, 0);
+  void *Ret;
+  if (__bolt_instr_counters_file[0] != '\0') {
+    // Back the counters with a file that other processes can map and read at
+    // any time. The file is created with zeroes, which matches the initial
+    // counter values. It always gets the PID appended: truncating a file that
+    // another run of the program still has mapped would corrupt its counters.
+    // The mapping is shared with forks, which is why BOLT does not allow this
+    // together with __bolt_instr_use_pid.
+    char Buf[BufSize];
+    char *Ptr = strCopy(Buf, __bolt_instr_counters_file, BufSize);
+    Ptr = strCopy(Ptr, ".", BufSize - (Ptr - Buf + 1));
+    Ptr = intToStr(Ptr, __getpid(), 10);
+    *Ptr++ = '\0';
+    uint64_t FD = __open(Buf, O_RDWR | O_TRUNC | O_CREAT, /*mode=*/0666);
+    assert(static_cast<int64_t>(FD) >= 0,
+           "__bolt_instr_setup: failed to open counters file!");
+    assert(__ftruncate(FD, CountersEnd - CountersStart) == 0,
+           "__bolt_instr_setup: failed to resize counters file!");
+    Ret = __mmap(CountersStart, CountersEnd - CountersStart,
+                 PROT_READ | PROT_WRITE, MAP_SHARED | MAP_FIXED, FD, 0);
+    __close(FD);
+  } else {
+    Ret = __mmap(CountersStart, CountersEnd - CountersStart,
+                 PROT_READ | PROT_WRITE,
+                 MAP_ANONYMOUS | MapPrivateOrShared | MAP_FIXED, -1, 0);
+  }
   assert(Ret != MAP_FAILED, "__bolt_instr_setup: Failed to mmap counters!");
 
   GlobalMetadataStorage = __mmap(0, 4096, PROT_READ | PROT_WRITE,
@@ -386,39 +386,57 @@ int main(int argc, char **argv) {
   // Merged information for all functions.
   StringMap<BinaryFunctionProfile> MergedBFs;
 
-  for (std::string &InputDataFilename : Inputs) {
+  // Parse the inputs in parallel, a window of files at a time so that only a
+  // bounded number of parsed profiles is alive. Merging into MergedBFs is done
+  // in input order to keep the output deterministic.
+  DefaultThreadPool Pool(optimal_concurrency(Inputs.size()));
+  const size_t WindowSize = Pool.getMaxConcurrency();
+  std::vector<BinaryProfile> Window(WindowSize);
+  auto ParseProfile = [](const std::string &InputDataFilename,
+                         BinaryProfile &BP) {
     ErrorOr<std::unique_ptr<MemoryBuffer>> MB =
         MemoryBuffer::getFileOrSTDIN(InputDataFilename);
     if (std::error_code EC = MB.getError())
       report_error(InputDataFilename, EC);
     yaml::Input YamlInput(MB.get()->getBuffer());
-
-    errs() << "Merging data from " << InputDataFilename << "...\n";
-
-    BinaryProfile BP;
     YamlInput >> BP;
     if (YamlInput.error())
       report_error(InputDataFilename, YamlInput.error());
+  };
 
-    // Sanity check.
-    if (BP.Header.Version != 1) {
-      errs() << "Unable to merge data from profile using version "
-             << BP.Header.Version << '\n';
-      exit(1);
+  for (size_t Begin = 0; Begin < Inputs.size(); Begin += WindowSize) {
+    const size_t End = std::min(Begin + WindowSize, Inputs.size());
+    for (size_t I = Begin; I != End; ++I) {
+      Window[I - Begin] = BinaryProfile();
+      Pool.async(ParseProfile, std::cref(Inputs[I]),
+                 std::ref(Window[I - Begin]));
     }
+    Pool.wait();
 
-    // Merge the header.
-    mergeProfileHeaders(MergedHeader, BP.Header);
+    for (size_t I = Begin; I != End; ++I) {
+      BinaryProfile &BP = Window[I - Begin];
+      errs() << "Merging data from " << Inputs[I] << "...\n";
 
-    // Do the function merge.
-    for (BinaryFunctionProfile &BF : BP.Functions) {
-      if (!MergedBFs.count(BF.Name)) {
-        MergedBFs.insert(std::make_pair(BF.Name, BF));
-        continue;
+      // Sanity check.
+      if (BP.Header.Version != 1) {
+        errs() << "Unable to merge data from profile using version "
+               << BP.Header.Version << '\n';
+        exit(1);
       }
 
-      BinaryFunctionProfile &MergedBF = MergedBFs.find(BF.Name)->second;
-      mergeFunctionProfile(MergedBF, std::move(BF));
+      // Merge the header.
+      mergeProfileHeaders(MergedHeader, BP.Header);
+
+      // Do the function merge.
+      for (BinaryFunctionProfile &BF : BP.Functions) {
+        if (!MergedBFs.count(BF.Name)) {
+          MergedBFs.insert(std::make_pair(BF.Name, std::move(BF)));
+          continue;
+        }
+
+        BinaryFunctionProfile &MergedBF = MergedBFs.find(BF.Name)->second;
+        mergeFunctionProfile(MergedBF, std::move(BF));
+      }
     }
   }
 
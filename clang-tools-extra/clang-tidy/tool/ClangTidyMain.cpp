@@ -255,7 +255,9 @@ configuration of all checks.
 
 static cl::opt<bool> EnableCheckProfile("enable-check-profile", desc(R"(
 Enable per-check timing profiles, and print a
-report to stderr.
+report to stderr. With --track-memory, the
+heap memory allocated and the growth of the
+peak RSS are reported for each check as well.
 )"),
                                         cl::init(false),
                                         cl::cat(ClangTidyCategory));
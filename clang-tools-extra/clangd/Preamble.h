@@ -168,6 +168,12 @@ bool isPreambleCompatible(const PreambleData &Preamble,
 /// updating compiler invocation with \c apply. This injected section
 /// approximately reflects additions to the preamble in Modified contents, e.g.
 /// new include directives.
+///
+/// Only the main file's preamble section is patched. Edits to a header the
+/// preamble includes can't be: the preamble is a single PCH whose recorded
+/// inputs no longer match, and chaining a PCH for the edited tail wouldn't
+/// help either, since a chained PCH can only add declarations to its prefix,
+/// not replace the ones an edited header contributed there.
 class PreamblePatch {
 public:
   enum class PatchType { MacroDirectives, All };
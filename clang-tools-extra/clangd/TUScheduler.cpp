@@ -116,6 +116,15 @@ constexpr trace::Metric PreambleBuildSize("preamble_build_size",
 constexpr trace::Metric PreambleSerializedSize("preamble_serialized_size",
                                                trace::Metric::Distribution);
 
+// Tracks time (in seconds) a request spent in an ASTWorker's queue, including
+// waiting for a free worker slot, before it started running. Updates are
+// measured from the end of their debounce delay.
+// request_type is "update" for file updates, "preamble" for the AST rebuilds
+// after a new preamble and "read" for everything else.
+constexpr trace::Metric ASTWorkerQueueLatency("ast_worker_queue_latency",
+                                              trace::Metric::Distribution,
+                                              "request_type");
+
 void reportPreambleBuild(const PreambleBuildStats &Stats,
                          bool IsFirstPreamble) {
   auto RecordWithLabel = [&Stats](llvm::StringRef Label) {
@@ -1390,11 +1399,15 @@ void ASTWorker::startTask(llvm::StringRef Name,
 void ASTWorker::run() {
   clang::noteBottomOfStack();
   while (true) {
+    // When the request became ready to run, and what kind it is, for the
+    // queue latency metric.
+    steady_clock::time_point ReadyTime;
+    llvm::StringLiteral RequestType = "read";
     {
       std::unique_lock<std::mutex> Lock(Mutex);
       assert(!CurrentRequest && "A task is already running, multiple workers?");
-      for (auto Wait = scheduleLocked(); !Wait.expired();
-           Wait = scheduleLocked()) {
+      auto Wait = scheduleLocked();
+      for (; !Wait.expired(); Wait = scheduleLocked()) {
         assert(PreambleRequests.empty() &&
                "Preamble updates should be scheduled immediately");
         if (Done) {
@@ -1430,9 +1443,19 @@ void ASTWorker::run() {
       if (!PreambleRequests.empty()) {
         CurrentRequest = std::move(PreambleRequests.front());
         PreambleRequests.pop_front();
+        ReadyTime = CurrentRequest->AddTime;
+        RequestType = "preamble";
       } else {
         CurrentRequest = std::move(Requests.front());
         Requests.pop_front();
+        ReadyTime = CurrentRequest->AddTime;
+        if (CurrentRequest->Update) {
+          RequestType = "update";
+          // A finite deadline is the end of the debounce delay, which may
+          // have been cut short by shutdown.
+          if (!(Wait == Deadline::zero()) && !(Wait == Deadline::infinity()))
+            ReadyTime = std::min(Wait.time(), steady_clock::now());
+        }
       }
     } // unlock Mutex
 
@@ -1450,6 +1473,10 @@ void ASTWorker::run() {
         });
         Lock.lock();
       }
+      ASTWorkerQueueLatency.record(
+          std::chrono::duration<double>(steady_clock::now() - ReadyTime)
+              .count(),
+          RequestType);
       WithContext Guard(std::move(CurrentRequest->Ctx));
       Status.update([&](TUStatus &Status) {
         Status.ASTActivity.K = ASTAction::RunningAction;
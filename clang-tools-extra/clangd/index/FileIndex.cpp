@@ -340,24 +340,39 @@ FileSymbols::buildIndex(IndexType Type, DuplicateHandling DuplicateHandle,
   std::vector<Ref> RefsStorage; // Contiguous ranges for each SymbolID.
   llvm::DenseMap<SymbolID, llvm::ArrayRef<Ref>> AllRefs;
   {
-    llvm::DenseMap<SymbolID, llvm::SmallVector<Ref, 4>> MergedRefs;
+    // Lay out the ranges in two passes over the slabs instead of collecting
+    // per-symbol copies first: on large indexes that intermediate copy of
+    // every reference dominated the peak memory of a rebuild.
+    // Holds each symbol's number of references, then the start of its range,
+    // then the end of the part of the range filled so far.
+    llvm::DenseMap<SymbolID, size_t> RangeEnds;
     size_t Count = 0;
     for (const auto &RefSlab : RefSlabs)
       for (const auto &Sym : *RefSlab) {
-        MergedRefs[Sym.first].append(Sym.second.begin(), Sym.second.end());
+        RangeEnds[Sym.first] += Sym.second.size();
         Count += Sym.second.size();
       }
-    RefsStorage.reserve(Count);
-    AllRefs.reserve(MergedRefs.size());
-    for (auto &Sym : MergedRefs) {
-      auto &SymRefs = Sym.second;
+    size_t Offset = 0;
+    for (auto &Sym : RangeEnds)
+      Offset += std::exchange(Sym.second, Offset);
+
+    RefsStorage.resize(Count);
+    for (const auto &RefSlab : RefSlabs)
+      for (const auto &Sym : *RefSlab) {
+        size_t &End = RangeEnds[Sym.first];
+        llvm::copy(Sym.second, RefsStorage.begin() + End);
+        End += Sym.second.size();
+      }
+
+    AllRefs.reserve(RangeEnds.size());
+    Offset = 0;
+    for (const auto &Sym : RangeEnds) {
+      llvm::MutableArrayRef<Ref> SymRefs(RefsStorage.data() + Offset,
+                                         Sym.second - Offset);
       // Sorting isn't required, but yields more stable results over rebuilds.
       llvm::sort(SymRefs);
-      llvm::copy(SymRefs, back_inserter(RefsStorage));
-      AllRefs.try_emplace(
-          Sym.first,
-          llvm::ArrayRef<Ref>(&RefsStorage[RefsStorage.size() - SymRefs.size()],
-                              SymRefs.size()));
+      AllRefs.try_emplace(Sym.first, SymRefs);
+      Offset = Sym.second;
     }
   }
 
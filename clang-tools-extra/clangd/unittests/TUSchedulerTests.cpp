@@ -955,6 +955,26 @@ TEST_F(TUSchedulerTests, NoChangeDiags) {
   ASSERT_TRUE(S.blockUntilIdle(timeoutSeconds(60)));
 }
 
+TEST_F(TUSchedulerTests, QueueLatencyMetric) {
+  trace::TestTracer Tracer;
+  TUScheduler S(CDB, optsForTest());
+
+  auto Foo = testPath("foo.cpp");
+  updateWithDiags(S, Foo, "int a;", WantDiagnostics::Yes,
+                  [](std::vector<Diag>) {});
+  S.runWithAST("touchAST", Foo, [](Expected<InputsAndAST> IA) {
+    cantFail(std::move(IA));
+  });
+  ASSERT_TRUE(S.blockUntilIdle(timeoutSeconds(60)));
+  EXPECT_THAT(Tracer.takeMetric("ast_worker_queue_latency", "update"),
+              SizeIs(1));
+  // The AST rebuild that applies the new preamble.
+  EXPECT_THAT(Tracer.takeMetric("ast_worker_queue_latency", "preamble"),
+              SizeIs(1));
+  EXPECT_THAT(Tracer.takeMetric("ast_worker_queue_latency", "read"),
+              SizeIs(1));
+}
+
 TEST_F(TUSchedulerTests, Run) {
   for (bool Sync : {false, true}) {
     auto Opts = optsForTest();
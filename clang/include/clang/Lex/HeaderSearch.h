@@ -28,6 +28,7 @@
 #include <cassert>
 #include <cstddef>
 #include <memory>
+#include <optional>
 #include <string>
 #include <utility>
 #include <vector>
@@ -351,6 +352,12 @@ class HeaderSearch {
   /// Describes whether a given directory has a module map in it.
   llvm::DenseMap<const DirectoryEntry *, bool> DirectoryHasModuleMap;
 
+  /// The names of the entries of each normal search directory, read once when
+  /// \c HeaderSearchOptions::CacheSearchDirContents is set. No value means
+  /// the directory could not be listed and is probed as usual.
+  llvm::DenseMap<const DirectoryEntry *, std::optional<llvm::StringSet<>>>
+      SearchDirContents;
+
   /// Set of module map files we've already loaded, and a flag indicating
   /// whether they were valid or not.
   llvm::DenseMap<const FileEntry *, bool> LoadedModuleMaps;
@@ -822,6 +829,11 @@ private:
                           ModuleMap::KnownHeader *SuggestedModule,
                           bool OpenFile = true, bool CacheFailures = true);
 
+  /// Returns false if the search directory \p Dir is known not to contain
+  /// the first path component of \p Filename, so that looking up
+  /// \p Filename in it would fail.
+  bool searchDirMayContain(DirectoryEntryRef Dir, StringRef Filename);
+
   /// Cache the result of a successful lookup at the given include location
   /// using the search path at \c HitIt.
   void cacheLookupSuccess(LookupFileCacheInfo &CacheLookup,
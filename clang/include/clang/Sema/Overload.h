@@ -977,6 +977,22 @@ class Sema;
         : IsSurrogate(false), IsADLCandidate(CallExpr::NotADL), RewriteKind(CRK_None) {}
   };
 
+  /// Allocator for the slabs backing the conversion sequences of an
+  /// OverloadCandidateSet. A candidate set is created and destroyed for
+  /// nearly every call and overloaded operator, and large sets outgrow their
+  /// inline storage, so freed slabs are kept in a small per-thread cache for
+  /// the next set instead of going back to malloc.
+  class OverloadSlabAllocator
+      : public llvm::AllocatorBase<OverloadSlabAllocator> {
+  public:
+    void *Allocate(size_t Size, size_t Alignment);
+    void Deallocate(const void *Ptr, size_t Size, size_t Alignment);
+
+    // Pull in base class overloads.
+    using AllocatorBase<OverloadSlabAllocator>::Allocate;
+    using AllocatorBase<OverloadSlabAllocator>::Deallocate;
+  };
+
   /// OverloadCandidateSet - A set of overload candidates, used in C++
   /// overload resolution (C++ 13.3).
   class OverloadCandidateSet {
@@ -1081,7 +1097,7 @@ class Sema;
 
     // Allocator for ConversionSequenceLists. We store the first few of these
     // inline to avoid allocation for small sets.
-    llvm::BumpPtrAllocator SlabAllocator;
+    llvm::BumpPtrAllocatorImpl<OverloadSlabAllocator> SlabAllocator;
 
     SourceLocation Loc;
     CandidateSetKind Kind;
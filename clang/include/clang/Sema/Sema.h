@@ -8798,6 +8798,14 @@ public:
   /// The number of SFINAE diagnostics that have been trapped.
   unsigned NumSFINAEErrors;
 
+  /// The number of function template definitions instantiated in this TU.
+  unsigned NumFunctionInstantiations = 0;
+
+  /// The implicit function template instantiations needed in this TU whose
+  /// definition was loaded from an AST file, e.g. a PCH built with
+  /// -fpch-instantiate-templates, rather than instantiated again.
+  llvm::SmallPtrSet<const FunctionDecl *, 4> FunctionInstantiationsFromAST;
+
   ArrayRef<sema::FunctionScopeInfo *> getFunctionScopes() const {
     return llvm::ArrayRef(FunctionScopes.begin() + FunctionScopesStart,
                           FunctionScopes.end());
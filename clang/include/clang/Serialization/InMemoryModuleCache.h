@@ -9,13 +9,70 @@
 #ifndef LLVM_CLANG_SERIALIZATION_INMEMORYMODULECACHE_H
 #define LLVM_CLANG_SERIALIZATION_INMEMORYMODULECACHE_H
 
+#include "clang/Basic/LLVM.h"
+#include "llvm/ADT/DenseMap.h"
 #include "llvm/ADT/IntrusiveRefCntPtr.h"
+#include "llvm/ADT/STLFunctionalExtras.h"
 #include "llvm/ADT/StringMap.h"
+#include "llvm/Support/ErrorOr.h"
+#include "llvm/Support/FileSystem/UniqueID.h"
 #include "llvm/Support/MemoryBuffer.h"
+#include <cstdint>
+#include <ctime>
 #include <memory>
+#include <mutex>
 
 namespace clang {
 
+class FileEntryRef;
+class FileManager;
+
+/// Process-wide cache of module files.
+///
+/// This is a read-only cache of PCM buffers for long-lived processes, such as
+/// a build daemon, that run many compilations importing the same explicitly
+/// built modules.  Each compilation still has its own \a InMemoryModuleCache;
+/// one constructed with a shared cache takes explicit module files from here
+/// rather than reading them from disk again.
+///
+/// Entries are keyed by the unique ID of the file, so that every path to a
+/// module file finds the same entry.  An entry is only reused while the size
+/// and modification time of the file match the ones it was read with and the
+/// caller accepts its contents, e.g. by their AST file signature.  The cache
+/// is thread-safe.
+class SharedModuleFileCache
+    : public llvm::ThreadSafeRefCountedBase<SharedModuleFileCache> {
+  struct Entry {
+    std::shared_ptr<llvm::MemoryBuffer> Buffer;
+    int64_t Size = 0;
+    time_t ModTime = 0;
+  };
+
+  mutable std::mutex Lock;
+  llvm::DenseMap<llvm::sys::fs::UniqueID, Entry> Entries;
+
+public:
+  /// Get a buffer for the module file \p File, reading it through \p FileMgr
+  /// unless an up-to-date copy is already cached.
+  ///
+  /// A cached copy is only returned if \p IsValid accepts it.  A file
+  /// rewritten within the same second with the same size is not told apart by
+  /// its size and modification time, so \p IsValid has to check the contents.
+  /// A copy it rejects is replaced by the file read from disk.
+  ///
+  /// The returned buffer shares ownership of the cached contents, so it stays
+  /// valid even if the entry is replaced or the cache is cleared.
+  llvm::ErrorOr<std::unique_ptr<llvm::MemoryBuffer>>
+  getBuffer(FileEntryRef File, FileManager &FileMgr,
+            llvm::function_ref<bool(const llvm::MemoryBuffer &)> IsValid);
+
+  /// Drop all cached buffers.
+  void clear();
+
+  /// Get the number of cached module files.
+  unsigned size() const;
+};
+
 /// In-memory cache for modules.
 ///
 /// This is a cache for modules for use across a compilation, sharing state
@@ -43,7 +100,18 @@ class InMemoryModuleCache : public llvm::RefCountedBase<InMemoryModuleCache> {
   /// Cache of buffers.
   llvm::StringMap<PCM> PCMs;
 
+  /// Process-wide cache consulted for explicit module files, if any.
+  IntrusiveRefCntPtr<SharedModuleFileCache> SharedCache;
+
 public:
+  InMemoryModuleCache() = default;
+  explicit InMemoryModuleCache(
+      IntrusiveRefCntPtr<SharedModuleFileCache> SharedCache)
+      : SharedCache(std::move(SharedCache)) {}
+
+  /// Get the process-wide cache of module files, or nullptr if there is none.
+  SharedModuleFileCache *getSharedCache() const { return SharedCache.get(); }
+
   /// There are four states for a PCM.  It must monotonically increase.
   ///
   ///  1. Unknown: the PCM has neither been read from disk nor built.
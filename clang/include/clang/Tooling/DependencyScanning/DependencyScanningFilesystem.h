@@ -14,6 +14,7 @@
 #include "llvm/ADT/DenseMap.h"
 #include "llvm/ADT/StringMap.h"
 #include "llvm/Support/Allocator.h"
+#include "llvm/Support/Error.h"
 #include "llvm/Support/ErrorOr.h"
 #include "llvm/Support/VirtualFileSystem.h"
 #include <mutex>
@@ -220,9 +221,36 @@ public:
   CacheShard &getShardForFilename(StringRef Filename) const;
   CacheShard &getShardForUID(llvm::sys::fs::UniqueID UID) const;
 
+  /// Memory-maps the directive tokens cache at \p Path, previously written by
+  /// \c writeDirectivesCache(). Entries are keyed by the hash of the file
+  /// contents, so they stay valid across runs as long as the contents match.
+  ///
+  /// Must be called before any worker filesystem starts using this cache.
+  llvm::Error loadDirectivesCache(StringRef Path);
+
+  /// Writes the directive tokens of all successfully scanned files, together
+  /// with any still-valid entries loaded by \c loadDirectivesCache(), to
+  /// \p Path.
+  llvm::Error writeDirectivesCache(StringRef Path) const;
+
+  /// Looks up directive tokens for the file with the given \p Contents in the
+  /// cache loaded by \c loadDirectivesCache().
+  ///
+  /// \returns true and populates \p Tokens and \p Directives if found.
+  bool findCachedDirectives(
+      StringRef Contents,
+      SmallVectorImpl<dependency_directives_scan::Token> &Tokens,
+      SmallVectorImpl<dependency_directives_scan::Directive> &Directives) const;
+
 private:
   std::unique_ptr<CacheShard[]> CacheShards;
   unsigned NumShards;
+
+  /// The memory-mapped directive tokens cache, if any.
+  std::unique_ptr<llvm::MemoryBuffer> DirectivesCacheBuffer;
+  /// Map from the hash of file contents to the serialized entry inside
+  /// \c DirectivesCacheBuffer.
+  llvm::DenseMap<uint64_t, StringRef> CachedDirectivesByHash;
 };
 
 /// This class is a local cache, that caches the 'stat' and 'open' calls to the
@@ -966,7 +966,7 @@ void ASTContext::PrintStats() const {
   }
 
   unsigned Idx = 0;
-  unsigned TotalBytes = 0;
+  uint64_t TotalBytes = 0;
 #define TYPE(Name, Parent)                                              \
   if (counts[Idx])                                                      \
     llvm::errs() << "    " << counts[Idx] << " " << #Name               \
@@ -1008,6 +1008,8 @@ void ASTContext::PrintStats() const {
   }
 
   BumpAlloc.PrintStats();
+  llvm::errs() << getSideTableAllocatedMemory()
+               << " bytes in side tables.\n";
 }
 
 void ASTContext::mergeDefinitionIntoModule(NamedDecl *ND, Module *M,
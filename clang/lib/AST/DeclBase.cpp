@@ -206,10 +206,10 @@ void Decl::PrintStats() {
 #include "clang/AST/DeclNodes.inc"
   llvm::errs() << "  " << totalDecls << " decls total.\n";
 
-  int totalBytes = 0;
+  uint64_t totalBytes = 0;
 #define DECL(DERIVED, BASE)                                             \
   if (n##DERIVED##s > 0) {                                              \
-    totalBytes += (int)(n##DERIVED##s * sizeof(DERIVED##Decl));         \
+    totalBytes += n##DERIVED##s * sizeof(DERIVED##Decl);                \
     llvm::errs() << "    " << n##DERIVED##s << " " #DERIVED " decls, "  \
                  << sizeof(DERIVED##Decl) << " each ("                  \
                  << n##DERIVED##s * sizeof(DERIVED##Decl)               \
@@ -102,7 +102,7 @@ void Stmt::PrintStats() {
   // Ensure the table is primed.
   getStmtInfoTableEntry(Stmt::NullStmtClass);
 
-  unsigned sum = 0;
+  uint64_t sum = 0;
   llvm::errs() << "\n*** Stmt/Expr Stats:\n";
   for (int i = 0; i != Stmt::lastStmtConstant+1; i++) {
     if (StmtClassInfo[i].Name == nullptr) continue;
@@ -113,11 +113,11 @@ void Stmt::PrintStats() {
   for (int i = 0; i != Stmt::lastStmtConstant+1; i++) {
     if (StmtClassInfo[i].Name == nullptr) continue;
     if (StmtClassInfo[i].Counter == 0) continue;
+    uint64_t bytes = uint64_t(StmtClassInfo[i].Counter) * StmtClassInfo[i].Size;
     llvm::errs() << "    " << StmtClassInfo[i].Counter << " "
                  << StmtClassInfo[i].Name << ", " << StmtClassInfo[i].Size
-                 << " each (" << StmtClassInfo[i].Counter*StmtClassInfo[i].Size
-                 << " bytes)\n";
-    sum += StmtClassInfo[i].Counter*StmtClassInfo[i].Size;
+                 << " each (" << bytes << " bytes)\n";
+    sum += bytes;
   }
 
   llvm::errs() << "Total bytes = " << sum << "\n";
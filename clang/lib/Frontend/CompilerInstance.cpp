@@ -1468,6 +1468,15 @@ static bool compileModuleAndReadASTImpl(CompilerInstance &ImportingInstance,
 /// multiple instances will compete to create the same module.  On timeout,
 /// deletes the lock file in order to avoid deadlock from crashing processes or
 /// bugs in the lock file manager.
+///
+/// The lock files are what lets independent modules be built concurrently:
+/// each compiler process builds whichever module it reaches first and waits
+/// for the others.  Within a single instance, modules are still built one at a
+/// time, on demand, as imports are encountered.  The set of modules a module
+/// depends on is only known once its own build has parsed its headers, and
+/// the nested CompilerInstance shares the FileManager, the InMemoryModuleCache
+/// and the diagnostics with its importer, none of which are thread-safe, so
+/// building siblings speculatively on other threads isn't possible here.
 static bool compileModuleAndReadASTBehindLock(
     CompilerInstance &ImportingInstance, SourceLocation ImportLoc,
     SourceLocation ModuleNameLoc, Module *Module, StringRef ModuleFileName) {
@@ -24,8 +24,13 @@
 #include "llvm/ADT/SmallString.h"
 #include "llvm/ADT/StringMap.h"
 #include "llvm/ADT/StringSwitch.h"
+#include "llvm/ADT/bit.h"
 #include <optional>
 
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
 using namespace clang;
 using namespace clang::dependency_directives_scan;
 using namespace llvm;
@@ -201,6 +206,27 @@ bool Scanner::reportError(const char *CurPtr, unsigned Err) {
   return true;
 }
 
+/// \returns the first character in [First, End) that is one of \p Stops, or
+/// \p End if there is none. Most of the input is code the scanner skips, so
+/// look at 16 characters at a time when possible.
+template <char... Stops>
+static const char *findFirstOf(const char *First, const char *const End) {
+#ifdef __SSE2__
+  while (End - First >= 16) {
+    __m128i Chunk = _mm_loadu_si128((const __m128i *)First);
+    __m128i Found = _mm_setzero_si128();
+    ((Found = _mm_or_si128(Found, _mm_cmpeq_epi8(Chunk, _mm_set1_epi8(Stops)))),
+     ...);
+    if (unsigned Mask = _mm_movemask_epi8(Found))
+      return First + llvm::countr_zero(Mask);
+    First += 16;
+  }
+#endif
+  while (First != End && ((*First != Stops) && ...))
+    ++First;
+  return First;
+}
+
 static void skipOverSpaces(const char *&First, const char *const End) {
   while (First != End && isHorizontalWhitespace(*First))
     ++First;
@@ -336,11 +362,10 @@ static void skipToNewlineRaw(const char *&First, const char *const End) {
     if (Len)
       return;
 
-    do {
-      if (++First == End)
-        return;
-      Len = isEOL(First, End);
-    } while (!Len);
+    First = findFirstOf<'\n', '\r'>(First + 1, End);
+    if (First == End)
+      return;
+    Len = isEOL(First, End);
 
     if (First[-1] != '\\')
       return;
@@ -362,8 +387,8 @@ static void skipBlockComment(const char *&First, const char *const End) {
     First = End;
     return;
   }
-  for (First += 3; First != End; ++First)
-    if (First[-1] == '*' && First[0] == '/') {
+  for (First += 3; (First = findFirstOf<'/'>(First, End)) != End; ++First)
+    if (First[-1] == '*') {
       ++First;
       return;
     }
@@ -405,6 +430,14 @@ void Scanner::skipLine(const char *&First, const char *const End) {
     }
     const char *Start = First;
     while (First != End && !isVerticalWhitespace(*First)) {
+      // Skip over characters that can't start a string or a comment.
+      const char *Next = findFirstOf<'"', '\'', '/', '\n', '\r'>(First, End);
+      if (Next != First) {
+        LastTokenPtr = Next - 1;
+        First = Next;
+        continue;
+      }
+
       // Iterate over strings correctly to avoid comments and newlines.
       if (*First == '"' ||
           (*First == '\'' && !isQuoteCppDigitSeparator(Start, First, End))) {
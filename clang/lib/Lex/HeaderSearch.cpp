@@ -57,6 +57,12 @@ ALWAYS_ENABLED_STATISTIC(
 ALWAYS_ENABLED_STATISTIC(NumFrameworkLookups, "Number of framework lookups.");
 ALWAYS_ENABLED_STATISTIC(NumSubFrameworkLookups,
                          "Number of subframework lookups.");
+ALWAYS_ENABLED_STATISTIC(NumDirLookupMisses,
+                         "Number of failed lookups in normal search "
+                         "directories.");
+ALWAYS_ENABLED_STATISTIC(NumDirLookupsSkipped,
+                         "Number of lookups in normal search directories "
+                         "skipped using the directory contents.");
 
 const IdentifierInfo *
 HeaderFileInfo::getControllingMacro(ExternalPreprocessorSource *External) {
@@ -100,6 +106,9 @@ void HeaderSearch::PrintStats() {
 
   llvm::errs() << NumFrameworkLookups << " framework lookups.\n"
                << NumSubFrameworkLookups << " subframework lookups.\n";
+  llvm::errs() << NumDirLookupMisses << " failed search directory lookups.\n"
+               << "  " << NumDirLookupsSkipped
+               << " lookups skipped due to the directory contents.\n";
 }
 
 void HeaderSearch::SetSearchPaths(
@@ -463,6 +472,32 @@ OptionalFileEntryRef HeaderSearch::getFileAndSuggestModule(
   return *File;
 }
 
+bool HeaderSearch::searchDirMayContain(DirectoryEntryRef Dir,
+                                       StringRef Filename) {
+  if (!HSOpts->CacheSearchDirContents)
+    return true;
+  // Relative components are resolved by the filesystem, not listed.
+  StringRef FirstComponent = *llvm::sys::path::begin(Filename);
+  if (FirstComponent == "." || FirstComponent == "..")
+    return true;
+
+  auto [It, Inserted] = SearchDirContents.try_emplace(&Dir.getDirEntry());
+  if (Inserted) {
+    llvm::StringSet<> Names;
+    std::error_code EC;
+    llvm::vfs::FileSystem &FS = FileMgr.getVirtualFileSystem();
+    llvm::vfs::directory_iterator DI = FS.dir_begin(Dir.getName(), EC), DE;
+    for (; !EC && DI != DE; DI.increment(EC))
+      Names.insert(llvm::sys::path::filename(DI->path()));
+    if (!EC)
+      It->second = std::move(Names);
+  }
+  if (!It->second || It->second->contains(FirstComponent))
+    return true;
+  ++NumDirLookupsSkipped;
+  return false;
+}
+
 /// LookupFile - Lookup the specified file in this search path, returning it
 /// if it exists or returning null if not.
 OptionalFileEntryRef DirectoryLookup::LookupFile(
@@ -491,9 +526,15 @@ OptionalFileEntryRef DirectoryLookup::LookupFile(
       RelativePath->append(Filename.begin(), Filename.end());
     }
 
-    return HS.getFileAndSuggestModule(
+    if (!HS.searchDirMayContain(*getDirRef(), Filename))
+      return std::nullopt;
+
+    OptionalFileEntryRef File = HS.getFileAndSuggestModule(
         TmpDir, IncludeLoc, getDir(), isSystemHeaderDirectory(),
         RequestingModule, SuggestedModule, OpenFile);
+    if (!File)
+      ++NumDirLookupMisses;
+    return File;
   }
 
   if (isFramework())
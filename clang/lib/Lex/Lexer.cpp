@@ -49,6 +49,8 @@
 
 #ifdef __SSE4_2__
 #include <nmmintrin.h>
+#elif defined(__SSE2__)
+#include <emmintrin.h>
 #endif
 
 using namespace clang;
@@ -1924,6 +1926,31 @@ fastParseASCIIIdentifier(const char *CurPtr,
       continue;
     return CurPtr;
   }
+#elif defined(__SSE2__)
+  // Without pcmpistri, classify 16 bytes at a time with signed compares.
+  // Non-ASCII bytes are negative and fall outside every range.
+  constexpr ssize_t BytesPerRegister = 16;
+  const __m128i LowerA = _mm_set1_epi8('a' - 1), LowerZ = _mm_set1_epi8('z' + 1);
+  const __m128i Digit0 = _mm_set1_epi8('0' - 1), Digit9 = _mm_set1_epi8('9' + 1);
+  const __m128i Underscore = _mm_set1_epi8('_'), CaseBit = _mm_set1_epi8(0x20);
+
+  while (LLVM_LIKELY(BufferEnd - CurPtr >= BytesPerRegister)) {
+    __m128i Cv = _mm_loadu_si128((const __m128i *)(CurPtr));
+    // Setting bit 5 maps 'A'-'Z' onto 'a'-'z' and nothing else onto them.
+    __m128i Lower = _mm_or_si128(Cv, CaseBit);
+    __m128i IsAlpha = _mm_and_si128(_mm_cmpgt_epi8(Lower, LowerA),
+                                    _mm_cmplt_epi8(Lower, LowerZ));
+    __m128i IsDigit = _mm_and_si128(_mm_cmpgt_epi8(Cv, Digit0),
+                                    _mm_cmplt_epi8(Cv, Digit9));
+    __m128i IsIdent = _mm_or_si128(_mm_or_si128(IsAlpha, IsDigit),
+                                   _mm_cmpeq_epi8(Cv, Underscore));
+    unsigned Mask = _mm_movemask_epi8(IsIdent) ^ 0xFFFF;
+    if (Mask == 0) {
+      CurPtr += BytesPerRegister;
+      continue;
+    }
+    return CurPtr + llvm::countr_zero(Mask);
+  }
 #endif
 
   unsigned char C = *CurPtr;
@@ -1932,6 +1959,35 @@ fastParseASCIIIdentifier(const char *CurPtr,
   return CurPtr;
 }
 
+/// Skip the run of horizontal whitespace starting at \p CurPtr.  Indentation
+/// makes long runs common, so scan them 16 bytes at a time when possible.
+static const char *
+skipHorizontalWhitespace(const char *CurPtr,
+                         [[maybe_unused]] const char *BufferEnd) {
+#ifdef __SSE2__
+  // Most runs are a single space between tokens; only go wide for longer
+  // ones.  CurPtr[0] being whitespace means CurPtr[1] is still in the buffer.
+  if (isHorizontalWhitespace(CurPtr[0]) && isHorizontalWhitespace(CurPtr[1])) {
+    const __m128i Space = _mm_set1_epi8(' '), Tab = _mm_set1_epi8('\t');
+    const __m128i FormFeed = _mm_set1_epi8('\f'), VTab = _mm_set1_epi8('\v');
+    while (BufferEnd - CurPtr >= 16) {
+      __m128i Cv = _mm_loadu_si128((const __m128i *)CurPtr);
+      __m128i IsWS = _mm_or_si128(
+          _mm_or_si128(_mm_cmpeq_epi8(Cv, Space), _mm_cmpeq_epi8(Cv, Tab)),
+          _mm_or_si128(_mm_cmpeq_epi8(Cv, FormFeed), _mm_cmpeq_epi8(Cv, VTab)));
+      unsigned Mask = _mm_movemask_epi8(IsWS) ^ 0xFFFF;
+      if (Mask != 0)
+        return CurPtr + llvm::countr_zero(Mask);
+      CurPtr += 16;
+    }
+  }
+#endif
+
+  while (isHorizontalWhitespace(*CurPtr))
+    ++CurPtr;
+  return CurPtr;
+}
+
 bool Lexer::LexIdentifierContinue(Token &Result, const char *CurPtr) {
   // Match [_A-Za-z0-9]*, we have already matched an identifier start.
 
@@ -2503,8 +2559,8 @@ bool Lexer::SkipWhitespace(Token &Result, const char *CurPtr,
   // Skip consecutive spaces efficiently.
   while (true) {
     // Skip horizontal whitespace very aggressively.
-    while (isHorizontalWhitespace(Char))
-      Char = *++CurPtr;
+    CurPtr = skipHorizontalWhitespace(CurPtr, BufferEnd);
+    Char = *CurPtr;
 
     // Otherwise if we have something other than whitespace, we're done.
     if (!isVerticalWhitespace(Char))
@@ -3722,9 +3778,7 @@ LexStart:
 
   // Small amounts of horizontal whitespace is very common between tokens.
   if (isHorizontalWhitespace(*CurPtr)) {
-    do {
-      ++CurPtr;
-    } while (isHorizontalWhitespace(*CurPtr));
+    CurPtr = skipHorizontalWhitespace(CurPtr + 1, BufferEnd);
 
     // If we are keeping whitespace and other tokens, just return what we just
     // skipped.  The next lexer invocation will return the token after the
@@ -610,6 +610,10 @@ void Sema::addExternalSource(ExternalSemaSource *E) {
 void Sema::PrintStats() const {
   llvm::errs() << "\n*** Semantic Analysis Stats:\n";
   llvm::errs() << NumSFINAEErrors << " SFINAE diagnostics trapped.\n";
+  llvm::errs() << NumFunctionInstantiations
+               << " function template definitions instantiated.\n";
+  llvm::errs() << FunctionInstantiationsFromAST.size()
+               << " function template instantiations reused from AST files.\n";
 
   BumpAlloc.PrintStats();
   AnalysisWarnings.PrintStats();
@@ -18012,7 +18012,12 @@ void Sema::MarkFunctionReferenced(SourceLocation Loc, FunctionDecl *Func,
     CUDA().CheckCall(Loc, Func);
 
   // If we need a definition, try to create one.
-  if (NeedDefinition && !Func->getBody()) {
+  const FunctionDecl *Definition = nullptr;
+  bool HasBody = NeedDefinition && Func->getBody(Definition);
+  if (HasBody && Definition->isFromASTFile() &&
+      Func->getTemplateSpecializationKind() == TSK_ImplicitInstantiation)
+    FunctionInstantiationsFromAST.insert(Func->getCanonicalDecl());
+  if (NeedDefinition && !HasBody) {
     runWithSufficientStackSpace(Loc, [&] {
       if (CXXConstructorDecl *Constructor =
               dyn_cast<CXXConstructorDecl>(Func)) {
@@ -1057,6 +1057,49 @@ bool OverloadCandidateSet::OperatorRewriteInfo::shouldAddReversed(
          FD->hasAttr<EnableIfAttr>();
 }
 
+namespace {
+/// Slabs released by OverloadCandidateSets on this thread, ready for reuse.
+struct OverloadSlabCache {
+  /// The size of the slabs a BumpPtrAllocator allocates first; custom-sized
+  /// and grown slabs are not cached.
+  static constexpr size_t SlabSize = 4096;
+  static constexpr size_t SlabAlign = alignof(std::max_align_t);
+  static constexpr unsigned MaxCachedSlabs = 8;
+
+  SmallVector<void *, MaxCachedSlabs> Slabs;
+
+  ~OverloadSlabCache() {
+    for (void *Slab : Slabs)
+      llvm::deallocate_buffer(Slab, SlabSize, SlabAlign);
+  }
+};
+} // namespace
+
+static OverloadSlabCache &getOverloadSlabCache() {
+  static thread_local OverloadSlabCache Cache;
+  return Cache;
+}
+
+void *OverloadSlabAllocator::Allocate(size_t Size, size_t Alignment) {
+  OverloadSlabCache &Cache = getOverloadSlabCache();
+  if (Size == OverloadSlabCache::SlabSize &&
+      Alignment == OverloadSlabCache::SlabAlign && !Cache.Slabs.empty())
+    return Cache.Slabs.pop_back_val();
+  return llvm::allocate_buffer(Size, Alignment);
+}
+
+void OverloadSlabAllocator::Deallocate(const void *Ptr, size_t Size,
+                                       size_t Alignment) {
+  OverloadSlabCache &Cache = getOverloadSlabCache();
+  if (Size == OverloadSlabCache::SlabSize &&
+      Alignment == OverloadSlabCache::SlabAlign &&
+      Cache.Slabs.size() < OverloadSlabCache::MaxCachedSlabs) {
+    Cache.Slabs.push_back(const_cast<void *>(Ptr));
+    return;
+  }
+  llvm::deallocate_buffer(const_cast<void *>(Ptr), Size, Alignment);
+}
+
 void OverloadCandidateSet::destroyCandidates() {
   for (iterator i = begin(), e = end(); i != e; ++i) {
     for (auto &C : i->Conversions)
@@ -8144,6 +8144,23 @@ void ASTReader::PrintStats() {
                  NumIdentifierLookupHits, NumIdentifierLookups,
                  (double)NumIdentifierLookupHits*100.0/NumIdentifierLookups);
 
+  unsigned NumModuleFiles = 0, NumMappedModuleFiles = 0;
+  uint64_t ModuleFileBytes = 0, MappedModuleFileBytes = 0;
+  for (ModuleFile &MF : ModuleMgr) {
+    ++NumModuleFiles;
+    ModuleFileBytes += MF.Buffer->getBufferSize();
+    if (MF.Buffer->getBufferKind() == llvm::MemoryBuffer::MemoryBuffer_MMap) {
+      ++NumMappedModuleFiles;
+      MappedModuleFileBytes += MF.Buffer->getBufferSize();
+    }
+  }
+  if (NumModuleFiles)
+    std::fprintf(stderr,
+                 "  %u/%u AST files memory-mapped (%llu/%llu bytes)\n",
+                 NumMappedModuleFiles, NumModuleFiles,
+                 (unsigned long long)MappedModuleFileBytes,
+                 (unsigned long long)ModuleFileBytes);
+
   if (GlobalIndex) {
     std::fprintf(stderr, "\n");
     GlobalIndex->printStats();
@@ -7,6 +7,7 @@
 //===----------------------------------------------------------------------===//
 
 #include "clang/Serialization/InMemoryModuleCache.h"
+#include "clang/Basic/FileManager.h"
 #include "llvm/Support/MemoryBuffer.h"
 
 using namespace clang;
@@ -78,3 +79,69 @@ void InMemoryModuleCache::finalizePCM(llvm::StringRef Filename) {
   assert(PCM.Buffer && "Trying to finalize a dropped PCM...");
   PCM.IsFinal = true;
 }
+
+namespace {
+/// A view of a buffer owned by a SharedModuleFileCache that keeps it alive.
+class SharedModuleFileBuffer : public llvm::MemoryBuffer {
+  std::shared_ptr<llvm::MemoryBuffer> Contents;
+
+public:
+  SharedModuleFileBuffer(std::shared_ptr<llvm::MemoryBuffer> Contents)
+      : Contents(std::move(Contents)) {
+    init(this->Contents->getBufferStart(), this->Contents->getBufferEnd(),
+         /*RequiresNullTerminator=*/false);
+  }
+
+  StringRef getBufferIdentifier() const override {
+    return Contents->getBufferIdentifier();
+  }
+
+  BufferKind getBufferKind() const override {
+    return Contents->getBufferKind();
+  }
+};
+} // namespace
+
+llvm::ErrorOr<std::unique_ptr<llvm::MemoryBuffer>>
+SharedModuleFileCache::getBuffer(
+    FileEntryRef File, FileManager &FileMgr,
+    llvm::function_ref<bool(const llvm::MemoryBuffer &)> IsValid) {
+  std::shared_ptr<llvm::MemoryBuffer> Cached;
+  {
+    std::lock_guard<std::mutex> Guard(Lock);
+    auto I = Entries.find(File.getUniqueID());
+    if (I != Entries.end() && I->second.Size == File.getSize() &&
+        I->second.ModTime == File.getModificationTime())
+      Cached = I->second.Buffer;
+  }
+  // Check the contents without holding the lock.
+  if (Cached && IsValid(*Cached)) {
+    File.closeFile();
+    return std::make_unique<SharedModuleFileBuffer>(std::move(Cached));
+  }
+
+  // Read the file without holding the lock; if another thread raced us here,
+  // the last one to finish wins and both copies remain valid for their users.
+  auto Buf = FileMgr.getBufferForFile(File, /*isVolatile=*/false,
+                                      /*RequiresNullTerminator=*/false);
+  if (!Buf)
+    return Buf.getError();
+
+  std::shared_ptr<llvm::MemoryBuffer> Contents = std::move(*Buf);
+  {
+    std::lock_guard<std::mutex> Guard(Lock);
+    Entries[File.getUniqueID()] = {Contents, File.getSize(),
+                                   File.getModificationTime()};
+  }
+  return std::make_unique<SharedModuleFileBuffer>(std::move(Contents));
+}
+
+void SharedModuleFileCache::clear() {
+  std::lock_guard<std::mutex> Guard(Lock);
+  Entries.clear();
+}
+
+unsigned SharedModuleFileCache::size() const {
+  std::lock_guard<std::mutex> Guard(Lock);
+  return Entries.size();
+}
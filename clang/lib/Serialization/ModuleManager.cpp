@@ -198,14 +198,31 @@ ModuleManager::addModule(StringRef FileName, ModuleKind Type,
     return OutOfDate;
   } else {
     // Get a buffer of the file and close the file descriptor when done.
-    // The file is volatile because in a parallel build we expect multiple
-    // compiler processes to use the same module file rebuilding it if needed.
+    // Implicit modules, PCHs and prebuilt modules are volatile because in a
+    // parallel build we expect multiple compiler processes to use the same
+    // module file rebuilding it if needed. Explicit modules are produced by
+    // the build system before any of their importers run and are not
+    // rewritten underneath them, so they can be mapped rather than copied
+    // into memory, which matters for TUs importing thousands of them.
     //
     // RequiresNullTerminator is false because module files don't need it, and
     // this allows the file to still be mmapped.
-    auto Buf = FileMgr.getBufferForFile(NewModule->File,
-                                        /*IsVolatile=*/true,
-                                        /*RequiresNullTerminator=*/false);
+    //
+    // A process running many compilations may share explicit module files
+    // between them through a SharedModuleFileCache. A cached copy is only
+    // taken if its signature is the expected one, so it is never used for
+    // module files imported without a signature.
+    bool IsVolatile = NewModule->Kind != MK_ExplicitModule;
+    SharedModuleFileCache *SharedCache = getModuleCache().getSharedCache();
+    auto HasExpectedSignature = [&](const llvm::MemoryBuffer &Buffer) {
+      return ReadSignature(PCHContainerRdr.ExtractPCH(Buffer)) ==
+             ExpectedSignature;
+    };
+    auto Buf = SharedCache && !IsVolatile && ExpectedSignature
+                   ? SharedCache->getBuffer(NewModule->File, FileMgr,
+                                            HasExpectedSignature)
+                   : FileMgr.getBufferForFile(NewModule->File, IsVolatile,
+                                              /*RequiresNullTerminator=*/false);
 
     if (!Buf) {
       ErrorStr = Buf.getError().message();
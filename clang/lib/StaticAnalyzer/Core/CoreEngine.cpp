@@ -47,6 +47,8 @@ STATISTIC(NumSTUSteps, "The # of STU steps executed.");
 STATISTIC(NumCTUSteps, "The # of CTU steps executed.");
 STATISTIC(NumReachedMaxSteps,
             "The # of times we reached the max number of steps.");
+STATISTIC(NumReachedMemoryBudget,
+          "The # of times we reached the memory budget of the exploded graph.");
 STATISTIC(NumPathsExplored,
             "The # of paths explored by the analyzer.");
 
@@ -135,7 +137,11 @@ bool CoreEngine::ExecuteWorkList(const LocationContext *L, unsigned MaxSteps,
   if(!UnlimitedSteps)
     G.reserve(std::min(MaxSteps, PreReservationCap));
 
-  auto ProcessWList = [this, UnlimitedSteps](unsigned MaxSteps) {
+  // The nodes and the states are allocated from the allocator of the graph.
+  const uint64_t MaxGraphBytes =
+      uint64_t(ExprEng.getAnalysisManager().options.MaxGraphMemoryMB) << 20;
+
+  auto ProcessWList = [this, UnlimitedSteps, MaxGraphBytes](unsigned MaxSteps) {
     unsigned Steps = MaxSteps;
     while (WList->hasWork()) {
       if (!UnlimitedSteps) {
@@ -146,6 +152,18 @@ bool CoreEngine::ExecuteWorkList(const LocationContext *L, unsigned MaxSteps,
         --Steps;
       }
 
+      if (MaxGraphBytes) {
+        uint64_t Bytes = G.getAllocator().getBytesAllocated();
+        if (Bytes >= MaxGraphBytes) {
+          NumReachedMemoryBudget++;
+          break;
+        }
+        // Past half of the budget, recycle nodes after every statement, unless
+        // reclamation is disabled altogether.
+        if (Bytes >= MaxGraphBytes / 2 && G.ReclaimNodeInterval > 1)
+          G.enableNodeReclamation(1);
+      }
+
       NumSteps++;
 
       const WorkListUnit &WU = WList->dequeue();
@@ -60,6 +60,11 @@ STATISTIC(NumVisitedBlocksInAnalyzedFunctions,
           "The # of visited basic blocks in the analyzed functions.");
 STATISTIC(PercentReachableBlocks, "The % of reachable basic blocks.");
 STATISTIC(MaxCFGSize, "The maximum number of basic blocks in a function.");
+STATISTIC(MaxExplodedGraphSize,
+          "The maximum number of exploded nodes of a top level function.");
+STATISTIC(MaxExplodedGraphMemoryKB,
+          "The maximum memory (in KB) of the exploded graph and the program "
+          "states of a top level function.");
 
 //===----------------------------------------------------------------------===//
 // AnalysisConsumer declaration.
@@ -728,6 +733,9 @@ void AnalysisConsumer::RunPathSensitiveChecks(Decl *D,
   }
   Eng.ExecuteWorkList(Mgr->getAnalysisDeclContextManager().getStackFrame(D),
                       Mgr->options.MaxNodesPerTopLevelFunction);
+  MaxExplodedGraphSize.updateMax(Eng.getGraph().size());
+  MaxExplodedGraphMemoryKB.updateMax(
+      Eng.getGraph().getAllocator().getBytesAllocated() >> 10);
   if (ExprEngineTimer) {
     ExprEngineTimer->stopTimer();
     llvm::TimeRecord ExprEngineEndTime = ExprEngineTimer->getTotalTime();
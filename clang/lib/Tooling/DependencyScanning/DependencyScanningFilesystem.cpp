@@ -7,9 +7,15 @@
 //===----------------------------------------------------------------------===//
 
 #include "clang/Tooling/DependencyScanning/DependencyScanningFilesystem.h"
+#include "clang/Basic/TokenKinds.h"
+#include "clang/Basic/Version.h"
+#include "llvm/ADT/DenseSet.h"
+#include "llvm/Support/EndianStream.h"
 #include "llvm/Support/MemoryBuffer.h"
 #include "llvm/Support/SmallVectorMemoryBuffer.h"
 #include "llvm/Support/Threading.h"
+#include "llvm/Support/raw_ostream.h"
+#include "llvm/Support/xxhash.h"
 #include <optional>
 
 using namespace clang;
@@ -62,9 +68,13 @@ bool DependencyScanningWorkerFilesystem::ensureDirectiveTokensArePopulated(
     return true;
 
   SmallVector<dependency_directives_scan::Directive, 64> Directives;
-  // Scan the file for preprocessor directives that might affect the
+  // Reuse the directives scanned by a previous run if the contents match.
+  // Otherwise, scan the file for preprocessor directives that might affect the
   // dependencies.
-  if (scanSourceForDependencyDirectives(Contents->Original->getBuffer(),
+  if (!SharedCache.findCachedDirectives(Contents->Original->getBuffer(),
+                                        Contents->DepDirectiveTokens,
+                                        Directives) &&
+      scanSourceForDependencyDirectives(Contents->Original->getBuffer(),
                                         Contents->DepDirectiveTokens,
                                         Directives)) {
     Contents->DepDirectiveTokens.clear();
@@ -108,6 +118,206 @@ DependencyScanningFilesystemSharedCache::getShardForUID(
   return CacheShards[Hash % NumShards];
 }
 
+namespace {
+/// Identifies a directive tokens cache file. The version must be bumped
+/// whenever the layout or the meaning of the serialized tokens changes. The
+/// header also records the number of token kinds and the full version of the
+/// compiler, including its revision, so that a cache written by any other
+/// build of the scanner is ignored.
+constexpr llvm::StringLiteral DirectivesCacheMagic = "CDDC";
+constexpr uint32_t DirectivesCacheVersion = 2;
+
+/// Every entry starts with the contents hash, the contents size, the number of
+/// tokens and the number of directives, followed by the tokens (offset,
+/// length, kind, flags) and the directives (kind, number of tokens).
+constexpr size_t DirectivesCacheEntryHeaderSize = 8 + 4 + 4 + 4;
+constexpr size_t DirectivesCacheTokenSize = 4 + 4 + 2 + 2;
+constexpr size_t DirectivesCacheDirectiveSize = 4 + 4;
+} // namespace
+
+llvm::Error
+DependencyScanningFilesystemSharedCache::loadDirectivesCache(StringRef Path) {
+  auto MaybeBuffer = llvm::MemoryBuffer::getFile(
+      Path, /*IsText=*/false, /*RequiresNullTerminator=*/false);
+  if (!MaybeBuffer)
+    return llvm::createFileError(Path, MaybeBuffer.getError());
+  auto Malformed = [&]() {
+    return llvm::createFileError(
+        Path, llvm::createStringError(llvm::inconvertibleErrorCode(),
+                                      "malformed directive tokens cache"));
+  };
+
+  using namespace llvm::support;
+  StringRef Data = (*MaybeBuffer)->getBuffer();
+  if (!Data.consume_front(DirectivesCacheMagic) || Data.size() < 12)
+    return Malformed();
+  const char *Ptr = Data.data();
+  uint32_t Version = endian::readNext<uint32_t, llvm::endianness::little>(Ptr);
+  uint32_t NumTokenKinds =
+      endian::readNext<uint32_t, llvm::endianness::little>(Ptr);
+  // A cache written by a different version of the scanner is stale, not
+  // broken; ignore it and let the next write replace it.
+  if (Version != DirectivesCacheVersion || NumTokenKinds != tok::NUM_TOKENS)
+    return llvm::Error::success();
+  uint32_t CompilerVersionSize =
+      endian::readNext<uint32_t, llvm::endianness::little>(Ptr);
+  const char *End = Data.end();
+  if (size_t(End - Ptr) < uint64_t(CompilerVersionSize) + 4)
+    return Malformed();
+  StringRef CompilerVersion(Ptr, CompilerVersionSize);
+  Ptr += CompilerVersionSize;
+  if (CompilerVersion != getClangFullVersion())
+    return llvm::Error::success();
+  uint32_t NumEntries =
+      endian::readNext<uint32_t, llvm::endianness::little>(Ptr);
+
+  llvm::DenseMap<uint64_t, StringRef> Entries;
+  for (uint32_t I = 0; I != NumEntries; ++I) {
+    if (size_t(End - Ptr) < DirectivesCacheEntryHeaderSize)
+      return Malformed();
+    const char *EntryStart = Ptr;
+    uint64_t Hash = endian::readNext<uint64_t, llvm::endianness::little>(Ptr);
+    Ptr += 4; // Contents size, validated on lookup.
+    uint64_t NumTokens =
+        endian::readNext<uint32_t, llvm::endianness::little>(Ptr);
+    uint64_t NumDirectives =
+        endian::readNext<uint32_t, llvm::endianness::little>(Ptr);
+    uint64_t PayloadSize = NumTokens * DirectivesCacheTokenSize +
+                           NumDirectives * DirectivesCacheDirectiveSize;
+    if (uint64_t(End - Ptr) < PayloadSize)
+      return Malformed();
+    Ptr += PayloadSize;
+    Entries[Hash] = StringRef(EntryStart, Ptr - EntryStart);
+  }
+
+  DirectivesCacheBuffer = std::move(*MaybeBuffer);
+  CachedDirectivesByHash = std::move(Entries);
+  return llvm::Error::success();
+}
+
+bool DependencyScanningFilesystemSharedCache::findCachedDirectives(
+    StringRef Contents,
+    SmallVectorImpl<dependency_directives_scan::Token> &Tokens,
+    SmallVectorImpl<dependency_directives_scan::Directive> &Directives) const {
+  if (CachedDirectivesByHash.empty())
+    return false;
+  auto It = CachedDirectivesByHash.find(llvm::xxh3_64bits(Contents));
+  if (It == CachedDirectivesByHash.end())
+    return false;
+
+  using namespace llvm::support;
+  const char *Ptr = It->second.data() + 8;
+  uint32_t Size = endian::readNext<uint32_t, llvm::endianness::little>(Ptr);
+  if (Size != Contents.size())
+    return false;
+  uint32_t NumTokens =
+      endian::readNext<uint32_t, llvm::endianness::little>(Ptr);
+  uint32_t NumDirectives =
+      endian::readNext<uint32_t, llvm::endianness::little>(Ptr);
+
+  SmallVector<dependency_directives_scan::Token, 64> NewTokens;
+  NewTokens.reserve(NumTokens);
+  for (uint32_t I = 0; I != NumTokens; ++I) {
+    uint32_t Offset = endian::readNext<uint32_t, llvm::endianness::little>(Ptr);
+    uint32_t Length = endian::readNext<uint32_t, llvm::endianness::little>(Ptr);
+    uint16_t Kind = endian::readNext<uint16_t, llvm::endianness::little>(Ptr);
+    uint16_t Flags = endian::readNext<uint16_t, llvm::endianness::little>(Ptr);
+    if (uint64_t(Offset) + Length > Contents.size() || Kind >= tok::NUM_TOKENS)
+      return false;
+    NewTokens.emplace_back(Offset, Length, tok::TokenKind(Kind), Flags);
+  }
+
+  // Directives refer to consecutive slices of the token array, so they can
+  // only be materialized once the tokens are in their final location.
+  SmallVector<std::pair<dependency_directives_scan::DirectiveKind, uint32_t>,
+              32>
+      NewDirectives;
+  uint64_t TotalDirectiveTokens = 0;
+  for (uint32_t I = 0; I != NumDirectives; ++I) {
+    uint32_t Kind = endian::readNext<uint32_t, llvm::endianness::little>(Ptr);
+    uint32_t Count = endian::readNext<uint32_t, llvm::endianness::little>(Ptr);
+    if (Kind > dependency_directives_scan::pp_eof)
+      return false;
+    NewDirectives.emplace_back(dependency_directives_scan::DirectiveKind(Kind),
+                               Count);
+    TotalDirectiveTokens += Count;
+  }
+  if (TotalDirectiveTokens != NumTokens)
+    return false;
+
+  Tokens.assign(NewTokens.begin(), NewTokens.end());
+  ArrayRef<dependency_directives_scan::Token> Remaining = Tokens;
+  Directives.clear();
+  for (auto [Kind, Count] : NewDirectives) {
+    Directives.emplace_back(Kind, Remaining.take_front(Count));
+    Remaining = Remaining.drop_front(Count);
+  }
+  return true;
+}
+
+llvm::Error DependencyScanningFilesystemSharedCache::writeDirectivesCache(
+    StringRef Path) const {
+  std::string Entries;
+  llvm::raw_string_ostream EntriesOS(Entries);
+  llvm::support::endian::Writer W(EntriesOS, llvm::endianness::little);
+  llvm::DenseSet<uint64_t> Written;
+  uint32_t NumEntries = 0;
+
+  for (unsigned I = 0; I != NumShards; ++I) {
+    CacheShard &Shard = CacheShards[I];
+    std::lock_guard<std::mutex> LockGuard(Shard.CacheLock);
+    for (const auto &[UID, Entry] : Shard.EntriesByUID) {
+      if (Entry->isError() || Entry->isDirectory())
+        continue;
+      std::optional<ArrayRef<dependency_directives_scan::Directive>>
+          Directives = Entry->getDirectiveTokens();
+      if (!Directives)
+        continue;
+      StringRef Contents = Entry->getOriginalContents();
+      uint64_t Hash = llvm::xxh3_64bits(Contents);
+      if (!Written.insert(Hash).second)
+        continue;
+      const auto &Tokens = Entry->getCachedContents()->DepDirectiveTokens;
+      W.write<uint64_t>(Hash);
+      W.write<uint32_t>(Contents.size());
+      W.write<uint32_t>(Tokens.size());
+      W.write<uint32_t>(Directives->size());
+      for (const dependency_directives_scan::Token &Tok : Tokens) {
+        W.write<uint32_t>(Tok.Offset);
+        W.write<uint32_t>(Tok.Length);
+        W.write<uint16_t>(Tok.Kind);
+        W.write<uint16_t>(Tok.Flags);
+      }
+      for (const dependency_directives_scan::Directive &D : *Directives) {
+        W.write<uint32_t>(D.Kind);
+        W.write<uint32_t>(D.Tokens.size());
+      }
+      ++NumEntries;
+    }
+  }
+
+  // Keep entries from the previous run for files this run didn't touch.
+  for (const auto &[Hash, Entry] : CachedDirectivesByHash) {
+    if (!Written.insert(Hash).second)
+      continue;
+    EntriesOS << Entry;
+    ++NumEntries;
+  }
+
+  return llvm::writeToOutput(Path, [&](llvm::raw_ostream &OS) {
+    llvm::support::endian::Writer W(OS, llvm::endianness::little);
+    OS << DirectivesCacheMagic;
+    W.write<uint32_t>(DirectivesCacheVersion);
+    W.write<uint32_t>(tok::NUM_TOKENS);
+    std::string CompilerVersion = getClangFullVersion();
+    W.write<uint32_t>(CompilerVersion.size());
+    OS << CompilerVersion;
+    W.write<uint32_t>(NumEntries);
+    OS << EntriesOS.str();
+    return llvm::Error::success();
+  });
+}
+
 const CachedFileSystemEntry *
 DependencyScanningFilesystemSharedCache::CacheShard::findEntryByFilename(
     StringRef Filename) const {
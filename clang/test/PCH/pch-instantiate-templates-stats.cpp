@@ -0,0 +1,32 @@
+// Test that -print-stats counts the function template instantiations that are
+// performed, and the ones that are reused from a PCH built with
+// -fpch-instantiate-templates.
+
+// RUN: %clang_cc1 -std=c++17 -fsyntax-only -print-stats -include %s %s 2>&1 \
+// RUN:   | FileCheck %s --check-prefix=NOPCH
+// RUN: %clang_cc1 -std=c++17 -x c++-header -emit-pch -fpch-instantiate-templates \
+// RUN:   -o %t.pch %s
+// RUN: %clang_cc1 -std=c++17 -fsyntax-only -print-stats -include-pch %t.pch %s \
+// RUN:   2>&1 | FileCheck %s --check-prefix=PCH
+
+// NOPCH: 3 function template definitions instantiated.
+// NOPCH: 0 function template instantiations reused from AST files.
+
+// The PCH already has the definitions of twice<int> and thrice<int>, so only
+// later<int> is instantiated in the TU.
+// PCH: 1 function template definitions instantiated.
+// PCH: 2 function template instantiations reused from AST files.
+
+#ifndef HEADER
+#define HEADER
+
+template <typename T> constexpr T twice(T x) { return x + x; }
+template <typename T> T thrice(T x) { return x + x + x; }
+inline int use() { return twice(1) + thrice(1); }
+
+#else
+
+template <typename T> T later(T x) { return x; }
+int main() { return twice(3) + thrice(3) + later(3); }
+
+#endif
@@ -18,6 +18,7 @@
 #include "llvm/ADT/STLExtras.h"
 #include "llvm/ADT/Twine.h"
 #include "llvm/Support/CommandLine.h"
+#include "llvm/Support/FileSystem.h"
 #include "llvm/Support/FileUtilities.h"
 #include "llvm/Support/Format.h"
 #include "llvm/Support/JSON.h"
@@ -78,6 +79,7 @@ static ScanningOutputFormat Format = ScanningOutputFormat::Make;
 static ScanningOptimizations OptimizeArgs;
 static std::string ModuleFilesDir;
 static bool EagerLoadModules;
+static std::string DirectivesCachePath;
 static unsigned NumThreads = 0;
 static std::string CompilationDB;
 static std::string ModuleName;
@@ -181,6 +183,9 @@ static void ParseArgs(int argc, char **argv) {
 
   EagerLoadModules = Args.hasArg(OPT_eager_load_pcm);
 
+  if (const llvm::opt::Arg *A = Args.getLastArg(OPT_directives_cache_EQ))
+    DirectivesCachePath = A->getValue();
+
   if (const llvm::opt::Arg *A = Args.getLastArg(OPT_j)) {
     StringRef S{A->getValue()};
     if (!llvm::to_integer(S, NumThreads, 0)) {
@@ -1004,6 +1009,14 @@ int clang_scan_deps_main(int argc, char **argv, const llvm::ToolContext &) {
   DependencyScanningService Service(ScanMode, Format, OptimizeArgs,
                                     EagerLoadModules);
 
+  // A missing or unreadable cache only costs a rescan, so don't fail on it.
+  if (!DirectivesCachePath.empty() &&
+      llvm::sys::fs::exists(DirectivesCachePath))
+    if (llvm::Error E =
+            Service.getSharedCache().loadDirectivesCache(DirectivesCachePath))
+      llvm::errs() << "warning: ignoring directives cache: "
+                   << llvm::toString(std::move(E)) << '\n';
+
   llvm::Timer T;
   T.startTimer();
 
@@ -1025,6 +1038,12 @@ int clang_scan_deps_main(int argc, char **argv, const llvm::ToolContext &) {
   }
 
   T.stopTimer();
+
+  if (!DirectivesCachePath.empty())
+    if (llvm::Error E =
+            Service.getSharedCache().writeDirectivesCache(DirectivesCachePath))
+      llvm::errs() << "warning: failed to write directives cache: "
+                   << llvm::toString(std::move(E)) << '\n';
   if (PrintTiming)
     llvm::errs() << llvm::format(
         "clang-scan-deps timing: %0.2fs wall, %0.2fs process\n",
@@ -359,6 +359,27 @@ TEST(MinimizeSourceToDependencyDirectivesTest, CommentSlashSlashStar) {
   EXPECT_STREQ("#define MACRO 1\n", Out.data());
 }
 
+TEST(MinimizeSourceToDependencyDirectivesTest, LongSkippedLines) {
+  SmallVector<char, 128> Out;
+
+  // Exercise skipping of lines, strings and comments that span multiple
+  // 16-byte chunks of input.
+  ASSERT_FALSE(minimizeSourceToDependencyDirectives(
+      "int some_long_variable_name = another_long_function_name(1, 2);\n"
+      "const char *S = \"a string that is long enough to cross chunks\"; "
+      "#define NOT_A_DIRECTIVE\n"
+      "/* a block comment that keeps going for quite a while **** and\n"
+      "#include <missing.h>\n"
+      "   ends here */ #include <a.h>\n"
+      "// a line comment that also goes on for a long time \\\n"
+      "#include <continued.h>\n"
+      "#include <b.h>\n",
+      Out));
+  EXPECT_STREQ("#include <a.h>\n"
+               "#include <b.h>\n",
+               Out.data());
+}
+
 TEST(MinimizeSourceToDependencyDirectivesTest, Ifdef) {
   SmallVector<char, 128> Out;
 
@@ -238,6 +238,32 @@ TEST_F(HeaderSearchTest, HeaderFrameworkLookup) {
   EXPECT_EQ(Search.getIncludeNameForHeader(FE), "Foo/Foo.h");
 }
 
+TEST_F(HeaderSearchTest, CachedSearchDirContents) {
+  Search.getHeaderSearchOpts().CacheSearchDirContents = true;
+  addSearchDir("/a");
+  addSearchDir("/b");
+  std::string HeaderPath = "/b/sub/x.h";
+  VFS->addFile(HeaderPath, 0,
+               llvm::MemoryBuffer::getMemBufferCopy("", HeaderPath),
+               /*User=*/std::nullopt, /*Group=*/std::nullopt,
+               llvm::sys::fs::file_type::regular_file);
+
+  auto Lookup = [&](StringRef Filename) {
+    return Search.LookupFile(
+        Filename, SourceLocation(), /*isAngled=*/false, /*FromDir=*/nullptr,
+        /*CurDir=*/nullptr, /*Includers=*/{}, /*SearchPath=*/nullptr,
+        /*RelativePath=*/nullptr, /*RequestingModule=*/nullptr,
+        /*SuggestedModule=*/nullptr, /*IsMapped=*/nullptr,
+        /*IsFrameworkFound=*/nullptr);
+  };
+  OptionalFileEntryRef FoundFile = Lookup("sub/x.h");
+  ASSERT_TRUE(FoundFile.has_value());
+  EXPECT_EQ(FoundFile->getName(), HeaderPath);
+  EXPECT_TRUE(Lookup("../b/sub/x.h").has_value());
+  EXPECT_FALSE(Lookup("sub/y.h").has_value());
+  EXPECT_FALSE(Lookup("x.h").has_value());
+}
+
 // Helper struct with null terminator character to make MemoryBuffer happy.
 template <class FileTy, class PaddingTy>
 struct NullTerminatedFile : public FileTy {
@@ -619,6 +619,28 @@ TEST_F(LexerTest, FindNextToken) {
                                                 "xyz", "=", "abcd", ";"));
 }
 
+TEST_F(LexerTest, LongIdentifiersAndWhitespaceRuns) {
+  // Identifiers and whitespace runs longer than a vector register, ending at
+  // every kind of boundary the fast scanners have to stop at.
+  std::string Ident =
+      "abcdefghijklmnopqrstuvwxyz_ABCDEFGHIJKLMNOPQRSTUVWXYZ_0123";
+  std::string Space = std::string(20, ' ') + "\t\f\v" + std::string(20, ' ');
+  std::string Source = Ident + Space + Ident + "[" + Ident + "@" + Space +
+                       Ident + "`" + Ident + "{" + Ident + "/" + Ident +
+                       ":" + Space + "\n" + Space + Ident;
+  auto Toks = Lex(Source);
+  ASSERT_EQ(Toks.size(), 14u);
+  for (unsigned I : {0, 1, 3, 5, 7, 9, 11, 13}) {
+    EXPECT_EQ(Toks[I].getKind(), tok::identifier);
+    EXPECT_EQ(Toks[I].getLength(), Ident.size());
+  }
+  EXPECT_TRUE(Toks[1].hasLeadingSpace());
+  EXPECT_TRUE(Toks[5].hasLeadingSpace());
+  EXPECT_FALSE(Toks[7].hasLeadingSpace());
+  EXPECT_TRUE(Toks[13].hasLeadingSpace());
+  EXPECT_TRUE(Toks[13].isAtStartOfLine());
+}
+
 TEST_F(LexerTest, CreatedFIDCountForPredefinedBuffer) {
   TrivialModuleLoader ModLoader;
   auto PP = CreatePP("", ModLoader);
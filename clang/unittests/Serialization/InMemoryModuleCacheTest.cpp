@@ -7,8 +7,11 @@
 //===----------------------------------------------------------------------===//
 
 #include "clang/Serialization/InMemoryModuleCache.h"
+#include "clang/Basic/FileManager.h"
 #include "llvm/Support/MemoryBuffer.h"
+#include "llvm/Support/VirtualFileSystem.h"
 #include "gtest/gtest.h"
+#include <vector>
 
 using namespace llvm;
 using namespace clang;
@@ -116,4 +119,54 @@ TEST(InMemoryModuleCacheTest, finalizePCM) {
   EXPECT_TRUE(Cache.isPCMFinal("B"));
 }
 
+TEST(InMemoryModuleCacheTest, sharedModuleFileCache) {
+  auto Shared = makeIntrusiveRefCnt<SharedModuleFileCache>();
+  InMemoryModuleCache Cache(Shared);
+  EXPECT_EQ(Shared.get(), Cache.getSharedCache());
+  EXPECT_EQ(nullptr, InMemoryModuleCache().getSharedCache());
+
+  // Every compilation has its own file manager.  Keep them around, since
+  // buffers read from an InMemoryFileSystem refer to its storage.
+  std::vector<std::unique_ptr<FileManager>> FileMgrs;
+  auto getFromCache = [&](time_t ModTime, StringRef Contents,
+                          StringRef Path = "/m.pcm", bool IsValid = true) {
+    auto FS = makeIntrusiveRefCnt<vfs::InMemoryFileSystem>();
+    FS->addFile("/m.pcm", ModTime, MemoryBuffer::getMemBufferCopy(Contents));
+    FS->addHardLink("/link.pcm", "/m.pcm");
+    FileMgrs.push_back(std::make_unique<FileManager>(FileSystemOptions(), FS));
+    FileManager &FileMgr = *FileMgrs.back();
+    auto File = FileMgr.getOptionalFileRef(Path);
+    EXPECT_TRUE(File);
+    auto Buf = Shared->getBuffer(*File, FileMgr,
+                                 [&](const MemoryBuffer &) { return IsValid; });
+    EXPECT_TRUE(Buf);
+    return std::move(*Buf);
+  };
+
+  // The first compilation reads the file, later ones reuse its contents,
+  // also when they reach it through another path.
+  auto B1 = getFromCache(1, "data:1");
+  auto B2 = getFromCache(1, "data:1");
+  auto B3 = getFromCache(1, "data:1", "/link.pcm");
+  EXPECT_EQ("data:1", B1->getBuffer());
+  EXPECT_EQ(B1->getBufferStart(), B2->getBufferStart());
+  EXPECT_EQ(B1->getBufferStart(), B3->getBufferStart());
+  EXPECT_EQ(1u, Shared->size());
+
+  // A cached copy the caller rejects is read again.
+  auto B4 = getFromCache(1, "data:1", "/m.pcm", /*IsValid=*/false);
+  EXPECT_EQ("data:1", B4->getBuffer());
+  EXPECT_NE(B1->getBufferStart(), B4->getBufferStart());
+  EXPECT_EQ(1u, Shared->size());
+
+  // A modified file replaces the entry; earlier buffers stay valid.
+  auto B5 = getFromCache(2, "data:22");
+  EXPECT_EQ("data:22", B5->getBuffer());
+  EXPECT_EQ("data:1", B1->getBuffer());
+
+  Shared->clear();
+  EXPECT_EQ(0u, Shared->size());
+  EXPECT_EQ("data:22", B5->getBuffer());
+}
+
 } // namespace
@@ -7,8 +7,12 @@
 //===----------------------------------------------------------------------===//
 
 #include "clang/Tooling/DependencyScanning/DependencyScanningFilesystem.h"
+#include "clang/Basic/Version.h"
 #include "llvm/ADT/SmallString.h"
+#include "llvm/Support/FileSystem.h"
+#include "llvm/Support/FileUtilities.h"
 #include "llvm/Support/VirtualFileSystem.h"
+#include "llvm/Testing/Support/Error.h"
 #include "gtest/gtest.h"
 
 using namespace clang::tooling::dependencies;
@@ -174,3 +178,102 @@ TEST(DependencyScanningFilesystem, CacheStatOnExists) {
   EXPECT_EQ(InstrumentingFS->NumStatusCalls, 2u);
   EXPECT_EQ(InstrumentingFS->NumExistsCalls, 0u);
 }
+
+TEST(DependencyScanningFilesystem, DirectivesCacheRoundTrip) {
+  auto InMemoryFS = llvm::makeIntrusiveRefCnt<llvm::vfs::InMemoryFileSystem>();
+  InMemoryFS->setCurrentWorkingDirectory("/");
+  llvm::StringRef Source = "#include \"a.h\"\n"
+                           "int x;\n"
+                           "#if FOO\n"
+                           "#import <b.h>\n"
+                           "#endif\n";
+  InMemoryFS->addFile("/foo.c", 0, llvm::MemoryBuffer::getMemBuffer(Source));
+
+  auto GetMinimized = [&](DependencyScanningFilesystemSharedCache &Cache) {
+    DependencyScanningWorkerFilesystem DepFS(Cache, InMemoryFS);
+    auto Entry = DepFS.getOrCreateFileSystemEntry("/foo.c");
+    EXPECT_TRUE(bool(Entry));
+    EXPECT_TRUE(DepFS.ensureDirectiveTokensArePopulated(*Entry));
+    std::string Minimized;
+    llvm::raw_string_ostream OS(Minimized);
+    clang::printDependencyDirectivesAsSource(
+        Entry->getContents(), *Entry->getDirectiveTokens(), OS);
+    return Minimized;
+  };
+
+  llvm::SmallString<128> CachePath;
+  ASSERT_FALSE(llvm::sys::fs::createTemporaryFile("directives", "cache",
+                                                  CachePath));
+  llvm::FileRemover Remover(CachePath);
+
+  DependencyScanningFilesystemSharedCache FirstRun;
+  std::string Expected = GetMinimized(FirstRun);
+  ASSERT_THAT_ERROR(FirstRun.writeDirectivesCache(CachePath),
+                    llvm::Succeeded());
+
+  DependencyScanningFilesystemSharedCache SecondRun;
+  ASSERT_THAT_ERROR(SecondRun.loadDirectivesCache(CachePath),
+                    llvm::Succeeded());
+  llvm::SmallVector<clang::dependency_directives_scan::Token> Tokens;
+  llvm::SmallVector<clang::dependency_directives_scan::Directive> Directives;
+  EXPECT_TRUE(SecondRun.findCachedDirectives(Source, Tokens, Directives));
+  EXPECT_FALSE(SecondRun.findCachedDirectives("int y;", Tokens, Directives));
+  EXPECT_EQ(GetMinimized(SecondRun), Expected);
+}
+
+TEST(DependencyScanningFilesystem, DirectivesCacheRejectsBadData) {
+  auto InMemoryFS = llvm::makeIntrusiveRefCnt<llvm::vfs::InMemoryFileSystem>();
+  InMemoryFS->setCurrentWorkingDirectory("/");
+  llvm::StringRef Source = "#include \"a.h\"\n";
+  InMemoryFS->addFile("/foo.c", 0, llvm::MemoryBuffer::getMemBuffer(Source));
+
+  llvm::SmallString<128> CachePath;
+  ASSERT_FALSE(llvm::sys::fs::createTemporaryFile("directives", "cache",
+                                                  CachePath));
+  llvm::FileRemover Remover(CachePath);
+  {
+    DependencyScanningFilesystemSharedCache Cache;
+    DependencyScanningWorkerFilesystem DepFS(Cache, InMemoryFS);
+    auto Entry = DepFS.getOrCreateFileSystemEntry("/foo.c");
+    ASSERT_TRUE(bool(Entry));
+    ASSERT_TRUE(DepFS.ensureDirectiveTokensArePopulated(*Entry));
+    ASSERT_THAT_ERROR(Cache.writeDirectivesCache(CachePath),
+                      llvm::Succeeded());
+  }
+  auto Buffer = llvm::MemoryBuffer::getFile(CachePath);
+  ASSERT_TRUE(bool(Buffer));
+  const std::string Original = (*Buffer)->getBuffer().str();
+
+  // Loads a copy of the cache with the byte at \p Offset replaced and returns
+  // whether the cached tokens for Source are used.
+  auto UsesPatchedCache = [&](size_t Offset, char Byte) {
+    std::string Patched = Original;
+    Patched[Offset] = Byte;
+    {
+      std::error_code EC;
+      llvm::raw_fd_ostream OS(CachePath, EC);
+      EXPECT_FALSE(EC);
+      OS << Patched;
+    }
+    DependencyScanningFilesystemSharedCache Cache;
+    EXPECT_THAT_ERROR(Cache.loadDirectivesCache(CachePath), llvm::Succeeded());
+    llvm::SmallVector<clang::dependency_directives_scan::Token> Tokens;
+    llvm::SmallVector<clang::dependency_directives_scan::Directive> Directives;
+    return Cache.findCachedDirectives(Source, Tokens, Directives);
+  };
+
+  // Magic, version, number of token kinds, then the compiler's version.
+  size_t CompilerVersionOffset = 4 + 4 + 4 + 4;
+  size_t CompilerVersionSize = clang::getClangFullVersion().size();
+  ASSERT_GT(CompilerVersionSize, 0u);
+  // Number of entries and the entry header, then the first token's offset
+  // and length before its kind.
+  size_t KindOffset = CompilerVersionOffset + CompilerVersionSize + 4 + 20 + 8;
+  ASSERT_LT(KindOffset + 1, Original.size());
+
+  EXPECT_TRUE(UsesPatchedCache(0, 'C'));
+  // A cache from another build of the compiler is ignored.
+  EXPECT_FALSE(UsesPatchedCache(CompilerVersionOffset, '\x7f'));
+  // So is a token of a kind that does not exist.
+  EXPECT_FALSE(UsesPatchedCache(KindOffset + 1, '\x7f'));
+}
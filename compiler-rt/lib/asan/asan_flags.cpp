@@ -58,6 +58,12 @@ void InitializeFlags() {
     cf.malloc_context_size = kDefaultMallocContextSize;
     cf.intercept_tls_get_addr = true;
     cf.exitcode = 1;
+    // Every allocation stores its stack, so the depot can grow large in long
+    // running processes. Delta compression is cheap enough to run in the
+    // background by default, where a background thread can be started.
+#if !SANITIZER_WINDOWS && !SANITIZER_FUCHSIA
+    cf.compress_stack_depot = 1;
+#endif
     OverrideCommonFlags(cf);
   }
   Flags *f = flags();
@@ -122,9 +122,10 @@ struct ChunkHeader {
   // 3-rd 4 bytes
   u32 timestamp_ms;
   // 4-th 4 bytes
-  // Note only 1 bit is needed for this flag if we need space in the future for
-  // more fields.
-  u32 from_memalign;
+  u32 from_memalign : 1;
+  // Whether the allocation is recorded in the profile, see
+  // sample_allocation_bytes.
+  u32 sampled : 1;
   // 5-th and 6-th 4 bytes
   // The max size of an allocation is 2^40 (kMaxAllowedMallocSize), so this
   // could be shrunk to kMaxAllowedMallocBits if we need space in the future for
@@ -246,6 +247,27 @@ void ClearShadow(uptr addr, uptr size) {
   }
 }
 
+// Returns the natural logarithm of `x` > 0, to about 1e-7, without calling
+// into libm.
+static double FastLog(double x) {
+  u64 bits;
+  internal_memcpy(&bits, &x, sizeof(bits));
+  int exponent = static_cast<int>((bits >> 52) & 0x7ff) - 1023;
+  // Scale x to m in [1, 2), so that log(x) = exponent * log(2) + log(m).
+  bits = (bits & ((1ULL << 52) - 1)) | (1023ULL << 52);
+  double m;
+  internal_memcpy(&m, &bits, sizeof(m));
+  // log(m) = 2 * atanh(s) with s = (m - 1) / (m + 1) in [0, 1/3).
+  double s = (m - 1) / (m + 1);
+  double s2 = s * s;
+  static const double kCoefficients[] = {1.0 / 9, 1.0 / 7, 1.0 / 5, 1.0 / 3,
+                                         1.0};
+  double series = 1.0 / 11;
+  for (double c : kCoefficients)
+    series = c + s2 * series;
+  return exponent * 0.69314718055994531 + 2 * s * series;
+}
+
 struct Allocator {
   static const uptr kMaxAllowedMallocSize = 1ULL << kMaxAllowedMallocBits;
 
@@ -316,7 +338,7 @@ struct Allocator {
           Allocator *A = (Allocator *)alloc;
           MemprofChunk *m =
               A->GetMemprofChunk((void *)chunk, user_requested_size);
-          if (!m)
+          if (!m || !m->sampled)
             return;
           uptr user_beg = ((uptr)m) + kChunkHeaderSize;
           u64 c = GetShadowCount(user_beg, user_requested_size);
@@ -338,6 +360,29 @@ struct Allocator {
                                        : kMaxAllowedMallocSize;
   }
 
+  // Returns whether an allocation of `size` bytes made by `t` is recorded in
+  // the profile. The distances in bytes between sampled bytes are drawn from
+  // an exponential distribution with mean sample_allocation_bytes, so that
+  // every allocated byte is sampled with the same probability, independently
+  // of the others, and an allocation of `size` bytes is sampled with
+  // probability 1 - exp(-size / sample_allocation_bytes).
+  bool ShouldSample(MemprofThread *t, uptr size) {
+    int interval = flags()->sample_allocation_bytes;
+    if (interval <= 0 || !t)
+      return true;
+    MemprofThreadLocalMallocStorage &ms = t->malloc_storage();
+    if (ms.bytes_until_sample > size) {
+      ms.bytes_until_sample -= size;
+      return false;
+    }
+    if (UNLIKELY(!ms.sample_rand_state))
+      ms.sample_rand_state = static_cast<u32>(MonotonicNanoTime()) | 1;
+    // A uniform draw from (0, 1].
+    double u = (Rand(&ms.sample_rand_state) + 1.0) / 4294967296.0;
+    ms.bytes_until_sample = 1 + static_cast<uptr>(-interval * FastLog(u));
+    return true;
+  }
+
   // -------------------- Allocation/Deallocation routines ---------------
   void *Allocate(uptr size, uptr alignment, BufferedStackTrace *stack,
                  AllocType alloc_type) {
@@ -408,14 +453,19 @@ struct Allocator {
     m->from_memalign = alloc_beg != chunk_beg;
     CHECK(size);
 
-    m->cpu_id = GetCpuId();
-    m->timestamp_ms = GetTimestamp();
-    m->alloc_context_id = StackDepotPut(*stack);
-
-    uptr size_rounded_down_to_granularity =
-        RoundDownTo(size, SHADOW_GRANULARITY);
-    if (size_rounded_down_to_granularity)
-      ClearShadow(user_beg, size_rounded_down_to_granularity);
+    // The shadow of allocations that are not sampled is never read, so there
+    // is no need to clear it or to record the allocation context.
+    m->sampled = ShouldSample(t, size);
+    if (m->sampled) {
+      m->cpu_id = GetCpuId();
+      m->timestamp_ms = GetTimestamp();
+      m->alloc_context_id = StackDepotPut(*stack);
+
+      uptr size_rounded_down_to_granularity =
+          RoundDownTo(size, SHADOW_GRANULARITY);
+      if (size_rounded_down_to_granularity)
+        ClearShadow(user_beg, size_rounded_down_to_granularity);
+    }
 
     MemprofStats &thread_stats = GetCurrentThreadStats();
     thread_stats.mallocs++;
@@ -449,7 +499,7 @@ struct Allocator {
 
     u64 user_requested_size =
         atomic_exchange(&m->user_requested_size, 0, memory_order_acquire);
-    if (memprof_inited && atomic_load_relaxed(&constructed) &&
+    if (m->sampled && memprof_inited && atomic_load_relaxed(&constructed) &&
         !atomic_load_relaxed(&destructing)) {
       u64 c = GetShadowCount(p, user_requested_size);
       long curtime = GetTimestamp();
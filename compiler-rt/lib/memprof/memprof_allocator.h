@@ -78,6 +78,10 @@ using AllocatorCache = MemprofAllocator::AllocatorCache;
 
 struct MemprofThreadLocalMallocStorage {
   AllocatorCache allocator_cache;
+  // The number of bytes to allocate before the next sampled allocation, and
+  // the state of the generator of the sampling distances.
+  uptr bytes_until_sample;
+  u32 sample_rand_state;
   void CommitBack();
 
 private:
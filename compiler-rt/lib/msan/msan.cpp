@@ -165,6 +165,9 @@ static void InitializeFlags() {
     // FIXME: test and enable.
     cf.check_printf = false;
     cf.intercept_tls_get_addr = true;
+    // Allocation and origin stacks can make the depot large; compress it in
+    // the background.
+    cf.compress_stack_depot = 1;
     OverrideCommonFlags(cf);
   }
 
@@ -127,7 +127,7 @@ void CompressThread::NewWorkNotify() {
   int compress = common_flags()->compress_stack_depot;
   if (!compress)
     return;
-  if (compress > 0 /* for testing or debugging */) {
+  if (compress > 0) {
     SpinMutexLock l(&mutex_);
     if (state_ == State::NotStarted) {
       atomic_store(&run_, 1, memory_order_release);
@@ -139,11 +139,15 @@ void CompressThread::NewWorkNotify() {
           },
           this);
       state_ = thread_ ? State::Started : State::Failed;
+      if (state_ == State::Failed)
+        VReport(1, "%s: StackDepot compression thread failed to start\n",
+                SanitizerToolName);
     }
-    if (state_ == State::Started) {
+    // Without the thread, do not compress at all rather than stalling the
+    // thread that filled the block; negative values ask for that instead.
+    if (state_ == State::Started)
       semaphore_.Post();
-      return;
-    }
+    return;
   }
   CompressStackStore();
 }
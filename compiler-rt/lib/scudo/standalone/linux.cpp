@@ -175,6 +175,10 @@ u32 getThreadID() {
 #endif
 }
 
+// With a C library that registers restartable sequences, like glibc 2.35 and
+// later, this reads the CPU number from the rseq area without a system call.
+s32 getCurrentCPU() { return static_cast<s32>(sched_getcpu()); }
+
 // Blocking is possibly unused if the getrandom block is not compiled in.
 bool getRandom(void *Buffer, uptr Length, UNUSED bool Blocking) {
   if (!Buffer || !Length || Length > MaxRandomLength)
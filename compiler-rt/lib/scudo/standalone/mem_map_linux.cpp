@@ -68,6 +68,12 @@ static void *mmapWrapper(uptr Addr, uptr Size, const char *Name, uptr Flags) {
       reportMapError(errno == ENOMEM ? Size : 0);
     return nullptr;
   }
+#if defined(MADV_HUGEPAGE)
+  // Failing to apply the hint (e.g. with transparent huge pages disabled) only
+  // means the memory is backed by regular pages.
+  if (Flags & MAP_HUGEPAGES)
+    madvise(P, Size, MADV_HUGEPAGE);
+#endif
 #if SCUDO_ANDROID
   if (Name)
     prctl(ANDROID_PR_SET_VMA, ANDROID_PR_SET_VMA_ANON_NAME, P, Size, Name);
@@ -127,17 +127,40 @@ public:
 
     if (Config::getEnableContiguousRegions()) {
       ReservedMemoryT ReservedMemory = {};
-      // Reserve the space required for the Primary.
-      CHECK(ReservedMemory.create(/*Addr=*/0U, RegionSize * NumClasses,
+      // Reserve the space required for the Primary. With huge pages, reserve
+      // an extra group so that the regions, and thus the groups, can be
+      // aligned to the group size.
+      const uptr AlignmentSlack = Config::getEnableHugePages() ? GroupSize : 0;
+      CHECK(ReservedMemory.create(/*Addr=*/0U,
+                                  RegionSize * NumClasses + AlignmentSlack,
                                   "scudo:primary_reserve"));
-      const uptr PrimaryBase = ReservedMemory.getBase();
+      uptr PrimaryBase = ReservedMemory.getBase();
+      if (Config::getEnableHugePages()) {
+        PrimaryBase = roundUp(PrimaryBase, GroupSize);
+        // Give back the parts of the reservation around the aligned regions.
+        const uptr PrimaryEnd = PrimaryBase + RegionSize * NumClasses;
+        const uptr ReservedEnd =
+            ReservedMemory.getBase() + ReservedMemory.getCapacity();
+        if (PrimaryBase != ReservedMemory.getBase()) {
+          MemMapT Head = ReservedMemory.dispatch(
+              ReservedMemory.getBase(), PrimaryBase - ReservedMemory.getBase());
+          Head.unmap(Head.getBase(), Head.getCapacity());
+        }
+        if (PrimaryEnd != ReservedEnd) {
+          MemMapT Tail =
+              ReservedMemory.dispatch(PrimaryEnd, ReservedEnd - PrimaryEnd);
+          Tail.unmap(Tail.getBase(), Tail.getCapacity());
+        }
+      }
 
       for (uptr I = 0; I < NumClasses; I++) {
         MemMapT RegionMemMap = ReservedMemory.dispatch(
             PrimaryBase + (I << RegionSizeLog), RegionSize);
         RegionInfo *Region = getRegionInfo(I);
 
-        initRegion(Region, I, RegionMemMap, Config::getEnableRandomOffset());
+        initRegion(Region, I, RegionMemMap,
+                   Config::getEnableRandomOffset() &&
+                       !Config::getEnableHugePages());
       }
       shuffle(RegionInfoArray, NumClasses, &Seed);
     }
@@ -1053,7 +1076,8 @@ private:
               RegionBeg + MappedUser, MapSize, "scudo:primary",
               MAP_ALLOWNOMEM | MAP_RESIZABLE |
                   (useMemoryTagging<Config>(Options.load()) ? MAP_MEMTAG
-                                                            : 0)))) {
+                                                            : 0) |
+                  (Config::getEnableHugePages() ? MAP_HUGEPAGES : 0)))) {
         return 0U;
       }
       Region->MemMapInfo.MappedUser += MapSize;
@@ -1394,6 +1418,24 @@ private:
 
       const uptr PushedBytesDelta = BG->BytesInBGAtLastCheckpoint - BytesInBG;
 
+      // Releasing a part of a group would split the huge pages backing it, so
+      // only release groups in which all the blocks are free. As allocations
+      // are served from a group until it is exhausted, other groups tend to
+      // become entirely free.
+      if (Config::getEnableHugePages()) {
+        const uptr BatchGroupEnd =
+            Min(BatchGroupBase + GroupSize, AllocatedUserEnd);
+        // The blocks of a group are the ones starting in it.
+        const uptr BlocksInBG =
+            (BatchGroupEnd - Region->RegionBeg + BlockSize - 1) / BlockSize -
+            (BatchGroupBase - Region->RegionBeg + BlockSize - 1) / BlockSize;
+        if (NumBlocks < BlocksInBG) {
+          Prev = BG;
+          BG = BG->Next;
+          continue;
+        }
+      }
+
       // Given the randomness property, we try to release the pages only if the
       // bytes used by free blocks exceed certain proportion of group size. Note
       // that this heuristic only applies when all the spaces in a BatchGroup
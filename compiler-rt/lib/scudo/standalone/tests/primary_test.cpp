@@ -68,6 +68,8 @@ template <typename SizeClassMapT> struct TestConfig2 {
     static const scudo::uptr CompactPtrScale = 0;
     static const bool EnableRandomOffset = true;
     static const scudo::uptr MapSizeIncrement = 1UL << 18;
+    // This is the only test config that enables huge pages.
+    static const bool EnableHugePages = true;
   };
 };
 
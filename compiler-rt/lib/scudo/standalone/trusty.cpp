@@ -105,6 +105,8 @@ u32 getNumberOfCPUs() { return 0; }
 
 u32 getThreadID() { return 0; }
 
+s32 getCurrentCPU() { return -1; }
+
 bool getRandom(UNUSED void *Buffer, UNUSED uptr Length, UNUSED bool Blocking) {
   return false;
 }
@@ -24,9 +24,16 @@
 
 namespace scudo {
 
-template <class Allocator, u32 TSDsArraySize, u32 DefaultTSDCount>
+// When PerCPU is true, there is one TSD per CPU (up to TSDsArraySize), and a
+// thread uses the TSD of the CPU it is running on, if the platform can tell.
+// Compared to associating a thread with a TSD once, this keeps contention on
+// the TSDs low when there are many more threads than CPUs, without needing
+// more TSDs, and thus cached memory, than there are CPUs.
+template <class Allocator, u32 TSDsArraySize, u32 DefaultTSDCount,
+          bool PerCPU = false>
 struct TSDRegistrySharedT {
-  using ThisT = TSDRegistrySharedT<Allocator, TSDsArraySize, DefaultTSDCount>;
+  using ThisT =
+      TSDRegistrySharedT<Allocator, TSDsArraySize, DefaultTSDCount, PerCPU>;
 
   struct ScopedTSD {
     ALWAYS_INLINE ScopedTSD(ThisT &TSDRegistry) {
@@ -53,8 +60,13 @@ struct TSDRegistrySharedT {
     for (u32 I = 0; I < TSDsArraySize; I++)
       TSDs[I].init(Instance);
     const u32 NumberOfCPUs = getNumberOfCPUs();
-    setNumberOfTSDs((NumberOfCPUs == 0) ? DefaultTSDCount
-                                        : Min(NumberOfCPUs, DefaultTSDCount));
+    if (PerCPU && NumberOfCPUs != 0 && getCurrentCPU() >= 0) {
+      setNumberOfTSDs(Min(NumberOfCPUs, TSDsArraySize));
+      NumberOfPerCPUTSDs = Min(NumberOfCPUs, TSDsArraySize);
+    } else {
+      setNumberOfTSDs((NumberOfCPUs == 0) ? DefaultTSDCount
+                                          : Min(NumberOfCPUs, DefaultTSDCount));
+    }
     Initialized = true;
   }
 
@@ -136,6 +148,8 @@ private:
   ALWAYS_INLINE TSD<Allocator> *getTSDAndLock() NO_THREAD_SAFETY_ANALYSIS {
     TSD<Allocator> *TSD = getCurrentTSD();
     DCHECK(TSD);
+    if (PerCPU && NumberOfPerCPUTSDs != 0)
+      TSD = getTSDForCurrentCPU(TSD);
     // Try to lock the currently associated context.
     if (TSD->tryLock())
       return TSD;
@@ -149,6 +163,20 @@ private:
     return getTSDAndLockSlow(TSD);
   }
 
+  // Associates the thread with the TSD of the CPU it is running on, as it may
+  // have migrated since its last allocation.
+  ALWAYS_INLINE TSD<Allocator> *
+  getTSDForCurrentCPU(TSD<Allocator> *CurrentTSD) {
+    const s32 CPU = getCurrentCPU();
+    if (UNLIKELY(CPU < 0))
+      return CurrentTSD;
+    TSD<Allocator> *CPUTSD =
+        &TSDs[static_cast<u32>(CPU) % NumberOfPerCPUTSDs];
+    if (CPUTSD != CurrentTSD)
+      setCurrentTSD(CPUTSD);
+    return CPUTSD;
+  }
+
   ALWAYS_INLINE uptr *getTlsPtr() const {
 #if SCUDO_HAS_PLATFORM_TLS_SLOT
     return reinterpret_cast<uptr *>(getPlatformAllocatorTlsSlot());
@@ -255,6 +283,9 @@ private:
   }
 
   atomic_u32 CurrentIndex = {};
+  // The number of TSDs indexed by CPU, 0 if threads are not associated with
+  // TSDs by CPU. Set once during initialization.
+  u32 NumberOfPerCPUTSDs = 0;
   u32 NumberOfTSDs GUARDED_BY(MutexTSDs) = 0;
   u32 NumberOfCoPrimes GUARDED_BY(MutexTSDs) = 0;
   u32 CoPrimes[TSDsArraySize] GUARDED_BY(MutexTSDs) = {};
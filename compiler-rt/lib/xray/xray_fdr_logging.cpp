@@ -62,6 +62,25 @@ struct XRAY_TLS_ALIGNAS(64) ThreadLocalData {
   using ControllerStorage = std::byte[sizeof(FDRController<>)];
   alignas(FDRController<>) ControllerStorage CStorage;
   FDRController<> *Controller = nullptr;
+
+  // State for sampling calls, see shouldSkipEntry(). SampleSlots is a hash
+  // table of call counts, tagged with the ID of the function that owns the
+  // slot. SampleFrames is the stack of the open calls, with whether each was
+  // logged, and SampleOverflow counts the open calls nested deeper than it.
+  struct SampleSlot {
+    int32_t FuncId;
+    uint32_t Calls;
+  };
+  struct SampleFrame {
+    int32_t FuncId;
+    bool Skipped;
+  };
+  static constexpr uint32_t kSampleSlotsLog2 = 8;
+  static constexpr uint32_t kMaxSampleDepth = 64;
+  SampleSlot SampleSlots[1 << kSampleSlotsLog2] = {};
+  SampleFrame SampleFrames[kMaxSampleDepth] = {};
+  uint32_t SampleDepth = 0;
+  uint32_t SampleOverflow = 0;
 };
 
 } // namespace
@@ -79,6 +98,9 @@ static BufferQueue *BQ = nullptr;
 // Global thresholds for function durations.
 static atomic_uint64_t ThresholdTicks{0};
 
+// Global rate of the calls of each function that are logged.
+static atomic_uint32_t SampleRate{1};
+
 // Global for ticks per second.
 static atomic_uint64_t TicksPerSec{0};
 
@@ -477,6 +499,12 @@ static bool setupTLD(ThreadLocalData &TLD) XRAY_NEVER_INSTRUMENT {
       TLD.Writer->resetRecord();
     }
 
+    // Drop the sampling state of the previous session, including the calls
+    // it left open.
+    internal_memset(TLD.SampleSlots, 0, sizeof(TLD.SampleSlots));
+    TLD.SampleDepth = 0;
+    TLD.SampleOverflow = 0;
+
     auto *CStorage = reinterpret_cast<FDRController<> *>(&TLD.CStorage);
     new (CStorage)
         FDRController<>(TLD.BQ, TLD.Buffer, *TLD.Writer, clock_gettime,
@@ -488,6 +516,54 @@ static bool setupTLD(ThreadLocalData &TLD) XRAY_NEVER_INSTRUMENT {
   return true;
 }
 
+// Decides whether the call that just entered the function with ID \p FuncId
+// is left out of the log, when only one in SampleRate calls are logged. The
+// decision is kept on a per-thread stack so that the matching exit is left
+// out as well. Calls nested deeper than the stack can track are all logged.
+//
+// Functions that hash to the same slot take it over from each other, and
+// restart their count when they do, so that a function is never logged less
+// often than one in SampleRate calls, only more often.
+static bool shouldSkipEntry(ThreadLocalData &TLD,
+                            int32_t FuncId) XRAY_NEVER_INSTRUMENT {
+  auto Rate = atomic_load_relaxed(&SampleRate);
+  if (LIKELY(Rate <= 1))
+    return false;
+  if (TLD.SampleDepth == ThreadLocalData::kMaxSampleDepth) {
+    ++TLD.SampleOverflow;
+    return false;
+  }
+  // Fibonacci hashing spreads the consecutive IDs of a DSO's functions.
+  auto &Slot = TLD.SampleSlots[(static_cast<uint32_t>(FuncId) * 2654435769u) >>
+                               (32 - ThreadLocalData::kSampleSlotsLog2)];
+  if (Slot.FuncId != FuncId)
+    Slot = {FuncId, 0};
+  bool Skip = Slot.Calls++ % Rate != 0;
+  TLD.SampleFrames[TLD.SampleDepth++] = {FuncId, Skip};
+  return Skip;
+}
+
+// Pops the decision of shouldSkipEntry() for the call of \p FuncId that is
+// exiting. Calls that were left without an exit, by an exception, a longjmp
+// or unpatching, are popped with it. Exits without a matching call, such as
+// those of calls entered before sampling was set up, are always logged.
+static bool shouldSkipExit(ThreadLocalData &TLD,
+                           int32_t FuncId) XRAY_NEVER_INSTRUMENT {
+  if (LIKELY(TLD.SampleDepth == 0))
+    return false;
+  if (TLD.SampleOverflow != 0) {
+    --TLD.SampleOverflow;
+    return false;
+  }
+  for (auto Depth = TLD.SampleDepth; Depth-- != 0;) {
+    if (TLD.SampleFrames[Depth].FuncId != FuncId)
+      continue;
+    TLD.SampleDepth = Depth;
+    return TLD.SampleFrames[Depth].Skipped;
+  }
+  return false;
+}
+
 void fdrLoggingHandleArg0(int32_t FuncId,
                           XRayEntryType Entry) XRAY_NEVER_INSTRUMENT {
   auto TC = getTimestamp();
@@ -504,12 +580,18 @@ void fdrLoggingHandleArg0(int32_t FuncId,
   switch (Entry) {
   case XRayEntryType::ENTRY:
   case XRayEntryType::LOG_ARGS_ENTRY:
+    if (shouldSkipEntry(TLD, FuncId))
+      return;
     TLD.Controller->functionEnter(FuncId, TSC, CPU);
     return;
   case XRayEntryType::EXIT:
+    if (shouldSkipExit(TLD, FuncId))
+      return;
     TLD.Controller->functionExit(FuncId, TSC, CPU);
     return;
   case XRayEntryType::TAIL:
+    if (shouldSkipExit(TLD, FuncId))
+      return;
     TLD.Controller->functionTailExit(FuncId, TSC, CPU);
     return;
   case XRayEntryType::CUSTOM_EVENT:
@@ -534,12 +616,18 @@ void fdrLoggingHandleArg1(int32_t FuncId, XRayEntryType Entry,
   switch (Entry) {
   case XRayEntryType::ENTRY:
   case XRayEntryType::LOG_ARGS_ENTRY:
+    if (shouldSkipEntry(TLD, FuncId))
+      return;
     TLD.Controller->functionEnterArg(FuncId, TSC, CPU, Arg);
     return;
   case XRayEntryType::EXIT:
+    if (shouldSkipExit(TLD, FuncId))
+      return;
     TLD.Controller->functionExit(FuncId, TSC, CPU);
     return;
   case XRayEntryType::TAIL:
+    if (shouldSkipExit(TLD, FuncId))
+      return;
     TLD.Controller->functionTailExit(FuncId, TSC, CPU);
     return;
   case XRayEntryType::CUSTOM_EVENT:
@@ -698,6 +786,8 @@ XRayLogInitStatus fdrLoggingInit(size_t, size_t, void *Options,
             });
       });
 
+  atomic_store(&SampleRate, Max(fdrFlags()->func_sample_rate, 1),
+               memory_order_release);
   atomic_store(&ThresholdTicks,
                atomic_load_relaxed(&TicksPerSec) *
                    fdrFlags()->func_duration_threshold_us / 1000000,
@@ -0,0 +1,32 @@
+// Check that allocations are sampled as a Poisson process over the allocated
+// bytes: an allocation of twice the sample interval is recorded with
+// probability 1 - exp(-2), about 86.5%, independently of the allocations
+// before it. Without sampling, every allocation is recorded.
+
+// RUN: %clangxx_memprof -O0 %s -o %t
+// RUN: %env_memprof_opts=print_text=true:log_path=stderr:print_terse=1 %run %t 2>&1 \
+// RUN:   | FileCheck %s --check-prefix=ALL
+// RUN: %env_memprof_opts=print_text=true:log_path=stderr:print_terse=1:sample_allocation_bytes=1024 \
+// RUN:   %run %t 2>&1 | FileCheck %s --check-prefix=SAMPLED
+
+// ALL: MIB:[[STACKID:[0-9]+]]/1000/2048.00/2048/2048/
+// ALL: Stack for id [[STACKID]]:
+// ALL-NEXT: #0 {{.*}} in operator new
+// ALL-NEXT: #1 {{.*}} in main {{.*}}:[[@LINE+12]]
+
+// The count is within about six standard deviations of 865.
+// SAMPLED: MIB:[[STACKID:[0-9]+]]/{{8[0-9][0-9]|9[0-2][0-9]}}/2048.00/2048/2048/
+// SAMPLED: Stack for id [[STACKID]]:
+// SAMPLED-NEXT: #0 {{.*}} in operator new
+// SAMPLED-NEXT: #1 {{.*}} in main {{.*}}:[[@LINE+6]]
+
+#include <stdlib.h>
+
+int main() {
+  for (int i = 0; i < 1000; i++) {
+    volatile char *p = new char[2048];
+    p[0] = 1;
+    delete[] p;
+  }
+  return 0;
+}
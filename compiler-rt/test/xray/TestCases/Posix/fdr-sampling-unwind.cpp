@@ -0,0 +1,57 @@
+// Check that sampling stays in step with the calls when an exception unwinds
+// through instrumented frames, which never log their exits.
+//
+// RUN: %clangxx_xray -g -std=c++11 %s -o %t
+// RUN: rm -f fdr-unwind-sampling-*
+// RUN: XRAY_OPTIONS="patch_premain=false xray_logfile_base=fdr-unwind-sampling-" \
+// RUN:   XRAY_FDR_OPTIONS="func_duration_threshold_us=0 func_sample_rate=2" \
+// RUN:   %run %t 2>&1
+// RUN: %llvm_xray convert --output-format=yaml --symbolize --instr_map=%t \
+// RUN:   "`ls fdr-unwind-sampling-* | head -n1`" | FileCheck %s
+// RUN: rm fdr-unwind-sampling-*
+
+// UNSUPPORTED: target=arm{{.*}}
+
+#include "xray/xray_log_interface.h"
+#include <cassert>
+
+[[clang::xray_always_instrument]] void __attribute__((noinline)) thrower() {
+  throw 1;
+}
+
+[[clang::xray_always_instrument]] void __attribute__((noinline)) catcher() {
+  try {
+    thrower();
+  } catch (int) {
+  }
+}
+
+[[clang::xray_always_instrument]] void __attribute__((noinline)) callee() {}
+
+int main(int argc, char *argv[]) {
+  auto status = __xray_log_init_mode("xray-fdr", "");
+  assert(status == XRayLogInitStatus::XRAY_LOG_INITIALIZED);
+
+  __xray_patch();
+  // The first thrower() is logged and the second one is not. Neither exits,
+  // so the exit of catcher() must still be matched with its own entry, which
+  // was logged, and not with the skipped thrower().
+  try {
+    thrower();
+  } catch (int) {
+  }
+  catcher();
+  callee();
+  __xray_unpatch();
+  assert(__xray_log_finalize() == XRAY_LOG_FINALIZED);
+  assert(__xray_log_flushLog() == XRAY_LOG_FLUSHED);
+  return 0;
+}
+
+// CHECK: records:
+// CHECK-NEXT: - { type: 0, func-id: {{[0-9]+}}, function: {{.*thrower.*}}, {{.*}} kind: function-enter,
+// CHECK-NEXT: - { type: 0, func-id: {{[0-9]+}}, function: {{.*catcher.*}}, {{.*}} kind: function-enter,
+// CHECK-NEXT: - { type: 0, func-id: {{[0-9]+}}, function: {{.*catcher.*}}, {{.*}} kind: function-exit,
+// CHECK-NEXT: - { type: 0, func-id: {{[0-9]+}}, function: {{.*callee.*}}, {{.*}} kind: function-enter,
+// CHECK-NEXT: - { type: 0, func-id: {{[0-9]+}}, function: {{.*callee.*}}, {{.*}} kind: function-exit,
+// CHECK-NOT: function-enter
@@ -0,0 +1,45 @@
+// RUN: %clangxx_xray -g -std=c++11 %s -o %t
+// RUN: rm -f fdr-sampling-*
+// RUN: XRAY_OPTIONS="patch_premain=false xray_logfile_base=fdr-sampling-" \
+// RUN:   XRAY_FDR_OPTIONS="func_duration_threshold_us=0 func_sample_rate=2" \
+// RUN:   %run %t 2>&1
+// RUN: %llvm_xray convert --output-format=yaml --symbolize --instr_map=%t \
+// RUN:   "`ls fdr-sampling-* | head -n1`" | FileCheck %s
+// RUN: rm fdr-sampling-*
+
+// UNSUPPORTED: target=arm{{.*}}
+
+#include "xray/xray_log_interface.h"
+#include <cassert>
+
+[[clang::xray_always_instrument]] void __attribute__((noinline)) callee() {}
+
+[[clang::xray_always_instrument]] void __attribute__((noinline)) caller() {
+  callee();
+}
+
+int main(int argc, char *argv[]) {
+  auto status = __xray_log_init_mode("xray-fdr", "");
+  assert(status == XRayLogInitStatus::XRAY_LOG_INITIALIZED);
+
+  __xray_patch();
+  // Only every other call of each function is logged: the first callee(),
+  // the first caller() without its nested callee(), and the nested callee()
+  // of the second caller() on its own.
+  callee();
+  caller();
+  caller();
+  __xray_unpatch();
+  assert(__xray_log_finalize() == XRAY_LOG_FINALIZED);
+  assert(__xray_log_flushLog() == XRAY_LOG_FLUSHED);
+  return 0;
+}
+
+// CHECK: records:
+// CHECK-NEXT: - { type: 0, func-id: {{[0-9]+}}, function: {{.*callee.*}}, {{.*}} kind: function-enter,
+// CHECK-NEXT: - { type: 0, func-id: {{[0-9]+}}, function: {{.*callee.*}}, {{.*}} kind: function-exit,
+// CHECK-NEXT: - { type: 0, func-id: {{[0-9]+}}, function: {{.*caller.*}}, {{.*}} kind: function-enter,
+// CHECK-NEXT: - { type: 0, func-id: {{[0-9]+}}, function: {{.*caller.*}}, {{.*}} kind: function-exit,
+// CHECK-NEXT: - { type: 0, func-id: {{[0-9]+}}, function: {{.*callee.*}}, {{.*}} kind: function-enter,
+// CHECK-NEXT: - { type: 0, func-id: {{[0-9]+}}, function: {{.*callee.*}}, {{.*}} kind: function-exit,
+// CHECK-NOT: function-enter
@@ -15,6 +15,7 @@
 #include "environment.h"
 #include "tools.h"
 #include "utf.h"
+#include <algorithm>
 
 namespace Fortran::runtime::io {
 
@@ -94,21 +95,26 @@ RT_API_ATTRS bool EmitRepeated(CONTEXT &to, char ch, std::size_t n) {
   if (n <= 0) {
     return true;
   }
+  // Emit in chunks rather than one character at a time; padding of wide
+  // fields is common in formatted output.
+  char buffer[64];
+  std::size_t chunk{std::min(n, sizeof buffer)};
+  for (std::size_t j{0}; j < chunk; ++j) {
+    buffer[j] = ch;
+  }
   ConnectionState &connection{to.GetConnectionState()};
-  if (connection.internalIoCharKind <= 1 &&
-      connection.access != Access::Stream) {
-    // faster path, no encoding needed
-    while (n-- > 0) {
-      if (!to.Emit(&ch, 1)) {
-        return false;
-      }
-    }
-  } else {
-    while (n-- > 0) {
-      if (!EmitEncoded(to, &ch, 1)) {
+  bool noEncoding{connection.internalIoCharKind <= 1 &&
+      connection.access != Access::Stream};
+  while (n > 0) {
+    chunk = std::min(n, sizeof buffer);
+    if (noEncoding) { // faster path, no encoding needed
+      if (!to.Emit(buffer, chunk)) {
         return false;
       }
+    } else if (!EmitEncoded(to, buffer, chunk)) {
+      return false;
     }
+    n -= chunk;
   }
   return true;
 }
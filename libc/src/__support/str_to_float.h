@@ -863,7 +863,29 @@ decimal_string_to_float(const char *__restrict src, const char DECIMAL_POINT,
   // The loop fills the mantissa with as many digits as it can hold
   const StorageType bitstype_max_div_by_base =
       cpp::numeric_limits<StorageType>::max() / BASE;
+  // Runs of digits are consumed eight at a time while the mantissa has room
+  // for them. This is tried at the start of the integer and fractional parts
+  // and after each run; once it fails, the rest of the part goes through the
+  // digit by digit path.
+  constexpr uint32_t EIGHT_DIGITS_BASE = 100000000;
+  const StorageType bitstype_max_div_by_eight_digits_base =
+      cpp::numeric_limits<StorageType>::max() / EIGHT_DIGITS_BASE;
+  bool try_eight_digits = true;
   while (true) {
+    if (try_eight_digits) {
+      cpp::optional<uint32_t> digits;
+      if (mantissa < bitstype_max_div_by_eight_digits_base)
+        digits = parse_eight_digits(src + index);
+      if (digits) {
+        seen_digit = true;
+        mantissa = (mantissa * EIGHT_DIGITS_BASE) + *digits;
+        if (after_decimal)
+          exponent -= 8;
+        index += 8;
+        continue;
+      }
+      try_eight_digits = false;
+    }
     if (isdigit(src[index])) {
       uint32_t digit = src[index] - '0';
       seen_digit = true;
@@ -889,6 +911,7 @@ decimal_string_to_float(const char *__restrict src, const char DECIMAL_POINT,
                // ending the number.
       }
       after_decimal = true;
+      try_eight_digits = true;
       ++index;
       continue;
     }
@@ -0,0 +1,84 @@
+//===-- Unittests for parse_eight_digits ----------------------------------===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+#include "src/__support/CPP/optional.h"
+#include "src/__support/str_to_integer.h"
+#include "test/UnitTest/Test.h"
+#include <stddef.h>
+#include <stdint.h>
+
+using LIBC_NAMESPACE::cpp::optional;
+using LIBC_NAMESPACE::internal::parse_eight_digits;
+
+TEST(LlvmLibcParseEightDigitsTest, AllDigits) {
+  optional<uint32_t> result = parse_eight_digits("12345678");
+  ASSERT_TRUE(result.has_value());
+  EXPECT_EQ(*result, uint32_t(12345678));
+
+  result = parse_eight_digits("00000000");
+  ASSERT_TRUE(result.has_value());
+  EXPECT_EQ(*result, uint32_t(0));
+
+  result = parse_eight_digits("99999999");
+  ASSERT_TRUE(result.has_value());
+  EXPECT_EQ(*result, uint32_t(99999999));
+
+  // Only the first eight characters are read.
+  result = parse_eight_digits("123456789");
+  ASSERT_TRUE(result.has_value());
+  EXPECT_EQ(*result, uint32_t(12345678));
+}
+
+TEST(LlvmLibcParseEightDigitsTest, EachDigitInEachPosition) {
+  for (size_t pos = 0; pos < 8; ++pos) {
+    uint32_t place = 1;
+    for (size_t i = pos + 1; i < 8; ++i)
+      place *= 10;
+    for (char digit = '0'; digit <= '9'; ++digit) {
+      char src[] = "00000000";
+      src[pos] = digit;
+      optional<uint32_t> result = parse_eight_digits(src);
+      ASSERT_TRUE(result.has_value());
+      EXPECT_EQ(*result, uint32_t(digit - '0') * place);
+    }
+  }
+}
+
+TEST(LlvmLibcParseEightDigitsTest, NonDigitInEachPosition) {
+  // The bytes just outside the digit range, and ones that a SWAR check on the
+  // whole word could confuse with digits.
+  const char non_digits[] = {'/', ':',  ' ',    '.',    'a',    'e',
+                             'A', '\0', '\x80', '\xb0', '\xb9', '\xff'};
+  for (size_t pos = 0; pos < 8; ++pos) {
+    for (char c : non_digits) {
+      char src[] = "12345678";
+      src[pos] = c;
+      EXPECT_FALSE(parse_eight_digits(src).has_value());
+    }
+  }
+}
+
+TEST(LlvmLibcParseEightDigitsTest, ShortLength) {
+  for (size_t len = 0; len < 8; ++len)
+    EXPECT_FALSE(parse_eight_digits("12345678", len).has_value());
+  optional<uint32_t> result = parse_eight_digits("12345678", 8);
+  ASSERT_TRUE(result.has_value());
+  EXPECT_EQ(*result, uint32_t(12345678));
+}
+
+TEST(LlvmLibcParseEightDigitsTest, UnalignedInput) {
+  alignas(8) char buffer[] = "x8765432187654321";
+  for (size_t offset = 1; offset < 9; ++offset) {
+    optional<uint32_t> result = parse_eight_digits(buffer + offset);
+    ASSERT_TRUE(result.has_value());
+    uint32_t expected = 0;
+    for (size_t i = 0; i < 8; ++i)
+      expected = expected * 10 + uint32_t(buffer[offset + i] - '0');
+    EXPECT_EQ(*result, expected);
+  }
+}
@@ -12,6 +12,7 @@
 
 #include <__algorithm/find_segment_if.h>
 #include <__algorithm/min.h>
+#include <__algorithm/simd_utils.h>
 #include <__algorithm/unwrap_iter.h>
 #include <__bit/countr.h>
 #include <__bit/invert_if.h>
@@ -21,10 +22,14 @@
 #include <__fwd/bit_reference.h>
 #include <__iterator/segmented_iterator.h>
 #include <__string/constexpr_c_functions.h>
+#include <__type_traits/is_constant_evaluated.h>
+#include <__type_traits/is_equality_comparable.h>
 #include <__type_traits/is_integral.h>
 #include <__type_traits/is_same.h>
 #include <__type_traits/is_signed.h>
+#include <__type_traits/remove_cv.h>
 #include <__utility/move.h>
+#include <cstddef>
 #include <limits>
 
 #ifndef _LIBCPP_HAS_NO_WIDE_CHARACTERS
@@ -40,16 +45,22 @@ _LIBCPP_PUSH_MACROS
 
 _LIBCPP_BEGIN_NAMESPACE_STD
 
-// generic implementation
 template <class _Iter, class _Sent, class _Tp, class _Proj>
 _LIBCPP_HIDE_FROM_ABI _LIBCPP_CONSTEXPR_SINCE_CXX14 _Iter
-__find(_Iter __first, _Sent __last, const _Tp& __value, _Proj& __proj) {
+__find_loop(_Iter __first, _Sent __last, const _Tp& __value, _Proj& __proj) {
   for (; __first != __last; ++__first)
     if (std::__invoke(__proj, *__first) == __value)
       break;
   return __first;
 }
 
+// generic implementation
+template <class _Iter, class _Sent, class _Tp, class _Proj>
+_LIBCPP_HIDE_FROM_ABI _LIBCPP_CONSTEXPR_SINCE_CXX14 _Iter
+__find(_Iter __first, _Sent __last, const _Tp& __value, _Proj& __proj) {
+  return std::__find_loop(std::move(__first), std::move(__last), __value, __proj);
+}
+
 // trivially equality comparable implementations
 template <class _Tp,
           class _Up,
@@ -77,6 +88,72 @@ _LIBCPP_HIDE_FROM_ABI _LIBCPP_CONSTEXPR_SINCE_CXX14 _Tp* __find(_Tp* __first, _T
 }
 #endif // _LIBCPP_HAS_NO_WIDE_CHARACTERS
 
+#if _LIBCPP_VECTORIZE_ALGORITHMS
+template <class _Tp>
+_LIBCPP_HIDE_FROM_ABI _Tp* __find_vectorized(_Tp* __first, _Tp* __last, __remove_cv_t<_Tp> __value) {
+  using __value_type              = __remove_cv_t<_Tp>;
+  constexpr size_t __unroll_count = 4;
+  constexpr size_t __vec_size     = __native_vector_size<__value_type>;
+  using __vec                     = __simd_vector<__value_type, __vec_size>;
+
+  auto __orig_first = __first;
+  __vec __values    = __value;
+  while (static_cast<size_t>(__last - __first) >= __unroll_count * __vec_size) [[__unlikely__]] {
+    __vec __lhs[__unroll_count];
+
+    for (size_t __i = 0; __i != __unroll_count; ++__i)
+      __lhs[__i] = std::__load_vector<__vec>(__first + __i * __vec_size);
+
+    for (size_t __i = 0; __i != __unroll_count; ++__i) {
+      if (auto __cmp_res = __lhs[__i] == __values; std::__any_of(__cmp_res))
+        return __first + __i * __vec_size + std::__find_first_set(__cmp_res);
+    }
+
+    __first += __unroll_count * __vec_size;
+  }
+
+  // check the remaining 0-3 vectors
+  while (static_cast<size_t>(__last - __first) >= __vec_size) {
+    if (auto __cmp_res = std::__load_vector<__vec>(__first) == __values; std::__any_of(__cmp_res))
+      return __first + std::__find_first_set(__cmp_res);
+    __first += __vec_size;
+  }
+
+  if (__last - __first == 0)
+    return __first;
+
+  // Check if we can load elements in front of the current pointer. If that's the case load a vector at
+  // (last - vector_size) to check the remaining elements. None of the elements in front of the current pointer
+  // match, so the first set lane is the first match, if there is any.
+  if (static_cast<size_t>(__first - __orig_first) >= __vec_size) {
+    __first = __last - __vec_size;
+    return __first + std::__find_first_set(std::__load_vector<__vec>(__first) == __values);
+  }
+
+  // else loop over the elements individually
+  __identity __proj;
+  return std::__find_loop(__first, __last, __value, __proj);
+}
+
+// integral types that aren't handled by memchr or wmemchr
+template <class _Tp,
+          class _Up,
+          class _Proj,
+          __enable_if_t<__is_identity<_Proj>::value && __libcpp_is_trivially_equality_comparable<_Tp, _Up>::value &&
+                            is_integral<_Tp>::value && __can_map_to_integer_v<_Tp> && sizeof(_Tp) != 1
+#  ifndef _LIBCPP_HAS_NO_WIDE_CHARACTERS
+                            && !(sizeof(_Tp) == sizeof(wchar_t) && _LIBCPP_ALIGNOF(_Tp) >= _LIBCPP_ALIGNOF(wchar_t))
+#  endif
+                            ,
+                        int> = 0>
+_LIBCPP_HIDE_FROM_ABI _LIBCPP_CONSTEXPR_SINCE_CXX14 _Tp*
+__find(_Tp* __first, _Tp* __last, const _Up& __value, _Proj& __proj) {
+  if (__libcpp_is_constant_evaluated())
+    return std::__find_loop(__first, __last, __value, __proj);
+  return std::__find_vectorized(__first, __last, static_cast<__remove_cv_t<_Tp> >(__value));
+}
+#endif // _LIBCPP_VECTORIZE_ALGORITHMS
+
 // TODO: This should also be possible to get right with different signedness
 // cast integral types to allow vectorization
 template <class _Tp,
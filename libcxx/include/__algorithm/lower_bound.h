@@ -12,14 +12,20 @@
 #include <__algorithm/comp.h>
 #include <__algorithm/half_positive.h>
 #include <__algorithm/iterator_operations.h>
+#include <__algorithm/unwrap_iter.h>
 #include <__config>
 #include <__functional/identity.h>
 #include <__functional/invoke.h>
 #include <__iterator/advance.h>
 #include <__iterator/distance.h>
 #include <__iterator/iterator_traits.h>
+#include <__type_traits/desugars_to.h>
+#include <__type_traits/enable_if.h>
+#include <__type_traits/is_arithmetic.h>
 #include <__type_traits/is_callable.h>
+#include <__type_traits/remove_cv.h>
 #include <__type_traits/remove_reference.h>
+#include <cstddef>
 
 #if !defined(_LIBCPP_HAS_NO_PRAGMA_SYSTEM_HEADER)
 #  pragma GCC system_header
@@ -46,12 +52,41 @@ __lower_bound(_Iter __first, _Sent __last, const _Type& __value, _Comp& __comp,
   return __first;
 }
 
+// Arithmetic keys are cheap to compare, so it pays to make every step of the search the same: the comparison only
+// selects whether to advance `__first`, which compiles to a conditional move instead of a hard to predict branch.
+template <class _AlgPolicy,
+          class _Tp,
+          class _Type,
+          class _Proj,
+          class _Comp,
+          __enable_if_t<is_arithmetic<_Tp>::value && __desugars_to_v<__less_tag, _Comp, __remove_cv_t<_Tp>, _Type> &&
+                            __is_identity<_Proj>::value,
+                        int> = 0>
+_LIBCPP_HIDE_FROM_ABI _LIBCPP_CONSTEXPR_SINCE_CXX20 _Tp*
+__lower_bound(_Tp* __first, _Tp* __last, const _Type& __value, _Comp& __comp, _Proj&) {
+  ptrdiff_t __len = __last - __first;
+  if (__len == 0)
+    return __first;
+
+  // The result is in [__first, __first + __len]. If __first[__half - 1] is less than __value, the result is past it,
+  // otherwise it is in [__first, __first + __half - 1], which is covered by the remaining length.
+  while (__len > 1) {
+    ptrdiff_t __half = __len / 2;
+    __first += __comp(__first[__half - 1], __value) ? __half : 0;
+    __len -= __half;
+  }
+  return __first + __comp(*__first, __value);
+}
+
 template <class _ForwardIterator, class _Tp, class _Compare>
 _LIBCPP_NODISCARD inline _LIBCPP_HIDE_FROM_ABI _LIBCPP_CONSTEXPR_SINCE_CXX20 _ForwardIterator
 lower_bound(_ForwardIterator __first, _ForwardIterator __last, const _Tp& __value, _Compare __comp) {
   static_assert(__is_callable<_Compare, decltype(*__first), const _Tp&>::value, "The comparator has to be callable");
   auto __proj = std::__identity();
-  return std::__lower_bound<_ClassicAlgPolicy>(__first, __last, __value, __comp, __proj);
+  return std::__rewrap_iter(
+      __first,
+      std::__lower_bound<_ClassicAlgPolicy>(
+          std::__unwrap_iter(__first), std::__unwrap_iter(__last), __value, __comp, __proj));
 }
 
 template <class _ForwardIterator, class _Tp>
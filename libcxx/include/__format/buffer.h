@@ -68,6 +68,7 @@ public:
       : __ptr_(__ptr),
         __capacity_(__capacity),
         __flush_([](_CharT* __p, size_t __n, void* __o) { static_cast<_Tp*>(__o)->__flush(__p, __n); }),
+        __write_(__make_write<_Tp>()),
         __obj_(__obj) {}
 
   _LIBCPP_HIDE_FROM_ABI void __reset(_CharT* __ptr, size_t __capacity) {
@@ -96,10 +97,9 @@ public:
     // When the underlying iterator is a simple iterator the __capacity_ is
     // infinite. For a string or container back_inserter it isn't. This means
     // that adding a large string to the buffer can cause some overhead. In that
-    // case a better approach could be:
-    // - flush the buffer
-    // - container.append(__str.begin(), __str.end());
-    // The same holds true for the fill.
+    // case the buffer is flushed and the string is appended to the container
+    // directly, when no character conversion is needed.
+    // The same could be done for the fill.
     // For transform it might be slightly harder, however the use case for
     // transform is slightly less common; it converts hexadecimal values to
     // upper case. For integral these strings are short.
@@ -113,6 +113,17 @@ public:
       return;
     }
 
+    // The output doesn't fit in the internal buffer. When the writer can take
+    // the data directly, e.g. a container writer inserting it, bypass the
+    // buffer instead of copying the data through it.
+    if constexpr (same_as<_InCharT, _CharT>) {
+      if (__write_) {
+        _LIBCPP_ASSERT_INTERNAL(__size_ == 0, "the buffer should be flushed by __flush_on_overflow");
+        __write_(__str.data(), __n, __obj_);
+        return;
+      }
+    }
+
     // The output doesn't fit in the internal buffer.
     // Copy the data in "__capacity_" sized chunks.
     _LIBCPP_ASSERT_INTERNAL(__size_ == 0, "the buffer should be flushed by __flush_on_overflow");
@@ -188,8 +199,21 @@ private:
   size_t __capacity_;
   size_t __size_{0};
   void (*__flush_)(_CharT*, size_t, void*);
+  void (*__write_)(const _CharT*, size_t, void*);
   void* __obj_;
 
+  /// Returns the function writing data directly to the output of \a _Tp.
+  ///
+  /// This is only available when \a _Tp has a \c __write member, otherwise
+  /// the data is always copied to the buffer.
+  template <class _Tp>
+  _LIBCPP_HIDE_FROM_ABI static constexpr auto __make_write() -> void (*)(const _CharT*, size_t, void*) {
+    if constexpr (requires(_Tp& __t, const _CharT* __p, size_t __n) { __t.__write(__p, __n); })
+      return [](const _CharT* __p, size_t __n, void* __o) { static_cast<_Tp*>(__o)->__write(__p, __n); };
+    else
+      return nullptr;
+  }
+
   /// Flushes the buffer when the output operation would overflow the buffer.
   ///
   /// A simple approach for the overflow detection would be something along the
@@ -334,6 +358,10 @@ public:
     __container_->insert(__container_->end(), __ptr, __ptr + __n);
   }
 
+  _LIBCPP_HIDE_FROM_ABI void __write(const _CharT* __ptr, size_t __n) {
+    __container_->insert(__container_->end(), __ptr, __ptr + __n);
+  }
+
 private:
   _Container* __container_;
 };
@@ -372,6 +400,12 @@ public:
 
   _LIBCPP_HIDE_FROM_ABI void __flush(_CharT* __ptr, size_t __n) { __writer_.__flush(__ptr, __n); }
 
+  _LIBCPP_HIDE_FROM_ABI void __write(const _CharT* __ptr, size_t __n)
+    requires(!same_as<typename __back_insert_iterator_container<_OutIt>::type, void>)
+  {
+    __writer_.__write(__ptr, __n);
+  }
+
   _LIBCPP_HIDE_FROM_ABI _OutIt __out_it() && {
     __output_.__flush();
     return std::move(__writer_).__out_it();
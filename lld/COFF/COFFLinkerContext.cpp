@@ -37,6 +37,10 @@ COFFLinkerContext::COFFLinkerContext()
       typeMergingTimer("Type Merging", addObjectsTimer),
       loadGHashTimer("Global Type Hashing", addObjectsTimer),
       mergeGHashTimer("GHash Type Merging", addObjectsTimer),
+      insertGHashTimer("GHash Table Insertion", mergeGHashTimer),
+      sortGHashTimer("GHash Cell Sorting", mergeGHashTimer),
+      assignGHashTimer("Type Index Assignment", mergeGHashTimer),
+      remapGHashTimer("Type Remapping", mergeGHashTimer),
       symbolMergingTimer("Symbol Merging", addObjectsTimer),
       publicsLayoutTimer("Publics Stream Layout", totalPdbLinkTimer),
       tpiStreamLayoutTimer("TPI Stream Layout", totalPdbLinkTimer),
@@ -82,6 +82,10 @@ public:
   Timer typeMergingTimer;
   Timer loadGHashTimer;
   Timer mergeGHashTimer;
+  Timer insertGHashTimer;
+  Timer sortGHashTimer;
+  Timer assignGHashTimer;
+  Timer remapGHashTimer;
   Timer symbolMergingTimer;
   Timer publicsLayoutTimer;
   Timer tpiStreamLayoutTimer;
@@ -1103,24 +1103,28 @@ void TypeMerger::mergeTypesWithGHash() {
   // position. Because the table does not rehash, the position will not change
   // under insertion. After insertion is done, the value of the cell can be read
   // to retrieve the final PDB type index.
-  parallelFor(0, ctx.tpiSourceList.size(), [&](size_t tpiSrcIdx) {
-    TpiSource *source = ctx.tpiSourceList[tpiSrcIdx];
-    source->indexMapStorage.resize(source->ghashes.size());
-    for (uint32_t i = 0, e = source->ghashes.size(); i < e; i++) {
-      if (source->shouldOmitFromPdb(i)) {
-        source->indexMapStorage[i] = TypeIndex(SimpleTypeKind::NotTranslated);
-        continue;
+  {
+    ScopedTimer t3(ctx.insertGHashTimer);
+    parallelFor(0, ctx.tpiSourceList.size(), [&](size_t tpiSrcIdx) {
+      TpiSource *source = ctx.tpiSourceList[tpiSrcIdx];
+      source->indexMapStorage.resize(source->ghashes.size());
+      for (uint32_t i = 0, e = source->ghashes.size(); i < e; i++) {
+        if (source->shouldOmitFromPdb(i)) {
+          source->indexMapStorage[i] =
+              TypeIndex(SimpleTypeKind::NotTranslated);
+          continue;
+        }
+        GloballyHashedType ghash = source->ghashes[i];
+        bool isItem = source->isItemIndex.test(i);
+        uint32_t cellIdx = ghashState.table.insert(
+            ctx, ghash, GHashCell(isItem, tpiSrcIdx, i));
+
+        // Store the ghash cell index as a type index in indexMapStorage. Later
+        // we will replace it with the PDB type index.
+        source->indexMapStorage[i] = TypeIndex::fromArrayIndex(cellIdx);
       }
-      GloballyHashedType ghash = source->ghashes[i];
-      bool isItem = source->isItemIndex.test(i);
-      uint32_t cellIdx =
-          ghashState.table.insert(ctx, ghash, GHashCell(isItem, tpiSrcIdx, i));
-
-      // Store the ghash cell index as a type index in indexMapStorage. Later
-      // we will replace it with the PDB type index.
-      source->indexMapStorage[i] = TypeIndex::fromArrayIndex(cellIdx);
-    }
-  });
+    });
+  }
 
   // Collect all non-empty cells and sort them. This will implicitly assign
   // destination type indices, and partition the entries into type records and
@@ -1131,12 +1135,33 @@ void TypeMerger::mergeTypesWithGHash() {
   // - item records
   //   - source 0, type 1...
   //   - source 1, type 0...
+  //
+  // The table is scanned in parallel shards: count the non-empty cells of each
+  // shard first, then copy them to their final positions.
   std::vector<GHashCell> entries;
-  for (const GHashCell &cell : ArrayRef(ghashState.table.table, tableSize)) {
-    if (!cell.isEmpty())
-      entries.push_back(cell);
+  {
+    ScopedTimer t4(ctx.sortGHashTimer);
+    ArrayRef<GHashCell> cells(ghashState.table.table, tableSize);
+    const size_t shardSize = 1 << 20;
+    const size_t numShards = divideCeil(cells.size(), shardSize);
+    std::vector<size_t> shardOffsets(numShards + 1);
+    parallelFor(0, numShards, [&](size_t shard) {
+      shardOffsets[shard + 1] =
+          llvm::count_if(cells.slice(shard * shardSize).take_front(shardSize),
+                         [](const GHashCell &cell) { return !cell.isEmpty(); });
+    });
+    for (size_t shard = 0; shard < numShards; ++shard)
+      shardOffsets[shard + 1] += shardOffsets[shard];
+    entries.resize(shardOffsets[numShards]);
+    parallelFor(0, numShards, [&](size_t shard) {
+      GHashCell *out = entries.data() + shardOffsets[shard];
+      for (const GHashCell &cell :
+           cells.slice(shard * shardSize).take_front(shardSize))
+        if (!cell.isEmpty())
+          *out++ = cell;
+    });
+    parallelSort(entries, std::less<GHashCell>());
   }
-  parallelSort(entries, std::less<GHashCell>());
   log(formatv("ghash table load factor: {0:p} (size {1} / capacity {2})\n",
               tableSize ? double(entries.size()) / tableSize : 0,
               entries.size(), tableSize));
@@ -1155,27 +1180,45 @@ void TypeMerger::mergeTypesWithGHash() {
   // merging will skip indices not on this list. Store the destination PDB type
   // index for these unique types in the tpiMap for each source. The entries for
   // non-unique types will be filled in prior to type merging.
-  for (uint32_t i = 0, e = entries.size(); i < e; ++i) {
-    auto &cell = entries[i];
-    uint32_t tpiSrcIdx = cell.getTpiSrcIdx();
-    TpiSource *source = ctx.tpiSourceList[tpiSrcIdx];
-    source->uniqueTypes.push_back(cell.getGHashIdx());
-
-    // Update the ghash table to store the destination PDB type index in the
-    // table.
-    uint32_t pdbTypeIndex = i < numTypes ? i : i - numTypes;
-    uint32_t ghashCellIndex =
-        source->indexMapStorage[cell.getGHashIdx()].toArrayIndex();
-    ghashState.table.table[ghashCellIndex] =
-        GHashCell(cell.isItem(), cell.getTpiSrcIdx(), pdbTypeIndex);
+  //
+  // Since the entries are sorted by (isItem, tpiSrcIdx, ghashIdx), the entries
+  // of each source form one contiguous range among the types and one among the
+  // items, so sources can be processed in parallel.
+  {
+    ScopedTimer t5(ctx.assignGHashTimer);
+    parallelFor(0, ctx.tpiSourceList.size(), [&](size_t tpiSrcIdx) {
+      TpiSource *source = ctx.tpiSourceList[tpiSrcIdx];
+      for (bool isItem : {false, true}) {
+        auto begin =
+            llvm::lower_bound(entries, GHashCell(isItem, tpiSrcIdx, 0));
+        auto end =
+            llvm::lower_bound(entries, GHashCell(isItem, tpiSrcIdx + 1, 0));
+        for (auto it = begin; it != end; ++it) {
+          const GHashCell &cell = *it;
+          source->uniqueTypes.push_back(cell.getGHashIdx());
+
+          // Update the ghash table to store the destination PDB type index in
+          // the table.
+          uint32_t i = std::distance(entries.begin(), it);
+          uint32_t pdbTypeIndex = i < numTypes ? i : i - numTypes;
+          uint32_t ghashCellIndex =
+              source->indexMapStorage[cell.getGHashIdx()].toArrayIndex();
+          ghashState.table.table[ghashCellIndex] =
+              GHashCell(cell.isItem(), cell.getTpiSrcIdx(), pdbTypeIndex);
+        }
+      }
+    });
   }
 
   // In parallel, remap all types.
-  for (TpiSource *source : dependencySources)
-    source->remapTpiWithGHashes(&ghashState);
-  parallelForEach(objectSources, [&](TpiSource *source) {
-    source->remapTpiWithGHashes(&ghashState);
-  });
+  {
+    ScopedTimer t6(ctx.remapGHashTimer);
+    for (TpiSource *source : dependencySources)
+      source->remapTpiWithGHashes(&ghashState);
+    parallelForEach(objectSources, [&](TpiSource *source) {
+      source->remapTpiWithGHashes(&ghashState);
+    });
+  }
 
   // Build a global map of from function ID to function type.
   for (TpiSource *source : ctx.tpiSourceList) {
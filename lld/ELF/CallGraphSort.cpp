@@ -21,6 +21,12 @@
 /// - a more advanced one, referred to as Cache-Directed-Sort (CDSort), which
 ///   typically produces layouts with higher locality, and hence, yields fewer
 ///   instruction cache misses on large binaries.
+///
+/// Nodes of the graph are input sections, not functions, so the same code
+/// orders basic block sections (-fbasic-block-sections=list) when the profile
+/// has edges between the symbols of those sections. Profile formats of
+/// post-link optimizers are not read here; they have to be converted to
+/// --call-graph-ordering-file entries first.
 //===----------------------------------------------------------------------===//
 
 #include "CallGraphSort.h"
@@ -156,6 +156,9 @@ struct Config {
   uint32_t andFeatures = 0;
   llvm::CachePruningPolicy thinLTOCachePolicy;
   llvm::SetVector<llvm::CachedHashString> dependencyFiles; // for --dependency-file
+  // Paths probed while searching for inputs that did not exist, for
+  // --incremental-state.
+  llvm::SetVector<llvm::CachedHashString> missingFiles;
   llvm::StringMap<uint64_t> sectionStartMap;
   llvm::StringRef bfdname;
   llvm::StringRef chroot;
@@ -165,6 +168,7 @@ struct Config {
   llvm::StringRef entry;
   llvm::StringRef emulation;
   llvm::StringRef fini;
+  llvm::StringRef incrementalState;
   llvm::StringRef init;
   llvm::StringRef ltoAAPipeline;
   llvm::StringRef ltoCSProfileFile;
@@ -182,6 +186,7 @@ struct Config {
   llvm::StringRef printArchiveStats;
   llvm::StringRef printSymbolOrder;
   llvm::StringRef soName;
+  llvm::StringRef statsJSON;
   llvm::StringRef sysroot;
   llvm::StringRef thinLTOCacheDir;
   llvm::StringRef thinLTOIndexOnlyArg;
@@ -358,6 +363,7 @@ struct Config {
   uint64_t commonPageSize;
   uint64_t maxPageSize;
   uint64_t mipsGotSize;
+  uint64_t outputBatchSize;
   uint64_t zStackSize;
   unsigned ltoPartitions;
   unsigned ltoo;
@@ -507,8 +513,25 @@ struct Ctx {
   unsigned scriptSymOrderCounter = 1;
   llvm::DenseMap<const Symbol *, unsigned> scriptSymOrder;
 
+  // Statistics of a link phase reported by --stats-json.
+  struct PhaseStats {
+    llvm::StringRef name;
+    std::chrono::nanoseconds wallTime;
+    std::chrono::nanoseconds cpuTime;
+    uint64_t peakRSS;
+  };
+  SmallVector<PhaseStats, 0> phaseStats;
+  llvm::StringRef phaseName;
+  llvm::sys::TimePoint<> phaseStartTime;
+  std::chrono::nanoseconds phaseStartCpuTime;
+
   void reset();
 
+  // Ends the current phase, if any, and starts a new phase. Starting a phase
+  // that has already ended adds to its entry. This is a no-op unless
+  // --stats-json is specified.
+  void startPhase(llvm::StringRef name);
+
   llvm::raw_fd_ostream openAuxiliaryFile(llvm::StringRef, std::error_code &);
 
   ArrayRef<uint8_t> aarch64PauthAbiCoreInfo;
@@ -59,17 +59,25 @@
 #include "llvm/Support/Compression.h"
 #include "llvm/Support/FileSystem.h"
 #include "llvm/Support/GlobPattern.h"
+#include "llvm/Support/JSON.h"
 #include "llvm/Support/LEB128.h"
 #include "llvm/Support/Parallel.h"
 #include "llvm/Support/Path.h"
+#include "llvm/Support/Process.h"
 #include "llvm/Support/TarWriter.h"
 #include "llvm/Support/TargetSelect.h"
 #include "llvm/Support/TimeProfiler.h"
+#include "llvm/Support/xxhash.h"
 #include "llvm/Support/raw_ostream.h"
+#include <atomic>
 #include <cstdlib>
 #include <tuple>
 #include <utility>
 
+#if LLVM_ON_UNIX
+#include <sys/resource.h>
+#endif
+
 using namespace llvm;
 using namespace llvm::ELF;
 using namespace llvm::object;
@@ -113,6 +121,50 @@ void Ctx::reset() {
   scriptSymOrderCounter = 1;
   scriptSymOrder.clear();
   ltoAllVtablesHaveTypeInfos = false;
+  phaseStats.clear();
+  phaseName = {};
+}
+
+// Returns the peak resident set size of the process in bytes, or 0 if it is
+// unknown.
+static uint64_t getPeakRSS() {
+#if LLVM_ON_UNIX
+  struct rusage ru;
+  if (getrusage(RUSAGE_SELF, &ru) == 0)
+#ifdef __APPLE__
+    return ru.ru_maxrss;
+#else
+    return uint64_t(ru.ru_maxrss) * 1024;
+#endif
+#endif
+  return 0;
+}
+
+void Ctx::startPhase(StringRef name) {
+  if (config->statsJSON.empty())
+    return;
+  sys::TimePoint<> now;
+  std::chrono::nanoseconds userTime, sysTime;
+  sys::Process::GetTimeUsage(now, userTime, sysTime);
+  if (!phaseName.empty()) {
+    PhaseStats stats{phaseName, now - phaseStartTime,
+                     userTime + sysTime - phaseStartCpuTime, getPeakRSS()};
+    // finalizeSections() resumes "finalize-sections" after scanning
+    // relocations. Fold the two parts into one entry.
+    auto it = llvm::find_if(phaseStats, [&](const PhaseStats &p) {
+      return p.name == phaseName;
+    });
+    if (it == phaseStats.end()) {
+      phaseStats.push_back(stats);
+    } else {
+      it->wallTime += stats.wallTime;
+      it->cpuTime += stats.cpuTime;
+      it->peakRSS = stats.peakRSS;
+    }
+  }
+  phaseName = name;
+  phaseStartTime = now;
+  phaseStartCpuTime = userTime + sysTime;
 }
 
 llvm::raw_fd_ostream Ctx::openAuxiliaryFile(llvm::StringRef filename,
@@ -281,13 +333,26 @@ void LinkerDriver::addFile(StringRef path, bool withLOption) {
     return;
   case file_magic::archive: {
     auto members = getArchiveMembers(mbref);
+    // Archive members are created serially because make<> is not thread-safe,
+    // but their ELF headers are read in parallel afterwards, which matters for
+    // archives with many members.
+    size_t firstMember = files.size();
+    auto initMembers = [&] {
+      parallelForEach(ArrayRef(files).slice(firstMember), [](InputFile *f) {
+        if (f->kind() == InputFile::ObjKind)
+          cast<ELFFileBase>(f)->init();
+      });
+    };
+
     if (inWholeArchive) {
       for (const std::pair<MemoryBufferRef, uint64_t> &p : members) {
         if (isBitcode(p.first))
           files.push_back(make<BitcodeFile>(p.first, path, p.second, false));
         else if (!tryAddFatLTOFile(p.first, path, p.second, false))
-          files.push_back(createObjFile(p.first, path));
+          files.push_back(createObjFile(p.first, path, /*lazy=*/false,
+                                        /*init=*/false));
       }
+      initMembers();
       return;
     }
 
@@ -311,7 +376,8 @@ void LinkerDriver::addFile(StringRef path, bool withLOption) {
       auto magic = identify_magic(p.first.getBuffer());
       if (magic == file_magic::elf_relocatable) {
         if (!tryAddFatLTOFile(p.first, path, p.second, true))
-          files.push_back(createObjFile(p.first, path, true));
+          files.push_back(createObjFile(p.first, path, /*lazy=*/true,
+                                        /*init=*/false));
       } else if (magic == file_magic::bitcode)
         files.push_back(make<BitcodeFile>(p.first, path, p.second, true));
       else
@@ -321,6 +387,7 @@ void LinkerDriver::addFile(StringRef path, bool withLOption) {
     InputFile::isInGroup = saved;
     if (!saved)
       ++InputFile::nextGroupId;
+    initMembers();
     return;
   }
   case file_magic::elf_shared_object: {
@@ -595,6 +662,146 @@ static void checkZOptions(opt::InputArgList &args) {
       warn("unknown -z value: " + StringRef(arg->getValue()));
 }
 
+// --incremental-state=<file> records the inputs of a successful link in
+// <file>. A subsequent link with the same command line is skipped if the
+// output file has not been touched since then, none of the input files (i.e.
+// the files listed by --dependency-file) has changed its contents, and none of
+// the paths probed without success while searching for inputs (-l, INPUT and
+// GROUP in linker scripts, -T, dependent libraries) has appeared, as that could
+// change which file a search finds.
+//
+// The state file starts with a header identifying the linker, the command line
+// and the output file, followed by a "<hash> <path>" line for each input file
+// and a "missing <path>" line for each path that did not exist.
+static std::optional<std::string>
+getIncrementalStateHeader(opt::InputArgList &args) {
+  sys::fs::file_status st;
+  if (config->outputFile == "-" || sys::fs::status(config->outputFile, st))
+    return std::nullopt;
+
+  SmallString<128> cwd;
+  if (sys::fs::current_path(cwd))
+    return std::nullopt;
+  std::string key;
+  raw_string_ostream keyOS(key);
+  keyOS << getLLDVersion() << '\n' << cwd << '\n';
+  for (const opt::Arg *arg : args)
+    keyOS << arg->getAsString(args) << '\n';
+
+  std::string header;
+  raw_string_ostream os(header);
+  os << "lld-incremental-state-v2\nkey " << utohexstr(xxh3_64bits(keyOS.str()))
+     << "\noutput " << st.getSize() << ' '
+     << st.getLastModificationTime().time_since_epoch().count() << '\n';
+  return os.str();
+}
+
+static std::optional<uint64_t> hashInputFile(StringRef path) {
+  ErrorOr<std::unique_ptr<MemoryBuffer>> mbOrErr =
+      MemoryBuffer::getFile(path, /*IsText=*/false,
+                            /*RequiresNullTerminator=*/false);
+  if (!mbOrErr)
+    return std::nullopt;
+  return xxh3_64bits((*mbOrErr)->getBuffer());
+}
+
+static bool isIncrementalStateUpToDate(opt::InputArgList &args) {
+  if (tar)
+    return false;
+  std::optional<std::string> header = getIncrementalStateHeader(args);
+  ErrorOr<std::unique_ptr<MemoryBuffer>> mbOrErr =
+      MemoryBuffer::getFile(config->incrementalState, /*IsText=*/true);
+  if (!header || !mbOrErr)
+    return false;
+  StringRef contents = (*mbOrErr)->getBuffer();
+  if (!contents.consume_front(*header))
+    return false;
+
+  SmallVector<StringRef, 0> lines;
+  contents.split(lines, '\n', /*MaxSplit=*/-1, /*KeepEmpty=*/false);
+  std::atomic<bool> upToDate = true;
+  parallelFor(0, lines.size(), [&](size_t i) {
+    auto [hash, path] = lines[i].split(' ');
+    if (hash == "missing") {
+      if (sys::fs::exists(path))
+        upToDate = false;
+      return;
+    }
+    std::optional<uint64_t> actual = hashInputFile(path);
+    if (!actual || utohexstr(*actual) != hash)
+      upToDate = false;
+  });
+  return upToDate;
+}
+
+static void writeIncrementalState(opt::InputArgList &args) {
+  std::optional<std::string> header = getIncrementalStateHeader(args);
+  if (!header)
+    return;
+
+  ArrayRef<CachedHashString> paths = config->dependencyFiles.getArrayRef();
+  SmallVector<std::optional<uint64_t>, 0> hashes(paths.size());
+  parallelFor(0, paths.size(),
+              [&](size_t i) { hashes[i] = hashInputFile(paths[i].val()); });
+
+  std::error_code ec;
+  raw_fd_ostream os = ctx.openAuxiliaryFile(config->incrementalState, ec);
+  if (ec) {
+    error("cannot open " + config->incrementalState + ": " + ec.message());
+    return;
+  }
+  os << *header;
+  // A file which cannot be read invalidates the state in the next link anyway,
+  // so it does not matter what hash is recorded for it.
+  for (size_t i = 0, e = paths.size(); i != e; ++i)
+    os << utohexstr(hashes[i].value_or(0)) << ' ' << paths[i].val() << '\n';
+  for (const CachedHashString &path : config->missingFiles)
+    os << "missing " << path.val() << '\n';
+}
+
+// Write the results of the phases recorded by Ctx::startPhase along with a few
+// size metrics of the link to the --stats-json file.
+static void writeStatsJSON() {
+  std::error_code ec;
+  raw_fd_ostream os = ctx.openAuxiliaryFile(config->statsJSON, ec);
+  if (ec) {
+    error("cannot open " + config->statsJSON + ": " + ec.message());
+    return;
+  }
+
+  // Memory of the arenas used by make<T>(). Thread-local arenas used by
+  // makeThreadLocal<T>() are not accounted for.
+  size_t arenaBytes = bAlloc().getTotalMemory();
+  for (const auto &[tag, alloc] : context().instances)
+    arenaBytes += alloc->getTotalMemory();
+
+  json::OStream j(os, /*IndentSize=*/2);
+  j.object([&] {
+    j.attributeArray("phases", [&] {
+      for (const Ctx::PhaseStats &p : ctx.phaseStats) {
+        j.object([&] {
+          j.attribute("name", p.name);
+          j.attribute("wall_ms",
+                      std::chrono::duration<double, std::milli>(p.wallTime)
+                          .count());
+          j.attribute("cpu_ms",
+                      std::chrono::duration<double, std::milli>(p.cpuTime)
+                          .count());
+          j.attribute("peak_rss", p.peakRSS);
+        });
+      }
+    });
+    j.attribute("object_files", ctx.objectFiles.size());
+    j.attribute("shared_files", ctx.sharedFiles.size());
+    j.attribute("bitcode_files", ctx.bitcodeFiles.size());
+    j.attribute("input_sections", ctx.inputSections.size());
+    j.attribute("symbols", symtab.getSymbols().size());
+    j.attribute("arena_bytes", arenaBytes);
+    j.attribute("peak_rss", getPeakRSS());
+  });
+  os << '\n';
+}
+
 constexpr const char *saveTempsValues[] = {
     "resolution", "preopt",     "promote", "internalize",  "import",
     "opt",        "precodegen", "prelink", "combinedindex"};
@@ -668,6 +875,7 @@ void LinkerDriver::linkerMain(ArrayRef<const char *> argsArr) {
     llvm::TimeTraceScope timeScope("ExecuteLinker");
 
     initLLVM();
+    ctx.startPhase("read-inputs");
     createFiles(args);
     if (errorCount())
       return;
@@ -678,7 +886,21 @@ void LinkerDriver::linkerMain(ArrayRef<const char *> argsArr) {
     if (errorCount())
       return;
 
-    invokeELFT(link, args);
+    // Fall through to writing --stats-json and --time-trace if the output is
+    // up to date.
+    if (!config->incrementalState.empty() && isIncrementalStateUpToDate(args)) {
+      log("skipping the link because " + config->outputFile + " is up to date");
+    } else {
+      invokeELFT(link, args);
+
+      if (!config->incrementalState.empty() && !errorCount())
+        writeIncrementalState(args);
+    }
+  }
+
+  if (!config->statsJSON.empty()) {
+    ctx.startPhase({});
+    writeStatsJSON();
   }
 
   if (config->timeTraceEnabled) {
@@ -1304,6 +1526,7 @@ static void readConfigs(opt::InputArgList &args) {
       args.hasArg(OPT_ignore_data_address_equality);
   config->ignoreFunctionAddressEquality =
       args.hasArg(OPT_ignore_function_address_equality);
+  config->incrementalState = args.getLastArgValue(OPT_incremental_state);
   config->init = args.getLastArgValue(OPT_init, "_init");
   config->ltoAAPipeline = args.getLastArgValue(OPT_lto_aa_pipeline);
   config->ltoCSProfileGenerate = args.hasArg(OPT_lto_cs_profile_generate);
@@ -1368,6 +1591,16 @@ static void readConfigs(opt::InputArgList &args) {
   config->optRemarksFormat = args.getLastArgValue(OPT_opt_remarks_format);
   config->optimize = args::getInteger(args, OPT_O, 1);
   config->orphanHandling = getOrphanHandling(args);
+  config->outputBatchSize = 0;
+  if (auto *arg = args.getLastArg(OPT_output_batch_size)) {
+    int64_t mib = 0;
+    if (!to_integer(arg->getValue(), mib) || mib <= 0)
+      error(arg->getSpelling() + ": expected a positive integer, but got '" +
+            arg->getValue() + "'");
+    else
+      config->outputBatchSize = std::min<uint64_t>(mib, UINT64_MAX >> 20)
+                                << 20;
+  }
   config->outputFile = args.getLastArgValue(OPT_o);
   config->packageMetadata = args.getLastArgValue(OPT_package_metadata);
   config->pie = args.hasFlag(OPT_pie, OPT_no_pie, false);
@@ -1406,6 +1639,7 @@ static void readConfigs(opt::InputArgList &args) {
   config->shared = args.hasArg(OPT_shared);
   config->singleRoRx = !args.hasFlag(OPT_rosegment, OPT_no_rosegment, true);
   config->soName = args.getLastArgValue(OPT_soname);
+  config->statsJSON = args.getLastArgValue(OPT_stats_json);
   config->sortSection = getSortSection(args);
   config->splitStackAdjustSize = args::getInteger(args, OPT_split_stack_adjust_size, 16384);
   config->strip = getStrip(args);
@@ -2811,6 +3045,7 @@ static void postParseObjectFile(ELFFileBase *file) {
 // all linker scripts have already been parsed.
 template <class ELFT> void LinkerDriver::link(opt::InputArgList &args) {
   llvm::TimeTraceScope timeScope("Link", StringRef("LinkerDriver::Link"));
+  ctx.startPhase("parse");
 
   // Handle --trace-symbol.
   for (auto *arg : args.filtered(OPT_trace_symbol))
@@ -2952,7 +3187,9 @@ template <class ELFT> void LinkerDriver::link(opt::InputArgList &args) {
   // With this the symbol table should be complete. After this, no new names
   // except a few linker-synthesized ones will be added to the symbol table.
   const size_t numObjsBeforeLTO = ctx.objectFiles.size();
+  ctx.startPhase("lto");
   compileBitcodeFiles<ELFT>(skipLinkedOutput);
+  ctx.startPhase("prepare-sections");
 
   // Symbol resolution finished. Report backward reference problems,
   // --print-archive-stats=, and --why-extract=.
@@ -3078,7 +3315,9 @@ template <class ELFT> void LinkerDriver::link(opt::InputArgList &args) {
   splitSections<ELFT>();
 
   // Garbage collection and removal of shared symbols from unused shared objects.
+  ctx.startPhase("gc");
   markLive<ELFT>();
+  ctx.startPhase("assign-sections");
 
   // Make copies of any input sections that need to be copied into each
   // partition.
@@ -3131,16 +3370,20 @@ template <class ELFT> void LinkerDriver::link(opt::InputArgList &args) {
   // Two input sections with different output sections should not be folded.
   // ICF runs after processSectionCommands() so that we know the output sections.
   if (config->icf != ICFLevel::None) {
+    ctx.startPhase("icf");
     findKeepUniqueSections<ELFT>(args);
     doIcf<ELFT>();
+    ctx.startPhase({});
   }
 
   // Read the callgraph now that we know what was gced or icfed
   if (config->callGraphProfileSort != CGProfileSortKind::None) {
+    ctx.startPhase("read-call-graph");
     if (auto *arg = args.getLastArg(OPT_call_graph_ordering_file))
       if (std::optional<MemoryBufferRef> buffer = readFile(arg->getValue()))
         readCallGraph(*buffer);
     readCallGraphsFromObjectFiles<ELFT>();
+    ctx.startPhase({});
   }
 
   // Write the result to the file.
@@ -33,6 +33,7 @@ enum {
 void printHelp();
 std::string createResponseFile(const llvm::opt::InputArgList &args);
 
+bool probeFile(StringRef path);
 std::optional<std::string> findFromSearchPaths(StringRef path);
 std::optional<std::string> searchScript(StringRef path);
 std::optional<std::string> searchLibraryBaseName(StringRef path);
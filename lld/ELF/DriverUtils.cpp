@@ -208,6 +208,17 @@ std::string elf::createResponseFile(const opt::InputArgList &args) {
   return std::string(data);
 }
 
+// Returns true if path exists. With --incremental-state, paths that don't
+// exist are recorded, since creating one of them later can change which file
+// a search finds.
+bool elf::probeFile(StringRef path) {
+  if (fs::exists(path))
+    return true;
+  if (!config->incrementalState.empty())
+    config->missingFiles.insert(CachedHashString(path));
+  return false;
+}
+
 // Find a file by concatenating given paths. If a resulting path
 // starts with "=", the character is replaced with a --sysroot value.
 static std::optional<std::string> findFile(StringRef path1,
@@ -218,7 +229,7 @@ static std::optional<std::string> findFile(StringRef path1,
   else
     path::append(s, path1, path2);
 
-  if (fs::exists(s))
+  if (probeFile(s))
     return std::string(s);
   return std::nullopt;
 }
@@ -255,7 +266,7 @@ std::optional<std::string> elf::searchLibrary(StringRef name) {
 // look for the script in the '-L' search paths. This matches the behaviour of
 // '-T', --version-script=, and linker script INPUT() command in ld.bfd.
 std::optional<std::string> elf::searchScript(StringRef name) {
-  if (fs::exists(name))
+  if (probeFile(name))
     return name.str();
   return findFromSearchPaths(name);
 }
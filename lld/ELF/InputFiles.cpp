@@ -26,6 +26,7 @@
 #include "llvm/Support/ARMBuildAttributes.h"
 #include "llvm/Support/Endian.h"
 #include "llvm/Support/FileSystem.h"
+#include "llvm/Support/Parallel.h"
 #include "llvm/Support/Path.h"
 #include "llvm/Support/RISCVAttributeParser.h"
 #include "llvm/Support/TarWriter.h"
@@ -345,6 +346,14 @@ extern template void ObjFile<ELF64BE>::importCmseSymbols();
 template <class ELFT>
 static void doParseFiles(const std::vector<InputFile *> &files,
                          InputFile *armCmseImpLib) {
+  // Symbol resolution below must be serial to be deterministic, but hashing
+  // symbol names, which is a considerable part of it, is not order-dependent.
+  // Hash the names of all object files in parallel in advance.
+  parallelForEach(files, [](InputFile *file) {
+    if (file->kind() == InputFile::ObjKind && file->ekind == config->ekind)
+      cast<ObjFile<ELFT>>(file)->hashGlobalSymbolNames();
+  });
+
   // Add all files to the symbol table. This will add almost all symbols that we
   // need to the symbol table. This process might add files to the link due to
   // addDependentLibrary.
@@ -429,7 +438,7 @@ static void addDependentLibrary(StringRef specifier, const InputFile *f) {
     ctx.driver.addFile(saver().save(*s), /*withLOption=*/true);
   else if (std::optional<std::string> s = findFromSearchPaths(specifier))
     ctx.driver.addFile(saver().save(*s), /*withLOption=*/true);
-  else if (fs::exists(specifier))
+  else if (probeFile(specifier))
     ctx.driver.addFile(specifier, /*withLOption=*/false);
   else
     error(toString(f) +
@@ -1135,7 +1144,8 @@ void ObjFile<ELFT>::initializeSymbols(const object::ELFFile<ELFT> &obj) {
   // Some entries have been filled by LazyObjFile.
   for (size_t i = firstGlobal, end = eSyms.size(); i != end; ++i)
     if (!symbols[i])
-      symbols[i] = symtab.insert(CHECK(eSyms[i].getName(stringTable), this));
+      symbols[i] = insertGlobalSymbol(i);
+  globalNameHashes.reset();
 
   // Perform symbol resolution on non-local symbols.
   SmallVector<unsigned, 32> undefineds;
@@ -1186,6 +1196,27 @@ void ObjFile<ELFT>::initializeSymbols(const object::ELFFile<ELFT> &obj) {
   }
 }
 
+template <class ELFT> void ObjFile<ELFT>::hashGlobalSymbolNames() {
+  ArrayRef<Elf_Sym> eSyms = this->getELFSyms<ELFT>();
+  auto hashes = std::make_unique<uint32_t[]>(eSyms.size() - firstGlobal);
+  for (size_t i = firstGlobal, end = eSyms.size(); i != end; ++i) {
+    // Leave an invalid name to insertGlobalSymbol, which reports an error.
+    if (LLVM_UNLIKELY(eSyms[i].st_name >= stringTable.size()))
+      return;
+    StringRef name(stringTable.data() + eSyms[i].st_name);
+    hashes[i - firstGlobal] = SymbolTable::hashName(name);
+  }
+  globalNameHashes = std::move(hashes);
+}
+
+template <class ELFT> Symbol *ObjFile<ELFT>::insertGlobalSymbol(size_t i) {
+  const Elf_Sym &eSym = this->getELFSyms<ELFT>()[i];
+  StringRef name = CHECK(eSym.getName(stringTable), this);
+  if (globalNameHashes)
+    return symtab.insert(name, globalNameHashes[i - firstGlobal]);
+  return symtab.insert(name);
+}
+
 template <class ELFT>
 void ObjFile<ELFT>::initSectionsAndLocalSyms(bool ignoreComdats) {
   if (!justSymbols)
@@ -1859,7 +1890,7 @@ InputFile *elf::createInternalFile(StringRef name) {
 }
 
 ELFFileBase *elf::createObjFile(MemoryBufferRef mb, StringRef archiveName,
-                                bool lazy) {
+                                bool lazy, bool init) {
   ELFFileBase *f;
   switch (getELFKind(mb, archiveName)) {
   case ELF32LEKind:
@@ -1877,7 +1908,8 @@ ELFFileBase *elf::createObjFile(MemoryBufferRef mb, StringRef archiveName,
   default:
     llvm_unreachable("getELFKind");
   }
-  f->init();
+  if (init)
+    f->init();
   f->lazy = lazy;
   return f;
 }
@@ -1893,11 +1925,12 @@ template <class ELFT> void ObjFile<ELFT>::parseLazy() {
   for (size_t i = firstGlobal, end = eSyms.size(); i != end; ++i) {
     if (eSyms[i].st_shndx == SHN_UNDEF)
       continue;
-    symbols[i] = symtab.insert(CHECK(eSyms[i].getName(stringTable), this));
+    symbols[i] = insertGlobalSymbol(i);
     symbols[i]->resolve(LazySymbol{*this});
     if (!lazy)
       break;
   }
+  globalNameHashes.reset();
 }
 
 bool InputFile::shouldExtractForCommon(StringRef name) const {
@@ -293,11 +293,17 @@ public:
   void postParse();
   void importCmseSymbols();
 
+  // Computes the symbol table hashes of the global symbol names. This is
+  // thread-safe and is called for all input files before symbol resolution,
+  // which has to be serial.
+  void hashGlobalSymbolNames();
+
 private:
   void initializeSections(bool ignoreComdats,
                           const llvm::object::ELFFile<ELFT> &obj);
   void initializeSymbols(const llvm::object::ELFFile<ELFT> &obj);
   void initializeJustSymbols();
+  Symbol *insertGlobalSymbol(size_t i);
 
   InputSectionBase *getRelocTarget(uint32_t idx, const Elf_Shdr &sec,
                                    uint32_t info);
@@ -320,6 +326,11 @@ private:
   // If the section does not exist (which is common), the array is empty.
   ArrayRef<Elf_Word> shndxTable;
 
+  // Hashes of the global symbol names computed by hashGlobalSymbolNames,
+  // indexed by symbol index minus firstGlobal. Freed once the symbols are
+  // inserted into the symbol table.
+  std::unique_ptr<uint32_t[]> globalNameHashes;
+
   // Debugging information to retrieve source file and line for error
   // reporting. Linker may find reasonable number of errors in a
   // single object file, so we cache debugging information in order to
@@ -383,8 +394,10 @@ public:
 };
 
 InputFile *createInternalFile(StringRef name);
+// Creates an ObjFile for mb. If init is false, the caller is responsible for
+// calling ELFFileBase::init() before the file is used.
 ELFFileBase *createObjFile(MemoryBufferRef mb, StringRef archiveName = "",
-                           bool lazy = false);
+                           bool lazy = false, bool init = true);
 
 std::string replaceThinLTOSuffix(StringRef path);
 
@@ -130,7 +130,7 @@ void InputSectionBase::decompress() const {
 
   invokeELFT(decompressAux, *this, uncompressedBuf, size);
   content_ = uncompressedBuf;
-  compressed = false;
+  contentCompressed = false;
 }
 
 template <class ELFT> RelsOrRelas<ELFT> InputSectionBase::relsOrRelas() const {
@@ -230,7 +230,7 @@ template <typename ELFT> void InputSectionBase::parseCompressedHeader() {
     return;
   }
 
-  compressed = true;
+  contentCompressed = true;
   compressedSize = size;
   size = hdr->ch_size;
   addralign = std::max<uint32_t>(hdr->ch_addralign, 1);
@@ -1193,7 +1193,7 @@ template <class ELFT> void InputSection::writeTo(uint8_t *buf) {
 
   // If this is a compressed section, uncompress section contents directly
   // to the buffer.
-  if (compressed) {
+  if (contentCompressed) {
     auto *hdr = reinterpret_cast<const typename ELFT::Chdr *>(content_);
     auto compressed = ArrayRef<uint8_t>(content_, compressedSize)
                           .slice(sizeof(typename ELFT::Chdr));
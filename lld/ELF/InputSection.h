@@ -54,15 +54,25 @@ public:
 
   uint8_t sectionKind : 3;
 
-  // The next two bit fields are only used by InputSectionBase, but we
-  // put them here so the struct packs better.
+  // The next bit fields are only used by InputSectionBase, but we put them
+  // here so the struct packs better.
 
   uint8_t bss : 1;
 
   // Set for sections that should not be folded by ICF.
   uint8_t keepUnique : 1;
 
+  // Whether the section needs to be padded with a NOP filler due to
+  // deleteFallThruJmpInsn.
+  uint8_t nopFiller : 1;
+
   uint8_t partition = 1;
+
+  // Set if the content is still compressed (SHF_COMPRESSED) and needs to be
+  // decompressed before use. Not a bit field: decompress() clears it while
+  // sections are processed in parallel. It fits in the padding before type.
+  mutable bool contentCompressed = false;
+
   uint32_t type;
   StringRef name;
 
@@ -97,9 +107,9 @@ protected:
   constexpr SectionBase(Kind sectionKind, StringRef name, uint64_t flags,
                         uint32_t entsize, uint32_t addralign, uint32_t type,
                         uint32_t info, uint32_t link)
-      : sectionKind(sectionKind), bss(false), keepUnique(false), type(type),
-        name(name), flags(flags), addralign(addralign), entsize(entsize),
-        link(link), info(info) {}
+      : sectionKind(sectionKind), bss(false), keepUnique(false),
+        nopFiller(false), type(type), name(name), flags(flags),
+        addralign(addralign), entsize(entsize), link(link), info(info) {}
 };
 
 struct SymbolAnchor {
@@ -158,12 +168,6 @@ public:
   // be reset to zero after uses.
   uint32_t bytesDropped = 0;
 
-  mutable bool compressed = false;
-
-  // Whether the section needs to be padded with a NOP filler due to
-  // deleteFallThruJmpInsn.
-  bool nopFiller = false;
-
   void drop_back(unsigned num) {
     assert(bytesDropped + num < 256);
     bytesDropped += num;
@@ -188,7 +192,7 @@ public:
     return ArrayRef<uint8_t>(content_, size);
   }
   ArrayRef<uint8_t> contentMaybeDecompress() const {
-    if (compressed)
+    if (contentCompressed)
       decompress();
     return content();
   }
@@ -247,7 +251,7 @@ public:
     // They do not use jumpInstrMod.
     RelaxAux *relaxAux;
 
-    // The compressed content size when `compressed` is true.
+    // The compressed content size when `contentCompressed` is true.
     size_t compressedSize;
   };
 
@@ -446,7 +450,7 @@ public:
   }
 };
 
-static_assert(sizeof(InputSection) <= 160, "InputSection is too big");
+static_assert(sizeof(InputSection) <= 152, "InputSection is too big");
 
 class SyntheticSection : public InputSection {
 public:
@@ -44,6 +44,11 @@ public:
 
   Symbol *insert(StringRef name);
 
+  // Same as insert(name), but takes a hash computed by hashName(name) in
+  // advance. This allows the hashes to be computed in parallel.
+  Symbol *insert(StringRef name, uint32_t hash);
+  static uint32_t hashName(StringRef name);
+
   template <typename T> Symbol *addSymbol(const T &newSym) {
     Symbol *sym = insert(newSym.getName());
     sym->resolve(newSym);
@@ -81,6 +86,8 @@ public:
   llvm::StringMap<bool> inCMSEOutImpLib;
 
 private:
+  Symbol *insert(StringRef name, llvm::CachedHashStringRef stem);
+
   SmallVector<Symbol *, 0> findByVersion(SymbolVersion ver);
   SmallVector<Symbol *, 0> findAllByVersion(SymbolVersion ver,
                                             bool includeNonDefault);
@@ -77,6 +77,7 @@ private:
   void writeTrapInstr();
   void writeHeader();
   void writeSections();
+  void writeSectionsInBatches();
   void writeSectionsBinary();
   void writeBuildId();
 
@@ -306,6 +307,7 @@ template <class ELFT> void Writer<ELFT>::run() {
   // completes section contents. For example, we need to add strings
   // to the string table, and add entries to .got and .plt.
   // finalizeSections does that.
+  ctx.startPhase("finalize-sections");
   finalizeSections();
   checkExecuteOnly();
 
@@ -349,6 +351,7 @@ template <class ELFT> void Writer<ELFT>::run() {
 
   {
     llvm::TimeTraceScope timeScope("Write output file");
+    ctx.startPhase("write");
     // Write the result down to a file.
     openFile();
     if (errorCount())
@@ -1743,9 +1746,11 @@ template <class ELFT> void Writer<ELFT>::finalizeSections() {
     // called after processSymbolAssignments() because it needs to know whether
     // a linker-script-defined symbol is absolute.
     ppc64noTocRelax.clear();
+    ctx.startPhase("scan-relocations");
     scanRelocations<ELFT>();
     reportUndefinedSymbols();
     postScanRelocations();
+    ctx.startPhase("finalize-sections");
 
     if (in.plt && in.plt->isNeeded())
       in.plt->addSymbols();
@@ -2770,7 +2775,9 @@ template <class ELFT> void Writer<ELFT>::writeSections() {
       if (isStaticRelSecType(sec->type))
         sec->writeTo<ELFT>(Out::bufferStart + sec->offset, tg);
   }
-  {
+  if (config->outputBatchSize) {
+    writeSectionsInBatches();
+  } else {
     parallel::TaskGroup tg;
     for (OutputSection *sec : outputSections)
       if (!isStaticRelSecType(sec->type))
@@ -2785,6 +2792,35 @@ template <class ELFT> void Writer<ELFT>::writeSections() {
   }
 }
 
+// With --output-batch-size, write output sections in file offset order in
+// batches of about the given size. After a batch is written, its range is
+// written back to the file so that the OS can reclaim the memory of the
+// output file mapping early. This bounds the amount of dirty memory, which
+// matters when the link runs under a tight memory limit.
+template <class ELFT> void Writer<ELFT>::writeSectionsInBatches() {
+  SmallVector<OutputSection *, 0> sections;
+  for (OutputSection *sec : outputSections)
+    if (!isStaticRelSecType(sec->type) && sec->type != SHT_NOBITS)
+      sections.push_back(sec);
+  llvm::stable_sort(sections, [](const OutputSection *a,
+                                 const OutputSection *b) {
+    return a->offset < b->offset;
+  });
+
+  for (size_t i = 0, e = sections.size(); i != e;) {
+    uint64_t begin = sections[i]->offset, end = begin;
+    {
+      parallel::TaskGroup tg;
+      for (; i != e && end - begin < config->outputBatchSize; ++i) {
+        OutputSection *sec = sections[i];
+        sec->writeTo<ELFT>(Out::bufferStart + sec->offset, tg);
+        end = std::max(end, sec->offset + sec->size);
+      }
+    }
+    buffer->writeBack(begin, end - begin);
+  }
+}
+
 // Computes a hash value of Data using a given hash function.
 // In order to utilize multiple cores, we first split data into 1MB
 // chunks, compute a hash for each chunk, and then compute a hash value
@@ -30,7 +30,7 @@ static constexpr bool verboseDiagnostics = false;
 
 class ICF {
 public:
-  ICF(std::vector<ConcatInputSection *> &inputs);
+  ICF(std::vector<ConcatInputSection *> &inputs, uint64_t uniqueIDBase);
   void run();
 
   using EqualsFn = bool (ICF::*)(const ConcatInputSection *,
@@ -40,6 +40,7 @@ public:
   void forEachClassRange(size_t begin, size_t end,
                          llvm::function_ref<void(size_t, size_t)> func);
   void forEachClass(llvm::function_ref<void(size_t, size_t)> func);
+  void removeSingletonClasses();
 
   bool equalsConstant(const ConcatInputSection *ia,
                       const ConcatInputSection *ib);
@@ -50,13 +51,18 @@ public:
   // segregation algorithm destroys the proper sequence.
   std::vector<ConcatInputSection *> icfInputs;
 
+  // Unique IDs for sections removed by removeSingletonClasses(). They never
+  // intersect with equivalence-class IDs, which are indices into icfInputs.
+  uint64_t nextUniqueID;
+
   unsigned icfPass = 0;
   std::atomic<bool> icfRepeat{false};
   std::atomic<uint64_t> equalsConstantCount{0};
   std::atomic<uint64_t> equalsVariableCount{0};
 };
 
-ICF::ICF(std::vector<ConcatInputSection *> &inputs) {
+ICF::ICF(std::vector<ConcatInputSection *> &inputs, uint64_t uniqueIDBase)
+    : nextUniqueID(std::max<uint64_t>(uniqueIDBase, inputs.size())) {
   icfInputs.assign(inputs.begin(), inputs.end());
 }
 
@@ -317,6 +323,7 @@ void ICF::run() {
   forEachClass([&](size_t begin, size_t end) {
     segregate(begin, end, &ICF::equalsConstant);
   });
+  removeSingletonClasses();
 
   // Split equivalence groups by comparing relocations until convergence
   do {
@@ -324,6 +331,8 @@ void ICF::run() {
     forEachClass([&](size_t begin, size_t end) {
       segregate(begin, end, &ICF::equalsVariable);
     });
+    if (icfRepeat)
+      removeSingletonClasses();
   } while (icfRepeat);
   log("ICF needed " + Twine(icfPass) + " iterations");
   if (verboseDiagnostics) {
@@ -366,6 +375,36 @@ void ICF::segregate(size_t begin, size_t end, EqualsFn equals) {
   }
 }
 
+// Remove the sections that are alone in their equivalence classes from
+// icfInputs. Such a section cannot be folded, and since segregation only ever
+// splits classes, it stays alone in all subsequent passes. This way, each pass
+// only visits the sections whose classes may still change, which is typically
+// a small fraction of all sections after the first few passes.
+//
+// A removed section gets a unique ID in both halves of icfEqClass, so that the
+// sections referring to it still compare correctly in equalsVariable().
+void ICF::removeSingletonClasses() {
+  const unsigned cur = icfPass % 2;
+  const size_t size = icfInputs.size();
+  std::vector<uint8_t> isSingleton(size);
+  parallelFor(0, size, [&](size_t i) {
+    uint32_t eqClass = icfInputs[i]->icfEqClass[cur];
+    isSingleton[i] =
+        (i == 0 || icfInputs[i - 1]->icfEqClass[cur] != eqClass) &&
+        (i + 1 == size || icfInputs[i + 1]->icfEqClass[cur] != eqClass);
+  });
+
+  size_t numKept = 0;
+  for (size_t i = 0; i < size; ++i) {
+    ConcatInputSection *isec = icfInputs[i];
+    if (isSingleton[i])
+      isec->icfEqClass[0] = isec->icfEqClass[1] = ++nextUniqueID;
+    else
+      icfInputs[numKept++] = isec;
+  }
+  icfInputs.resize(numKept);
+}
+
 void macho::markSymAsAddrSig(Symbol *s) {
   if (auto *d = dyn_cast_or_null<Defined>(s))
     if (d->isec())
@@ -461,5 +500,5 @@ void macho::foldIdenticalSections(bool onlyCfStrings) {
   });
   // Now that every input section is either hashed or marked as unique, run the
   // segregation algorithm to detect foldable subsections.
-  ICF(foldable).run();
+  ICF(foldable, icfUniqueID).run();
 }
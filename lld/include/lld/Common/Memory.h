@@ -28,6 +28,7 @@ namespace lld {
 // SpecificAlloc<> instances.
 struct SpecificAllocBase {
   virtual ~SpecificAllocBase() = default;
+  virtual size_t getTotalMemory() const = 0;
   static SpecificAllocBase *getOrCreate(void *tag, size_t size, size_t align,
                                         SpecificAllocBase *(&creator)(void *));
 };
@@ -37,6 +38,7 @@ template <class T> struct SpecificAlloc : public SpecificAllocBase {
   static SpecificAllocBase *create(void *storage) {
     return new (storage) SpecificAlloc<T>();
   }
+  size_t getTotalMemory() const override { return alloc.getTotalMemory(); }
   llvm::SpecificBumpPtrAllocator<T> alloc;
   static int tag;
 };
@@ -0,0 +1,86 @@
+# REQUIRES: x86
+## Test that --incremental-state skips a link only if the command line, the
+## inputs and the results of the library and linker script searches are
+## unchanged.
+
+# RUN: rm -rf %t && split-file %s %t && cd %t
+# RUN: llvm-mc -filetype=obj -triple=x86_64 a.s -o a.o
+# RUN: llvm-mc -filetype=obj -triple=x86_64 b.s -o b.o
+# RUN: llvm-mc -filetype=obj -triple=x86_64 b2.s -o b2.o
+# RUN: mkdir dir1 dir2 sub
+# RUN: llvm-ar rc dir2/libb.a b.o
+
+# RUN: ld.lld a.o -Ldir1 -Ldir2 -lb -o out --incremental-state=state --verbose 2>&1 \
+# RUN:   | FileCheck %s --check-prefix=LINK --implicit-check-not=skipping
+# RUN: ld.lld a.o -Ldir1 -Ldir2 -lb -o out --incremental-state=state --verbose 2>&1 \
+# RUN:   | FileCheck %s --check-prefix=SKIP
+
+## Touching an input without changing it does not force a link.
+# RUN: touch a.o
+# RUN: ld.lld a.o -Ldir1 -Ldir2 -lb -o out --incremental-state=state --verbose 2>&1 \
+# RUN:   | FileCheck %s --check-prefix=SKIP
+
+## Changing an input does.
+# RUN: llvm-ar rc dir2/libb.a b2.o
+# RUN: ld.lld a.o -Ldir1 -Ldir2 -lb -o out --incremental-state=state --verbose 2>&1 \
+# RUN:   | FileCheck %s --check-prefix=LINK --implicit-check-not=skipping
+# RUN: ld.lld a.o -Ldir1 -Ldir2 -lb -o out --incremental-state=state --verbose 2>&1 \
+# RUN:   | FileCheck %s --check-prefix=SKIP
+
+## So does a library that appears in an earlier search directory.
+# RUN: llvm-ar rc dir1/libb.a b.o
+# RUN: ld.lld a.o -Ldir1 -Ldir2 -lb -o out --incremental-state=state --verbose 2>&1 \
+# RUN:   | FileCheck %s --check-prefix=LINK --implicit-check-not=skipping
+# RUN: FileCheck %s --check-prefix=STATE < state
+
+## And a different search order.
+# RUN: ld.lld a.o -Ldir2 -Ldir1 -lb -o out --incremental-state=state --verbose 2>&1 \
+# RUN:   | FileCheck %s --check-prefix=LINK --implicit-check-not=skipping
+
+## Modifying the output forces a link.
+# RUN: ld.lld a.o -Ldir2 -Ldir1 -lb -o out --incremental-state=state --verbose 2>&1 \
+# RUN:   | FileCheck %s --check-prefix=SKIP
+# RUN: echo >> out
+# RUN: ld.lld a.o -Ldir2 -Ldir1 -lb -o out --incremental-state=state --verbose 2>&1 \
+# RUN:   | FileCheck %s --check-prefix=LINK --implicit-check-not=skipping
+
+## INPUT in a linker script first looks in the directory of the script, then
+## in the current directory. A file that appears in the first one forces a
+## link.
+# RUN: cp b.o c.o
+# RUN: ld.lld a.o sub/script.t -o out2 --incremental-state=state2 --verbose 2>&1 \
+# RUN:   | FileCheck %s --check-prefix=LINK --implicit-check-not=skipping
+# RUN: ld.lld a.o sub/script.t -o out2 --incremental-state=state2 --verbose 2>&1 \
+# RUN:   | FileCheck %s --check-prefix=SKIP
+# RUN: cp b2.o sub/c.o
+# RUN: ld.lld a.o sub/script.t -o out2 --incremental-state=state2 --verbose 2>&1 \
+# RUN:   | FileCheck %s --check-prefix=LINK --implicit-check-not=skipping
+
+# LINK: a.o
+# SKIP: skipping the link because {{.*}} is up to date
+
+# STATE:      lld-incremental-state-v2
+# STATE:      {{[0-9A-F]+}} a.o
+# STATE:      {{[0-9A-F]+}} dir1{{/|\\}}libb.a
+# STATE-NOT:  missing dir1{{/|\\}}libb.a
+# STATE-NOT:  dir2{{/|\\}}libb.a
+# STATE:      missing dir1{{/|\\}}libb.so
+
+#--- a.s
+.globl _start
+_start:
+  call b
+
+#--- b.s
+.globl b
+b:
+  ret
+
+#--- b2.s
+.globl b
+b:
+  nop
+  ret
+
+#--- sub/script.t
+INPUT(c.o)
@@ -0,0 +1,26 @@
+# REQUIRES: x86
+## Test that --output-batch-size produces the same output and only accepts
+## positive sizes.
+
+# RUN: llvm-mc -filetype=obj -triple=x86_64 %s -o %t.o
+# RUN: ld.lld %t.o -o %t
+# RUN: ld.lld %t.o -o %t.batch --output-batch-size=1
+# RUN: cmp %t %t.batch
+
+# RUN: not ld.lld %t.o -o /dev/null --output-batch-size=0 2>&1 \
+# RUN:   | FileCheck %s --check-prefix=ERR0
+# RUN: not ld.lld %t.o -o /dev/null --output-batch-size=-1 2>&1 \
+# RUN:   | FileCheck %s --check-prefix=ERRNEG
+# RUN: not ld.lld %t.o -o /dev/null --output-batch-size=x 2>&1 \
+# RUN:   | FileCheck %s --check-prefix=ERRX
+
+# ERR0: error: --output-batch-size=: expected a positive integer, but got '0'
+# ERRNEG: error: --output-batch-size=: expected a positive integer, but got '-1'
+# ERRX: error: --output-batch-size=: expected a positive integer, but got 'x'
+
+.globl _start
+_start:
+  ret
+
+.data
+.quad 1
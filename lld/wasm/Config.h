@@ -73,6 +73,7 @@ struct Configuration {
   bool stripDebug;
   bool stackFirst;
   bool isStatic = false;
+  bool timeTraceEnabled;
   bool trace;
   uint64_t globalBase;
   uint64_t initialHeap;
@@ -85,6 +86,7 @@ struct Configuration {
   // runtime).
   uint64_t tableBase;
   uint64_t zStackSize;
+  unsigned timeTraceGranularity;
   unsigned ltoPartitions;
   unsigned ltoo;
   llvm::CodeGenOptLevel ltoCgo;
@@ -24,6 +24,7 @@
 #include "InputElement.h"
 #include "SymbolTable.h"
 #include "Symbols.h"
+#include "llvm/Support/TimeProfiler.h"
 
 #define DEBUG_TYPE "lld"
 
@@ -167,6 +168,8 @@ void markLive() {
   if (!config->gcSections)
     return;
 
+  llvm::TimeTraceScope timeScope("Mark live");
+
   LLVM_DEBUG(dbgs() << "markLive\n");
 
   MarkLive marker;
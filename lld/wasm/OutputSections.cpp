@@ -79,9 +79,10 @@ void CodeSection::writeTo(uint8_t *buf) {
   // Write code section headers
   memcpy(buf, codeSectionHeader.data(), codeSectionHeader.size());
 
-  // Write code section bodies
-  for (const InputChunk *chunk : functions)
-    chunk->writeTo(buf);
+  // Write code section bodies. Each function applies its own relocations to
+  // its own part of the output, so they can all be written at once.
+  parallelForEach(functions,
+                  [buf](const InputChunk *chunk) { chunk->writeTo(buf); });
 }
 
 uint32_t CodeSection::getNumRelocations() const {
@@ -184,8 +185,8 @@ void DataSection::writeTo(uint8_t *buf) {
     memcpy(segStart, segment->header.data(), segment->header.size());
 
     // Write segment data payload
-    for (const InputChunk *chunk : segment->inputSegments)
-      chunk->writeTo(buf);
+    parallelForEach(segment->inputSegments,
+                    [buf](const InputChunk *chunk) { chunk->writeTo(buf); });
   }
 }
 
@@ -269,9 +270,10 @@ void CustomSection::writeTo(uint8_t *buf) {
   memcpy(buf, nameData.data(), nameData.size());
   buf += nameData.size();
 
-  // Write custom sections payload
-  for (const InputChunk *section : inputSections)
-    section->writeTo(buf);
+  // Write custom sections payload, e.g. one chunk per input file for debug
+  // sections.
+  parallelForEach(inputSections,
+                  [buf](const InputChunk *section) { section->writeTo(buf); });
 }
 
 uint32_t CustomSection::getNumRelocations() const {
@@ -12,6 +12,7 @@
 #include "InputElement.h"
 #include "WriterUtils.h"
 #include "lld/Common/CommonLinkerContext.h"
+#include "llvm/Support/TimeProfiler.h"
 #include <optional>
 
 #define DEBUG_TYPE "lld"
@@ -75,6 +76,7 @@ void SymbolTable::addFile(InputFile *file, StringRef symName) {
 // Because all bitcode files that the program consists of are passed
 // to the compiler at once, it can do whole-program optimization.
 void SymbolTable::compileBitcodeFiles() {
+  llvm::TimeTraceScope timeScope("LTO");
   // Prevent further LTO objects being included
   BitcodeFile::doneLTO = true;
 
@@ -35,6 +35,7 @@
 #include "llvm/Support/Parallel.h"
 #include "llvm/Support/RandomNumberGenerator.h"
 #include "llvm/Support/SHA1.h"
+#include "llvm/Support/TimeProfiler.h"
 #include "llvm/Support/xxhash.h"
 
 #include <cstdarg>
@@ -218,6 +219,7 @@ void Writer::writeHeader() {
 }
 
 void Writer::writeSections() {
+  llvm::TimeTraceScope timeScope("Write sections");
   uint8_t *buf = buffer->getBufferStart();
   parallelForEach(outputSections, [buf](OutputSection *s) {
     assert(s->isNeeded());
@@ -558,6 +560,7 @@ void Writer::addSections() {
 }
 
 void Writer::finalizeSections() {
+  llvm::TimeTraceScope timeScope("Finalize sections");
   for (OutputSection *s : outputSections) {
     s->setOffset(fileSize);
     s->finalizeContents();
@@ -845,6 +848,7 @@ void Writer::populateSymtab() {
 }
 
 void Writer::calculateTypes() {
+  llvm::TimeTraceScope timeScope("Calculate types");
   // The output type section is the union of the following sets:
   // 1. Any signature used in the TYPE relocation
   // 2. The signatures of all imported functions
@@ -945,6 +949,7 @@ static void finalizeIndirectFunctionTable() {
 }
 
 static void scanRelocations() {
+  llvm::TimeTraceScope timeScope("Scan relocations");
   for (ObjFile *file : ctx.objectFiles) {
     LLVM_DEBUG(dbgs() << "scanRelocations: " << file->getName() << "\n");
     for (InputChunk *chunk : file->functions)
@@ -957,6 +962,7 @@ static void scanRelocations() {
 }
 
 void Writer::assignIndexes() {
+  llvm::TimeTraceScope timeScope("Assign indexes");
   // Seal the import section, since other index spaces such as function and
   // global are effected by the number of imports.
   out.importSec->seal();
@@ -1842,6 +1848,7 @@ void Writer::run() {
   if (errorCount())
     return;
 
+  llvm::TimeTraceScope timeScope("Commit output file");
   if (Error e = buffer->commit())
     fatal("failed to write output '" + buffer->getPath() +
           "': " + toString(std::move(e)));
@@ -1870,6 +1877,9 @@ void Writer::createHeader() {
   fileSize += header.size();
 }
 
-void writeResult() { Writer().run(); }
+void writeResult() {
+  llvm::TimeTraceScope timeScope("Write output file");
+  Writer().run();
+}
 
 } // namespace wasm::lld
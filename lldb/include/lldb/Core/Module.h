@@ -880,6 +880,13 @@ public:
   /// ElapsedTime RAII object.
   StatsDuration &GetSymtabIndexTime() { return m_symtab_index_time; }
 
+  /// Accessor for the time spent in PreloadSymbols().
+  ///
+  /// This includes the symbol table parse and index times as well as any
+  /// work the symbol file does up front, so it is the cost of the module to
+  /// the target that loaded it.
+  StatsDuration &GetPreloadSymbolsTime() { return m_preload_symbols_time; }
+
   /// \class LookupInfo Module.h "lldb/Core/Module.h"
   /// A class that encapsulates name lookup information.
   ///
@@ -1056,6 +1063,9 @@ protected:
   /// an object file and a symbol file which both have symbol tables. The parse
   /// time for the symbol tables can be aggregated here.
   StatsDuration m_symtab_index_time;
+  /// The time spent in PreloadSymbols(), wall clock on whichever thread did
+  /// the preloading.
+  StatsDuration m_preload_symbols_time;
 
   std::once_flag m_optimization_warning;
   std::once_flag m_language_warning;
@@ -112,6 +112,7 @@ struct ModuleStats {
   llvm::StringMap<llvm::json::Value> type_system_stats;
   double symtab_parse_time = 0.0;
   double symtab_index_time = 0.0;
+  double preload_symbols_time = 0.0;
   double debug_parse_time = 0.0;
   double debug_index_time = 0.0;
   uint64_t debug_info_size = 0;
@@ -148,11 +149,17 @@ public:
   void IncreaseSourceMapDeduceCount();
 
   StatsDuration &GetCreateTime() { return m_create_time; }
+  StatsDuration &GetPreloadDependentsTime() {
+    return m_preload_dependents_time;
+  }
   StatsSuccessFail &GetExpressionStats() { return m_expr_eval; }
   StatsSuccessFail &GetFrameVariableStats() { return m_frame_var; }
 
 protected:
   StatsDuration m_create_time;
+  /// Wall clock time spent preloading the symbols of the executable's
+  /// dependent modules, which happens in parallel across modules.
+  StatsDuration m_preload_dependents_time;
   std::optional<StatsTimepoint> m_launch_or_attach_time;
   std::optional<StatsTimepoint> m_first_private_stop_time;
   std::optional<StatsTimepoint> m_first_public_stop_time;
@@ -1583,6 +1583,9 @@ protected:
   bool m_valid;
   bool m_suppress_stop_hooks; /// Used to not run stop hooks for expressions
   bool m_is_dummy_target;
+  /// Set while SetExecutableModule() gathers the dependent modules, so that
+  /// GetOrCreateModule() leaves preloading them to a parallel pass afterwards.
+  bool m_defer_preload_symbols = false;
   unsigned m_next_persistent_variable_index = 0;
   /// An optional \a lldb_private::Trace object containing processor trace
   /// information of this target.
@@ -1321,6 +1321,7 @@ void Module::FindSymbolsMatchingRegExAndType(
 
 void Module::PreloadSymbols() {
   std::lock_guard<std::recursive_mutex> guard(m_mutex);
+  ElapsedTime elapsed(m_preload_symbols_time);
   SymbolFile *sym_file = GetSymbolFile();
   if (!sym_file)
     return;
@@ -32,6 +32,7 @@
 #include "lldb/Target/MemoryRegionInfo.h"
 #include "lldb/Utility/Args.h"
 #include "lldb/Utility/DataBuffer.h"
+#include "lldb/Utility/DataExtractor.h"
 #include "lldb/Utility/Endian.h"
 #include "lldb/Utility/GDBRemote.h"
 #include "lldb/Utility/LLDBAssert.h"
@@ -639,6 +640,55 @@ static void WriteRegisterValueInHexFixedWidth(
   }
 }
 
+namespace {
+/// A frame record (saved frame pointer and return address) copied from the
+/// stack of a stopped thread.
+struct StackMemory {
+  lldb::addr_t addr;
+  uint8_t bytes[2 * sizeof(uint64_t)];
+  size_t size;
+};
+} // namespace
+
+/// Read up to \p frame_limit records of the frame pointer chain of \p thread.
+/// Sending these along with the stop lets the client unwind the innermost
+/// frames from its memory cache instead of with a memory read per frame.
+/// Threads that don't maintain a frame pointer chain just yield fewer records,
+/// as the walk stops at the first unreadable or repeated address.
+static std::vector<StackMemory>
+ReadFramePointerChain(NativeThreadProtocol &thread, uint32_t frame_limit) {
+  std::vector<StackMemory> records;
+  NativeProcessProtocol &process = thread.GetProcess();
+  const uint32_t addr_size = process.GetAddressByteSize();
+  if (addr_size != 4 && addr_size != 8)
+    return records;
+
+  lldb::addr_t fp = thread.GetRegisterContext().GetFP(0);
+  while (fp != 0 && records.size() < frame_limit) {
+    if (llvm::any_of(records, [fp](const StackMemory &record) {
+          return record.addr == fp;
+        }))
+      break;
+
+    StackMemory record;
+    record.addr = fp;
+    record.size = 2 * addr_size;
+    size_t bytes_read = 0;
+    Status error = process.ReadMemoryWithoutTrap(fp, record.bytes,
+                                                 record.size, bytes_read);
+    if (error.Fail() || bytes_read != record.size)
+      break;
+    records.push_back(record);
+
+    // The saved frame pointer comes first in the record.
+    DataExtractor data(record.bytes, record.size, process.GetByteOrder(),
+                       addr_size);
+    lldb::offset_t offset = 0;
+    fp = data.GetAddress(&offset);
+  }
+  return records;
+}
+
 static std::optional<json::Object>
 GetRegistersAsJSON(NativeThreadProtocol &thread) {
   Log *log = GetLog(LLDBLog::Thread);
@@ -755,6 +805,19 @@ GetJSONThreadsInfo(NativeProcessProtocol &process, bool abridged) {
     if (!abridged) {
       if (std::optional<json::Object> registers = GetRegistersAsJSON(thread))
         thread_obj.try_emplace("registers", std::move(*registers));
+
+      // Expedite the frame pointer chain, as debugserver does, so that the
+      // client can backtrace without further memory reads.
+      json::Array memory_array;
+      for (const StackMemory &record : ReadFramePointerChain(thread, 256)) {
+        StreamString bytes;
+        AppendHexValue(bytes, record.bytes, record.size, false);
+        memory_array.push_back(json::Object{
+            {"address", static_cast<int64_t>(record.addr)},
+            {"bytes", bytes.GetString().str()}});
+      }
+      if (!memory_array.empty())
+        thread_obj.try_emplace("memory", std::move(memory_array));
     }
 
     thread_obj.try_emplace("tid", static_cast<int64_t>(tid));
@@ -950,6 +1013,14 @@ GDBRemoteCommunicationServerLLGS::PrepareStopReplyPacketForThread(
     }
   }
 
+  // Expedite the first two frame records so that stepping, which mostly only
+  // looks at the innermost frames, doesn't need memory reads to unwind.
+  for (const StackMemory &record : ReadFramePointerChain(thread, 2)) {
+    response.Printf("memory:0x%" PRIx64 "=", record.addr);
+    AppendHexValue(response, record.bytes, record.size, false);
+    response.PutChar(';');
+  }
+
   const char *reason_str = GetStopReasonString(tid_stop_info.reason);
   if (reason_str != nullptr) {
     response.Printf("reason:%s;", reason_str);
@@ -2181,6 +2181,19 @@ bool DWARFASTParserClang::ParseTemplateParameterInfos(
          template_param_infos.hasParameterPack();
 }
 
+// Completing a record is already as lazy as the AST allows: members whose
+// types are pointers or references leave the pointee as a forward
+// declaration, to be completed through the external AST source (and the
+// ClangASTImporter's minimal import) only once an expression looks inside it.
+// What gets completed eagerly here is what clang needs to lay out the record
+// and check it: by-value members and bases (RequireCompleteType), methods,
+// and declarations for contained types, which clang never asks for.
+//
+// FIXME: Prefetching likely-needed types on other threads is not possible
+// while the ASTContext, SymbolFileDWARF's DIE-to-type maps and the
+// ClangASTImporter are only safe to use under the module mutex. The part that
+// could overlap is DIE extraction for the units the record's member types
+// live in.
 bool DWARFASTParserClang::CompleteRecordType(const DWARFDIE &die,
                                              lldb_private::Type *type,
                                              CompilerType &clang_type) {
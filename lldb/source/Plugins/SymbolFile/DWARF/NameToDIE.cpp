@@ -103,12 +103,14 @@ bool NameToDIE::Decode(const DataExtractor &data, lldb::offset_t *offset_ptr,
   const uint32_t count = data.GetU32(offset_ptr);
   m_map.Reserve(count);
   for (uint32_t i = 0; i < count; ++i) {
-    llvm::StringRef str(strtab.Get(data.GetU32(offset_ptr)));
+    // The same names appear many times, both within a map and across the
+    // maps of an index set, so have the string table hand out ConstStrings.
+    ConstString str = strtab.GetConstString(data.GetU32(offset_ptr));
     // No empty strings allowed in the name to DIE maps.
-    if (str.empty())
+    if (str.IsEmpty())
       return false;
     if (std::optional<DIERef> die_ref = DIERef::Decode(data, offset_ptr))
-      m_map.Append(ConstString(str), *die_ref);
+      m_map.Append(str, *die_ref);
     else
       return false;
   }
@@ -56,6 +56,7 @@ json::Value ModuleStats::ToJSON() const {
   module.try_emplace("identifier", identifier);
   module.try_emplace("symbolTableParseTime", symtab_parse_time);
   module.try_emplace("symbolTableIndexTime", symtab_index_time);
+  module.try_emplace("symbolPreloadTime", preload_symbols_time);
   module.try_emplace("symbolTableLoadedFromCache", symtab_loaded_from_cache);
   module.try_emplace("symbolTableSavedToCache", symtab_saved_to_cache);
   module.try_emplace("debugInfoParseTime", debug_parse_time);
@@ -132,6 +133,8 @@ TargetStats::ToJSON(Target &target,
     }
     target_metrics_json.try_emplace("targetCreateTime",
                                     m_create_time.get().count());
+    target_metrics_json.try_emplace("dependentModulesPreloadTime",
+                                    m_preload_dependents_time.get().count());
 
     json::Array breakpoints_array;
     double totalBreakpointResolveTime = 0.0;
@@ -232,6 +235,7 @@ llvm::json::Value DebuggerStats::ReportStatistics(
   json::Array json_modules;
   double symtab_parse_time = 0.0;
   double symtab_index_time = 0.0;
+  double preload_symbols_time = 0.0;
   double debug_parse_time = 0.0;
   double debug_index_time = 0.0;
   uint32_t symtabs_loaded = 0;
@@ -254,6 +258,8 @@ llvm::json::Value DebuggerStats::ReportStatistics(
     ModuleStats module_stat;
     module_stat.symtab_parse_time = module->GetSymtabParseTime().get().count();
     module_stat.symtab_index_time = module->GetSymtabIndexTime().get().count();
+    module_stat.preload_symbols_time =
+        module->GetPreloadSymbolsTime().get().count();
     Symtab *symtab = module->GetSymtab();
     if (symtab) {
       module_stat.symtab_loaded_from_cache = symtab->GetWasLoadedFromCache();
@@ -301,6 +307,7 @@ llvm::json::Value DebuggerStats::ReportStatistics(
     }
     symtab_parse_time += module_stat.symtab_parse_time;
     symtab_index_time += module_stat.symtab_index_time;
+    preload_symbols_time += module_stat.preload_symbols_time;
     debug_parse_time += module_stat.debug_parse_time;
     debug_index_time += module_stat.debug_index_time;
     debug_info_size += module_stat.debug_info_size;
@@ -331,6 +338,7 @@ llvm::json::Value DebuggerStats::ReportStatistics(
   json::Object global_stats{
       {"totalSymbolTableParseTime", symtab_parse_time},
       {"totalSymbolTableIndexTime", symtab_index_time},
+      {"totalSymbolPreloadTime", preload_symbols_time},
       {"totalSymbolTablesLoadedFromCache", symtabs_loaded},
       {"totalSymbolTablesSavedToCache", symtabs_saved},
       {"totalDebugInfoParseTime", debug_parse_time},
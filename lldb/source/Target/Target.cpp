@@ -66,6 +66,7 @@
 
 #include "llvm/ADT/ScopeExit.h"
 #include "llvm/ADT/SetVector.h"
+#include "llvm/Support/ThreadPool.h"
 
 #include <memory>
 #include <mutex>
@@ -1510,6 +1511,11 @@ void Target::SetExecutableModule(ModuleSP &executable_sp,
 
     if (executable_objfile && load_dependents) {
       ModuleList added_modules;
+      // Finding the dependents only needs their load commands or dynamic
+      // sections, so defer preloading their symbols until all of them are
+      // known and then preload them in parallel.
+      const bool preload_symbols = GetPreloadSymbols();
+      m_defer_preload_symbols = preload_symbols;
       executable_objfile->GetDependentModules(dependent_files);
       for (uint32_t i = 0; i < dependent_files.GetSize(); i++) {
         FileSpec dependent_file_spec(dependent_files.GetFileSpecAtIndex(i));
@@ -1530,6 +1536,14 @@ void Target::SetExecutableModule(ModuleSP &executable_sp,
             objfile->GetDependentModules(dependent_files);
         }
       }
+      m_defer_preload_symbols = false;
+      if (preload_symbols) {
+        ElapsedTime elapsed(m_stats.GetPreloadDependentsTime());
+        llvm::ThreadPoolTaskGroup task_group(Debugger::GetThreadPool());
+        for (const ModuleSP &module_sp : added_modules.Modules())
+          task_group.async([module_sp] { module_sp->PreloadSymbols(); });
+        task_group.wait();
+      }
       ModulesDidLoad(added_modules);
     }
   }
@@ -2313,7 +2327,7 @@ ModuleSP Target::GetOrCreateModule(const ModuleSpec &module_spec, bool notify,
 
         // Preload symbols outside of any lock, so hopefully we can do this for
         // each library in parallel.
-        if (GetPreloadSymbols())
+        if (GetPreloadSymbols() && !m_defer_preload_symbols)
           module_sp->PreloadSymbols();
         llvm::SmallVector<ModuleSP, 1> replaced_modules;
         for (ModuleSP &old_module_sp : old_modules) {
@@ -0,0 +1,170 @@
+//===- CodeGenO0.cpp - -O0 code generation throughput ---------------------===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+//
+// Measures how fast the -O0 pipelines turn IR into object code, which is what
+// dominates debug build times. Each target is run with FastISel and with
+// GlobalISel over the same generated corpus, and throughput is reported in IR
+// instructions per second. Use llc -O0 -time-passes on a real module for a
+// per-pass breakdown of a regression found here.
+//
+//===----------------------------------------------------------------------===//
+
+#include "benchmark/benchmark.h"
+#include "llvm/AsmParser/Parser.h"
+#include "llvm/IR/LLVMContext.h"
+#include "llvm/IR/LegacyPassManager.h"
+#include "llvm/IR/Module.h"
+#include "llvm/MC/TargetRegistry.h"
+#include "llvm/Support/SourceMgr.h"
+#include "llvm/Support/TargetSelect.h"
+#include "llvm/Support/raw_ostream.h"
+#include "llvm/Target/TargetMachine.h"
+#include "llvm/Target/TargetOptions.h"
+#include <memory>
+#include <string>
+
+using namespace llvm;
+
+namespace {
+
+enum class Selector { FastISel, GlobalISel };
+
+/// Generates a module with \p NumFunctions functions of \p NumBlocks blocks
+/// each, mixing the integer, floating point, memory, call and control flow
+/// instructions that unoptimized front-end output is made of.
+std::string generateCorpus(unsigned NumFunctions, unsigned NumBlocks) {
+  std::string IR;
+  raw_string_ostream OS(IR);
+  OS << "declare i64 @ext(i64, double)\n";
+  for (unsigned F = 0; F != NumFunctions; ++F) {
+    OS << "define i64 @f" << F << "(ptr %p, i64 %a, i64 %b, double %x) {\n"
+       << "entry:\n"
+       << "  %acc = alloca i64\n"
+       << "  store i64 %a, ptr %acc\n"
+       << "  br label %bb0\n";
+    for (unsigned B = 0; B != NumBlocks; ++B) {
+      std::string V = "%v" + std::to_string(B);
+      OS << "bb" << B << ":\n"
+         << "  " << V << ".0 = load i64, ptr %acc\n"
+         << "  " << V << ".1 = mul i64 " << V << ".0, %b\n"
+         << "  " << V << ".2 = add i64 " << V << ".1, " << B << "\n"
+         << "  " << V << ".3 = getelementptr i64, ptr %p, i64 " << B << "\n"
+         << "  " << V << ".4 = load i64, ptr " << V << ".3\n"
+         << "  " << V << ".5 = xor i64 " << V << ".2, " << V << ".4\n"
+         << "  " << V << ".6 = sitofp i64 " << V << ".5 to double\n"
+         << "  " << V << ".7 = fmul double " << V << ".6, %x\n"
+         << "  " << V << ".8 = call i64 @ext(i64 " << V << ".5, double " << V
+         << ".7)\n"
+         << "  store i64 " << V << ".8, ptr " << V << ".3\n"
+         << "  store i64 " << V << ".5, ptr %acc\n"
+         << "  " << V << ".9 = icmp slt i64 " << V << ".8, %a\n"
+         << "  br i1 " << V << ".9, label %bb" << B + 1 << ", label %exit\n";
+    }
+    OS << "bb" << NumBlocks << ":\n"
+       << "  br label %exit\n"
+       << "exit:\n"
+       << "  %r = load i64, ptr %acc\n"
+       << "  ret i64 %r\n"
+       << "}\n";
+  }
+  return IR;
+}
+
+std::unique_ptr<TargetMachine> createTargetMachine(StringRef TripleName,
+                                                   Selector Sel,
+                                                   std::string &Error) {
+  const Target *T = TargetRegistry::lookupTarget(TripleName, Error);
+  if (!T)
+    return nullptr;
+  std::unique_ptr<TargetMachine> TM(
+      T->createTargetMachine(TripleName, "", "", TargetOptions(), std::nullopt,
+                             std::nullopt, CodeGenOptLevel::None));
+  if (!TM) {
+    Error = "cannot create a target machine for " + TripleName.str();
+    return nullptr;
+  }
+  // Targets pick their own selector at -O0 in the constructor, e.g. AArch64
+  // enables GlobalISel, so override it afterwards.
+  TM->setFastISel(Sel == Selector::FastISel);
+  TM->setGlobalISel(Sel == Selector::GlobalISel);
+  // Measure the pipeline as shipped, including any SelectionDAG fallback.
+  TM->setGlobalISelAbort(GlobalISelAbortMode::Disable);
+  return TM;
+}
+
+void runCodeGen(benchmark::State &State, StringRef TripleName, Selector Sel) {
+  InitializeAllTargetInfos();
+  InitializeAllTargets();
+  InitializeAllTargetMCs();
+  InitializeAllAsmPrinters();
+
+  std::string Error;
+  std::unique_ptr<TargetMachine> TM =
+      createTargetMachine(TripleName, Sel, Error);
+  if (!TM) {
+    State.SkipWithError(Error.c_str());
+    return;
+  }
+
+  const std::string IR = generateCorpus(State.range(0), State.range(1));
+  uint64_t NumInsts = 0;
+  for (auto _ : State) {
+    // Code generation mutates the module, so start from fresh IR each time.
+    State.PauseTiming();
+    LLVMContext Ctx;
+    SMDiagnostic Diag;
+    std::unique_ptr<Module> M = parseAssemblyString(IR, Diag, Ctx);
+    if (!M) {
+      State.SkipWithError(Diag.getMessage().str().c_str());
+      return;
+    }
+    M->setTargetTriple(TripleName);
+    M->setDataLayout(TM->createDataLayout());
+    NumInsts = M->getInstructionCount();
+    State.ResumeTiming();
+
+    raw_null_ostream OS;
+    legacy::PassManager PM;
+    if (TM->addPassesToEmitFile(PM, OS, nullptr, CodeGenFileType::ObjectFile)) {
+      State.SkipWithError("target does not support object emission");
+      return;
+    }
+    PM.run(*M);
+  }
+  State.counters["insts/s"] = benchmark::Counter(
+      NumInsts, benchmark::Counter::kIsIterationInvariantRate);
+}
+
+void BM_X86_FastISel(benchmark::State &State) {
+  runCodeGen(State, "x86_64-unknown-linux-gnu", Selector::FastISel);
+}
+void BM_X86_GlobalISel(benchmark::State &State) {
+  runCodeGen(State, "x86_64-unknown-linux-gnu", Selector::GlobalISel);
+}
+void BM_AArch64_FastISel(benchmark::State &State) {
+  runCodeGen(State, "aarch64-unknown-linux-gnu", Selector::FastISel);
+}
+void BM_AArch64_GlobalISel(benchmark::State &State) {
+  runCodeGen(State, "aarch64-unknown-linux-gnu", Selector::GlobalISel);
+}
+
+} // namespace
+
+// Arguments are the number of functions and the number of blocks per function:
+// many small functions and a few large ones.
+#define CODEGEN_BENCHMARK(Name)                                                \
+  BENCHMARK(Name)                                                              \
+      ->Args({256, 4})                                                         \
+      ->Args({8, 512})                                                         \
+      ->Unit(benchmark::kMillisecond)
+CODEGEN_BENCHMARK(BM_X86_FastISel);
+CODEGEN_BENCHMARK(BM_X86_GlobalISel);
+CODEGEN_BENCHMARK(BM_AArch64_FastISel);
+CODEGEN_BENCHMARK(BM_AArch64_GlobalISel);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,70 @@
+//===- ConcurrentStringSaver.cpp - Concurrent string uniquing -------------===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+//
+// Compares ConcurrentUniqueStringSaver with a UniqueStringSaver behind a mutex,
+// with threads saving mostly the same strings.
+//
+//===----------------------------------------------------------------------===//
+
+#include "benchmark/benchmark.h"
+#include "llvm/Support/ConcurrentStringSaver.h"
+#include "llvm/Support/StringSaver.h"
+#include <mutex>
+#include <string>
+#include <vector>
+
+using namespace llvm;
+
+// Symbol-like names, of which each thread saves a slice shifted by its index,
+// so that threads mostly find strings that other threads saved first.
+static const std::vector<std::string> &getNames() {
+  static const std::vector<std::string> Names = [] {
+    std::vector<std::string> Names;
+    for (unsigned I = 0; I != 1 << 16; ++I)
+      Names.push_back("_ZN4llvm6detail8function" + std::to_string(I * 7919));
+    return Names;
+  }();
+  return Names;
+}
+
+namespace {
+/// UniqueStringSaver behind a single lock, the usual way to share it.
+class LockedUniqueStringSaver {
+  std::mutex Mutex;
+  BumpPtrAllocator Alloc;
+  UniqueStringSaver Saver{Alloc};
+
+public:
+  StringRef save(StringRef S) {
+    std::lock_guard<std::mutex> Lock(Mutex);
+    return Saver.save(S);
+  }
+};
+} // namespace
+
+template <typename SaverT> static void BM_Save(benchmark::State &State) {
+  static SaverT *Saver;
+  if (State.thread_index() == 0)
+    Saver = new SaverT();
+  const std::vector<std::string> &Names = getNames();
+  size_t Next = State.thread_index() * 4099;
+  for (auto _ : State) {
+    benchmark::DoNotOptimize(Saver->save(Names[Next % Names.size()]));
+    ++Next;
+  }
+  State.SetItemsProcessed(State.iterations());
+  if (State.thread_index() == 0)
+    delete Saver;
+}
+
+BENCHMARK(BM_Save<LockedUniqueStringSaver>)->ThreadRange(1, 128)->UseRealTime();
+BENCHMARK(BM_Save<ConcurrentUniqueStringSaver>)
+    ->ThreadRange(1, 128)
+    ->UseRealTime();
+
+BENCHMARK_MAIN();
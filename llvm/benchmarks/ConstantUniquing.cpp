@@ -0,0 +1,49 @@
+//===- ConstantUniquing.cpp - Concurrent constant uniquing ----------------===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+//
+// Measures how fast ConstantInt::get uniques integers, in the default mode and
+// under contention in the concurrent uniquing mode.
+//
+//===----------------------------------------------------------------------===//
+
+#include "benchmark/benchmark.h"
+#include "llvm/ADT/APInt.h"
+#include "llvm/IR/Constants.h"
+#include "llvm/IR/LLVMContext.h"
+
+using namespace llvm;
+
+// All threads of a benchmark share one context, which is only valid in
+// concurrent uniquing mode.
+static LLVMContext *SharedContext;
+
+static void setUp(const benchmark::State &State) {
+  SharedContext = new LLVMContext();
+  if (State.range(0))
+    SharedContext->enableConcurrentConstantUniquing();
+}
+
+static void tearDown(const benchmark::State &) { delete SharedContext; }
+
+static void BM_ConstantIntGet(benchmark::State &State) {
+  uint64_t V = State.thread_index() * 7919;
+  for (auto _ : State) {
+    benchmark::DoNotOptimize(
+        ConstantInt::get(*SharedContext, APInt(64, V++ % 65536)));
+  }
+}
+// Single-threaded baseline with the default, unsynchronized tables.
+BENCHMARK(BM_ConstantIntGet)->Setup(setUp)->Teardown(tearDown)->Arg(0);
+// Lock-striped tables under contention.
+BENCHMARK(BM_ConstantIntGet)
+    ->Setup(setUp)
+    ->Teardown(tearDown)
+    ->Arg(1)
+    ->ThreadRange(1, 16);
+
+BENCHMARK_MAIN();
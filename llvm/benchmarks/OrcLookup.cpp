@@ -0,0 +1,78 @@
+//===- OrcLookup.cpp - Concurrent ORC symbol lookup -----------------------===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+//
+// Measures ExecutionSession::lookup for symbols that have already been
+// materialized, as done by JIT clients that resolve the entry points of
+// compiled code on every request, from an increasing number of threads.
+//
+//===----------------------------------------------------------------------===//
+
+#include "benchmark/benchmark.h"
+#include "llvm/ExecutionEngine/Orc/Core.h"
+#include "llvm/ExecutionEngine/Orc/ExecutorProcessControl.h"
+#include "llvm/Support/Error.h"
+#include <string>
+#include <vector>
+
+using namespace llvm;
+using namespace llvm::orc;
+
+namespace {
+
+constexpr unsigned NumSymbols = 1024;
+
+struct Session {
+  Session() : ES(cantFail(SelfExecutorProcessControl::Create())) {
+    JD = &ES.createBareJITDylib("main");
+    SymbolMap Defs;
+    for (unsigned I = 0; I != NumSymbols; ++I) {
+      Names.push_back(ES.intern("sym" + std::to_string(I)));
+      Defs[Names.back()] = {ExecutorAddr(0x1000 + I * 16),
+                            JITSymbolFlags::Exported};
+    }
+    cantFail(JD->define(absoluteSymbols(std::move(Defs))));
+
+    // Materialize everything up front so that the benchmark only measures
+    // lookups of Ready symbols.
+    SymbolLookupSet All;
+    for (auto &Name : Names)
+      All.add(Name);
+    cantFail(ES.lookup(makeJITDylibSearchOrder(JD), std::move(All)));
+  }
+  ~Session() { cantFail(ES.endSession()); }
+
+  ExecutionSession ES;
+  JITDylib *JD;
+  std::vector<SymbolStringPtr> Names;
+};
+
+Session &getSession() {
+  static Session S;
+  return S;
+}
+
+void BM_LookupReady(benchmark::State &State) {
+  Session &S = getSession();
+  auto SearchOrder = makeJITDylibSearchOrder(S.JD);
+  unsigned I = State.thread_index() * 7;
+  for (auto _ : State) {
+    auto Sym = S.ES.lookup(SearchOrder, S.Names[I++ % NumSymbols]);
+    if (!Sym) {
+      State.SkipWithError(toString(Sym.takeError()).c_str());
+      return;
+    }
+    benchmark::DoNotOptimize(Sym->getAddress());
+  }
+  State.SetItemsProcessed(State.iterations());
+}
+
+} // namespace
+
+BENCHMARK(BM_LookupReady)->ThreadRange(1, 64)->UseRealTime();
+
+BENCHMARK_MAIN();
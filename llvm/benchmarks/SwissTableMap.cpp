@@ -0,0 +1,139 @@
+//===- SwissTableMap.cpp - SwissTableMap vs. DenseMap ---------------------===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+//
+// Compares SwissTableMap with DenseMap on insertion, lookup, erasure and
+// iteration, for pointer keys and integer keys.
+//
+//===----------------------------------------------------------------------===//
+
+#include "benchmark/benchmark.h"
+#include "llvm/ADT/DenseMap.h"
+#include "llvm/ADT/SwissTableMap.h"
+#include <algorithm>
+#include <random>
+#include <type_traits>
+#include <vector>
+
+using namespace llvm;
+
+// Keys shaped like the pointers that key most of the compiler's maps:
+// distinct, aligned addresses of objects allocated close together.
+static std::vector<uintptr_t *> getPointerKeys(size_t N, unsigned Seed) {
+  static std::vector<uintptr_t> Storage(1 << 22);
+  std::vector<uintptr_t *> Keys;
+  for (size_t I = 0; I != N; ++I)
+    Keys.push_back(&Storage[I * 2]);
+  std::shuffle(Keys.begin(), Keys.end(), std::mt19937(Seed));
+  return Keys;
+}
+
+static std::vector<uint64_t> getIntegerKeys(size_t N, unsigned Seed) {
+  std::mt19937_64 Rand(Seed);
+  std::vector<uint64_t> Keys;
+  // Stay clear of DenseMap's empty and tombstone keys.
+  for (size_t I = 0; I != N; ++I)
+    Keys.push_back(Rand() >> 2);
+  return Keys;
+}
+
+template <typename KeyT>
+static std::vector<KeyT> getKeys(size_t N, unsigned Seed) {
+  if constexpr (std::is_pointer_v<KeyT>)
+    return getPointerKeys(N, Seed);
+  else
+    return getIntegerKeys(N, Seed);
+}
+
+template <typename MapT> static void BM_Insert(benchmark::State &State) {
+  auto Keys = getKeys<typename MapT::key_type>(State.range(0), 1);
+  for (auto _ : State) {
+    MapT M;
+    for (const auto &Key : Keys)
+      M.try_emplace(Key, 0);
+    benchmark::DoNotOptimize(M);
+  }
+  State.SetItemsProcessed(State.iterations() * Keys.size());
+}
+
+/// Looks up keys of which the percentage State.range(1) are in the map.
+template <typename MapT> static void BM_Lookup(benchmark::State &State) {
+  size_t N = State.range(0);
+  auto Keys = getKeys<typename MapT::key_type>(N * 2, 2);
+  MapT M;
+  for (size_t I = 0; I != N; ++I)
+    M.try_emplace(Keys[I], I);
+  std::vector<typename MapT::key_type> Queries;
+  std::mt19937 Rand(3);
+  for (size_t I = 0; I != N; ++I) {
+    bool Hit = Rand() % 100 < unsigned(State.range(1));
+    Queries.push_back(Keys[Hit ? Rand() % N : N + Rand() % N]);
+  }
+  for (auto _ : State) {
+    for (const auto &Query : Queries)
+      benchmark::DoNotOptimize(M.find(Query));
+  }
+  State.SetItemsProcessed(State.iterations() * Queries.size());
+}
+
+/// Erases and reinserts keys in a map of constant size, as worklist and
+/// cache maps do.
+template <typename MapT> static void BM_EraseInsert(benchmark::State &State) {
+  size_t N = State.range(0);
+  auto Keys = getKeys<typename MapT::key_type>(N * 2, 4);
+  MapT M;
+  for (size_t I = 0; I != N; ++I)
+    M.try_emplace(Keys[I], I);
+  size_t Next = 0;
+  for (auto _ : State) {
+    M.erase(Keys[Next % (N * 2)]);
+    M.try_emplace(Keys[(Next + N) % (N * 2)], Next);
+    ++Next;
+  }
+  State.SetItemsProcessed(State.iterations());
+}
+
+template <typename MapT> static void BM_Iterate(benchmark::State &State) {
+  auto Keys = getKeys<typename MapT::key_type>(State.range(0), 5);
+  MapT M;
+  for (const auto &Key : Keys)
+    M.try_emplace(Key, 1);
+  for (auto _ : State) {
+    unsigned Sum = 0;
+    for (const auto &KV : M)
+      Sum += KV.second;
+    benchmark::DoNotOptimize(Sum);
+  }
+  State.SetItemsProcessed(State.iterations() * Keys.size());
+}
+
+#define MAP_BENCHMARKS(KeyT)                                                   \
+  BENCHMARK(BM_Insert<DenseMap<KeyT, unsigned>>)                               \
+      ->RangeMultiplier(16)                                                    \
+      ->Range(16, 1 << 20);                                                    \
+  BENCHMARK(BM_Insert<SwissTableMap<KeyT, unsigned>>)                          \
+      ->RangeMultiplier(16)                                                    \
+      ->Range(16, 1 << 20);                                                    \
+  BENCHMARK(BM_Lookup<DenseMap<KeyT, unsigned>>)                               \
+      ->ArgsProduct({{64, 4096, 1 << 20}, {0, 50, 100}});                      \
+  BENCHMARK(BM_Lookup<SwissTableMap<KeyT, unsigned>>)                          \
+      ->ArgsProduct({{64, 4096, 1 << 20}, {0, 50, 100}});                      \
+  BENCHMARK(BM_EraseInsert<DenseMap<KeyT, unsigned>>)                          \
+      ->Arg(64)                                                                \
+      ->Arg(4096)                                                              \
+      ->Arg(1 << 20);                                                          \
+  BENCHMARK(BM_EraseInsert<SwissTableMap<KeyT, unsigned>>)                     \
+      ->Arg(64)                                                                \
+      ->Arg(4096)                                                              \
+      ->Arg(1 << 20);                                                          \
+  BENCHMARK(BM_Iterate<DenseMap<KeyT, unsigned>>)->Arg(4096)->Arg(1 << 20);    \
+  BENCHMARK(BM_Iterate<SwissTableMap<KeyT, unsigned>>)->Arg(4096)->Arg(1 << 20)
+
+MAP_BENCHMARKS(uintptr_t *);
+MAP_BENCHMARKS(uint64_t);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,579 @@
+//===- llvm/ADT/SwissTableMap.h - Group probed hash table -------*- C++ -*-===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+///
+/// \file
+/// This file defines the SwissTableMap class, an open addressing hash map in
+/// the style of Abseil's "Swiss tables".
+///
+/// Next to its slots, the table keeps one control byte per slot, holding 7
+/// bits of the hash of a full slot or marking it as empty or deleted. Lookups
+/// probe groups of 16 control bytes at a time, comparing them all against the
+/// hash bits at once (with SSE2 where available), and only compare keys whose
+/// hash bits match. Unlike DenseMap, keys need no empty or tombstone values.
+///
+/// The interface follows DenseMap's, so that a hot DenseMap can be switched
+/// over by changing its type. Like DenseMap, insertions invalidate iterators
+/// and references, erasures invalidate only the erased element, and the
+/// iteration order is unspecified. Unlike DenseMap, iterator invalidation is
+/// not checked in debug builds.
+///
+//===----------------------------------------------------------------------===//
+
+#ifndef LLVM_ADT_SWISSTABLEMAP_H
+#define LLVM_ADT_SWISSTABLEMAP_H
+
+#include "llvm/ADT/DenseMapInfo.h"
+#include "llvm/ADT/bit.h"
+#include "llvm/Support/MemAlloc.h"
+#include "llvm/Support/type_traits.h"
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <initializer_list>
+#include <iterator>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+// MSVC does not define __SSE2__, but SSE2 is always available on x86-64 and
+// enabled by /arch:SSE2 and up on x86.
+#if defined(__SSE2__) || (defined(_M_X64) && !defined(_M_ARM64EC)) ||          \
+    (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define LLVM_SWISSTABLE_SSE2
+#include <emmintrin.h>
+#endif
+
+namespace llvm {
+
+namespace detail {
+
+/// Control byte values of slots without an element. Full slots hold 7 bits of
+/// the hash of their key, so they are never negative.
+enum : int8_t { SwissTableEmpty = -128, SwissTableDeleted = -2 };
+
+constexpr size_t SwissTableGroupWidth = 16;
+
+/// The control bytes of a group of slots, returning the slots that match a
+/// query as a bit mask.
+class SwissTableGroup {
+public:
+  explicit SwissTableGroup(const int8_t *Ctrl)
+#ifdef LLVM_SWISSTABLE_SSE2
+      : Ctrl(_mm_load_si128(reinterpret_cast<const __m128i *>(Ctrl))) {
+  }
+#else
+      : Ctrl(Ctrl) {
+  }
+#endif
+
+  /// Returns the full slots holding the hash bits \p H2.
+  uint32_t match(int8_t H2) const {
+#ifdef LLVM_SWISSTABLE_SSE2
+    return _mm_movemask_epi8(_mm_cmpeq_epi8(Ctrl, _mm_set1_epi8(H2)));
+#else
+    uint32_t Mask = 0;
+    for (size_t I = 0; I != SwissTableGroupWidth; ++I)
+      Mask |= uint32_t(Ctrl[I] == H2) << I;
+    return Mask;
+#endif
+  }
+
+  uint32_t matchEmpty() const { return match(SwissTableEmpty); }
+
+  uint32_t matchEmptyOrDeleted() const {
+#ifdef LLVM_SWISSTABLE_SSE2
+    return _mm_movemask_epi8(Ctrl);
+#else
+    uint32_t Mask = 0;
+    for (size_t I = 0; I != SwissTableGroupWidth; ++I)
+      Mask |= uint32_t(Ctrl[I] < 0) << I;
+    return Mask;
+#endif
+  }
+
+private:
+#ifdef LLVM_SWISSTABLE_SSE2
+  __m128i Ctrl;
+#else
+  const int8_t *Ctrl;
+#endif
+};
+
+} // end namespace detail
+
+template <typename KeyT, typename ValueT,
+          typename KeyInfoT = DenseMapInfo<KeyT>>
+class SwissTableMap {
+  template <typename T>
+  using const_arg_type_t = typename const_pointer_or_const_ref<T>::type;
+
+  template <bool IsConst> class IteratorImpl;
+
+public:
+  using size_type = unsigned;
+  using key_type = KeyT;
+  using mapped_type = ValueT;
+  using value_type = std::pair<KeyT, ValueT>;
+
+  using iterator = IteratorImpl<false>;
+  using const_iterator = IteratorImpl<true>;
+
+  SwissTableMap() = default;
+
+  /// Create a map that can hold \p NumElementsToReserve elements without
+  /// growing.
+  explicit SwissTableMap(unsigned NumElementsToReserve) {
+    reserve(NumElementsToReserve);
+  }
+
+  SwissTableMap(std::initializer_list<value_type> Vals) {
+    reserve(Vals.size());
+    insert(Vals.begin(), Vals.end());
+  }
+
+  SwissTableMap(const SwissTableMap &Other) { copyFrom(Other); }
+
+  SwissTableMap(SwissTableMap &&Other) { swap(Other); }
+
+  ~SwissTableMap() {
+    destroyAll();
+    deallocate();
+  }
+
+  SwissTableMap &operator=(const SwissTableMap &Other) {
+    if (&Other != this) {
+      destroyAll();
+      deallocate();
+      copyFrom(Other);
+    }
+    return *this;
+  }
+
+  SwissTableMap &operator=(SwissTableMap &&Other) {
+    if (&Other == this)
+      return *this;
+    destroyAll();
+    deallocate();
+    Ctrl = nullptr;
+    Slots = nullptr;
+    Capacity = NumElements = GrowthLeft = 0;
+    swap(Other);
+    return *this;
+  }
+
+  iterator begin() { return makeIterator(0, /*SkipEmpty=*/true); }
+  iterator end() { return makeIterator(Capacity, /*SkipEmpty=*/false); }
+  const_iterator begin() const {
+    return makeConstIterator(0, /*SkipEmpty=*/true);
+  }
+  const_iterator end() const {
+    return makeConstIterator(Capacity, /*SkipEmpty=*/false);
+  }
+
+  [[nodiscard]] bool empty() const { return NumElements == 0; }
+  size_type size() const { return NumElements; }
+
+  /// Grow the map so that it can hold \p NumEntries elements without growing
+  /// again.
+  void reserve(size_type NumEntries) {
+    size_t NewCapacity = getCapacityFor(NumEntries);
+    if (NewCapacity > Capacity)
+      resize(NewCapacity);
+  }
+
+  void clear() {
+    if (NumElements == 0 && GrowthLeft == getMaxLoad(Capacity))
+      return;
+    destroyAll();
+    if (Capacity)
+      std::memset(Ctrl, detail::SwissTableEmpty, Capacity);
+    NumElements = 0;
+    GrowthLeft = getMaxLoad(Capacity);
+  }
+
+  /// Return true if the specified key is in the map, false otherwise.
+  bool contains(const_arg_type_t<KeyT> Val) const {
+    return findSlot(Val, getHash(Val)) != Capacity;
+  }
+
+  /// Return 1 if the specified key is in the map, 0 otherwise.
+  size_type count(const_arg_type_t<KeyT> Val) const {
+    return contains(Val) ? 1 : 0;
+  }
+
+  iterator find(const_arg_type_t<KeyT> Val) {
+    return makeIterator(findSlot(Val, getHash(Val)), /*SkipEmpty=*/false);
+  }
+  const_iterator find(const_arg_type_t<KeyT> Val) const {
+    return makeConstIterator(findSlot(Val, getHash(Val)),
+                             /*SkipEmpty=*/false);
+  }
+
+  /// Return the entry for the specified key, or a default constructed value
+  /// if no such entry exists.
+  ValueT lookup(const_arg_type_t<KeyT> Val) const {
+    size_t Slot = findSlot(Val, getHash(Val));
+    if (Slot != Capacity)
+      return Slots[Slot].second;
+    return ValueT();
+  }
+
+  /// Return the entry for the specified key, asserting that it exists.
+  const ValueT &at(const_arg_type_t<KeyT> Val) const {
+    size_t Slot = findSlot(Val, getHash(Val));
+    assert(Slot != Capacity && "SwissTableMap::at failed due to a missing key");
+    return Slots[Slot].second;
+  }
+
+  // Inserts key,value pair into the map if the key isn't already in the map.
+  // If the key is already in the map, it returns false and doesn't update the
+  // value.
+  std::pair<iterator, bool> insert(const value_type &KV) {
+    return try_emplace(KV.first, KV.second);
+  }
+
+  std::pair<iterator, bool> insert(value_type &&KV) {
+    return try_emplace(std::move(KV.first), std::move(KV.second));
+  }
+
+  template <typename InputIt> void insert(InputIt I, InputIt E) {
+    for (; I != E; ++I)
+      insert(*I);
+  }
+
+  // Inserts key,value pair into the map if the key isn't already in the map.
+  // The value is constructed in-place if the key is not in the map, otherwise
+  // it is not moved.
+  template <typename... Ts>
+  std::pair<iterator, bool> try_emplace(KeyT &&Key, Ts &&...Args) {
+    auto [Slot, Inserted] = findOrPrepareInsert(Key);
+    if (Inserted)
+      ::new (&Slots[Slot])
+          value_type(std::piecewise_construct,
+                     std::forward_as_tuple(std::move(Key)),
+                     std::forward_as_tuple(std::forward<Ts>(Args)...));
+    return {makeIterator(Slot, /*SkipEmpty=*/false), Inserted};
+  }
+
+  template <typename... Ts>
+  std::pair<iterator, bool> try_emplace(const KeyT &Key, Ts &&...Args) {
+    auto [Slot, Inserted] = findOrPrepareInsert(Key);
+    if (Inserted)
+      ::new (&Slots[Slot])
+          value_type(std::piecewise_construct, std::forward_as_tuple(Key),
+                     std::forward_as_tuple(std::forward<Ts>(Args)...));
+    return {makeIterator(Slot, /*SkipEmpty=*/false), Inserted};
+  }
+
+  ValueT &operator[](const KeyT &Key) { return try_emplace(Key).first->second; }
+
+  ValueT &operator[](KeyT &&Key) {
+    return try_emplace(std::move(Key)).first->second;
+  }
+
+  bool erase(const KeyT &Val) {
+    size_t Slot = findSlot(Val, getHash(Val));
+    if (Slot == Capacity)
+      return false;
+    eraseSlot(Slot);
+    return true;
+  }
+
+  void erase(iterator I) { eraseSlot(I.Slot - Slots); }
+
+  void swap(SwissTableMap &RHS) {
+    std::swap(Ctrl, RHS.Ctrl);
+    std::swap(Slots, RHS.Slots);
+    std::swap(Capacity, RHS.Capacity);
+    std::swap(NumElements, RHS.NumElements);
+    std::swap(GrowthLeft, RHS.GrowthLeft);
+  }
+
+  /// Return the approximate size (in bytes) of the actual map.
+  /// This is just the raw memory used by the map and control bytes.
+  size_t getMemorySize() const {
+    return Capacity * (sizeof(value_type) + sizeof(int8_t));
+  }
+
+private:
+  template <bool IsConst> class IteratorImpl {
+    friend class SwissTableMap;
+    using SlotT = std::conditional_t<IsConst, const SwissTableMap::value_type,
+                                     SwissTableMap::value_type>;
+
+  public:
+    using difference_type = ptrdiff_t;
+    using value_type = SlotT;
+    using pointer = value_type *;
+    using reference = value_type &;
+    using iterator_category = std::forward_iterator_tag;
+
+    IteratorImpl() = default;
+
+    // Converting ctor from non-const iterators to const iterators.
+    template <bool IsConstSrc,
+              typename = std::enable_if_t<!IsConstSrc && IsConst>>
+    IteratorImpl(const IteratorImpl<IsConstSrc> &I)
+        : Ctrl(I.Ctrl), CtrlEnd(I.CtrlEnd), Slot(I.Slot) {}
+
+    reference operator*() const { return *Slot; }
+    pointer operator->() const { return Slot; }
+
+    friend bool operator==(const IteratorImpl &LHS, const IteratorImpl &RHS) {
+      return LHS.Slot == RHS.Slot;
+    }
+    friend bool operator!=(const IteratorImpl &LHS, const IteratorImpl &RHS) {
+      return !(LHS == RHS);
+    }
+
+    IteratorImpl &operator++() {
+      ++Ctrl;
+      ++Slot;
+      skipEmpty();
+      return *this;
+    }
+    IteratorImpl operator++(int) {
+      IteratorImpl Tmp = *this;
+      ++*this;
+      return Tmp;
+    }
+
+  private:
+    IteratorImpl(const int8_t *Ctrl, const int8_t *CtrlEnd, SlotT *Slot,
+                 bool SkipEmpty)
+        : Ctrl(Ctrl), CtrlEnd(CtrlEnd), Slot(Slot) {
+      if (SkipEmpty)
+        skipEmpty();
+    }
+
+    void skipEmpty() {
+      while (Ctrl != CtrlEnd && *Ctrl < 0) {
+        ++Ctrl;
+        ++Slot;
+      }
+    }
+
+    template <bool> friend class IteratorImpl;
+
+    const int8_t *Ctrl = nullptr;
+    const int8_t *CtrlEnd = nullptr;
+    SlotT *Slot = nullptr;
+  };
+
+  iterator makeIterator(size_t Slot, bool SkipEmpty) {
+    return iterator(Ctrl + Slot, Ctrl + Capacity, Slots + Slot, SkipEmpty);
+  }
+  const_iterator makeConstIterator(size_t Slot, bool SkipEmpty) const {
+    return const_iterator(Ctrl + Slot, Ctrl + Capacity, Slots + Slot,
+                          SkipEmpty);
+  }
+
+  /// Returns a hash of \p Val mixed so that both its low bits, which select
+  /// the first group to probe, and its high bits, which are kept in the
+  /// control bytes, depend on all bits of the key's hash.
+  template <typename LookupKeyT>
+  static uint64_t getHash(const LookupKeyT &Val) {
+    uint64_t H = uint64_t(KeyInfoT::getHashValue(Val)) * 0x9E3779B97F4A7C15ULL;
+    return H ^ (H >> 32);
+  }
+  static int8_t getH2(uint64_t Hash) { return static_cast<int8_t>(Hash >> 57); }
+
+  /// Tables are filled to at most 7/8 of their capacity.
+  static size_t getMaxLoad(size_t Capacity) { return Capacity - Capacity / 8; }
+
+  static size_t getCapacityFor(size_t NumEntries) {
+    if (NumEntries == 0)
+      return 0;
+    size_t Capacity = detail::SwissTableGroupWidth;
+    while (getMaxLoad(Capacity) < NumEntries)
+      Capacity *= 2;
+    return Capacity;
+  }
+
+  /// Calls \p Fn on the start of each group in the probe sequence of
+  /// \p Hash until it returns true. The triangular sequence visits every
+  /// group, as the number of groups is a power of two.
+  template <typename FnT> void probe(uint64_t Hash, FnT Fn) const {
+    size_t GroupMask = Capacity / detail::SwissTableGroupWidth - 1;
+    size_t Group = Hash & GroupMask;
+    for (size_t Step = 1;; ++Step) {
+      if (Fn(Group * detail::SwissTableGroupWidth))
+        return;
+      Group = (Group + Step) & GroupMask;
+    }
+  }
+
+  /// Returns the slot holding \p Val, whose hash is \p Hash, or Capacity if
+  /// there is none.
+  template <typename LookupKeyT>
+  size_t findSlot(const LookupKeyT &Val, uint64_t Hash) const {
+    if (NumElements == 0)
+      return Capacity;
+    int8_t H2 = getH2(Hash);
+    size_t Result = Capacity;
+    probe(Hash, [&](size_t GroupStart) {
+      detail::SwissTableGroup Group(Ctrl + GroupStart);
+      for (uint32_t Mask = Group.match(H2); Mask; Mask &= Mask - 1) {
+        size_t Slot = GroupStart + llvm::countr_zero(Mask);
+        if (KeyInfoT::isEqual(Val, Slots[Slot].first)) {
+          Result = Slot;
+          return true;
+        }
+      }
+      // Insertions fill the first group with room in the probe sequence, so
+      // the key cannot be in a later group.
+      return Group.matchEmpty() != 0;
+    });
+    return Result;
+  }
+
+  /// Returns the first empty or deleted slot in the probe sequence of
+  /// \p Hash.
+  size_t findFirstNonFull(uint64_t Hash) const {
+    size_t Result = 0;
+    probe(Hash, [&](size_t GroupStart) {
+      uint32_t Mask = detail::SwissTableGroup(Ctrl + GroupStart)
+                          .matchEmptyOrDeleted();
+      if (!Mask)
+        return false;
+      Result = GroupStart + llvm::countr_zero(Mask);
+      return true;
+    });
+    return Result;
+  }
+
+  /// Returns the slot holding \p Val and false if there is one. Otherwise
+  /// marks a slot for \p Val as full and returns it and true; the caller
+  /// constructs the element in it.
+  std::pair<size_t, bool> findOrPrepareInsert(const KeyT &Val) {
+    uint64_t Hash = getHash(Val);
+    size_t Slot = findSlot(Val, Hash);
+    if (Slot != Capacity)
+      return {Slot, false};
+
+    if (Capacity == 0)
+      resize(detail::SwissTableGroupWidth);
+    Slot = findFirstNonFull(Hash);
+    // Reusing a deleted slot does not use up room for growth.
+    if (GrowthLeft == 0 && Ctrl[Slot] != detail::SwissTableDeleted) {
+      // Drop the deleted slots if they take up most of the room, otherwise
+      // grow.
+      resize(NumElements < getMaxLoad(Capacity) / 2 ? Capacity
+                                                    : Capacity * 2);
+      Slot = findFirstNonFull(Hash);
+    }
+    if (Ctrl[Slot] == detail::SwissTableEmpty)
+      --GrowthLeft;
+    Ctrl[Slot] = getH2(Hash);
+    ++NumElements;
+    return {Slot, true};
+  }
+
+  void eraseSlot(size_t Slot) {
+    assert(Slot < Capacity && Ctrl[Slot] >= 0 && "erasing an empty slot");
+    Slots[Slot].~value_type();
+    --NumElements;
+    // A lookup only continues past a group without empty slots, so if the
+    // group already has one, no lookup continues past it and the slot can
+    // become empty again.
+    size_t GroupStart = Slot & ~(detail::SwissTableGroupWidth - 1);
+    if (detail::SwissTableGroup(Ctrl + GroupStart).matchEmpty()) {
+      Ctrl[Slot] = detail::SwissTableEmpty;
+      ++GrowthLeft;
+    } else {
+      Ctrl[Slot] = detail::SwissTableDeleted;
+    }
+  }
+
+  void allocate(size_t NewCapacity) {
+    Capacity = NewCapacity;
+    GrowthLeft = getMaxLoad(Capacity);
+    if (Capacity == 0) {
+      Ctrl = nullptr;
+      Slots = nullptr;
+      return;
+    }
+    Ctrl = static_cast<int8_t *>(
+        allocate_buffer(Capacity, detail::SwissTableGroupWidth));
+    std::memset(Ctrl, detail::SwissTableEmpty, Capacity);
+    Slots = static_cast<value_type *>(
+        allocate_buffer(sizeof(value_type) * Capacity, alignof(value_type)));
+  }
+
+  void deallocate() {
+    if (Capacity == 0)
+      return;
+    deallocate_buffer(Ctrl, Capacity, detail::SwissTableGroupWidth);
+    deallocate_buffer(Slots, sizeof(value_type) * Capacity,
+                      alignof(value_type));
+  }
+
+  void destroyAll() {
+    if constexpr (!std::is_trivially_destructible_v<value_type>)
+      for (size_t I = 0; I != Capacity; ++I)
+        if (Ctrl[I] >= 0)
+          Slots[I].~value_type();
+  }
+
+  /// Moves the elements into a new table of \p NewCapacity slots.
+  void resize(size_t NewCapacity) {
+    int8_t *OldCtrl = Ctrl;
+    value_type *OldSlots = Slots;
+    size_t OldCapacity = Capacity;
+    allocate(NewCapacity);
+    for (size_t I = 0; I != OldCapacity; ++I) {
+      if (OldCtrl[I] < 0)
+        continue;
+      uint64_t Hash = getHash(OldSlots[I].first);
+      size_t Slot = findFirstNonFull(Hash);
+      Ctrl[Slot] = getH2(Hash);
+      ::new (&Slots[Slot]) value_type(std::move(OldSlots[I]));
+      OldSlots[I].~value_type();
+    }
+    GrowthLeft -= NumElements;
+    if (OldCapacity) {
+      deallocate_buffer(OldCtrl, OldCapacity, detail::SwissTableGroupWidth);
+      deallocate_buffer(OldSlots, sizeof(value_type) * OldCapacity,
+                        alignof(value_type));
+    }
+  }
+
+  /// Copies the elements and the layout of \p Other into this empty map.
+  void copyFrom(const SwissTableMap &Other) {
+    allocate(Other.Capacity);
+    NumElements = Other.NumElements;
+    GrowthLeft = Other.GrowthLeft;
+    if (Capacity == 0)
+      return;
+    std::memcpy(Ctrl, Other.Ctrl, Capacity);
+    for (size_t I = 0; I != Capacity; ++I)
+      if (Ctrl[I] >= 0)
+        ::new (&Slots[I]) value_type(Other.Slots[I]);
+  }
+
+  int8_t *Ctrl = nullptr;
+  value_type *Slots = nullptr;
+  size_t Capacity = 0;
+  size_t NumElements = 0;
+  /// The number of elements that can still be added to empty slots before
+  /// the table is rehashed.
+  size_t GrowthLeft = 0;
+};
+
+template <typename KeyT, typename ValueT, typename KeyInfoT>
+inline size_t
+capacity_in_bytes(const SwissTableMap<KeyT, ValueT, KeyInfoT> &X) {
+  return X.getMemorySize();
+}
+
+} // end namespace llvm
+
+#undef LLVM_SWISSTABLE_SSE2
+
+#endif // LLVM_ADT_SWISSTABLEMAP_H
@@ -1013,6 +1013,20 @@ private:
 /// disambiguate memory accesses, or they may want the nearest dominating
 /// may-aliasing MemoryDef for a call or a store. This API enables a
 /// standardized interface to getting and using that info.
+///
+/// Results are cached on the accesses themselves: the caching walker records
+/// the clobber it finds with MemoryUseOrDef::setOptimized, so repeated queries
+/// for the same access are answered without any alias queries until
+/// MemorySSAUpdater resets it. The BatchAAResults passed in only caches the
+/// alias queries made during walks, and callers decide how long it lives. A
+/// pass may keep one across many queries, as DeadStoreElimination does, but
+/// must then make sure its IR changes cannot invalidate cached results:
+/// BatchAAResults is keyed by Value pointers, and a new instruction allocated
+/// at the address of an erased one would inherit its results. Passes that
+/// freely rewrite IR between queries, such as LICM, therefore use one per query
+/// and bound the number of walks instead (see -licm-mssa-optimization-cap and
+/// -memssa-check-limit), falling back to the unoptimized defining access once
+/// the budget is spent.
 class MemorySSAWalker {
 public:
   MemorySSAWalker(MemorySSA *);
@@ -101,10 +101,9 @@ public:
   static bool allowExtraAnalysis(const Function &F, StringRef PassName) {
     return allowExtraAnalysis(F.getContext(), PassName);
   }
-  static bool allowExtraAnalysis(LLVMContext &Ctx, StringRef PassName) {
-    return Ctx.getLLVMRemarkStreamer() ||
-           Ctx.getDiagHandlerPtr()->isAnyRemarkEnabled(PassName);
-  }
+  /// Remarks of passes that the optimization record's pass filter rejects
+  /// are not considered enabled for the record.
+  static bool allowExtraAnalysis(LLVMContext &Ctx, StringRef PassName);
 
 private:
   const Function *F;
@@ -306,6 +306,18 @@ public:
     }
   }
 
+  /// Append \p Words, a whole number of 32-bit words produced by another
+  /// BitstreamWriter, at the current position, which must be 32-bit aligned.
+  /// The caller is responsible for the spliced bits being valid here, e.g. by
+  /// only splicing complete subblocks encoded with the same abbrev ID width
+  /// and BLOCKINFO.
+  void spliceWords(StringRef Words) {
+    assert(CurBit == 0 && "Splicing at an unaligned position");
+    assert((Words.size() & 3) == 0 && "Spliced data is not whole words");
+    Buffer.append(Words.begin(), Words.end());
+    FlushToFile();
+  }
+
   void EmitVBR(uint32_t Val, unsigned NumBits) {
     assert(NumBits <= 32 && "Too many bits to emit!");
     uint32_t Threshold = 1U << (NumBits-1);
@@ -74,6 +74,14 @@ enum {
 ///     extremely long patterns which need more than 255 temporaries.
 ///     We could just use 2 bytes everytime, but then some targets like
 ///     X86/AMDGPU that have no need for it will pay the price all the time.
+///   - Rules are grouped by root opcode and then by type, so the table starts
+///     with a GIM_SwitchOpcode that jumps straight to the rules for the
+///     instruction being selected. Each opcode in effect has its own entry
+///     point, and only the rules that share a prefix are tried in sequence.
+///   - The interpreter dispatches with a plain switch rather than
+///     computed-goto threading. That extension isn't available on every host
+///     compiler LLVM supports, and a dense switch over a byte already lowers
+///     to a single indirect jump.
 enum {
   /// Begin a try-block to attempt a match and jump to OnFail if it is
   /// unsuccessful.
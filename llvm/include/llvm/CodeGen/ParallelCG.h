@@ -20,10 +20,20 @@
 namespace llvm {
 
 template <typename T> class ArrayRef;
+class LLVMContext;
 class Module;
 class TargetMachine;
 class raw_pwrite_stream;
 
+namespace legacy {
+class PassManager;
+} // namespace legacy
+
+/// Called once per partition with the context the partition is compiled in
+/// and its code generation pass manager, before the target adds its passes.
+using PartitionSetupFn =
+    std::function<void(LLVMContext &, legacy::PassManager &)>;
+
 /// Split M into OSs.size() partitions, and generate code for each. Takes a
 /// factory function for the TargetMachine TMFactory. Writes OSs.size() output
 /// files to the output streams in OSs. The resulting output files if linked
@@ -32,12 +42,16 @@ class raw_pwrite_stream;
 ///
 /// Writes bitcode for individual partitions into output streams in BCOSs, if
 /// BCOSs is not empty.
+///
+/// If PartitionSetup is set, it may install a diagnostic handler on each
+/// partition's context or add analysis passes such as TargetLibraryInfo. When
+/// more than one partition is used it runs concurrently on worker threads.
 void splitCodeGen(
     Module &M, ArrayRef<raw_pwrite_stream *> OSs,
     ArrayRef<llvm::raw_pwrite_stream *> BCOSs,
     const std::function<std::unique_ptr<TargetMachine>()> &TMFactory,
     CodeGenFileType FileType = CodeGenFileType::ObjectFile,
-    bool PreserveLocals = false);
+    bool PreserveLocals = false, const PartitionSetupFn &PartitionSetup = {});
 
 } // namespace llvm
 
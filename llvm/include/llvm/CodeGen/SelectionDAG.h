@@ -478,6 +478,11 @@ public:
   /// SelectionDAG ready to process a new block.
   void clear();
 
+  /// Make room in the CSE map for about \p NumNodes nodes up front, so that
+  /// building a large DAG doesn't repeatedly grow it and recompute the
+  /// profile of every node already in it.
+  void reserveCSEMap(unsigned NumNodes) { CSEMap.reserve(NumNodes); }
+
   MachineFunction &getMachineFunction() const { return *MF; }
   const Pass *getPass() const { return SDAGISelPass; }
   MachineFunctionAnalysisManager *getMFAM() { return MFAM; }
@@ -229,6 +229,13 @@ public:
   virtual void overrideSchedPolicy(MachineSchedPolicy &Policy,
                                    unsigned NumRegionInstrs) const {}
 
+  /// Number of memory operations the scheduling DAG builder tracks in its
+  /// alias maps before it folds the oldest half behind a barrier chain. This
+  /// bounds the quadratic cost of memory dependencies in huge regions, such
+  /// as unrolled vector kernels, at the price of precision. Subtargets with
+  /// many independent loads and stores per region may want to raise it.
+  virtual unsigned getSchedDAGMemMapsLimit() const { return 1000; }
+
   // Perform target-specific adjustments to the latency of a schedule
   // dependency.
   // If a pair of operands is associated with the schedule dependency, DefOpIdx
@@ -207,6 +207,9 @@ struct DIDumpOptions {
   bool DumpNonSkeleton = false;
   bool ShowAggregateErrors = false;
   std::string JsonErrSummaryFile;
+  // Threads to parse units on before verifying (0 means one per hardware
+  // thread). The checks themselves always run serially.
+  unsigned VerifyThreads = 1;
   std::function<llvm::StringRef(uint64_t DwarfRegNum, bool IsEH)>
       GetNameForDWARFReg;
 
@@ -235,7 +238,7 @@ struct DIDumpOptions {
 
 class DIContext {
 public:
-  enum DIContextKind { CK_DWARF, CK_PDB, CK_BTF };
+  enum DIContextKind { CK_DWARF, CK_PDB, CK_BTF, CK_GSYM };
 
   DIContext(DIContextKind K) : Kind(K) {}
   virtual ~DIContext() = default;
@@ -41,6 +41,7 @@ class DWARFDebugNames;
 class DWARFGdbIndex;
 class DWARFTypeUnit;
 class DWARFUnitIndex;
+class ThreadPoolInterface;
 
 /// DWARFContext
 /// This data structure is the top level entity that deals with dwarf debug
@@ -82,6 +83,8 @@ public:
         getLineTableForUnit(DWARFUnit *U,
                             function_ref<void(Error)> RecoverableErrHandler) = 0;
     virtual void clearLineTableForUnit(DWARFUnit *U) = 0;
+    virtual void prefetchLineTables(ArrayRef<DWARFUnit *> Units,
+                                    ThreadPoolInterface &Pool) = 0;
     virtual Expected<const DWARFDebugFrame *> getDebugFrame() = 0;
     virtual Expected<const DWARFDebugFrame *> getEHFrame() = 0;
     virtual const DWARFDebugMacro *getDebugMacinfo() = 0;
@@ -350,6 +353,15 @@ public:
   // management purpose. When it's referred to again, it'll be re-populated.
   void clearLineTableForUnit(DWARFUnit *U);
 
+  /// Extract the DIEs and decode the line tables of all normal units up
+  /// front, on up to \p NumThreads threads (0 means one per hardware thread).
+  /// Later queries for those units are answered from the parsed data. DIE
+  /// errors go to the usual handler, in unit order, after all units are
+  /// parsed. Line tables that fail to parse are not kept; they are parsed
+  /// again, and their errors reported, when first queried.
+  /// Must not run concurrently with any other use of this context.
+  void prefetchUnits(unsigned NumThreads = 0);
+
   DataExtractor getStringExtractor() const {
     return DataExtractor(DObj->getStrSection(), false, 0);
   }
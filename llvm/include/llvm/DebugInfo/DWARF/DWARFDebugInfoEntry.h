@@ -19,6 +19,9 @@ class DWARFUnit;
 class DWARFDataExtractor;
 
 /// DWARFDebugInfoEntry - A DIE with only the minimum required data.
+///
+/// Units keep one of these per DIE for as long as their DIEs are extracted,
+/// so keep the layout free of padding and avoid adding members.
 class DWARFDebugInfoEntry {
   /// Offset within the .debug_info of the start of this entry.
   uint64_t Offset = 0;
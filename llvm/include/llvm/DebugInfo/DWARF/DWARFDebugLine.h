@@ -314,6 +314,12 @@ public:
                       function_ref<void(Error)> RecoverableErrorHandler);
   void clearLineTable(uint64_t Offset);
 
+  /// Return the cache entry for the line table at \p Offset, inserting an
+  /// empty one if there is none. The second member is true if the entry was
+  /// inserted and still has to be parsed. Lets callers parse several tables
+  /// concurrently, each into its own entry, without touching the cache.
+  std::pair<LineTable *, bool> getOrInsertLineTable(uint64_t Offset);
+
   /// Helper to allow for parsing of an entire .debug_line section in sequence.
   class SectionParser {
   public:
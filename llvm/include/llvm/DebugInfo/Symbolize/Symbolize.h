@@ -36,6 +36,10 @@ class ObjectFile;
 struct SectionedAddress;
 } // namespace object
 
+namespace gsym {
+class GsymReader;
+} // namespace gsym
+
 namespace symbolize {
 
 class SymbolizableModule;
@@ -62,6 +66,8 @@ public:
     std::string FallbackDebugPath;
     std::string DWPName;
     std::vector<std::string> DebugFileDirectory;
+    std::vector<std::string> GsymFileDirectory;
+    bool DisableGsym = false;
     size_t MaxCacheSize =
         sizeof(size_t) == 4
             ? 512 * 1024 * 1024 /* 512 MiB */
@@ -170,6 +176,12 @@ private:
   createModuleInfo(const ObjectFile *Obj, std::unique_ptr<DIContext> Context,
                    StringRef ModuleName);
 
+  /// Looks for a GSYM file for \p BinaryName, first next to the binary and
+  /// then in each of the GSYM file directories, and returns a reader for the
+  /// first one whose UUID matches \p Obj. Returns null if there is none.
+  std::unique_ptr<gsym::GsymReader> findGsymFile(const std::string &BinaryName,
+                                                 const ObjectFile &Obj);
+
   ObjectFile *lookUpDsymFile(const std::string &Path,
                              const MachOObjectFile *ExeObj,
                              const std::string &ArchName);
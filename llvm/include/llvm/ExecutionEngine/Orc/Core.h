@@ -27,10 +27,13 @@
 #include "llvm/Support/Debug.h"
 #include "llvm/Support/ExtensibleRTTI.h"
 
+#include <array>
 #include <atomic>
 #include <deque>
 #include <future>
 #include <memory>
+#include <optional>
+#include <shared_mutex>
 #include <vector>
 
 namespace llvm {
@@ -1294,6 +1297,46 @@ private:
 
   using SymbolTable = DenseMap<SymbolStringPtr, SymbolTableEntry>;
 
+  /// A copy of the Ready entries of the symbol table that can be read without
+  /// the session lock. It is only written with the session lock held, and is
+  /// sharded so that concurrent readers rarely touch the same lock.
+  class ReadySymbolTable {
+  public:
+    void add(const SymbolStringPtr &Name, ExecutorSymbolDef Sym) {
+      Shard &S = getShard(Name);
+      std::unique_lock<std::shared_mutex> Lock(S.Mutex);
+      S.Symbols[Name] = Sym;
+    }
+
+    void remove(const SymbolStringPtr &Name) {
+      Shard &S = getShard(Name);
+      std::unique_lock<std::shared_mutex> Lock(S.Mutex);
+      S.Symbols.erase(Name);
+    }
+
+    std::optional<ExecutorSymbolDef> find(const SymbolStringPtr &Name) {
+      Shard &S = getShard(Name);
+      std::shared_lock<std::shared_mutex> Lock(S.Mutex);
+      auto I = S.Symbols.find(Name);
+      if (I == S.Symbols.end())
+        return std::nullopt;
+      return I->second;
+    }
+
+  private:
+    struct alignas(64) Shard {
+      std::shared_mutex Mutex;
+      DenseMap<SymbolStringPtr, ExecutorSymbolDef> Symbols;
+    };
+
+    Shard &getShard(const SymbolStringPtr &Name) {
+      return Shards[DenseMapInfo<SymbolStringPtr>::getHashValue(Name) %
+                    Shards.size()];
+    }
+
+    std::array<Shard, 16> Shards;
+  };
+
   JITDylib(ExecutionSession &ES, std::string Name);
 
   std::pair<AsynchronousSymbolQuerySet, std::shared_ptr<SymbolDependenceMap>>
@@ -1341,6 +1384,7 @@ private:
   enum { Open, Closing, Closed } State = Open;
   std::mutex GeneratorsMutex;
   SymbolTable Symbols;
+  ReadySymbolTable ReadySymbols;
   UnmaterializedInfosMap UnmaterializedInfos;
   MaterializingInfosMap MaterializingInfos;
   std::vector<std::shared_ptr<DefinitionGenerator>> DefGenerators;
@@ -146,6 +146,7 @@ private:
                       std::unique_ptr<ABISupport> ABI);
 
   Expected<IndirectStubInfoVector> getIndirectStubs(unsigned NumStubs);
+  void releaseIndirectStubs(ArrayRef<IndirectStubInfo> Stubs);
 
   std::mutex EPCUIMutex;
   ExecutorProcessControl &EPC;
@@ -13,6 +13,7 @@
 #ifndef LLVM_EXECUTIONENGINE_ORC_INDIRECTIONUTILS_H
 #define LLVM_EXECUTIONENGINE_ORC_INDIRECTIONUTILS_H
 
+#include "llvm/ADT/ArrayRef.h"
 #include "llvm/ADT/StringMap.h"
 #include "llvm/ADT/StringRef.h"
 #include "llvm/ExecutionEngine/JITSymbol.h"
@@ -305,6 +306,10 @@ public:
   /// Change the value of the implementation pointer for the stub.
   virtual Error updatePointer(StringRef Name, ExecutorAddr NewAddr) = 0;
 
+  /// Release the stubs with the given names so that their memory can be
+  ///        reused by later stubs. The stubs must no longer be called.
+  virtual void releaseStubs(ArrayRef<StringRef> Names) = 0;
+
 private:
   virtual void anchor();
 };
@@ -432,6 +437,17 @@ public:
     return Error::success();
   }
 
+  void releaseStubs(ArrayRef<StringRef> Names) override {
+    std::lock_guard<std::mutex> Lock(StubsMutex);
+    for (StringRef Name : Names) {
+      auto I = StubIndexes.find(Name);
+      if (I == StubIndexes.end())
+        continue;
+      FreeStubs.push_back(I->second.first);
+      StubIndexes.erase(I);
+    }
+  }
+
 private:
   Error reserveStubs(unsigned NumStubs) {
     if (NumStubs <= FreeStubs.size())
@@ -0,0 +1,82 @@
+//===- PersistentObjectCache.h - On-disk cache of JIT'd objects -*- C++ -*-===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+//
+// An ObjectCache that keeps compiled objects in a directory, so that they can
+// be reused by later processes JITing the same modules.
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef LLVM_EXECUTIONENGINE_ORC_PERSISTENTOBJECTCACHE_H
+#define LLVM_EXECUTIONENGINE_ORC_PERSISTENTOBJECTCACHE_H
+
+#include "llvm/ADT/DenseMap.h"
+#include "llvm/ExecutionEngine/ObjectCache.h"
+#include "llvm/Support/CachePruning.h"
+#include "llvm/Support/Error.h"
+#include <memory>
+#include <mutex>
+#include <string>
+
+namespace llvm {
+namespace orc {
+
+class JITTargetMachineBuilder;
+
+/// An ObjectCache backed by a directory.
+///
+/// Entries are keyed by a hash of the module's bitcode together with the
+/// target triple, CPU, features, optimization level, relocation model, code
+/// model and code generation affecting TargetOptions of the
+/// JITTargetMachineBuilder the cache was created for, so one directory can be
+/// shared by differently configured JITs. Hits are returned as memory mapped
+/// files.
+///
+/// Entries are named so that pruneCache() can manage them; the pruning
+/// policy is applied when the cache is created and by prune(), which also
+/// removes temporary files left behind by processes that died while storing
+/// an entry.
+///
+/// The cache can be shared by the compile threads of a single JIT (e.g. via
+/// ConcurrentIRCompiler) and by concurrent processes.
+class PersistentObjectCache : public ObjectCache {
+public:
+  /// Creates a cache in \p CacheDir, creating the directory if needed, for
+  /// code compiled with the configuration in \p JTMB.
+  static Expected<std::unique_ptr<PersistentObjectCache>>
+  Create(StringRef CacheDir, const JITTargetMachineBuilder &JTMB,
+         CachePruningPolicy Policy = CachePruningPolicy());
+
+  void notifyObjectCompiled(const Module *M, MemoryBufferRef Obj) override;
+  std::unique_ptr<MemoryBuffer> getObject(const Module *M) override;
+
+  /// Applies the pruning policy to the cache directory. Returns false if the
+  /// pruning failed.
+  bool prune();
+
+private:
+  PersistentObjectCache(std::string CacheDir, std::string ConfigKey,
+                        CachePruningPolicy Policy)
+      : CacheDir(std::move(CacheDir)), ConfigKey(std::move(ConfigKey)),
+        Policy(std::move(Policy)) {}
+
+  std::string getEntryPath(const Module &M);
+
+  std::string CacheDir;
+  std::string ConfigKey;
+  CachePruningPolicy Policy;
+
+  /// Compilation changes the module, so the path computed on the lookup
+  /// miss is kept for storing the object.
+  std::mutex PendingMutex;
+  DenseMap<const Module *, std::string> PendingPaths;
+};
+
+} // end namespace orc
+} // end namespace llvm
+
+#endif // LLVM_EXECUTIONENGINE_ORC_PERSISTENTOBJECTCACHE_H
@@ -0,0 +1,125 @@
+//===- ReOptimizeLayer.h - Recompile hot modules ----------------*- C++ -*-===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+//
+// Tiered compilation for in-process JITs: modules are first emitted as given
+// (typically compiled with a fast, unoptimized pipeline) behind indirect
+// stubs, and are recompiled with a client supplied optimization once their
+// functions have been called often enough.
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef LLVM_EXECUTIONENGINE_ORC_REOPTIMIZELAYER_H
+#define LLVM_EXECUTIONENGINE_ORC_REOPTIMIZELAYER_H
+
+#include "llvm/ADT/DenseMap.h"
+#include "llvm/ADT/FunctionExtras.h"
+#include "llvm/ExecutionEngine/Orc/IndirectionUtils.h"
+#include "llvm/ExecutionEngine/Orc/Layer.h"
+#include "llvm/ExecutionEngine/Orc/ThreadSafeModule.h"
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace llvm {
+namespace orc {
+
+/// A layer that emits each module twice if it turns out to be hot.
+///
+/// On emit, the externally visible function definitions of the module are
+/// renamed and their original symbols are defined as stubs in the
+/// IndirectStubsManager of the target JITDylib, which is created by the
+/// supplied builder on first use. Calls between functions of the module are
+/// routed through the stubs too. Each renamed function is given an entry
+/// counter, shared by the whole module, and the module is handed to the base
+/// layer unchanged otherwise.
+///
+/// The optimized definitions are a lazy MaterializationUnit in the same
+/// ResourceTracker as the module. When the counter reaches the threshold, a
+/// task is dispatched on the ExecutionSession that looks them up, which
+/// clones the original module, runs the Optimize function on it and emits it
+/// through the base layer under fresh names; the stubs are then pointed at
+/// the new definitions. Callers that are already running in the first tier
+/// code finish there; there is no on-stack replacement. Removing the tracker
+/// removes both tiers and releases the stubs.
+///
+/// The counter calls straight into this layer, so JIT'd code must run in
+/// the same process and the layer must outlive it. Modules that contain
+/// aliases or ifuncs are passed to the base layer as they are.
+class ReOptimizeLayer : public IRLayer, private ResourceManager {
+public:
+  /// Optimizes the module in place. Called at most once per emitted module,
+  /// from a task dispatched on the ExecutionSession.
+  using OptimizeFunction = unique_function<Error(ThreadSafeModule &TSM)>;
+
+  /// Builder for IndirectStubsManagers.
+  using IndirectStubsManagerBuilder =
+      std::function<std::unique_ptr<IndirectStubsManager>()>;
+
+  ReOptimizeLayer(ExecutionSession &ES, IRLayer &BaseLayer,
+                  IndirectStubsManagerBuilder BuildIndirectStubsManager,
+                  OptimizeFunction Optimize,
+                  uint64_t CallCountThreshold = 1000);
+  ~ReOptimizeLayer();
+
+  void emit(std::unique_ptr<MaterializationResponsibility> R,
+            ThreadSafeModule TSM) override;
+
+  /// Returns the number of modules that have been recompiled so far.
+  size_t getNumReOptimized() const { return NumReOptimized; }
+
+private:
+  class OptimizedModuleMaterializationUnit;
+
+  /// A function redirected through a stub, by mangled name.
+  struct Redirection {
+    std::string IRName;
+    SymbolStringPtr Stub;
+    SymbolStringPtr FirstTier;
+    SymbolStringPtr SecondTier;
+    /// Known once the first tier has been resolved.
+    ExecutorAddr FirstTierAddr;
+  };
+
+  struct Unit {
+    JITDylib *JD = nullptr;
+    /// The key of the module's tracker, which owns both tiers.
+    ResourceKey Key = 0;
+    std::vector<Redirection> Redirected;
+  };
+
+  IndirectStubsManager &getStubsManager(JITDylib &JD);
+
+  static void handleCallCountReached(void *Layer, uint64_t UnitID);
+  void reoptimize(uint64_t UnitID);
+  void emitOptimized(std::unique_ptr<MaterializationResponsibility> R,
+                     uint64_t UnitID, ThreadSafeModule TSM);
+
+  Error handleRemoveResources(JITDylib &JD, ResourceKey K) override;
+  void handleTransferResources(JITDylib &JD, ResourceKey DstK,
+                               ResourceKey SrcK) override;
+
+  IRLayer &BaseLayer;
+  IndirectStubsManagerBuilder BuildIndirectStubsManager;
+  OptimizeFunction Optimize;
+  uint64_t CallCountThreshold;
+
+  std::mutex UnitsMutex;
+  DenseMap<const JITDylib *, std::unique_ptr<IndirectStubsManager>> DylibStubs;
+  DenseMap<uint64_t, std::unique_ptr<Unit>> Units;
+  uint64_t NextUnitID = 0;
+  std::atomic<size_t> NumReOptimized = 0;
+};
+
+} // end namespace orc
+} // end namespace llvm
+
+#endif // LLVM_EXECUTIONENGINE_ORC_REOPTIMIZELAYER_H
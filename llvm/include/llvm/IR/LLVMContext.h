@@ -149,6 +149,16 @@ public:
   /// especially in release mode.
   void setDiscardValueNames(bool Discard);
 
+  /// Whether scalar ConstantInts, ConstantFPs and IntegerTypes of this context
+  /// may be created concurrently from several threads. Off by default. All
+  /// other IR construction still requires external synchronization.
+  bool hasConcurrentConstantUniquing() const;
+
+  /// Switch the context to lock-striped uniquing of scalar constants. This must
+  /// be called before the context is used from more than one thread and cannot
+  /// be undone.
+  void enableConcurrentConstantUniquing();
+
   /// Whether there is a string map for uniquing debug info
   /// identifiers across the context.  Off by default.
   bool isODRUniquingDebugTypes() const;
@@ -895,6 +895,12 @@ public:
   /// Dump the module to stderr (for debugging).
   void dump() const;
 
+  /// Print an approximate breakdown of the memory held by the values of this
+  /// module (globals, arguments, basic blocks, instructions and their operands,
+  /// and value names), grouped by kind. Constants and metadata are owned by
+  /// the LLVMContext and are not included.
+  void printMemoryStats(raw_ostream &OS) const;
+
   /// This function causes all the subinstructions to "let go" of all references
   /// that they are maintaining.  This allows one to 'delete' a whole class at
   /// a time, even though there may be circular references... first all
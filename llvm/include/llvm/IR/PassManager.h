@@ -888,6 +888,12 @@ using ModuleAnalysisManagerFunctionProxy =
 /// Note that although function passes can access module analyses, module
 /// analyses are not invalidated while the function passes are running, so they
 /// may be stale.  Function analyses will not be stale.
+///
+/// Functions are currently visited one at a time, in module order. Running
+/// them concurrently would additionally require thread-safe constant and type
+/// uniquing in LLVMContext, use-list updates on shared globals and constants,
+/// a thread-safe FunctionAnalysisManager cache, and ordered pass
+/// instrumentation callbacks; none of these hold today.
 class ModuleToFunctionPassAdaptor
     : public PassInfoMixin<ModuleToFunctionPassAdaptor> {
 public:
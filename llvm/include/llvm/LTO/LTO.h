@@ -73,6 +73,12 @@ void computeLTOCacheKey(
     const std::set<GlobalValue::GUID> &CfiFunctionDefs = {},
     const std::set<GlobalValue::GUID> &CfiFunctionDecls = {});
 
+/// Computes a unique hash for a regular LTO code generation partition, from
+/// the parts of \p Conf that affect code generation and the bitcode of the
+/// optimized partition \p PartitionBC. The hash is produced in \p Key.
+void computeLTOPartitionCacheKey(SmallString<40> &Key, const lto::Config &Conf,
+                                 StringRef PartitionBC);
+
 namespace lto {
 
 StringLiteral getThinLTODefaultCPU(const Triple &TheTriple);
@@ -94,8 +100,21 @@ Expected<std::unique_ptr<ToolOutputFile>>
 setupStatsFile(StringRef StatsFilename);
 
 /// Produces a container ordering for optimal multi-threaded processing. Returns
-/// ordered indices to elements in the input array.
-std::vector<int> generateModulesOrdering(ArrayRef<BitcodeModule *> R);
+/// ordered indices to elements in the input array. If \p Costs is not empty it
+/// holds an estimated backend cost for each element of \p R, and elements are
+/// ordered by decreasing cost, with bitcode size used to break ties.
+std::vector<int> generateModulesOrdering(ArrayRef<BitcodeModule *> R,
+                                         ArrayRef<uint64_t> Costs = {});
+
+/// Estimates the amount of work the ThinLTO backend for a module has to do, as
+/// the number of IR instructions in the functions it defines (\p
+/// DefinedGlobals) plus the functions it imports (\p ImportList), according
+/// to the summaries in \p Index. Distributed build systems can use this to
+/// schedule the largest backend jobs first.
+uint64_t
+estimateThinBackendCost(const ModuleSummaryIndex &Index,
+                        const GVSummaryMapTy &DefinedGlobals,
+                        const FunctionImporter::ImportMapTy &ImportList);
 
 /// Updates MemProf attributes (and metadata) based on whether the index
 /// has recorded that we are linking with allocation libraries containing
@@ -430,7 +449,7 @@ private:
   Error addThinLTO(BitcodeModule BM, ArrayRef<InputFile::Symbol> Syms,
                    const SymbolResolution *&ResI, const SymbolResolution *ResE);
 
-  Error runRegularLTO(AddStreamFn AddStream);
+  Error runRegularLTO(AddStreamFn AddStream, FileCache Cache);
   Error runThinLTO(AddStreamFn AddStream, FileCache Cache,
                    const DenseSet<GlobalValue::GUID> &GUIDPreservedSymbols);
 
@@ -41,9 +41,11 @@ bool opt(const Config &Conf, TargetMachine *TM, unsigned Task, Module &Mod,
 
 /// Runs a regular LTO backend. The regular LTO backend can also act as the
 /// regular LTO phase of ThinLTO, which may need to access the combined index.
+/// If \p Cache is provided and code generation is split into partitions, the
+/// object for each optimized partition is looked up in and added to the cache.
 Error backend(const Config &C, AddStreamFn AddStream,
               unsigned ParallelCodeGenParallelismLevel, Module &M,
-              ModuleSummaryIndex &CombinedIndex);
+              ModuleSummaryIndex &CombinedIndex, FileCache Cache = nullptr);
 
 /// Runs a ThinLTO backend.
 /// If \p ModuleMap is not nullptr, all the module files to be imported have
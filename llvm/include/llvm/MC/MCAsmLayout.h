@@ -47,6 +47,11 @@ public:
 
   void layoutBundle(MCFragment *F);
 
+  /// Place \p F at \p Offset in its section, adding bundle padding if needed,
+  /// assuming every fragment before it has already been placed.
+  /// \return The final offset of \p F.
+  uint64_t layoutFragment(MCFragment &F, uint64_t Offset);
+
   /// \name Section Access (in layout order)
   /// @{
 
@@ -937,6 +937,23 @@ class CoverageMapping {
       ArrayRef<std::unique_ptr<CoverageMappingReader>> CoverageReaders,
       IndexedInstrProfReader &ProfileReader, CoverageMapping &Coverage);
 
+  // The coverage readers of an object file, the buffers they refer to, and
+  // the function records decoded from them.
+  struct ObjectFileReaders;
+
+  // Read and decode the coverage mapping of an object file. This does not
+  // depend on the profile, so several files may be read concurrently.
+  static Expected<ObjectFileReaders>
+  readObjectFile(StringRef Filename, StringRef Arch, StringRef CompilationDir,
+                 bool ReadBinaryIDs);
+
+  // Load the decoded coverage records of an object file.
+  static Error
+  loadFromFile(StringRef Filename, Expected<ObjectFileReaders> FileOrErr,
+               IndexedInstrProfReader &ProfileReader, CoverageMapping &Coverage,
+               bool &DataFound,
+               SmallVectorImpl<object::BuildID> *FoundBinaryIDs = nullptr);
+
   // Load coverage records from file.
   static Error
   loadFromFile(StringRef Filename, StringRef Arch, StringRef CompilationDir,
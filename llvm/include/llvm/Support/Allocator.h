@@ -379,6 +379,11 @@ private:
 /// parameters.
 typedef BumpPtrAllocatorImpl<> BumpPtrAllocator;
 
+/// A BumpPtrAllocator whose 2MiB slabs are mapped with a request for huge
+/// pages, for arenas that grow very large.
+typedef BumpPtrAllocatorImpl<MappedMemoryAllocator, 2 * 1024 * 1024>
+    HugePageBumpPtrAllocator;
+
 /// A BumpPtrAllocator that allows only elements of a specific type to be
 /// allocated.
 ///
@@ -435,6 +440,12 @@ public:
 
   /// Allocate space for an array of objects without constructing them.
   T *Allocate(size_t num = 1) { return Allocator.Allocate<T>(num); }
+
+  /// Returns the total memory allocated by the underlying BumpPtrAllocator.
+  size_t getTotalMemory() const { return Allocator.getTotalMemory(); }
+
+  /// Returns the number of bytes handed out by Allocate.
+  size_t getBytesAllocated() const { return Allocator.getBytesAllocated(); }
 };
 
 } // end namespace llvm
@@ -105,6 +105,37 @@ public:
   void PrintStats() const {}
 };
 
+/// An allocator that maps every allocation as its own anonymous memory region
+/// and asks for it to be backed by huge pages where the system supports that.
+///
+/// It is meant as the slab allocator of a BumpPtrAllocatorImpl with large
+/// slabs, such as HugePageBumpPtrAllocator, for arenas that grow to hundreds
+/// of megabytes and would otherwise pay for a TLB miss on most accesses. Each
+/// allocation takes at least a page and a system call, so it is a poor choice
+/// for small allocations. Allocations of at least a huge page are aligned to
+/// the huge page size on systems with transparent huge pages, but callers can
+/// only rely on page alignment.
+class MappedMemoryAllocator : public AllocatorBase<MappedMemoryAllocator> {
+public:
+  void Reset() {}
+
+  LLVM_ATTRIBUTE_RETURNS_NONNULL void *Allocate(size_t Size, size_t Alignment);
+
+  // Pull in base class overloads.
+  using AllocatorBase<MappedMemoryAllocator>::Allocate;
+
+  void Deallocate(const void *Ptr, size_t Size, size_t Alignment);
+
+  // Pull in base class overloads.
+  using AllocatorBase<MappedMemoryAllocator>::Deallocate;
+
+  void PrintStats() const {}
+
+  /// \returns the number of bytes currently allocated by all
+  /// MappedMemoryAllocators in the process.
+  static size_t getTotalBytesAllocated();
+};
+
 namespace detail {
 
 template <typename Alloc> class AllocatorHolder : Alloc {
@@ -20,6 +20,7 @@
 namespace llvm {
 
 class MemoryBuffer;
+class MemoryBufferRef;
 
 /// This class wraps an output stream for a file. Most clients should just be
 /// able to return an instance of this base class from the stream callback, but
@@ -63,17 +64,38 @@ using FileCache = std::function<Expected<AddStreamFn>(
 using AddBufferFn = std::function<void(unsigned Task, const Twine &ModuleName,
                                        std::unique_ptr<MemoryBuffer> MB)>;
 
+/// This type defines the callback to look up a key in a shared (e.g. remote,
+/// content-addressed) store when the local cache misses. It returns null if
+/// the store does not hold the key or cannot be reached.
+///
+/// Fetch callbacks must be thread safe.
+using FetchBufferFn =
+    std::function<std::unique_ptr<MemoryBuffer>(StringRef Key)>;
+
+/// This type defines the callback to publish a newly produced cache entry to a
+/// shared store. The buffer is only valid for the duration of the call, so
+/// implementations that upload asynchronously must copy it.
+///
+/// Store callbacks must be thread safe.
+using StoreBufferFn = std::function<void(StringRef Key, MemoryBufferRef MB)>;
+
 /// Create a local file system cache which uses the given cache name, temporary
 /// file prefix, cache directory and file callback.  This function does not
 /// immediately create the cache directory if it does not yet exist; this is
 /// done lazily the first time a file is added.  The cache name appears in error
 /// messages for errors during caching. The temporary file prefix is used in the
 /// temporary file naming scheme used when writing files atomically.
+///
+/// If \p Fetch is set it is consulted on a local miss, and an entry it returns
+/// is added to the link as a hit. If \p Store is set it is given every entry
+/// written to the local cache. Together they let a team share one cache across
+/// machines without the local cache knowing how the shared store works.
 Expected<FileCache> localCache(
     const Twine &CacheNameRef, const Twine &TempFilePrefixRef,
     const Twine &CacheDirectoryPathRef,
     AddBufferFn AddBuffer = [](size_t Task, const Twine &ModuleName,
-                               std::unique_ptr<MemoryBuffer> MB) {});
+                               std::unique_ptr<MemoryBuffer> MB) {},
+    FetchBufferFn Fetch = nullptr, StoreBufferFn Store = nullptr);
 } // namespace llvm
 
 #endif
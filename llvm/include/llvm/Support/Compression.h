@@ -116,6 +116,16 @@ const char *getReasonIfUnsupported(Format F);
 void compress(Params P, ArrayRef<uint8_t> Input,
               SmallVectorImpl<uint8_t> &Output);
 
+// Compress Input like compress(), but split it into shards of ShardSize bytes
+// that are compressed concurrently. The output is a single zlib stream or a
+// sequence of zstd frames, which decompress() accepts. Shards do not share
+// history, so the output is slightly larger than that of compress(), but it
+// does not depend on the number of threads. Inputs that fit in one shard are
+// compressed exactly like compress() does.
+void compressInShards(Params P, ArrayRef<uint8_t> Input,
+                      SmallVectorImpl<uint8_t> &Output,
+                      size_t ShardSize = size_t(1) << 20);
+
 // Decompress Input. The uncompressed size must be available.
 Error decompress(DebugCompressionType T, ArrayRef<uint8_t> Input,
                  uint8_t *Output, size_t UncompressedSize);
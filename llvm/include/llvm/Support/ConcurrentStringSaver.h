@@ -0,0 +1,68 @@
+//===- llvm/Support/ConcurrentStringSaver.h ---------------------*- C++ -*-===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef LLVM_SUPPORT_CONCURRENTSTRINGSAVER_H
+#define LLVM_SUPPORT_CONCURRENTSTRINGSAVER_H
+
+#include "llvm/ADT/CachedHashString.h"
+#include "llvm/ADT/DenseSet.h"
+#include "llvm/ADT/StringRef.h"
+#include "llvm/ADT/Twine.h"
+#include "llvm/Support/Allocator.h"
+#include <memory>
+#include <shared_mutex>
+#include <string>
+
+namespace llvm {
+
+/// A thread-safe UniqueStringSaver: saves strings in storage it owns and
+/// returns a StringRef with a stable character pointer, and saving the same
+/// string from any thread yields the same StringRef.
+///
+/// The strings are split by hash into shards, each with its own lock, arena
+/// and set, so that threads saving different strings rarely contend. Strings
+/// that are already saved are found under a shared lock. Unlike
+/// ConcurrentHashTableByPtr with a PerThreadBumpPtrAllocator, it can be used
+/// from any thread, not only from the threads of the parallel executor.
+class ConcurrentUniqueStringSaver final {
+public:
+  /// Creates a saver with \p NumShards shards, rounded up to a power of two,
+  /// or with a number of shards suited to the host's threads if 0.
+  explicit ConcurrentUniqueStringSaver(unsigned NumShards = 0);
+  ~ConcurrentUniqueStringSaver();
+
+  ConcurrentUniqueStringSaver(const ConcurrentUniqueStringSaver &) = delete;
+  ConcurrentUniqueStringSaver &
+  operator=(const ConcurrentUniqueStringSaver &) = delete;
+
+  // All returned strings are null-terminated: *save(S).end() == 0.
+  StringRef save(const char *S) { return save(StringRef(S)); }
+  StringRef save(StringRef S);
+  StringRef save(const Twine &S);
+  StringRef save(const std::string &S) { return save(StringRef(S)); }
+
+  /// \returns the number of distinct strings saved.
+  size_t size() const;
+
+  /// \returns the number of bytes allocated for the saved strings.
+  size_t getBytesAllocated() const;
+
+private:
+  struct alignas(64) Shard {
+    mutable std::shared_mutex Mutex;
+    BumpPtrAllocator Alloc;
+    DenseSet<CachedHashStringRef> Strings;
+  };
+
+  std::unique_ptr<Shard[]> Shards;
+  unsigned ShardBits;
+};
+
+} // namespace llvm
+
+#endif // LLVM_SUPPORT_CONCURRENTSTRINGSAVER_H
@@ -76,6 +76,13 @@ public:
   /// but keeps the memory mapping alive.
   virtual void discard() {}
 
+  /// Starts writing back the given range of the buffer to the file without
+  /// waiting for the I/O to complete. If the caller does not modify the range
+  /// afterwards, this allows the OS to reclaim the memory backing it before
+  /// the buffer is committed. This is a no-op if the buffer is not backed by a
+  /// file mapping or if the OS does not support it.
+  virtual void writeBack(size_t Offset, size_t Size) {}
+
 protected:
   FileOutputBuffer(StringRef Path) : FinalPath(Path) {}
 
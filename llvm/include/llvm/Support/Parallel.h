@@ -89,6 +89,10 @@ public:
 class TaskGroup {
   detail::Latch L;
   bool Parallel;
+  // The nesting level of this group: 0 for a group created outside of the
+  // default executor, and one more than the level of the enclosing task
+  // otherwise.
+  unsigned Depth = 0;
 
 public:
   TaskGroup();
@@ -101,7 +105,12 @@ public:
   // threads, but strictly in sequential order.
   void spawn(std::function<void()> f, bool Sequential = false);
 
-  void sync() const { L.sync(); }
+  // Wait for all spawned tasks to finish. For a nested TaskGroup, the waiting
+  // thread first runs the group's tasks (and their descendants) that no other
+  // thread has picked up yet. Such tasks run on top of the waiting task's
+  // stack, so per-thread state indexed by getThreadIndex() must not be left
+  // inconsistent across a nested wait.
+  void sync() const;
 
   bool isParallel() const { return Parallel; }
 };
@@ -27,6 +27,7 @@ class TimeRecord {
   double UserTime = 0.0;             ///< User time elapsed.
   double SystemTime = 0.0;           ///< System time elapsed.
   ssize_t MemUsed = 0;               ///< Memory allocated (in bytes).
+  ssize_t PeakRSSGrowth = 0;         ///< Growth of the peak RSS (in bytes).
   uint64_t InstructionsExecuted = 0; ///< Number of instructions executed
 public:
   TimeRecord() = default;
@@ -42,6 +43,7 @@ public:
   double getSystemTime() const { return SystemTime; }
   double getWallTime() const { return WallTime; }
   ssize_t getMemUsed() const { return MemUsed; }
+  ssize_t getPeakRSSGrowth() const { return PeakRSSGrowth; }
   uint64_t getInstructionsExecuted() const { return InstructionsExecuted; }
 
   bool operator<(const TimeRecord &T) const {
@@ -54,6 +56,7 @@ public:
     UserTime += RHS.UserTime;
     SystemTime += RHS.SystemTime;
     MemUsed += RHS.MemUsed;
+    PeakRSSGrowth += RHS.PeakRSSGrowth;
     InstructionsExecuted += RHS.InstructionsExecuted;
   }
   void operator-=(const TimeRecord &RHS) {
@@ -61,6 +64,7 @@ public:
     UserTime -= RHS.UserTime;
     SystemTime -= RHS.SystemTime;
     MemUsed -= RHS.MemUsed;
+    PeakRSSGrowth -= RHS.PeakRSSGrowth;
     InstructionsExecuted -= RHS.InstructionsExecuted;
   }
 
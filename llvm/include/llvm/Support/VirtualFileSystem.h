@@ -17,6 +17,7 @@
 #include "llvm/ADT/IntrusiveRefCntPtr.h"
 #include "llvm/ADT/STLFunctionalExtras.h"
 #include "llvm/ADT/SmallVector.h"
+#include "llvm/ADT/StringMap.h"
 #include "llvm/ADT/StringRef.h"
 #include "llvm/Support/Chrono.h"
 #include "llvm/Support/Errc.h"
@@ -30,6 +31,7 @@
 #include <cstdint>
 #include <ctime>
 #include <memory>
+#include <mutex>
 #include <optional>
 #include <stack>
 #include <string>
@@ -482,6 +484,47 @@ private:
   virtual void anchor() override;
 };
 
+/// Caches the results of \c status() and \c exists() on the underlying file
+/// system, including failures, by absolute path. Long-lived clients that stat
+/// the same files many times, such as servers and the dependency scanner, can
+/// layer it over the real file system, and must call \c invalidate() when
+/// files change, e.g. from a directory watcher. Other calls are not cached.
+/// It is thread-safe if the underlying file system is.
+class StatusCachingFileSystem
+    : public RTTIExtends<StatusCachingFileSystem, ProxyFileSystem> {
+public:
+  static const char ID;
+  explicit StatusCachingFileSystem(IntrusiveRefCntPtr<FileSystem> FS)
+      : RTTIExtends(std::move(FS)) {}
+
+  llvm::ErrorOr<Status> status(const Twine &Path) override;
+  bool exists(const Twine &Path) override;
+
+  /// Forgets the cached status of \p Path.
+  void invalidate(const Twine &Path);
+  /// Forgets all cached statuses.
+  void invalidate();
+
+  /// \returns the number of cached statuses.
+  size_t getNumCachedStatuses() const;
+
+protected:
+  void printImpl(raw_ostream &OS, PrintType Type,
+                 unsigned IndentLevel) const override;
+
+private:
+  /// Makes \p Path absolute and removes "." components, so that equivalent
+  /// spellings of a path share a cache entry.
+  std::error_code getCacheKey(const Twine &Path,
+                              SmallVectorImpl<char> &Key) const;
+
+  mutable std::mutex Mutex;
+  llvm::StringMap<llvm::ErrorOr<Status>> Cache;
+  /// Bumped by every invalidation, so that a status queried concurrently with
+  /// one is not cached.
+  uint64_t Generation = 0;
+};
+
 namespace detail {
 
 class InMemoryDirectory;
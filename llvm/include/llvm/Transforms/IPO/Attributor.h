@@ -1459,6 +1459,12 @@ struct AttributorConfig {
   /// Maximum number of iterations to run until fixpoint.
   std::optional<unsigned> MaxFixpointIterations;
 
+  /// Maximum number of abstract attribute updates to perform until fixpoint,
+  /// summed over all iterations. Unlike the iteration limit, this bounds the
+  /// work done on large modules, where a single iteration can update every
+  /// abstract attribute.
+  std::optional<unsigned> MaxFixpointUpdates;
+
   /// A callback function that returns an ORE object from a Function pointer.
   ///{
   using OptimizationRemarkGetter =
@@ -26,6 +26,7 @@ class AssumptionCache;
 class DominatorTree;
 class CodeExtractor;
 class CodeExtractorAnalysisCache;
+class InstructionCost;
 
 /// A sequence of basic blocks.
 ///
@@ -50,7 +51,8 @@ private:
   bool shouldOutlineFrom(const Function &F) const;
   bool outlineColdRegions(Function &F, bool HasProfileSummary);
   bool isSplittingBeneficial(CodeExtractor &CE, const BlockSequence &Region,
-                             TargetTransformInfo &TTI);
+                             TargetTransformInfo &TTI, bool IsHotFunction,
+                             InstructionCost &OutliningBenefit);
   Function *extractColdRegion(BasicBlock &EntryPoint, CodeExtractor &CE,
                               const CodeExtractorAnalysisCache &CEAC,
                               BlockFrequencyInfo *BFI, TargetTransformInfo &TTI,
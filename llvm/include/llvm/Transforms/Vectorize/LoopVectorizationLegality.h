@@ -384,6 +384,18 @@ public:
   /// has a vectorized variant available.
   bool hasVectorCallVariants() const { return VecCallVariantsFound; }
 
+  /// Returns true if the loop was recognized as a search loop: a loop with a
+  /// countable latch exit plus one data-dependent early exit, which could be
+  /// vectorized by speculatively evaluating whole vectors of iterations.
+  bool hasUncountableEarlyExit() const {
+    return UncountableExitingBB != nullptr;
+  }
+
+  /// Returns the block of the data-dependent early exit, if any.
+  BasicBlock *getUncountableExitingBlock() const {
+    return UncountableExitingBB;
+  }
+
   unsigned getNumStores() const { return LAI->getNumStores(); }
   unsigned getNumLoads() const { return LAI->getNumLoads(); }
 
@@ -443,6 +455,14 @@ private:
   /// specific checks for outer loop vectorization.
   bool canVectorizeOuterLoop();
 
+  /// Return true if the loop, whose backedge-taken count is not computable,
+  /// has the shape of a search loop that could be vectorized: the latch exit
+  /// is countable, there is exactly one other exit whose count is not, the
+  /// loop does not write memory, and every load may be executed
+  /// speculatively for all iterations up to the latch exit count. Records
+  /// the early exiting block in UncountableExitingBB on success.
+  bool isVectorizableEarlyExitLoop();
+
   /// Return true if all of the instructions in the block can be speculatively
   /// executed, and record the loads/stores that require masking.
   /// \p SafePtrs is a list of addresses that are known to be legal and we know
@@ -548,6 +568,10 @@ private:
   /// (potentially) make a better decision on the maximum VF and enable
   /// the use of those function variants.
   bool VecCallVariantsFound = false;
+
+  /// The exiting block of a data-dependent early exit, set if the loop was
+  /// recognized by isVectorizableEarlyExitLoop.
+  BasicBlock *UncountableExitingBB = nullptr;
 };
 
 } // namespace llvm
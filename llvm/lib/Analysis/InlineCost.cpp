@@ -361,7 +361,9 @@ protected:
     return false;
   }
 
-  bool IsCallerRecursive = false;
+  /// Whether the caller calls itself directly; computed on first use by
+  /// isCallerRecursive.
+  std::optional<bool> IsCallerRecursive;
   bool IsRecursiveCall = false;
   bool ExposesReturnsTwice = false;
   bool HasDynamicAlloca = false;
@@ -421,6 +423,7 @@ protected:
 
   // Custom simplification helper routines.
   bool isAllocaDerivedArg(Value *V);
+  bool isCallerRecursive();
   void disableSROAForArg(AllocaInst *SROAArg);
   void disableSROA(Value *V);
   void findDeadBlocks(BasicBlock *CurrBB, BasicBlock *NextBB);
@@ -2599,7 +2602,7 @@ CallAnalyzer::analyzeBlock(BasicBlock *BB,
     // If the caller is a recursive function then we don't want to inline
     // functions which allocate a lot of stack space because it would increase
     // the caller stack usage dramatically.
-    if (IsCallerRecursive && AllocatedSize > RecurStackSizeThreshold) {
+    if (AllocatedSize > RecurStackSizeThreshold && isCallerRecursive()) {
       auto IR =
           InlineResult::failure("recursive and allocates too much stack space");
       if (ORE)
@@ -2698,6 +2701,20 @@ void CallAnalyzer::findDeadBlocks(BasicBlock *CurrBB, BasicBlock *NextBB) {
   }
 }
 
+bool CallAnalyzer::isCallerRecursive() {
+  if (IsCallerRecursive)
+    return *IsCallerRecursive;
+
+  // This walks all uses of the caller, which can be many for a widely used
+  // function, so only do it for the rare call sites that need to know.
+  Function *Caller = CandidateCall.getFunction();
+  IsCallerRecursive = any_of(Caller->users(), [&](User *U) {
+    auto *Call = dyn_cast<CallBase>(U);
+    return Call && Call->getFunction() == Caller;
+  });
+  return *IsCallerRecursive;
+}
+
 /// Analyze a call site for potential inlining.
 ///
 /// Returns true if inlining this call is viable, and false if it is not
@@ -2715,16 +2732,6 @@ InlineResult CallAnalyzer::analyze() {
   if (F.empty())
     return InlineResult::success();
 
-  Function *Caller = CandidateCall.getFunction();
-  // Check if the caller function is recursive itself.
-  for (User *U : Caller->users()) {
-    CallBase *Call = dyn_cast<CallBase>(U);
-    if (Call && Call->getFunction() == Caller) {
-      IsCallerRecursive = true;
-      break;
-    }
-  }
-
   // Populate our simplified values by mapping from function arguments to call
   // arguments with known important simplifications.
   auto CAI = CandidateCall.arg_begin();
@@ -2842,6 +2849,7 @@ InlineResult CallAnalyzer::analyze() {
   // If the callee's stack size exceeds the user-specified threshold,
   // do not let it be inlined.
   // The command line option overrides a limit set in the function attributes.
+  Function *Caller = CandidateCall.getFunction();
   size_t FinalStackSizeThreshold = StackSizeThreshold;
   if (!StackSizeThreshold.getNumOccurrences())
     if (std::optional<int> AttrMaxStackSize = getStringFnAttrAsInt(
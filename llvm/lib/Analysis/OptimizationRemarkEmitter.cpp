@@ -20,6 +20,7 @@
 #include "llvm/IR/Dominators.h"
 #include "llvm/IR/LLVMContext.h"
 #include "llvm/InitializePasses.h"
+#include "llvm/Remarks/RemarkStreamer.h"
 #include <optional>
 
 using namespace llvm;
@@ -76,6 +77,14 @@ void OptimizationRemarkEmitter::computeHotness(
     OptDiag.setHotness(computeHotness(V));
 }
 
+bool OptimizationRemarkEmitter::allowExtraAnalysis(LLVMContext &Ctx,
+                                                   StringRef PassName) {
+  if (Ctx.getLLVMRemarkStreamer() &&
+      Ctx.getMainRemarkStreamer()->matchesFilter(PassName))
+    return true;
+  return Ctx.getDiagHandlerPtr()->isAnyRemarkEnabled(PassName);
+}
+
 void OptimizationRemarkEmitter::emit(
     DiagnosticInfoOptimizationBase &OptDiagBase) {
   auto &OptDiag = cast<DiagnosticInfoIROptimization>(OptDiagBase);
@@ -6982,7 +6982,10 @@ Error BitcodeReader::materializeModule() {
   WillMaterializeAllForwardRefs = true;
 
   // Iterate over the module, deserializing any functions that are still on
-  // disk.
+  // disk. This is done serially and in module order: parsing a body creates
+  // constants, types and metadata in the shared LLVMContext, and the order in
+  // which bodies are parsed determines the use-list order of the globals they
+  // reference.
   for (Function &F : *TheModule) {
     if (Error Err = materialize(&F))
       return Err;
@@ -7326,8 +7329,15 @@ std::vector<FunctionSummary::EdgeTy>
 ModuleSummaryIndexBitcodeReader::makeCallList(ArrayRef<uint64_t> Record,
                                               bool IsOldProfileFormat,
                                               bool HasProfile, bool HasRelBF) {
+  // The summaries keep these vectors for the whole thin link, so reserve the
+  // exact number of edges rather than one per record field.
+  unsigned FieldsPerEdge = 1;
+  if (IsOldProfileFormat)
+    FieldsPerEdge += HasProfile ? 2 : 1;
+  else if (HasProfile || HasRelBF)
+    FieldsPerEdge += 1;
   std::vector<FunctionSummary::EdgeTy> Ret;
-  Ret.reserve(Record.size());
+  Ret.reserve(Record.size() / FieldsPerEdge);
   for (unsigned I = 0, E = Record.size(); I != E; ++I) {
     CalleeInfo::HotnessType Hotness = CalleeInfo::HotnessType::Unknown;
     bool HasTailCall = false;
@@ -66,6 +66,7 @@
 #include "llvm/Support/Error.h"
 #include "llvm/Support/ErrorHandling.h"
 #include "llvm/Support/MathExtras.h"
+#include "llvm/Support/Parallel.h"
 #include "llvm/Support/SHA1.h"
 #include "llvm/Support/raw_ostream.h"
 #include "llvm/TargetParser/Triple.h"
@@ -95,6 +96,11 @@ static cl::opt<bool> WriteRelBFToSummary(
     "write-relbf-to-summary", cl::Hidden, cl::init(false),
     cl::desc("Write relative block frequency to function summary "));
 
+static cl::opt<bool> ParallelFunctionBlocks(
+    "bitcode-parallel-function-blocks", cl::Hidden, cl::init(false),
+    cl::desc("Encode function blocks on multiple threads; the output is "
+             "identical to serial encoding"));
+
 namespace llvm {
 extern FunctionSummary::ForceSummaryHotnessType ForceSummaryEdgesCold;
 }
@@ -409,6 +415,9 @@ private:
   void
   writeFunction(const Function &F,
                 DenseMap<const Function *, uint64_t> &FunctionToBitcodeIndex);
+  void encodeFunctionBlocksInParallel(
+      std::vector<SmallVector<char, 0>> &Buffers,
+      DenseMap<const Function *, StringRef> &FunctionBlocks);
   void writeBlockInfo();
   void writeModuleHash(StringRef View);
 
@@ -3681,6 +3690,63 @@ void ModuleBitcodeWriter::writeFunction(
   Stream.ExitBlock();
 }
 
+/// Encode the function blocks of the module ahead of time on multiple threads.
+/// Each worker owns a ModuleBitcodeWriter with its own ValueEnumerator and a
+/// scratch stream carrying the same BLOCKINFO as the module stream. Since the
+/// ValueEnumerator is deterministic, and a function block only depends on the
+/// module-level IDs and the BLOCKINFO abbrevs, the encoded blocks are
+/// bit-identical to the ones writeFunction would emit into the module stream.
+void ModuleBitcodeWriter::encodeFunctionBlocksInParallel(
+    std::vector<SmallVector<char, 0>> &Buffers,
+    DenseMap<const Function *, StringRef> &FunctionBlocks) {
+  // Use-list orders are predicted for the whole module and consumed in order.
+  if (VE.shouldPreserveUseListOrder())
+    return;
+
+  std::vector<const Function *> Defined;
+  for (const Function &F : M)
+    if (!F.isDeclaration())
+      Defined.push_back(&F);
+
+  // Every worker enumerates the whole module, so use one contiguous range of
+  // functions per thread rather than finer-grained tasks.
+  size_t NumChunks = std::min<size_t>(
+      parallel::strategy.compute_thread_count(), Defined.size());
+  if (NumChunks < 2)
+    return;
+
+  Buffers.resize(NumChunks);
+  std::vector<std::vector<std::pair<size_t, size_t>>> Ranges(NumChunks);
+  parallelFor(0, NumChunks, [&](size_t I) {
+    size_t Begin = I * Defined.size() / NumChunks;
+    size_t End = (I + 1) * Defined.size() / NumChunks;
+
+    StringTableBuilder ScratchStrtab(StringTableBuilder::RAW);
+    BitstreamWriter ScratchStream(Buffers[I]);
+    ModuleBitcodeWriter Writer(M, ScratchStrtab, ScratchStream,
+                               /*ShouldPreserveUseListOrder=*/false,
+                               /*Index=*/nullptr, /*GenerateHash=*/false);
+    ScratchStream.EnterSubblock(bitc::MODULE_BLOCK_ID, 3);
+    Writer.writeBlockInfo();
+
+    DenseMap<const Function *, uint64_t> ScratchIndex;
+    for (size_t J = Begin; J != End; ++J) {
+      size_t Start = ScratchStream.GetCurrentBitNo() / 8;
+      Writer.writeFunction(*Defined[J], ScratchIndex);
+      Ranges[I].push_back({Start, ScratchStream.GetCurrentBitNo() / 8});
+    }
+    ScratchStream.ExitBlock();
+  });
+
+  for (size_t I = 0; I != NumChunks; ++I) {
+    size_t Begin = I * Defined.size() / NumChunks;
+    for (auto [J, Range] : enumerate(Ranges[I]))
+      FunctionBlocks[Defined[Begin + J]] =
+          StringRef(Buffers[I].data() + Range.first,
+                    Range.second - Range.first);
+  }
+}
+
 // Emit blockinfo, which defines the standard abbreviations etc.
 void ModuleBitcodeWriter::writeBlockInfo() {
   // We only want to emit block info records for blocks that have multiple
@@ -4863,10 +4929,26 @@ void ModuleBitcodeWriter::write() {
   writeSyncScopeNames();
 
   // Emit function bodies.
+  std::vector<SmallVector<char, 0>> FunctionBlockBuffers;
+  DenseMap<const Function *, StringRef> FunctionBlocks;
+  if (ParallelFunctionBlocks)
+    encodeFunctionBlocksInParallel(FunctionBlockBuffers, FunctionBlocks);
+
   DenseMap<const Function *, uint64_t> FunctionToBitcodeIndex;
-  for (const Function &F : M)
-    if (!F.isDeclaration())
-      writeFunction(F, FunctionToBitcodeIndex);
+  for (const Function &F : M) {
+    if (F.isDeclaration())
+      continue;
+    // Pre-encoded blocks start on a word boundary of the scratch stream, so
+    // they can only be spliced where the module stream is word aligned too.
+    // That holds after any previous function block.
+    auto It = FunctionBlocks.find(&F);
+    if (It != FunctionBlocks.end() && Stream.GetCurrentBitNo() % 32 == 0) {
+      FunctionToBitcodeIndex[&F] = Stream.GetCurrentBitNo();
+      Stream.spliceWords(It->second);
+      continue;
+    }
+    writeFunction(F, FunctionToBitcodeIndex);
+  }
 
   // Need to write after the above call to WriteFunction which populates
   // the summary information in the index.
@@ -18,6 +18,7 @@
 #include "llvm/IR/DiagnosticInfo.h"
 #include "llvm/IR/LLVMContext.h"
 #include "llvm/InitializePasses.h"
+#include "llvm/Remarks/RemarkStreamer.h"
 #include <optional>
 
 using namespace llvm;
@@ -46,6 +47,15 @@ void MachineOptimizationRemarkEmitter::computeHotness(
     Remark.setHotness(computeHotness(*MBB));
 }
 
+bool MachineOptimizationRemarkEmitter::allowExtraAnalysis(
+    StringRef PassName) const {
+  LLVMContext &Ctx = MF.getFunction().getContext();
+  if (Ctx.getLLVMRemarkStreamer() &&
+      Ctx.getMainRemarkStreamer()->matchesFilter(PassName))
+    return true;
+  return Ctx.getDiagHandlerPtr()->isAnyRemarkEnabled(PassName);
+}
+
 void MachineOptimizationRemarkEmitter::emit(
     DiagnosticInfoOptimizationBase &OptDiagCommon) {
   auto &OptDiag = cast<DiagnosticInfoMIROptimization>(OptDiagCommon);
@@ -25,11 +25,14 @@ using namespace llvm;
 
 static void codegen(Module *M, llvm::raw_pwrite_stream &OS,
                     function_ref<std::unique_ptr<TargetMachine>()> TMFactory,
-                    CodeGenFileType FileType) {
+                    CodeGenFileType FileType,
+                    const PartitionSetupFn &PartitionSetup) {
   std::unique_ptr<TargetMachine> TM = TMFactory();
   assert(TM && "Failed to create target machine!");
 
   legacy::PassManager CodeGenPasses;
+  if (PartitionSetup)
+    PartitionSetup(M->getContext(), CodeGenPasses);
   if (TM->addPassesToEmitFile(CodeGenPasses, OS, nullptr, FileType))
     report_fatal_error("Failed to setup codegen");
   CodeGenPasses.run(*M);
@@ -39,13 +42,14 @@ void llvm::splitCodeGen(
     Module &M, ArrayRef<llvm::raw_pwrite_stream *> OSs,
     ArrayRef<llvm::raw_pwrite_stream *> BCOSs,
     const std::function<std::unique_ptr<TargetMachine>()> &TMFactory,
-    CodeGenFileType FileType, bool PreserveLocals) {
+    CodeGenFileType FileType, bool PreserveLocals,
+    const PartitionSetupFn &PartitionSetup) {
   assert(BCOSs.empty() || BCOSs.size() == OSs.size());
 
   if (OSs.size() == 1) {
     if (!BCOSs.empty())
       WriteBitcodeToFile(M, *BCOSs[0]);
-    codegen(&M, *OSs[0], TMFactory, FileType);
+    codegen(&M, *OSs[0], TMFactory, FileType, PartitionSetup);
     return;
   }
 
@@ -76,7 +80,8 @@ void llvm::splitCodeGen(
           llvm::raw_pwrite_stream *ThreadOS = OSs[ThreadCount++];
           // Enqueue the task
           CodegenThreadPool.async(
-              [TMFactory, FileType, ThreadOS](const SmallString<0> &BC) {
+              [TMFactory, FileType, PartitionSetup,
+               ThreadOS](const SmallString<0> &BC) {
                 LLVMContext Ctx;
                 Expected<std::unique_ptr<Module>> MOrErr = parseBitcodeFile(
                     MemoryBufferRef(BC.str(), "<split-module>"), Ctx);
@@ -84,7 +89,8 @@ void llvm::splitCodeGen(
                   report_fatal_error("Failed to read bitcode");
                 std::unique_ptr<Module> MPartInCtx = std::move(MOrErr.get());
 
-                codegen(MPartInCtx.get(), *ThreadOS, TMFactory, FileType);
+                codegen(MPartInCtx.get(), *ThreadOS, TMFactory, FileType,
+                        PartitionSetup);
               },
               // Pass BC using std::move to ensure that it get moved rather than
               // copied into the thread's context.
@@ -140,6 +140,13 @@ static cl::opt<bool> GreedyReverseLocalAssignment(
              "shorter local live ranges will tend to be allocated first"),
     cl::Hidden);
 
+static cl::opt<unsigned> GreedyWorkBudget(
+    "greedy-work-budget",
+    cl::desc("Maximum number of live ranges per function that may go through "
+             "eviction and splitting. Past it, spillable ranges only try "
+             "region splitting before being spilled (0 = unlimited)"),
+    cl::init(0), cl::Hidden);
+
 static cl::opt<unsigned> SplitThresholdForRegWithHint(
     "split-threshold-for-reg-with-hint",
     cl::desc("The threshold for splitting a virtual register with a hint, in "
@@ -1804,8 +1811,13 @@ unsigned RAGreedy::trySplit(const LiveInterval &VirtReg, AllocationOrder &Order,
   if (ExtraInfo->getStage(VirtReg) >= RS_Spill)
     return 0;
 
+  // Past the work budget, only region splitting is worth its cost.
+  bool RegionSplitOnly = OverWorkBudget && VirtReg.isSpillable();
+
   // Local intervals are handled separately.
   if (LIS->intervalIsInOneMBB(VirtReg)) {
+    if (RegionSplitOnly)
+      return 0;
     NamedRegionTimer T("local_split", "Local Splitting", TimerGroupName,
                        TimerGroupDescription, TimePassesIsEnabled);
     SA->analyze(&VirtReg);
@@ -1829,6 +1841,9 @@ unsigned RAGreedy::trySplit(const LiveInterval &VirtReg, AllocationOrder &Order,
       return PhysReg;
   }
 
+  if (RegionSplitOnly)
+    return 0;
+
   // Then isolate blocks.
   return tryBlockSplit(VirtReg, Order, NewVRegs);
 }
@@ -2442,8 +2457,12 @@ MCRegister RAGreedy::selectOrSplitImpl(const LiveInterval &VirtReg,
 
   // Try to evict a less worthy live range, but only for ranges from the primary
   // queue. The RS_Split ranges already failed to do this, and they should not
-  // get a second chance until they have been split.
-  if (Stage != RS_Split)
+  // get a second chance until they have been split. Once the function is over
+  // its work budget, avoid eviction cascades and leave the range to be split
+  // or spilled, unless it can't be spilled. RS_Split ranges were charged when
+  // they failed to evict, so they are not charged again. Evicted ranges are
+  // charged each time they come back, which is what bounds a cascade.
+  if (Stage != RS_Split && (chargeWorkBudget() || !VirtReg.isSpillable()))
     if (Register PhysReg =
             tryEvict(VirtReg, Order, NewVRegs, CostPerUseLimit,
                      FixedRegisters)) {
@@ -2690,6 +2709,33 @@ void RAGreedy::reportStats() {
   }
 }
 
+/// Count one more live range needing eviction or splitting against
+/// -greedy-work-budget.
+/// \return false once the budget is exhausted for the current function.
+bool RAGreedy::chargeWorkBudget() {
+  if (OverWorkBudget)
+    return false;
+  if (!GreedyWorkBudget || ++WorkAttempts <= GreedyWorkBudget)
+    return true;
+
+  OverWorkBudget = true;
+  LLVM_DEBUG(dbgs() << "Work budget of " << GreedyWorkBudget
+                    << " exceeded, switching to cheaper allocation\n");
+  ORE->emit([&]() {
+    DebugLoc Loc;
+    if (auto *SP = MF->getFunction().getSubprogram())
+      Loc = DILocation::get(SP->getContext(), SP->getLine(), 1, SP);
+    MachineOptimizationRemarkMissed R(DEBUG_TYPE, "WorkBudgetExceeded", Loc,
+                                      &MF->front());
+    R << "register allocation work budget of "
+      << ore::NV("WorkBudget", GreedyWorkBudget.getValue())
+      << " live ranges exceeded; skipping eviction and most splitting for "
+         "the rest of the function";
+    return R;
+  });
+  return false;
+}
+
 bool RAGreedy::hasVirtRegAlloc() {
   for (unsigned I = 0, E = MRI->getNumVirtRegs(); I != E; ++I) {
     Register Reg = Register::index2VirtReg(I);
@@ -2767,6 +2813,8 @@ bool RAGreedy::runOnMachineFunction(MachineFunction &mf) {
   IntfCache.init(MF, Matrix->getLiveUnions(), Indexes, LIS, TRI);
   GlobalCand.resize(32);  // This will grow as needed.
   SetOfBrokenHints.clear();
+  WorkAttempts = 0;
+  OverWorkBudget = false;
 
   allocatePhysRegs();
   tryHintsRecoloring();
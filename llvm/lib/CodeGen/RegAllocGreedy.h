@@ -204,6 +204,14 @@ private:
 
   uint8_t CutOffInfo = CutOffStage::CO_None;
 
+  // Number of live ranges in the current function that needed more than a
+  // free register, checked against -greedy-work-budget.
+  unsigned WorkAttempts = 0;
+
+  // Set once the current function has used up its work budget. From then on,
+  // eviction and all but region splitting are skipped for spillable ranges.
+  bool OverWorkBudget = false;
+
 #ifndef NDEBUG
   static const char *const StageName[];
 #endif
@@ -450,6 +458,7 @@ private:
 
   /// Report the statistic for each loop.
   void reportStats();
+  bool chargeWorkBudget();
 };
 } // namespace llvm
 #endif // #ifndef LLVM_CODEGEN_REGALLOCGREEDY_H_
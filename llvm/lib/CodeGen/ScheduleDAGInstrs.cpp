@@ -17,6 +17,7 @@
 #include "llvm/ADT/MapVector.h"
 #include "llvm/ADT/SmallVector.h"
 #include "llvm/ADT/SparseSet.h"
+#include "llvm/ADT/Statistic.h"
 #include "llvm/ADT/iterator_range.h"
 #include "llvm/Analysis/AliasAnalysis.h"
 #include "llvm/Analysis/ValueTracking.h"
@@ -44,12 +45,14 @@
 #include "llvm/IR/Value.h"
 #include "llvm/MC/LaneBitmask.h"
 #include "llvm/MC/MCRegisterInfo.h"
+#include "llvm/Pass.h"
 #include "llvm/Support/Casting.h"
 #include "llvm/Support/CommandLine.h"
 #include "llvm/Support/Compiler.h"
 #include "llvm/Support/Debug.h"
 #include "llvm/Support/ErrorHandling.h"
 #include "llvm/Support/Format.h"
+#include "llvm/Support/Timer.h"
 #include "llvm/Support/raw_ostream.h"
 #include <algorithm>
 #include <cassert>
@@ -61,6 +64,11 @@ using namespace llvm;
 
 #define DEBUG_TYPE "machine-scheduler"
 
+STATISTIC(NumSchedDAGNodes, "Number of SUnits in built scheduling DAGs");
+STATISTIC(NumSchedDAGEdges, "Number of edges in built scheduling DAGs");
+STATISTIC(NumMemMapReductions,
+          "Number of times memory dependency maps were reduced");
+
 static cl::opt<bool>
     EnableAASchedMI("enable-aa-sched-mi", cl::Hidden,
                     cl::desc("Enable use of AA during MI DAG construction"));
@@ -73,7 +81,8 @@ static cl::opt<bool> UseTBAA("use-tbaa-in-sched-mi", cl::Hidden,
 // reached means best-effort, but may be slow.
 
 // When Stores and Loads maps (or NonAliasStores and NonAliasLoads)
-// together hold this many SUs, a reduction of maps will be done.
+// together hold this many SUs, a reduction of maps will be done. Unless set
+// explicitly, the subtarget's getSchedDAGMemMapsLimit() is used.
 static cl::opt<unsigned> HugeRegion("dag-maps-huge-region", cl::Hidden,
     cl::init(1000), cl::desc("The limit to use while constructing the DAG "
                              "prior to scheduling, at which point a trade-off "
@@ -90,11 +99,17 @@ static cl::opt<bool> SchedPrintCycles(
     cl::desc("Report top/bottom cycles when dumping SUnit instances"));
 #endif
 
-static unsigned getReductionSize() {
+static unsigned getHugeRegion(const TargetSubtargetInfo &ST) {
+  if (HugeRegion.getNumOccurrences() == 0)
+    return ST.getSchedDAGMemMapsLimit();
+  return HugeRegion;
+}
+
+static unsigned getReductionSize(unsigned HugeRegionLimit) {
   // Always reduce a huge region with half of the elements, except
   // when user sets this number explicitly.
   if (ReductionSize.getNumOccurrences() == 0)
-    return HugeRegion / 2;
+    return HugeRegionLimit / 2;
   return ReductionSize;
 }
 
@@ -741,10 +756,15 @@ void ScheduleDAGInstrs::buildSchedGraph(AAResults *AA,
                                         PressureDiffs *PDiffs,
                                         LiveIntervals *LIS,
                                         bool TrackLaneMasks) {
+  NamedRegionTimer T("build_sched_graph", "Build Scheduling DAG",
+                     "machine-scheduler", "Machine Instruction Scheduler",
+                     TimePassesIsEnabled);
   const TargetSubtargetInfo &ST = MF.getSubtarget();
   bool UseAA = EnableAASchedMI.getNumOccurrences() > 0 ? EnableAASchedMI
                                                        : ST.useAA();
   AAForDep = UseAA ? AA : nullptr;
+  const unsigned HugeRegionLimit = getHugeRegion(ST);
+  const unsigned HugeRegionReduction = getReductionSize(HugeRegionLimit);
 
   BarrierChain = nullptr;
 
@@ -927,10 +947,10 @@ void ScheduleDAGInstrs::buildSchedGraph(AAResults *AA,
 
       FPExceptions.insert(SU, UnknownValue);
 
-      if (FPExceptions.size() >= HugeRegion) {
+      if (FPExceptions.size() >= HugeRegionLimit) {
         LLVM_DEBUG(dbgs() << "Reducing FPExceptions map.\n";);
         Value2SUsMap empty;
-        reduceHugeMemNodeMaps(FPExceptions, empty, getReductionSize());
+        reduceHugeMemNodeMaps(FPExceptions, empty, HugeRegionReduction);
       }
     }
 
@@ -1010,14 +1030,15 @@ void ScheduleDAGInstrs::buildSchedGraph(AAResults *AA,
     }
 
     // Reduce maps if they grow huge.
-    if (Stores.size() + Loads.size() >= HugeRegion) {
+    if (Stores.size() + Loads.size() >= HugeRegionLimit) {
       LLVM_DEBUG(dbgs() << "Reducing Stores and Loads maps.\n";);
-      reduceHugeMemNodeMaps(Stores, Loads, getReductionSize());
+      reduceHugeMemNodeMaps(Stores, Loads, HugeRegionReduction);
     }
-    if (NonAliasStores.size() + NonAliasLoads.size() >= HugeRegion) {
+    if (NonAliasStores.size() + NonAliasLoads.size() >= HugeRegionLimit) {
       LLVM_DEBUG(
           dbgs() << "Reducing NonAliasStores and NonAliasLoads maps.\n";);
-      reduceHugeMemNodeMaps(NonAliasStores, NonAliasLoads, getReductionSize());
+      reduceHugeMemNodeMaps(NonAliasStores, NonAliasLoads,
+                            HugeRegionReduction);
     }
   }
 
@@ -1030,6 +1051,12 @@ void ScheduleDAGInstrs::buildSchedGraph(AAResults *AA,
   CurrentVRegUses.clear();
 
   Topo.MarkDirty();
+
+  if (AreStatisticsEnabled()) {
+    NumSchedDAGNodes += SUnits.size();
+    for (const SUnit &SU : SUnits)
+      NumSchedDAGEdges += SU.Preds.size();
+  }
 }
 
 raw_ostream &llvm::operator<<(raw_ostream &OS, const PseudoSourceValue* PSV) {
@@ -1057,6 +1084,7 @@ void ScheduleDAGInstrs::Value2SUsMap::dump() {
 
 void ScheduleDAGInstrs::reduceHugeMemNodeMaps(Value2SUsMap &stores,
                                               Value2SUsMap &loads, unsigned N) {
+  ++NumMemMapReductions;
   LLVM_DEBUG(dbgs() << "Before reduction:\nStoring SUnits:\n"; stores.dump();
              dbgs() << "Loading SUnits:\n"; loads.dump());
 
@@ -838,6 +838,10 @@ void SelectionDAGISel::SelectBasicBlock(BasicBlock::const_iterator Begin,
   // Allow creating illegal types during DAG building for the basic block.
   CurDAG->NewNodesMustHaveLegalTypes = false;
 
+  // Each instruction typically becomes a few nodes, most of which end up in
+  // the CSE map. Size it once instead of growing it as the DAG is built.
+  CurDAG->reserveCSEMap(2 * std::distance(Begin, End));
+
   // Lower the instructions. If a call is emitted as a tail call, cease emitting
   // nodes for this block. If an instruction is elided, don't emit it, but do
   // handle any debug-info attached to it.
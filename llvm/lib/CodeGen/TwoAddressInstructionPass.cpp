@@ -1898,6 +1898,11 @@ bool TwoAddressInstructionPass::runOnMachineFunction(MachineFunction &Func) {
 
             // The COPY no longer has a use of %reg.
             LIS->shrinkToUses(&LI);
+          } else if (!MRI->shouldTrackSubRegLiveness(Reg)) {
+            // Without subregister liveness the value numbers stay the same;
+            // only the explicit use of %reg is gone, and the subregister def
+            // still reads %reg unless it is undef.
+            LIS->shrinkToUses(&LI);
           } else {
             // The live interval for Reg did not have subranges but now it needs
             // them because we have introduced a subreg def. Recompute it.
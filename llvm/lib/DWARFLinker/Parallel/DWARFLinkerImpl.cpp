@@ -11,6 +11,7 @@
 #include "DependencyTracker.h"
 #include "llvm/DWARFLinker/Utils.h"
 #include "llvm/DebugInfo/DWARF/DWARFDebugAbbrev.h"
+#include "llvm/Pass.h"
 #include "llvm/Support/FormatVariadic.h"
 #include "llvm/Support/Parallel.h"
 #include "llvm/Support/ThreadPool.h"
@@ -182,6 +183,7 @@ Error DWARFLinkerImpl::link() {
 
   // Link object files.
   if (GlobalData.getOptions().Threads == 1) {
+    PhaseTimer Phase(*this, "link-objects", "Link object files");
     for (std::unique_ptr<LinkContext> &Context : ObjectContexts) {
       // Link object file.
       if (Error Err = Context->link(ArtificialTypeUnit.get()))
@@ -190,6 +192,7 @@ Error DWARFLinkerImpl::link() {
       Context->InputDWARFFile.unload();
     }
   } else {
+    PhaseTimer Phase(*this, "link-objects", "Link object files");
     DefaultThreadPool Pool(llvm::parallel::strategy);
     for (std::unique_ptr<LinkContext> &Context : ObjectContexts)
       Pool.async([&]() {
@@ -208,6 +211,7 @@ Error DWARFLinkerImpl::link() {
                                                   ->getValue()
                                                   .load()
                                                   ->Children.empty()) {
+    PhaseTimer Phase(*this, "emit-types", "Emit deduplicated types");
     if (GlobalData.getTargetTriple().has_value())
       if (Error Err = ArtificialTypeUnit.get()->finishCloningAndEmit(
               (*GlobalData.getTargetTriple()).get()))
@@ -219,6 +223,9 @@ Error DWARFLinkerImpl::link() {
   // glueing debug tables from each compile unit.
   glueCompileUnitsAndWriteToTheOutput();
 
+  if (GlobalData.getOptions().Statistics)
+    printPhaseTimes();
+
   return Error::success();
 }
 
@@ -856,20 +863,33 @@ void DWARFLinkerImpl::glueCompileUnitsAndWriteToTheOutput() {
 
   // Go through all object files, all compile units and assign
   // offsets to them.
-  assignOffsets();
+  {
+    PhaseTimer Phase(*this, "assign-offsets", "Assign offsets");
+    assignOffsets();
+  }
 
   // Patch size/offsets fields according to the assigned CU offsets.
-  patchOffsetsAndSizes();
+  {
+    PhaseTimer Phase(*this, "patch-offsets", "Patch offsets and sizes");
+    patchOffsetsAndSizes();
+  }
 
   // Emit common sections and write debug tables from all object files/compile
   // units into the resulting file.
-  emitCommonSectionsAndWriteCompileUnitsToTheOutput();
+  {
+    PhaseTimer Phase(*this, "emit-units", "Emit compile units");
+    emitCommonSectionsAndWriteCompileUnitsToTheOutput();
+  }
 
   if (ArtificialTypeUnit.get() != nullptr)
     ArtificialTypeUnit.reset();
 
   // Write common debug sections into the resulting file.
-  writeCommonSectionsToTheOutput();
+  {
+    PhaseTimer Phase(*this, "write-common-sections",
+                     "Write common sections");
+    writeCommonSectionsToTheOutput();
+  }
 
   // Cleanup data.
   cleanupDataAfterDWARFOutputIsWritten();
@@ -943,6 +963,21 @@ void DWARFLinkerImpl::printStatistic() {
             "---------------\n\n";
 }
 
+Timer *DWARFLinkerImpl::getPhaseTimer(StringRef Name, StringRef Description) {
+  if (!GlobalData.getOptions().Statistics && !TimePassesIsEnabled)
+    return nullptr;
+
+  Timer &T = PhaseTimers[Name];
+  if (!T.isInitialized())
+    T.init(Name, Description, PhaseTimerGroup);
+  return &T;
+}
+
+void DWARFLinkerImpl::printPhaseTimes() {
+  // Reset the timers so that -time-passes does not print them again.
+  PhaseTimerGroup.print(outs(), /*ResetAfterPrint=*/true);
+}
+
 void DWARFLinkerImpl::assignOffsets() {
   llvm::parallel::TaskGroup TGroup;
   TGroup.spawn([&]() { assignOffsetsToStrings(); });
@@ -17,6 +17,8 @@
 #include "llvm/CodeGen/AccelTable.h"
 #include "llvm/DWARFLinker/Parallel/DWARFLinker.h"
 #include "llvm/DWARFLinker/StringPool.h"
+#include "llvm/Support/TimeProfiler.h"
+#include "llvm/Support/Timer.h"
 
 namespace llvm {
 namespace dwarf_linker {
@@ -290,6 +292,26 @@ protected:
   /// Print statistic for processed Debug Info.
   void printStatistic();
 
+  /// Print the time spent in each linking phase.
+  void printPhaseTimes();
+
+  /// Return the timer of the linking phase \p Name, or null if phases are not
+  /// timed, i.e. neither statistics nor -time-passes are requested.
+  Timer *getPhaseTimer(StringRef Name, StringRef Description);
+
+  /// Times the enclosing scope as the linking phase \p Name and adds it to the
+  /// time trace.
+  class PhaseTimer {
+  public:
+    PhaseTimer(DWARFLinkerImpl &Linker, StringRef Name, StringRef Description)
+        : Trace(Description),
+          Region(Linker.getPhaseTimer(Name, Description)) {}
+
+  private:
+    TimeTraceScope Trace;
+    TimeRegion Region;
+  };
+
   enum StringDestinationKind : uint8_t { DebugStr, DebugLineStr };
 
   /// Enumerates all strings.
@@ -370,6 +392,10 @@ protected:
 
   /// Overall compile units number.
   uint64_t OverallNumberOfCU = 0;
+
+  /// Timers of the linking phases.
+  TimerGroup PhaseTimerGroup{"dwarf-linker", "DWARF linker phases"};
+  StringMap<Timer> PhaseTimers;
   /// @}
 };
 
@@ -20,7 +20,9 @@
 #include "llvm/Object/ELFObjectFile.h"
 #include "llvm/Support/CommandLine.h"
 #include "llvm/Support/MemoryBuffer.h"
+#include "llvm/Support/Parallel.h"
 #include <limits>
+#include <optional>
 
 using namespace llvm;
 using namespace llvm::object;
@@ -636,19 +638,45 @@ Error write(MCStreamer &Out, ArrayRef<std::string> Inputs,
   SmallVector<OwningBinary<object::ObjectFile>, 128> Objects;
   Objects.reserve(Inputs.size());
 
-  std::deque<SmallString<32>> UncompressedSections;
-
-  for (const auto &Input : Inputs) {
-    auto ErrOrObj = object::ObjectFile::createObjectFile(Input);
-    if (!ErrOrObj) {
-      return handleErrors(ErrOrObj.takeError(),
-                          [&](std::unique_ptr<ECError> EC) -> Error {
-                            return createFileError(Input, Error(std::move(EC)));
-                          });
+  // Open and map all inputs concurrently. With tens of thousands of .dwo
+  // files this is a large part of the run time, especially on network file
+  // systems. The objects are still processed serially and in input order
+  // below, so the output does not depend on scheduling.
+  {
+    std::vector<std::optional<Expected<OwningBinary<object::ObjectFile>>>>
+        Opened(Inputs.size());
+    parallelFor(0, Inputs.size(), [&](size_t I) {
+      Opened[I].emplace(object::ObjectFile::createObjectFile(Inputs[I]));
+    });
+
+    // Report the first input that failed to open, in input order.
+    Error Err = Error::success();
+    for (size_t I = 0, E = Inputs.size(); I != E; ++I) {
+      Expected<OwningBinary<object::ObjectFile>> &ErrOrObj = *Opened[I];
+      if (ErrOrObj) {
+        if (!Err)
+          Objects.push_back(std::move(*ErrOrObj));
+        continue;
+      }
+      if (Err) {
+        consumeError(ErrOrObj.takeError());
+        continue;
+      }
+      Err = handleErrors(ErrOrObj.takeError(),
+                         [&](std::unique_ptr<ECError> EC) -> Error {
+                           return createFileError(Inputs[I],
+                                                  Error(std::move(EC)));
+                         });
     }
+    if (Err)
+      return Err;
+  }
+
+  std::deque<SmallString<32>> UncompressedSections;
 
-    auto &Obj = *ErrOrObj->getBinary();
-    Objects.push_back(std::move(*ErrOrObj));
+  for (size_t InputIdx = 0, E = Inputs.size(); InputIdx != E; ++InputIdx) {
+    const std::string &Input = Inputs[InputIdx];
+    auto &Obj = *Objects[InputIdx].getBinary();
 
     UnitIndexEntry CurEntry = {};
 
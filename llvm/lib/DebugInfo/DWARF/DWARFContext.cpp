@@ -51,11 +51,13 @@
 #include "llvm/Support/FormatVariadic.h"
 #include "llvm/Support/MemoryBuffer.h"
 #include "llvm/Support/Path.h"
+#include "llvm/Support/ThreadPool.h"
 #include "llvm/Support/raw_ostream.h"
 #include <algorithm>
 #include <cstdint>
 #include <deque>
 #include <map>
+#include <optional>
 #include <string>
 #include <utility>
 #include <vector>
@@ -440,6 +442,60 @@ public:
     Line->clearLineTable(stmtOffset);
   }
 
+  void prefetchLineTables(ArrayRef<DWARFUnit *> Units,
+                          ThreadPoolInterface &Pool) override {
+    if (!Line)
+      Line = std::make_unique<DWARFDebugLine>();
+
+    // Reserve a cache entry for every table that still has to be parsed, so
+    // that the workers below only ever write to their own entry. Units that
+    // share a line table parse it once.
+    struct LineTableWork {
+      DWARFUnit *U;
+      uint64_t Offset;
+      DWARFDebugLine::LineTable *LT;
+      bool Failed = false;
+    };
+    std::vector<LineTableWork> Work;
+    for (DWARFUnit *U : Units) {
+      DWARFDie UnitDIE = U->getUnitDIE();
+      if (!UnitDIE)
+        continue;
+      std::optional<uint64_t> Offset =
+          toSectionOffset(UnitDIE.find(DW_AT_stmt_list));
+      if (!Offset)
+        continue;
+      uint64_t StmtOffset = *Offset + U->getLineTableOffset();
+      if (StmtOffset >= U->getLineSection().Data.size())
+        continue;
+      auto [LT, Inserted] = Line->getOrInsertLineTable(StmtOffset);
+      if (Inserted)
+        Work.push_back({U, StmtOffset, LT});
+    }
+
+    for (LineTableWork &W : Work)
+      Pool.async([&W] {
+        DWARFDataExtractor Data(W.U->getContext().getDWARFObj(),
+                                W.U->getLineSection(), W.U->isLittleEndian(),
+                                W.U->getAddressByteSize());
+        uint64_t Offset = W.Offset;
+        auto Discard = [&W](Error E) {
+          consumeError(std::move(E));
+          W.Failed = true;
+        };
+        if (Error Err =
+                W.LT->parse(Data, &Offset, W.U->getContext(), W.U, Discard))
+          Discard(std::move(Err));
+      });
+    Pool.wait();
+
+    // Drop the tables that had any problem. They are parsed again when first
+    // queried, which reports their errors exactly as without prefetching.
+    for (LineTableWork &W : Work)
+      if (W.Failed)
+        Line->clearLineTable(W.Offset);
+  }
+
   Expected<const DWARFDebugFrame *> getDebugFrame() override {
     if (DebugFrame)
       return DebugFrame.get();
@@ -682,6 +738,11 @@ public:
     std::unique_lock<std::recursive_mutex> LockGuard(Mutex);
     return ThreadUnsafeDWARFContextState::clearLineTableForUnit(U);
   }
+  void prefetchLineTables(ArrayRef<DWARFUnit *> Units,
+                          ThreadPoolInterface &Pool) override {
+    std::unique_lock<std::recursive_mutex> LockGuard(Mutex);
+    return ThreadUnsafeDWARFContextState::prefetchLineTables(Units, Pool);
+  }
   Expected<const DWARFDebugFrame *> getDebugFrame() override {
     std::unique_lock<std::recursive_mutex> LockGuard(Mutex);
     return ThreadUnsafeDWARFContextState::getDebugFrame();
@@ -1394,6 +1455,9 @@ DWARFDie DWARFContext::getDIEForOffset(uint64_t Offset) {
 
 bool DWARFContext::verify(raw_ostream &OS, DIDumpOptions DumpOpts) {
   bool Success = true;
+  if (DumpOpts.VerifyThreads != 1 &&
+      (DumpOpts.DumpType & (DIDT_DebugInfo | DIDT_DebugLine)))
+    prefetchUnits(DumpOpts.VerifyThreads);
   DWARFVerifier verifier(OS, *this, DumpOpts);
 
   Success &= verifier.handleDebugAbbrev();
@@ -1505,6 +1569,32 @@ void DWARFContext::clearLineTableForUnit(DWARFUnit *U) {
   return State->clearLineTableForUnit(U);
 }
 
+void DWARFContext::prefetchUnits(unsigned NumThreads) {
+  SmallVector<DWARFUnit *, 0> Units;
+  for (const std::unique_ptr<DWARFUnit> &U : getNormalUnitsVector()) {
+    // Abbreviation sets are shared between units, so parse them here first.
+    // After that, extracting the DIEs of a unit only writes to that unit.
+    U->getAbbreviations();
+    Units.push_back(U.get());
+  }
+  if (Units.empty())
+    return;
+
+  DefaultThreadPool Pool(hardware_concurrency(NumThreads));
+  std::vector<std::optional<Error>> DIEErrors(Units.size());
+  for (size_t I = 0, E = Units.size(); I != E; ++I)
+    Pool.async([&, I] {
+      DIEErrors[I].emplace(
+          Units[I]->tryExtractDIEsIfNeeded(/*CUDieOnly=*/false));
+    });
+  Pool.wait();
+  for (std::optional<Error> &Err : DIEErrors)
+    if (*Err)
+      getRecoverableErrorHandler()(std::move(*Err));
+
+  State->prefetchLineTables(Units, Pool);
+}
+
 DWARFUnitVector &DWARFContext::getDWOUnits(bool Lazy) {
   return State->getDWOUnits(Lazy);
 }
@@ -624,6 +624,13 @@ void DWARFDebugLine::clearLineTable(uint64_t Offset) {
   LineTableMap.erase(Offset);
 }
 
+std::pair<DWARFDebugLine::LineTable *, bool>
+DWARFDebugLine::getOrInsertLineTable(uint64_t Offset) {
+  std::pair<LineTableIter, bool> Pos =
+      LineTableMap.insert(LineTableMapTy::value_type(Offset, LineTable()));
+  return {&Pos.first->second, Pos.second};
+}
+
 static StringRef getOpcodeName(uint8_t Opcode, uint8_t OpcodeBase) {
   assert(Opcode != 0);
   if (Opcode < OpcodeBase)
@@ -488,6 +488,14 @@ void DWARFUnit::extractDIEsToVector(
 
     // Stop when compile unit die is removed from the parents stack.
   } while (Parents.size() > 1);
+
+  // The reservation above is only an estimate, and units with larger than
+  // average entries, or ones that outgrew it, are left with a good part of
+  // the vector unused. For LTO units with millions of DIEs that adds up, so
+  // hand the excess back. As with clearDIEs(), shrink_to_fit() is not
+  // guaranteed to do this, so copy into a vector of the exact size.
+  if (AppendNonCUDies && Dies.capacity() - Dies.size() > Dies.size() / 8)
+    std::vector<DWARFDebugInfoEntry>(Dies.begin(), Dies.end()).swap(Dies);
 }
 
 void DWARFUnit::extractDIEsIfNeeded(bool CUDieOnly) {
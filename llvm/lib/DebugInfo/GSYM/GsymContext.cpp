@@ -0,0 +1,179 @@
+//===-- GsymContext.cpp ---------------------------------------------------===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+#include "llvm/DebugInfo/GSYM/GsymContext.h"
+
+#include "llvm/DebugInfo/GSYM/GsymReader.h"
+#include "llvm/Support/Path.h"
+
+using namespace llvm;
+using namespace llvm::gsym;
+
+GsymContext::~GsymContext() = default;
+GsymContext::GsymContext(std::unique_ptr<GsymReader> Reader,
+                         std::unique_ptr<DIContext> Fallback)
+    : DIContext(CK_GSYM), Reader(std::move(Reader)),
+      Fallback(std::move(Fallback)) {}
+
+void GsymContext::dump(raw_ostream &OS, DIDumpOptions DumpOpts) {
+  if (Fallback)
+    Fallback->dump(OS, DumpOpts);
+}
+
+static std::string getFileName(StringRef Dir, StringRef Base,
+                               DILineInfoSpecifier::FileLineInfoKind Kind) {
+  using FileLineInfoKind = DILineInfoSpecifier::FileLineInfoKind;
+  switch (Kind) {
+  case FileLineInfoKind::None:
+    return DILineInfo::BadString;
+  case FileLineInfoKind::BaseNameOnly:
+    return Base.str();
+  case FileLineInfoKind::RawValue:
+  case FileLineInfoKind::RelativeFilePath:
+  case FileLineInfoKind::AbsoluteFilePath:
+    break;
+  }
+  // GSYM only keeps the directory and base name of each file, so the closest
+  // thing to a relative or absolute path is the two joined together.
+  if (Dir.empty())
+    return Base.str();
+  SmallString<128> Path(Dir);
+  if (!Base.empty())
+    sys::path::append(Path, Base);
+  return std::string(Path);
+}
+
+static void fillLineInfoFromLocation(const SourceLocation &Location,
+                                     DILineInfoSpecifier Specifier,
+                                     DILineInfo &LineInfo) {
+  // GSYM stores whatever name the producer chose, which is the linkage name
+  // when one is available. There is no separate short name to return.
+  if (Specifier.FNKind != DILineInfoSpecifier::FunctionNameKind::None)
+    LineInfo.FunctionName = Location.Name.str();
+  LineInfo.FileName =
+      getFileName(Location.Dir, Location.Base, Specifier.FLIKind);
+  LineInfo.Line = Location.Line;
+}
+
+DILineInfo GsymContext::getLineInfoForAddress(object::SectionedAddress Address,
+                                              DILineInfoSpecifier Specifier) {
+  Expected<LookupResult> Result = Reader->lookup(Address.Address);
+  if (!Result) {
+    consumeError(Result.takeError());
+    if (Fallback)
+      return Fallback->getLineInfoForAddress(Address, Specifier);
+    return DILineInfo();
+  }
+
+  DILineInfo LineInfo;
+  if (!Result->Locations.empty()) {
+    // The deepest inlined function is at index zero.
+    fillLineInfoFromLocation(Result->Locations.front(), Specifier, LineInfo);
+  } else if (Specifier.FNKind !=
+             DILineInfoSpecifier::FunctionNameKind::None) {
+    LineInfo.FunctionName = Result->FuncName.str();
+  }
+  LineInfo.StartAddress = Result->FuncRange.start();
+  return LineInfo;
+}
+
+DILineInfo
+GsymContext::getLineInfoForDataAddress(object::SectionedAddress Address) {
+  // GSYM does not describe variables.
+  if (Fallback)
+    return Fallback->getLineInfoForDataAddress(Address);
+  return DILineInfo();
+}
+
+DILineInfoTable
+GsymContext::getLineInfoForAddressRange(object::SectionedAddress Address,
+                                        uint64_t Size,
+                                        DILineInfoSpecifier Specifier) {
+  if (Size == 0)
+    return DILineInfoTable();
+
+  Expected<FunctionInfo> FI = Reader->getFunctionInfo(Address.Address);
+  if (!FI || !FI->OptLineTable) {
+    if (!FI)
+      consumeError(FI.takeError());
+    if (Fallback)
+      return Fallback->getLineInfoForAddressRange(Address, Size, Specifier);
+    return DILineInfoTable();
+  }
+
+  DILineInfoTable Table;
+  const uint64_t EndAddr = Address.Address + Size;
+  StringRef FuncName = Reader->getString(FI->Name);
+  auto AddRow = [&](const LineEntry &LE) {
+    DILineInfo LineInfo;
+    if (Specifier.FNKind != DILineInfoSpecifier::FunctionNameKind::None)
+      LineInfo.FunctionName = FuncName.str();
+    if (std::optional<FileEntry> File = Reader->getFile(LE.File))
+      LineInfo.FileName =
+          getFileName(Reader->getString(File->Dir),
+                      Reader->getString(File->Base), Specifier.FLIKind);
+    LineInfo.Line = LE.Line;
+    LineInfo.StartAddress = FI->startAddress();
+    Table.push_back(std::make_pair(LE.Addr, LineInfo));
+  };
+
+  // Like DWARFContext, start with the row that covers the start address even
+  // if it begins before it, then add every row that begins inside the range.
+  std::optional<LineEntry> Covering;
+  for (const LineEntry &LE : *FI->OptLineTable) {
+    if (LE.Addr <= Address.Address) {
+      Covering = LE;
+      continue;
+    }
+    if (Covering) {
+      AddRow(*Covering);
+      Covering.reset();
+    }
+    if (LE.Addr >= EndAddr)
+      break;
+    AddRow(LE);
+  }
+  if (Covering)
+    AddRow(*Covering);
+  return Table;
+}
+
+DIInliningInfo
+GsymContext::getInliningInfoForAddress(object::SectionedAddress Address,
+                                       DILineInfoSpecifier Specifier) {
+  Expected<LookupResult> Result = Reader->lookup(Address.Address);
+  if (!Result) {
+    consumeError(Result.takeError());
+    if (Fallback)
+      return Fallback->getInliningInfoForAddress(Address, Specifier);
+    return DIInliningInfo();
+  }
+
+  DIInliningInfo InlineInfo;
+  for (const SourceLocation &Location : Result->Locations) {
+    DILineInfo LineInfo;
+    fillLineInfoFromLocation(Location, Specifier, LineInfo);
+    InlineInfo.addFrame(LineInfo);
+  }
+  if (InlineInfo.getNumberOfFrames() == 0) {
+    // No line table: report just the function that contains the address.
+    DILineInfo LineInfo;
+    if (Specifier.FNKind != DILineInfoSpecifier::FunctionNameKind::None)
+      LineInfo.FunctionName = Result->FuncName.str();
+    InlineInfo.addFrame(LineInfo);
+  }
+  return InlineInfo;
+}
+
+std::vector<DILocal>
+GsymContext::getLocalsForAddress(object::SectionedAddress Address) {
+  // GSYM does not describe variables.
+  if (Fallback)
+    return Fallback->getLocalsForAddress(Address);
+  return {};
+}
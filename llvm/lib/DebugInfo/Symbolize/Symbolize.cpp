@@ -15,6 +15,8 @@
 #include "llvm/ADT/STLExtras.h"
 #include "llvm/DebugInfo/BTF/BTFContext.h"
 #include "llvm/DebugInfo/DWARF/DWARFContext.h"
+#include "llvm/DebugInfo/GSYM/GsymContext.h"
+#include "llvm/DebugInfo/GSYM/GsymReader.h"
 #include "llvm/DebugInfo/PDB/PDB.h"
 #include "llvm/DebugInfo/PDB/PDBContext.h"
 #include "llvm/DebugInfo/Symbolize/SymbolizableObjectFile.h"
@@ -599,6 +601,50 @@ LLVMSymbolizer::createModuleInfo(const ObjectFile *Obj,
   return InsertResult.first->second.get();
 }
 
+// Returns true if the UUID recorded in the GSYM header matches the UUID of a
+// Mach-O binary, or the build ID of an ELF one, as llvm-gsymutil records them.
+// A GSYM file without a UUID, or a binary without one, is never used: a stale
+// sidecar file would silently produce wrong answers.
+static bool gsymMatchesBinary(const gsym::GsymReader &Reader,
+                              const ObjectFile &Obj) {
+  const gsym::Header &Hdr = Reader.getHeader();
+  ArrayRef<uint8_t> ID;
+  if (auto *MachO = dyn_cast<MachOObjectFile>(&Obj))
+    ID = MachO->getUuid();
+  else
+    ID = object::getBuildID(&Obj);
+  if (Hdr.UUIDSize == 0 || ID.empty())
+    return false;
+  return ArrayRef<uint8_t>(Hdr.UUID, Hdr.UUIDSize) == ID;
+}
+
+std::unique_ptr<gsym::GsymReader>
+LLVMSymbolizer::findGsymFile(const std::string &BinaryName,
+                             const ObjectFile &Obj) {
+  SmallVector<std::string, 2> Candidates;
+  Candidates.push_back(BinaryName + ".gsym");
+  StringRef FileName = sys::path::filename(BinaryName);
+  for (const std::string &Dir : Opts.GsymFileDirectory) {
+    SmallString<128> Path(Dir);
+    sys::path::append(Path, Twine(FileName) + ".gsym");
+    Candidates.push_back(std::string(Path));
+  }
+
+  for (const std::string &Path : Candidates) {
+    if (!sys::fs::exists(Path))
+      continue;
+    Expected<gsym::GsymReader> ReaderOrErr = gsym::GsymReader::openFile(Path);
+    if (!ReaderOrErr) {
+      consumeError(ReaderOrErr.takeError());
+      continue;
+    }
+    if (!gsymMatchesBinary(*ReaderOrErr, Obj))
+      continue;
+    return std::make_unique<gsym::GsymReader>(std::move(*ReaderOrErr));
+  }
+  return nullptr;
+}
+
 Expected<SymbolizableModule *>
 LLVMSymbolizer::getOrCreateModuleInfo(const std::string &ModuleName) {
   std::string BinaryName = ModuleName;
@@ -660,6 +706,11 @@ LLVMSymbolizer::getOrCreateModuleInfo(const std::string &ModuleName) {
     Context = DWARFContext::create(
         *Objects.second, DWARFContext::ProcessDebugRelocations::Process,
         nullptr, Opts.DWPName);
+  if (!Opts.DisableGsym && Context->getKind() == DIContext::CK_DWARF)
+    if (std::unique_ptr<gsym::GsymReader> Reader =
+            findGsymFile(BinaryName, *Objects.first))
+      Context = std::make_unique<gsym::GsymContext>(std::move(Reader),
+                                                    std::move(Context));
   auto ModuleOrErr =
       createModuleInfo(Objects.first, std::move(Context), ModuleName);
   if (ModuleOrErr) {
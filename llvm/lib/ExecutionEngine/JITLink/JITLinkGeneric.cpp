@@ -23,6 +23,7 @@ namespace jitlink {
 JITLinkerBase::~JITLinkerBase() = default;
 
 void JITLinkerBase::linkPhase1(std::unique_ptr<JITLinkerBase> Self) {
+  TimeTraceScope TimeScope("JITLink phase 1", G->getName());
 
   LLVM_DEBUG({
     dbgs() << "Starting link phase 1 for graph " << G->getName() << "\n";
@@ -69,6 +70,7 @@ void JITLinkerBase::linkPhase1(std::unique_ptr<JITLinkerBase> Self) {
 
 void JITLinkerBase::linkPhase2(std::unique_ptr<JITLinkerBase> Self,
                                AllocResult AR) {
+  TimeTraceScope TimeScope("JITLink phase 2", G->getName());
 
   if (AR)
     Alloc = std::move(*AR);
@@ -133,6 +135,7 @@ void JITLinkerBase::linkPhase2(std::unique_ptr<JITLinkerBase> Self,
 
 void JITLinkerBase::linkPhase3(std::unique_ptr<JITLinkerBase> Self,
                                Expected<AsyncLookupResult> LR) {
+  TimeTraceScope TimeScope("JITLink phase 3", G->getName());
 
   LLVM_DEBUG({
     dbgs() << "Starting link phase 3 for graph " << G->getName() << "\n";
@@ -188,6 +191,7 @@ void JITLinkerBase::linkPhase3(std::unique_ptr<JITLinkerBase> Self,
 
 void JITLinkerBase::linkPhase4(std::unique_ptr<JITLinkerBase> Self,
                                FinalizeResult FR) {
+  TimeTraceScope TimeScope("JITLink phase 4", G->getName());
 
   LLVM_DEBUG({
     dbgs() << "Starting link phase 4 for graph " << G->getName() << "\n";
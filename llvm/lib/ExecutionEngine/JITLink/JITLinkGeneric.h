@@ -14,6 +14,8 @@
 #define LIB_EXECUTIONENGINE_JITLINK_JITLINKGENERIC_H
 
 #include "llvm/ExecutionEngine/JITLink/JITLink.h"
+#include "llvm/Support/Parallel.h"
+#include "llvm/Support/TimeProfiler.h"
 
 #define DEBUG_TYPE "jitlink"
 
@@ -130,16 +132,17 @@ private:
   }
 
   Error fixUpBlocks(LinkGraph &G) const override {
+    TimeTraceScope TimeScope("JITLink fix up blocks");
     LLVM_DEBUG(dbgs() << "Fixing up blocks:\n");
 
+    // Gather the blocks to fix up. Content for no-alloc sections is copied
+    // onto the graph's allocator here, as that is not thread safe.
+    std::vector<Block *> Blocks;
+    size_t NumEdges = 0;
     for (auto &Sec : G.sections()) {
       bool NoAllocSection = Sec.getMemLifetime() == orc::MemLifetime::NoAlloc;
 
       for (auto *B : Sec.blocks()) {
-        LLVM_DEBUG(dbgs() << "  " << *B << ":\n");
-
-        // Copy Block data and apply fixups.
-        LLVM_DEBUG(dbgs() << "    Applying fixups.\n");
         assert((!B->isZeroFill() || all_of(B->edges(),
                                            [](const Edge &E) {
                                              return E.getKind() ==
@@ -153,29 +156,59 @@ private:
         if (NoAllocSection)
           (void)B->getMutableContent(G);
 
-        for (auto &E : B->edges()) {
+        // If B is a block in a Standard or Finalize section then make sure
+        // that no edges point to symbols in NoAlloc sections.
+        assert((NoAllocSection ||
+                none_of(B->edges(),
+                        [](const Edge &E) {
+                          return E.isRelocation() &&
+                                 E.getTarget().isDefined() &&
+                                 E.getTarget()
+                                         .getBlock()
+                                         .getSection()
+                                         .getMemLifetime() ==
+                                     orc::MemLifetime::NoAlloc;
+                        })) &&
+               "Block in allocated section has edge pointing to no-alloc "
+               "section");
+
+        Blocks.push_back(B);
+        NumEdges += B->edges_size();
+      }
+    }
 
-          // Skip non-relocation edges.
-          if (!E.isRelocation())
-            continue;
+    // Fixups only write to their own block's working memory, so blocks can
+    // be fixed up concurrently. Only bother for large graphs, and keep the
+    // debug output in order.
+    bool Parallel = NumEdges >= ParallelFixupThreshold;
+    LLVM_DEBUG(Parallel = false);
+    if (!Parallel) {
+      for (auto *B : Blocks)
+        if (auto Err = fixUpBlock(G, *B))
+          return Err;
+      return Error::success();
+    }
 
-          // If B is a block in a Standard or Finalize section then make sure
-          // that no edges point to symbols in NoAlloc sections.
-          assert((NoAllocSection || !E.getTarget().isDefined() ||
-                  E.getTarget().getBlock().getSection().getMemLifetime() !=
-                      orc::MemLifetime::NoAlloc) &&
-                 "Block in allocated section has edge pointing to no-alloc "
-                 "section");
+    return parallelForEachError(
+        Blocks, [&](Block *B) { return fixUpBlock(G, *B); });
+  }
 
-          // Dispatch to LinkerImpl for fixup.
-          if (auto Err = impl().applyFixup(G, *B, E))
-            return Err;
-        }
-      }
-    }
+  Error fixUpBlock(LinkGraph &G, Block &B) const {
+    LLVM_DEBUG(dbgs() << "  " << B << ":\n");
+    for (auto &E : B.edges()) {
+      // Skip non-relocation edges.
+      if (!E.isRelocation())
+        continue;
 
+      // Dispatch to LinkerImpl for fixup.
+      if (auto Err = impl().applyFixup(G, B, E))
+        return Err;
+    }
     return Error::success();
   }
+
+  /// The number of edges above which blocks are fixed up in parallel.
+  static constexpr size_t ParallelFixupThreshold = 1 << 16;
 };
 
 /// Removes dead symbols/blocks/addressables.
@@ -15,6 +15,7 @@
 
 #include "llvm/ExecutionEngine/JITLink/JITLink.h"
 #include "llvm/Support/Debug.h"
+#include "llvm/Support/TimeProfiler.h"
 
 #define DEBUG_TYPE "jitlink"
 
@@ -36,6 +37,7 @@ public:
   static Error asPass(LinkGraph &G) { return BuilderImplT(G).run(); }
 
   Error run() {
+    TimeTraceScope TimeScope("JITLink build GOT and PLT stubs");
     LLVM_DEBUG(dbgs() << "Running Per-Graph GOT and Stubs builder:\n");
 
     // We're going to be adding new blocks, but we don't want to iterate over
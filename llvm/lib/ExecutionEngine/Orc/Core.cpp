@@ -1120,6 +1120,7 @@ Error JITDylib::remove(const SymbolNameSet &Names) {
       }
 
       auto SymI = SymbolMaterializerItrPair.first;
+      ReadySymbols.remove(SymI->first);
       Symbols.erase(SymI);
     }
 
@@ -1323,6 +1324,7 @@ JITDylib::removeTracker(ResourceTracker &RT) {
              "Symbol has materializer attached");
     }
 
+    ReadySymbols.remove(I->first);
     Symbols.erase(I);
   }
 
@@ -1835,6 +1837,25 @@ ExecutionSession::lookup(const JITDylibSearchOrder &SearchOrder,
                          SymbolLookupSet Symbols, LookupKind K,
                          SymbolState RequiredState,
                          RegisterDependenciesFunction RegisterDependencies) {
+  // Fast path: symbols that are already Ready in the first JITDylib searched
+  // are the result of the lookup no matter what the rest of the search order
+  // would find, and they need no dependencies registered. If that covers all
+  // of them, answer without taking the session lock or building a query.
+  if (!SearchOrder.empty()) {
+    auto &[JD, JDLookupFlags] = SearchOrder.front();
+    SymbolMap Result;
+    for (auto &[Name, Flags] : Symbols) {
+      auto Sym = JD->ReadySymbols.find(Name);
+      if (!Sym || (JDLookupFlags ==
+                       JITDylibLookupFlags::MatchExportedSymbolsOnly &&
+                   !Sym->getFlags().isExported()))
+        break;
+      Result[Name] = *Sym;
+    }
+    if (Result.size() == Symbols.size())
+      return std::move(Result);
+  }
+
 #if LLVM_ENABLE_THREADS
   // In the threaded case we use promises to return the results.
   std::promise<SymbolMap> PromisedResult;
@@ -3118,6 +3139,8 @@ void ExecutionSession::IL_makeEDUReady(
            "Emitting from state other than Resolved");
 
     Entry.setState(SymbolState::Ready);
+    if (!Entry.getFlags().hasMaterializationSideEffectsOnly())
+      JD.ReadySymbols.add(SymbolStringPtr(Sym), Entry.getSymbol());
 
     auto MII = JD.MaterializingInfos.find(SymbolStringPtr(Sym));
 
@@ -28,6 +28,11 @@ public:
   getIndirectStubs(EPCIndirectionUtils &EPCIU, unsigned NumStubs) {
     return EPCIU.getIndirectStubs(NumStubs);
   };
+
+  static void releaseIndirectStubs(EPCIndirectionUtils &EPCIU,
+                                   ArrayRef<IndirectStubInfo> Stubs) {
+    EPCIU.releaseIndirectStubs(Stubs);
+  }
 };
 
 } // end namespace orc
@@ -69,6 +74,8 @@ public:
 
   Error updatePointer(StringRef Name, ExecutorAddr NewAddr) override;
 
+  void releaseStubs(ArrayRef<StringRef> Names) override;
+
 private:
   using StubInfo = std::pair<IndirectStubInfo, JITSymbolFlags>;
 
@@ -224,6 +231,21 @@ Error EPCIndirectStubsManager::updatePointer(StringRef Name,
   }
 }
 
+void EPCIndirectStubsManager::releaseStubs(ArrayRef<StringRef> Names) {
+  std::vector<IndirectStubInfo> Released;
+  {
+    std::lock_guard<std::mutex> Lock(ISMMutex);
+    for (StringRef Name : Names) {
+      auto I = StubInfos.find(Name);
+      if (I == StubInfos.end())
+        continue;
+      Released.push_back(I->second.first);
+      StubInfos.erase(I);
+    }
+  }
+  releaseIndirectStubs(EPCIU, Released);
+}
+
 } // end anonymous namespace.
 
 namespace llvm {
@@ -404,6 +426,12 @@ EPCIndirectionUtils::getIndirectStubs(unsigned NumStubs) {
   return std::move(Result);
 }
 
+void EPCIndirectionUtils::releaseIndirectStubs(
+    ArrayRef<IndirectStubInfo> Stubs) {
+  std::lock_guard<std::mutex> Lock(EPCUIMutex);
+  llvm::append_range(AvailableIndirectStubs, Stubs);
+}
+
 static JITTargetAddress reentry(JITTargetAddress LCTMAddr,
                                 JITTargetAddress TrampolineAddr) {
   auto &LCTM = *jitTargetAddressToPointer<LazyCallThroughManager *>(LCTMAddr);
@@ -0,0 +1,192 @@
+//===------ PersistentObjectCache.cpp - On-disk cache of JIT'd objects ----===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+#include "llvm/ExecutionEngine/Orc/PersistentObjectCache.h"
+#include "llvm/ADT/StringExtras.h"
+#include "llvm/Bitcode/BitcodeWriter.h"
+#include "llvm/ExecutionEngine/Orc/JITTargetMachineBuilder.h"
+#include "llvm/IR/Module.h"
+#include "llvm/Support/Debug.h"
+#include "llvm/Support/FileSystem.h"
+#include "llvm/Support/MemoryBuffer.h"
+#include "llvm/Support/Path.h"
+#include "llvm/Support/raw_sha1_ostream.h"
+#include <chrono>
+
+#define DEBUG_TYPE "orc"
+
+namespace llvm {
+namespace orc {
+
+/// Temporary files that are this old belong to a process that died while
+/// storing an entry, and are removed by prune().
+static constexpr std::chrono::hours OrphanedTempFileAge(1);
+
+/// Appends the target options that change the generated code to the key.
+static void addTargetOptions(raw_ostream &OS, const TargetOptions &Options) {
+  const unsigned Flags[] = {
+      Options.UnsafeFPMath,          Options.NoInfsFPMath,
+      Options.NoNaNsFPMath,          Options.NoTrappingFPMath,
+      Options.NoSignedZerosFPMath,   Options.ApproxFuncFPMath,
+      Options.HonorSignDependentRoundingFPMathOption,
+      Options.NoZerosInBSS,          Options.GuaranteedTailCallOpt,
+      Options.EnableFastISel,        Options.EnableGlobalISel,
+      Options.UseInitArray,          Options.FunctionSections,
+      Options.DataSections,          Options.UniqueSectionNames,
+      Options.TrapUnreachable,       Options.NoTrapAfterNoreturn,
+      Options.EmulatedTLS,           Options.EnableTLSDESC,
+      Options.EnableIPRA,            Options.EmitStackSizeSection,
+      Options.EnableMachineOutliner, Options.EmitAddrsig,
+      Options.EmitCallSiteInfo,      Options.EnableDebugEntryValues,
+      Options.ForceDwarfFrameSection,
+      Options.MCOptions.X86RelaxRelocations};
+  for (unsigned Flag : Flags)
+    OS << (Flag ? '1' : '0');
+  OS << '\0' << Options.LoopAlignment << '\0'
+     << static_cast<int>(Options.FloatABIType) << '\0'
+     << static_cast<int>(Options.AllowFPOpFusion) << '\0'
+     << static_cast<int>(Options.ThreadModel) << '\0'
+     << static_cast<int>(Options.EABIVersion) << '\0'
+     << static_cast<int>(Options.DebuggerTuning) << '\0'
+     << static_cast<int>(Options.ExceptionModel) << '\0';
+  for (DenormalMode Mode : {Options.getRawFPDenormalMode(),
+                            Options.getRawFP32DenormalMode()})
+    OS << static_cast<int>(Mode.Output) << ',' << static_cast<int>(Mode.Input)
+       << '\0';
+}
+
+static bool isTempFileName(StringRef Name) {
+  return Name.starts_with("orcjit-") && Name.ends_with(".tmp.o");
+}
+
+Expected<std::unique_ptr<PersistentObjectCache>>
+PersistentObjectCache::Create(StringRef CacheDir,
+                              const JITTargetMachineBuilder &JTMB,
+                              CachePruningPolicy Policy) {
+  if (auto EC = sys::fs::create_directories(CacheDir))
+    return createFileError(CacheDir, EC);
+
+  std::string ConfigKey;
+  raw_string_ostream OS(ConfigKey);
+  OS << JTMB.getTargetTriple().str() << '\0' << JTMB.getCPU() << '\0'
+     << JTMB.getFeatures().getString() << '\0'
+     << static_cast<int>(JTMB.getCodeGenOptLevel()) << '\0';
+  if (auto RM = JTMB.getRelocationModel())
+    OS << static_cast<int>(*RM);
+  OS << '\0';
+  if (auto CM = JTMB.getCodeModel())
+    OS << static_cast<int>(*CM);
+  OS << '\0';
+  addTargetOptions(OS, JTMB.getOptions());
+
+  std::unique_ptr<PersistentObjectCache> Cache(new PersistentObjectCache(
+      CacheDir.str(), std::move(ConfigKey), std::move(Policy)));
+  Cache->prune();
+  return std::move(Cache);
+}
+
+std::string PersistentObjectCache::getEntryPath(const Module &M) {
+  raw_sha1_ostream Hash;
+  Hash << ConfigKey << '\0';
+  WriteBitcodeToFile(M, Hash);
+
+  // This choice of file name allows the cache to be pruned (see pruneCache()
+  // in include/llvm/Support/CachePruning.h).
+  SmallString<128> Path(CacheDir);
+  sys::path::append(Path, "llvmcache-" + toHex(Hash.sha1()));
+  return std::string(Path);
+}
+
+std::unique_ptr<MemoryBuffer>
+PersistentObjectCache::getObject(const Module *M) {
+  std::string Path = getEntryPath(*M);
+
+  Expected<sys::fs::file_t> FD =
+      sys::fs::openNativeFileForRead(Path, sys::fs::OF_UpdateAtime);
+  if (FD) {
+    auto MB = MemoryBuffer::getOpenFile(*FD, Path, /*FileSize=*/-1,
+                                        /*RequiresNullTerminator=*/false);
+    sys::fs::closeFile(*FD);
+    if (MB) {
+      LLVM_DEBUG(dbgs() << "Object cache hit for "
+                        << M->getModuleIdentifier() << ": " << Path << "\n");
+      return std::move(*MB);
+    }
+  } else {
+    consumeError(FD.takeError());
+  }
+
+  std::lock_guard<std::mutex> Lock(PendingMutex);
+  PendingPaths[M] = std::move(Path);
+  return nullptr;
+}
+
+void PersistentObjectCache::notifyObjectCompiled(const Module *M,
+                                                 MemoryBufferRef Obj) {
+  std::string Path;
+  {
+    std::lock_guard<std::mutex> Lock(PendingMutex);
+    auto I = PendingPaths.find(M);
+    if (I == PendingPaths.end())
+      return;
+    Path = std::move(I->second);
+    PendingPaths.erase(I);
+  }
+
+  // Write to a temporary file and rename it into place, so that concurrent
+  // readers never see a partial entry. Failing to store is not an error:
+  // the object is simply compiled again next time.
+  SmallString<128> TempPath(CacheDir);
+  sys::path::append(TempPath, "orcjit-%%%%%%.tmp.o");
+  auto Temp = sys::fs::TempFile::create(TempPath);
+  if (!Temp) {
+    Error Err = Temp.takeError();
+    LLVM_DEBUG(dbgs() << "Could not create object cache entry: "
+                      << toString(std::move(Err)) << "\n");
+    consumeError(std::move(Err));
+    return;
+  }
+  {
+    raw_fd_ostream OS(Temp->FD, /*shouldClose=*/false);
+    OS << Obj.getBuffer();
+    OS.flush();
+    if (OS.has_error()) {
+      LLVM_DEBUG(dbgs() << "Could not write object cache entry "
+                        << Temp->TmpName << ": " << OS.error().message()
+                        << "\n");
+      OS.clear_error();
+      consumeError(Temp->discard());
+      return;
+    }
+  }
+  if (auto Err = Temp->keep(Path)) {
+    LLVM_DEBUG(dbgs() << "Could not store object cache entry " << Path
+                      << ": " << toString(std::move(Err)) << "\n");
+    consumeError(std::move(Err));
+    consumeError(Temp->discard());
+  }
+}
+
+bool PersistentObjectCache::prune() {
+  // pruneCache() only looks at entries, so remove the temporary files left
+  // behind by processes that were killed while storing one.
+  std::error_code EC;
+  auto Now = std::chrono::system_clock::now();
+  for (sys::fs::directory_iterator I(CacheDir, EC), E; I != E && !EC;
+       I.increment(EC)) {
+    if (!isTempFileName(sys::path::filename(I->path())))
+      continue;
+    ErrorOr<sys::fs::basic_file_status> Status = I->status();
+    if (Status && Now - Status->getLastModificationTime() > OrphanedTempFileAge)
+      sys::fs::remove(I->path());
+  }
+  return pruneCache(CacheDir, Policy);
+}
+
+} // end namespace orc
+} // end namespace llvm
@@ -0,0 +1,481 @@
+//===-------- ReOptimizeLayer.cpp - Recompile hot modules -----------------===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+#include "llvm/ExecutionEngine/Orc/ReOptimizeLayer.h"
+#include "llvm/ADT/STLExtras.h"
+#include "llvm/ADT/SmallVector.h"
+#include "llvm/ExecutionEngine/Orc/Mangling.h"
+#include "llvm/IR/IRBuilder.h"
+#include "llvm/IR/Module.h"
+#include "llvm/Support/Debug.h"
+
+#define DEBUG_TYPE "orc"
+
+using namespace llvm;
+using namespace llvm::orc;
+
+/// Renames \p F to its name plus \p Suffix and makes it a hidden external
+/// definition. All uses, including recursive calls and address-taken uses,
+/// are redirected to a new declaration under the original name, which will
+/// resolve to the stub.
+static Function *renameBehindStub(Function &F, const Twine &Suffix) {
+  Module &M = *F.getParent();
+  std::string Name = F.getName().str();
+  F.setName(Name + Suffix);
+
+  auto *Decl = Function::Create(F.getFunctionType(),
+                                GlobalValue::ExternalLinkage, Name, M);
+  Decl->setCallingConv(F.getCallingConv());
+  Decl->setAttributes(F.getAttributes());
+  F.replaceAllUsesWith(Decl);
+
+  F.setLinkage(GlobalValue::ExternalLinkage);
+  F.setVisibility(GlobalValue::HiddenVisibility);
+  F.setDLLStorageClass(GlobalValue::DefaultStorageClass);
+  F.setComdat(nullptr);
+  return &F;
+}
+
+/// Gives every function entry of the unit a shared counter, and calls
+/// \p Handler with \p Layer and \p UnitID on the entry that brings the
+/// counter to \p Threshold.
+static void addCallCounter(Function &F, GlobalVariable &Counter,
+                           uint64_t Threshold, ExecutorAddr Handler,
+                           ExecutorAddr Layer, uint64_t UnitID) {
+  LLVMContext &Ctx = F.getContext();
+  BasicBlock &Body = F.getEntryBlock();
+  auto *Entry = BasicBlock::Create(Ctx, "reopt.count", &F, &Body);
+  auto *Reached = BasicBlock::Create(Ctx, "reopt.reached", &F, &Body);
+
+  // Keep fixed size allocas in the entry block so that they stay static.
+  for (Instruction &I : make_early_inc_range(Body))
+    if (auto *AI = dyn_cast<AllocaInst>(&I))
+      if (isa<Constant>(AI->getArraySize()))
+        AI->moveBefore(*Entry, Entry->end());
+
+  IRBuilder<> B(Entry);
+  Value *Old =
+      B.CreateAtomicRMW(AtomicRMWInst::Add, &Counter, B.getInt64(1),
+                        MaybeAlign(8), AtomicOrdering::Monotonic);
+  B.CreateCondBr(B.CreateICmpEQ(Old, B.getInt64(Threshold - 1)), Reached,
+                 &Body);
+
+  B.SetInsertPoint(Reached);
+  auto *HandlerTy = FunctionType::get(
+      B.getVoidTy(), {B.getPtrTy(), B.getInt64Ty()}, /*isVarArg=*/false);
+  auto *HandlerPtr = ConstantExpr::getIntToPtr(
+      B.getInt64(Handler.getValue()), B.getPtrTy());
+  auto *LayerPtr =
+      ConstantExpr::getIntToPtr(B.getInt64(Layer.getValue()), B.getPtrTy());
+  B.CreateCall(HandlerTy, HandlerPtr, {LayerPtr, B.getInt64(UnitID)});
+  B.CreateBr(&Body);
+}
+
+/// Emits the optimized definitions of a unit from the copy of its module
+/// that was taken before instrumentation. Lives in the module's tracker, so
+/// the copy is freed when the module is removed.
+class ReOptimizeLayer::OptimizedModuleMaterializationUnit
+    : public MaterializationUnit {
+public:
+  OptimizedModuleMaterializationUnit(ReOptimizeLayer &L, uint64_t UnitID,
+                                     ThreadSafeModule TSM,
+                                     SymbolFlagsMap SymbolFlags)
+      : MaterializationUnit(Interface(std::move(SymbolFlags), nullptr)), L(L),
+        UnitID(UnitID), TSM(std::move(TSM)) {}
+
+  StringRef getName() const override { return "ReOptimizeLayer"; }
+
+  void materialize(std::unique_ptr<MaterializationResponsibility> R) override {
+    L.emitOptimized(std::move(R), UnitID, std::move(TSM));
+  }
+
+private:
+  // emitOptimized only defines the symbols that R is responsible for.
+  void discard(const JITDylib &JD, const SymbolStringPtr &Name) override {}
+
+  ReOptimizeLayer &L;
+  uint64_t UnitID;
+  ThreadSafeModule TSM;
+};
+
+ReOptimizeLayer::ReOptimizeLayer(
+    ExecutionSession &ES, IRLayer &BaseLayer,
+    IndirectStubsManagerBuilder BuildIndirectStubsManager,
+    OptimizeFunction Optimize, uint64_t CallCountThreshold)
+    : IRLayer(ES, BaseLayer.getManglingOptions()), BaseLayer(BaseLayer),
+      BuildIndirectStubsManager(std::move(BuildIndirectStubsManager)),
+      Optimize(std::move(Optimize)),
+      CallCountThreshold(CallCountThreshold) {
+  assert(CallCountThreshold > 0 && "Threshold must be at least one call");
+  ES.registerResourceManager(*this);
+}
+
+ReOptimizeLayer::~ReOptimizeLayer() {
+  getExecutionSession().deregisterResourceManager(*this);
+}
+
+IndirectStubsManager &ReOptimizeLayer::getStubsManager(JITDylib &JD) {
+  std::lock_guard<std::mutex> Lock(UnitsMutex);
+  auto &ISM = DylibStubs[&JD];
+  if (!ISM)
+    ISM = BuildIndirectStubsManager();
+  return *ISM;
+}
+
+void ReOptimizeLayer::emit(std::unique_ptr<MaterializationResponsibility> R,
+                           ThreadSafeModule TSM) {
+  assert(TSM && "Null module");
+  auto &ES = getExecutionSession();
+
+  // Collect the functions to put behind stubs.
+  std::vector<Redirection> Redirected;
+  TSM.withModuleDo([&](Module &M) {
+    if (!M.alias_empty() || !M.ifunc_empty())
+      return;
+    MangleAndInterner Mangle(ES, M.getDataLayout());
+    for (auto &F : M.functions()) {
+      if (F.isDeclaration() || F.hasLocalLinkage() ||
+          F.hasAvailableExternallyLinkage())
+        continue;
+      auto Name = Mangle(F.getName());
+      if (R->getSymbols().count(Name)) {
+        Redirected.emplace_back();
+        Redirected.back().IRName = F.getName().str();
+        Redirected.back().Stub = std::move(Name);
+      }
+    }
+  });
+  if (Redirected.empty()) {
+    BaseLayer.emit(std::move(R), std::move(TSM));
+    return;
+  }
+
+  uint64_t UnitID;
+  {
+    std::lock_guard<std::mutex> Lock(UnitsMutex);
+    UnitID = NextUnitID++;
+  }
+
+  SymbolFlagsMap NewSymbols;
+  TSM.withModuleDo([&](Module &M) {
+    MangleAndInterner Mangle(ES, M.getDataLayout());
+
+    // The optimized copy must share the module's state, so give the local
+    // variables unique external names it can refer to.
+    for (auto &GV : M.globals()) {
+      if (!GV.hasLocalLinkage())
+        continue;
+      GV.setName((GV.hasName() ? GV.getName() : "__reopt.anon") +
+                 ".__reopt." + Twine(UnitID));
+      GV.setLinkage(GlobalValue::ExternalLinkage);
+      GV.setVisibility(GlobalValue::HiddenVisibility);
+      NewSymbols[Mangle(GV.getName())] = JITSymbolFlags::fromGlobalValue(GV);
+    }
+  });
+
+  ThreadSafeModule Source = cloneToNewContext(TSM);
+
+  SymbolFlagsMap OptimizedSymbols;
+  TSM.withModuleDo([&](Module &M) {
+    MangleAndInterner Mangle(ES, M.getDataLayout());
+    auto *Counter = new GlobalVariable(
+        M, Type::getInt64Ty(M.getContext()), /*isConstant=*/false,
+        GlobalValue::PrivateLinkage,
+        ConstantInt::get(Type::getInt64Ty(M.getContext()), 0),
+        "__reopt.count");
+    for (auto &Rd : Redirected) {
+      Function *F = renameBehindStub(*M.getFunction(Rd.IRName), ".__reopt.0");
+      addCallCounter(*F, *Counter, CallCountThreshold,
+                     ExecutorAddr::fromPtr(&handleCallCountReached),
+                     ExecutorAddr::fromPtr(this), UnitID);
+      auto Flags = JITSymbolFlags::fromGlobalValue(*F);
+      Rd.FirstTier = Mangle(F->getName());
+      Rd.SecondTier = Mangle(Rd.IRName + ".__reopt.1");
+      NewSymbols[Rd.FirstTier] = Flags;
+      NewSymbols[Rd.SecondTier] = Flags;
+      OptimizedSymbols[Rd.SecondTier] = Flags;
+    }
+  });
+
+  // Split off the responsibility for the original names, which become the
+  // stubs, add the renamed definitions to what R materializes, and hand the
+  // optimized definitions to a lazy unit in the same tracker.
+  if (auto Err = R->defineMaterializing(std::move(NewSymbols))) {
+    ES.reportError(std::move(Err));
+    R->failMaterialization();
+    return;
+  }
+  if (auto Err = R->withResourceKeyDo([&](ResourceKey K) {
+        auto U = std::make_unique<Unit>();
+        U->JD = &R->getTargetJITDylib();
+        U->Key = K;
+        U->Redirected = Redirected;
+        std::lock_guard<std::mutex> Lock(UnitsMutex);
+        Units[UnitID] = std::move(U);
+      })) {
+    ES.reportError(std::move(Err));
+    R->failMaterialization();
+    return;
+  }
+  auto OptimizedMU = std::make_unique<OptimizedModuleMaterializationUnit>(
+      *this, UnitID, std::move(Source), std::move(OptimizedSymbols));
+  if (auto Err = R->replace(std::move(OptimizedMU))) {
+    ES.reportError(std::move(Err));
+    R->failMaterialization();
+    return;
+  }
+  SymbolNameSet StubNames;
+  for (auto &Rd : Redirected)
+    StubNames.insert(Rd.Stub);
+  auto StubsR = R->delegate(StubNames);
+  if (!StubsR) {
+    ES.reportError(StubsR.takeError());
+    R->failMaterialization();
+    return;
+  }
+
+  // Resolve the stubs right away so that the module, which calls through
+  // them, can be linked. They are pointed at the definitions once those
+  // have addresses, and are not emitted before then.
+  JITDylib &JD = R->getTargetJITDylib();
+  IndirectStubsManager &ISM = getStubsManager(JD);
+  IndirectStubsManager::StubInitsMap StubInits;
+  for (auto &KV : (*StubsR)->getSymbols())
+    StubInits[*KV.first] = {ExecutorAddr(), KV.second};
+  if (auto Err = ISM.createStubs(StubInits)) {
+    ES.reportError(std::move(Err));
+    (*StubsR)->failMaterialization();
+    R->failMaterialization();
+    return;
+  }
+  SymbolMap StubSyms;
+  for (auto &KV : (*StubsR)->getSymbols())
+    StubSyms[KV.first] = ISM.findStub(*KV.first, false);
+  if (auto Err = (*StubsR)->notifyResolved(StubSyms)) {
+    ES.reportError(std::move(Err));
+    (*StubsR)->failMaterialization();
+    R->failMaterialization();
+    return;
+  }
+
+  BaseLayer.emit(std::move(R), std::move(TSM));
+
+  SymbolLookupSet LookupSet;
+  for (auto &Rd : Redirected)
+    LookupSet.add(Rd.FirstTier);
+  ES.lookup(
+      LookupKind::Static, {{&JD, JITDylibLookupFlags::MatchAllSymbols}},
+      std::move(LookupSet), SymbolState::Resolved,
+      [this, &JD, &ISM, UnitID,
+       StubsR = std::move(*StubsR)](Expected<SymbolMap> Result) mutable {
+        auto &ES = getExecutionSession();
+        if (!Result) {
+          ES.reportError(Result.takeError());
+          StubsR->failMaterialization();
+          return;
+        }
+        SymbolDependenceGroup DepGroup;
+        {
+          // The stubs are released with the unit, so update them while it
+          // cannot be removed.
+          std::lock_guard<std::mutex> Lock(UnitsMutex);
+          auto I = Units.find(UnitID);
+          if (I == Units.end()) {
+            StubsR->failMaterialization();
+            return;
+          }
+          for (auto &Rd : I->second->Redirected) {
+            // Kept for the functions that the optimizer drops.
+            Rd.FirstTierAddr = (*Result)[Rd.FirstTier].getAddress();
+            if (auto Err = ISM.updatePointer(*Rd.Stub, Rd.FirstTierAddr)) {
+              ES.reportError(std::move(Err));
+              StubsR->failMaterialization();
+              return;
+            }
+            DepGroup.Symbols.insert(Rd.Stub);
+            DepGroup.Dependencies[&JD].insert(Rd.FirstTier);
+          }
+        }
+        if (auto Err = StubsR->notifyEmitted(DepGroup)) {
+          ES.reportError(std::move(Err));
+          StubsR->failMaterialization();
+        }
+      },
+      NoDependenciesToRegister);
+}
+
+void ReOptimizeLayer::handleCallCountReached(void *Layer, uint64_t UnitID) {
+  auto &L = *static_cast<ReOptimizeLayer *>(Layer);
+  L.getExecutionSession().dispatchTask(makeGenericNamedTask(
+      [&L, UnitID]() { L.reoptimize(UnitID); }, "ReOptimizeLayer"));
+}
+
+void ReOptimizeLayer::reoptimize(uint64_t UnitID) {
+  auto &ES = getExecutionSession();
+  JITDylib *JD;
+  SymbolLookupSet LookupSet;
+  {
+    std::lock_guard<std::mutex> Lock(UnitsMutex);
+    // The module may have been removed since the counter fired.
+    auto I = Units.find(UnitID);
+    if (I == Units.end())
+      return;
+    JD = I->second->JD;
+    for (auto &Rd : I->second->Redirected)
+      LookupSet.add(Rd.SecondTier);
+  }
+
+  // Looking up the optimized definitions materializes them.
+  ES.lookup(
+      LookupKind::Static, {{JD, JITDylibLookupFlags::MatchAllSymbols}},
+      std::move(LookupSet), SymbolState::Ready,
+      [this, UnitID](Expected<SymbolMap> Result) {
+        auto &ES = getExecutionSession();
+        if (!Result) {
+          ES.reportError(Result.takeError());
+          return;
+        }
+        std::lock_guard<std::mutex> Lock(UnitsMutex);
+        auto I = Units.find(UnitID);
+        if (I == Units.end())
+          return;
+        auto &ISM = *DylibStubs[I->second->JD];
+        for (auto &Rd : I->second->Redirected)
+          if (auto Err = ISM.updatePointer(
+                  *Rd.Stub, (*Result)[Rd.SecondTier].getAddress())) {
+            ES.reportError(std::move(Err));
+            return;
+          }
+        LLVM_DEBUG({
+          dbgs() << "ReOptimizeLayer: redirected "
+                 << I->second->Redirected.size()
+                 << " stubs to optimized code\n";
+        });
+        ++NumReOptimized;
+      },
+      NoDependenciesToRegister);
+}
+
+void ReOptimizeLayer::emitOptimized(
+    std::unique_ptr<MaterializationResponsibility> R, uint64_t UnitID,
+    ThreadSafeModule TSM) {
+  auto &ES = getExecutionSession();
+
+  std::vector<Redirection> Redirected;
+  {
+    std::lock_guard<std::mutex> Lock(UnitsMutex);
+    auto I = Units.find(UnitID);
+    if (I == Units.end()) {
+      R->failMaterialization();
+      return;
+    }
+    Redirected = I->second->Redirected;
+  }
+
+  // Everything but the code belongs to the first tier: refer to its
+  // variables, keeping constant initializers visible to the optimizer, and
+  // do not run its constructors again.
+  TSM.withModuleDo([&](Module &M) {
+    for (auto *Name : {"llvm.global_ctors", "llvm.global_dtors"})
+      if (auto *GV = M.getNamedGlobal(Name))
+        GV->eraseFromParent();
+    for (auto &GV : M.globals()) {
+      if (GV.isDeclaration() || GV.getName().starts_with("llvm."))
+        continue;
+      GV.setComdat(nullptr);
+      if (GV.isConstant()) {
+        GV.setLinkage(GlobalValue::AvailableExternallyLinkage);
+      } else {
+        GV.setInitializer(nullptr);
+        GV.setLinkage(GlobalValue::ExternalLinkage);
+      }
+    }
+  });
+
+  if (auto Err = Optimize(TSM)) {
+    ES.reportError(std::move(Err));
+    R->failMaterialization();
+    return;
+  }
+
+  // Functions that the optimizer dropped keep running the first tier.
+  SymbolMap Dropped;
+  SymbolDependenceGroup DroppedDeps;
+  JITDylib &JD = R->getTargetJITDylib();
+  TSM.withModuleDo([&](Module &M) {
+    for (auto &Rd : Redirected) {
+      Function *F = M.getFunction(Rd.IRName);
+      auto Flags = R->getSymbols().find(Rd.SecondTier);
+      if (Flags == R->getSymbols().end()) {
+        // Discarded: calls go to the stub.
+        if (F && !F->isDeclaration())
+          F->deleteBody();
+        continue;
+      }
+      if (F && !F->isDeclaration()) {
+        renameBehindStub(*F, ".__reopt.1");
+        continue;
+      }
+      Dropped[Rd.SecondTier] = {Rd.FirstTierAddr, Flags->second};
+      DroppedDeps.Symbols.insert(Rd.SecondTier);
+      DroppedDeps.Dependencies[&JD].insert(Rd.FirstTier);
+    }
+  });
+
+  if (!Dropped.empty()) {
+    SymbolNameSet DroppedNames;
+    for (auto &KV : Dropped)
+      DroppedNames.insert(KV.first);
+    auto DroppedR = R->delegate(DroppedNames);
+    if (!DroppedR) {
+      ES.reportError(DroppedR.takeError());
+      R->failMaterialization();
+      return;
+    }
+    if (auto Err = (*DroppedR)->notifyResolved(Dropped)) {
+      ES.reportError(std::move(Err));
+      (*DroppedR)->failMaterialization();
+      R->failMaterialization();
+      return;
+    }
+    if (auto Err = (*DroppedR)->notifyEmitted(DroppedDeps)) {
+      ES.reportError(std::move(Err));
+      (*DroppedR)->failMaterialization();
+      R->failMaterialization();
+      return;
+    }
+  }
+
+  if (R->getSymbols().empty())
+    return;
+  BaseLayer.emit(std::move(R), std::move(TSM));
+}
+
+Error ReOptimizeLayer::handleRemoveResources(JITDylib &JD, ResourceKey K) {
+  std::lock_guard<std::mutex> Lock(UnitsMutex);
+  for (auto I = Units.begin(), E = Units.end(); I != E;) {
+    auto Cur = I++;
+    if (Cur->second->Key != K)
+      continue;
+    // The module's code, which calls the stubs, is removed with the tracker.
+    SmallVector<StringRef> StubNames;
+    for (auto &Rd : Cur->second->Redirected)
+      StubNames.push_back(*Rd.Stub);
+    DylibStubs[Cur->second->JD]->releaseStubs(StubNames);
+    Units.erase(Cur);
+  }
+  return Error::success();
+}
+
+void ReOptimizeLayer::handleTransferResources(JITDylib &JD, ResourceKey DstK,
+                                              ResourceKey SrcK) {
+  std::lock_guard<std::mutex> Lock(UnitsMutex);
+  for (auto &KV : Units)
+    if (KV.second->Key == SrcK)
+      KV.second->Key = DstK;
+}
@@ -885,10 +885,37 @@ Constant *ConstantInt::getBool(Type *Ty, bool V) {
   return V ? getTrue(Ty) : getFalse(Ty);
 }
 
+/// ConstantInt::get for contexts in concurrent uniquing mode.
+static ConstantInt *getConcurrentConstantInt(LLVMContext &Context,
+                                             const APInt &V) {
+  LLVMContextImpl *pImpl = Context.pImpl;
+  IntegerType *ITy = IntegerType::get(Context, V.getBitWidth());
+  if (V.isZero() || V.isOne()) {
+    std::lock_guard<std::mutex> Lock(pImpl->ScalarUniquingLock);
+    std::unique_ptr<ConstantInt> &Slot =
+        V.isZero() ? pImpl->IntZeroConstants[V.getBitWidth()]
+                   : pImpl->IntOneConstants[V.getBitWidth()];
+    if (!Slot)
+      Slot.reset(new ConstantInt(ITy, V));
+    return Slot.get();
+  }
+
+  LLVMContextImpl::IntConstantShard &Shard =
+      pImpl->IntConstantShards[hash_value(V) %
+                               LLVMContextImpl::NumIntConstantShards];
+  std::lock_guard<std::mutex> Lock(Shard.Lock);
+  std::unique_ptr<ConstantInt> &Slot = Shard.Constants[V];
+  if (!Slot)
+    Slot.reset(new ConstantInt(ITy, V));
+  return Slot.get();
+}
+
 // Get a ConstantInt from an APInt.
 ConstantInt *ConstantInt::get(LLVMContext &Context, const APInt &V) {
   // get an existing value or the insertion position
   LLVMContextImpl *pImpl = Context.pImpl;
+  if (pImpl->IntConstantShards)
+    return getConcurrentConstantInt(Context, V);
   std::unique_ptr<ConstantInt> &Slot =
       V.isZero()  ? pImpl->IntZeroConstants[V.getBitWidth()]
       : V.isOne() ? pImpl->IntOneConstants[V.getBitWidth()]
@@ -1051,6 +1078,10 @@ Constant *ConstantFP::getZero(Type *Ty, bool Negative) {
 ConstantFP* ConstantFP::get(LLVMContext &Context, const APFloat& V) {
   LLVMContextImpl* pImpl = Context.pImpl;
 
+  std::unique_lock<std::mutex> Lock;
+  if (pImpl->IntConstantShards)
+    Lock = std::unique_lock<std::mutex>(pImpl->ScalarUniquingLock);
+
   std::unique_ptr<ConstantFP> &Slot = pImpl->FPConstants[V];
 
   if (!Slot) {
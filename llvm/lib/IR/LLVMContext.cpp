@@ -352,6 +352,29 @@ bool LLVMContext::shouldDiscardValueNames() const {
   return pImpl->DiscardValueNames;
 }
 
+bool LLVMContext::hasConcurrentConstantUniquing() const {
+  return !!pImpl->IntConstantShards;
+}
+
+void LLVMContext::enableConcurrentConstantUniquing() {
+  if (pImpl->IntConstantShards)
+    return;
+
+  // Populate the lazily created i1 constants now so that getTrue() and
+  // getFalse() do not race on their caches later.
+  ConstantInt::getTrue(*this);
+  ConstantInt::getFalse(*this);
+
+  // Move what has been uniqued so far into the shards.
+  constexpr unsigned NumShards = LLVMContextImpl::NumIntConstantShards;
+  pImpl->IntConstantShards =
+      std::make_unique<LLVMContextImpl::IntConstantShard[]>(NumShards);
+  for (auto &[V, C] : pImpl->IntConstants)
+    pImpl->IntConstantShards[hash_value(V) % NumShards].Constants[V] =
+        std::move(C);
+  pImpl->IntConstants.clear();
+}
+
 bool LLVMContext::isODRUniquingDebugTypes() const { return !!pImpl->DITypeMap; }
 
 void LLVMContext::enableDebugTypeODRUniquing() {
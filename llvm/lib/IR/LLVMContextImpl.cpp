@@ -119,6 +119,9 @@ LLVMContextImpl::~LLVMContextImpl() {
   IntZeroConstants.clear();
   IntOneConstants.clear();
   IntConstants.clear();
+  if (IntConstantShards)
+    for (unsigned I = 0; I != NumIntConstantShards; ++I)
+      IntConstantShards[I].Constants.clear();
   IntSplatConstants.clear();
   FPConstants.clear();
   FPSplatConstants.clear();
@@ -45,6 +45,7 @@
 #include <cstddef>
 #include <cstdint>
 #include <memory>
+#include <mutex>
 #include <optional>
 #include <string>
 #include <utility>
@@ -1512,6 +1513,18 @@ public:
   DenseMap<std::pair<ElementCount, APFloat>, std::unique_ptr<ConstantFP>>
       FPSplatConstants;
 
+  /// In concurrent uniquing mode, ConstantInts other than zero and one live in
+  /// these shards instead of IntConstants, selected by the hash of the value.
+  /// Everything else that ConstantInt::get, ConstantFP::get and
+  /// IntegerType::get touch is guarded by ScalarUniquingLock.
+  struct IntConstantShard {
+    std::mutex Lock;
+    DenseMap<APInt, std::unique_ptr<ConstantInt>> Constants;
+  };
+  static constexpr unsigned NumIntConstantShards = 32;
+  std::unique_ptr<IntConstantShard[]> IntConstantShards;
+  std::mutex ScalarUniquingLock;
+
   FoldingSet<AttributeImpl> AttrsSet;
   FoldingSet<AttributeListImpl> AttrsLists;
   FoldingSet<AttributeSetNode> AttrsSetNodes;
@@ -29,6 +29,8 @@
 #include "llvm/IR/GlobalIFunc.h"
 #include "llvm/IR/GlobalValue.h"
 #include "llvm/IR/GlobalVariable.h"
+#include "llvm/IR/InstrTypes.h"
+#include "llvm/IR/Instructions.h"
 #include "llvm/IR/LLVMContext.h"
 #include "llvm/IR/Metadata.h"
 #include "llvm/IR/ModuleSummaryIndex.h"
@@ -40,12 +42,14 @@
 #include "llvm/Support/Casting.h"
 #include "llvm/Support/CodeGen.h"
 #include "llvm/Support/Error.h"
+#include "llvm/Support/Format.h"
 #include "llvm/Support/MemoryBuffer.h"
 #include "llvm/Support/Path.h"
 #include "llvm/Support/RandomNumberGenerator.h"
 #include "llvm/Support/VersionTuple.h"
 #include <algorithm>
 #include <cassert>
+#include <cinttypes>
 #include <cstdint>
 #include <memory>
 #include <optional>
@@ -895,3 +899,82 @@ VersionTuple Module::getDarwinTargetVariantSDKVersion() const {
 void Module::setDarwinTargetVariantSDKVersion(VersionTuple Version) {
   addSDKVersionMD(Version, *this, "darwin.target_variant.SDK Version");
 }
+
+static size_t getInstructionSize(const Instruction &I) {
+  switch (I.getOpcode()) {
+#define HANDLE_INST(N, OPC, CLASS)                                             \
+  case Instruction::OPC:                                                       \
+    return sizeof(CLASS);
+#include "llvm/IR/Instruction.def"
+  }
+  llvm_unreachable("unknown instruction opcode");
+}
+
+void Module::printMemoryStats(raw_ostream &OS) const {
+  struct KindStats {
+    uint64_t Count = 0;
+    uint64_t Bytes = 0;
+  };
+  StringMap<KindStats> Stats;
+  auto Add = [&](StringRef Kind, uint64_t Bytes) {
+    KindStats &S = Stats[Kind];
+    ++S.Count;
+    S.Bytes += Bytes;
+  };
+  auto AddName = [&](const Value &V) {
+    if (V.hasName())
+      Add("ValueName", sizeof(ValueName) + V.getName().size() + 1);
+  };
+  auto AddGlobal = [&](StringRef Kind, const GlobalValue &GV, size_t Size) {
+    Add(Kind, Size + GV.getNumOperands() * sizeof(Use));
+    AddName(GV);
+  };
+
+  for (const GlobalVariable &GV : globals())
+    AddGlobal("GlobalVariable", GV, sizeof(GlobalVariable));
+  for (const GlobalAlias &GA : aliases())
+    AddGlobal("GlobalAlias", GA, sizeof(GlobalAlias));
+  for (const GlobalIFunc &GI : ifuncs())
+    AddGlobal("GlobalIFunc", GI, sizeof(GlobalIFunc));
+  for (const Function &F : *this) {
+    AddGlobal("Function", F, sizeof(Function));
+    for (const Argument &A : F.args()) {
+      Add("Argument", sizeof(Argument));
+      AddName(A);
+    }
+    for (const BasicBlock &BB : F) {
+      Add("BasicBlock", sizeof(BasicBlock));
+      AddName(BB);
+      for (const Instruction &I : BB) {
+        // Uses are either co-allocated in front of the instruction or hung
+        // off it; PHI nodes also keep an array of incoming blocks.
+        uint64_t Bytes =
+            getInstructionSize(I) + I.getNumOperands() * sizeof(Use);
+        if (isa<PHINode>(I))
+          Bytes += I.getNumOperands() * sizeof(BasicBlock *);
+        Add(I.getOpcodeName(), Bytes);
+        AddName(I);
+      }
+    }
+  }
+
+  std::vector<std::pair<StringRef, KindStats>> Sorted;
+  uint64_t TotalBytes = 0;
+  for (const auto &Entry : Stats) {
+    Sorted.emplace_back(Entry.getKey(), Entry.getValue());
+    TotalBytes += Entry.getValue().Bytes;
+  }
+  llvm::sort(Sorted, [](const auto &A, const auto &B) {
+    if (A.second.Bytes != B.second.Bytes)
+      return A.second.Bytes > B.second.Bytes;
+    return A.first < B.first;
+  });
+
+  OS << "IR memory statistics for module '" << getModuleIdentifier()
+     << "' (approximate):\n";
+  OS << format("%12s %14s  %s\n", "Count", "Bytes", "Kind");
+  for (const auto &[Kind, S] : Sorted)
+    OS << format("%12" PRIu64 " %14" PRIu64 "  ", S.Count, S.Bytes) << Kind
+       << '\n';
+  OS << format("%12s %14" PRIu64 "  ", "", TotalBytes) << "Total\n";
+}
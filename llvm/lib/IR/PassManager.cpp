@@ -8,6 +8,7 @@
 
 #include "llvm/IR/PassManager.h"
 #include "llvm/IR/PassManagerImpl.h"
+#include "llvm/Support/Error.h"
 #include <optional>
 
 using namespace llvm;
@@ -114,6 +115,14 @@ PreservedAnalyses ModuleToFunctionPassAdaptor::run(Module &M,
     if (F.isDeclaration())
       continue;
 
+    // Bodies of lazily loaded modules are read right before their passes run,
+    // so only the functions visited so far are resident.
+    if (F.isMaterializable())
+      handleAllErrors(F.materialize(), [&](ErrorInfoBase &EIB) {
+        report_fatal_error(Twine("Error reading bitcode file: ") +
+                           EIB.message());
+      });
+
     // Check the PassInstrumentation's BeforePass callbacks before running the
     // pass, skip its execution completely if asked to (callback returns
     // false).
@@ -291,6 +291,10 @@ IntegerType *IntegerType::get(LLVMContext &C, unsigned NumBits) {
     break;
   }
 
+  std::unique_lock<std::mutex> Lock;
+  if (C.pImpl->IntConstantShards)
+    Lock = std::unique_lock<std::mutex>(C.pImpl->ScalarUniquingLock);
+
   IntegerType *&Entry = C.pImpl->IntegerTypes[NumBits];
 
   if (!Entry)
@@ -83,23 +83,9 @@ extern cl::opt<bool> SupportsHotColdNew;
 extern cl::opt<bool> EnableMemProfContextDisambiguation;
 } // namespace llvm
 
-// Computes a unique hash for the Module considering the current list of
-// export/import and other global analysis results.
-// The hash is produced in \p Key.
-void llvm::computeLTOCacheKey(
-    SmallString<40> &Key, const Config &Conf, const ModuleSummaryIndex &Index,
-    StringRef ModuleID, const FunctionImporter::ImportMapTy &ImportList,
-    const FunctionImporter::ExportSetTy &ExportList,
-    const std::map<GlobalValue::GUID, GlobalValue::LinkageTypes> &ResolvedODR,
-    const GVSummaryMapTy &DefinedGlobals,
-    const std::set<GlobalValue::GUID> &CfiFunctionDefs,
-    const std::set<GlobalValue::GUID> &CfiFunctionDecls) {
-  // Compute the unique hash for this entry.
-  // This is based on the current compiler version, the module itself, the
-  // export list, the hash for every single module in the import list, the
-  // list of ResolvedODR for the module, and the list of preserved symbols.
-  SHA1 Hasher;
-
+// Adds the compiler revision and the parts of the LTO configuration that
+// affect code generation to \p Hasher.
+static void addLTOConfigToHash(SHA1 &Hasher, const Config &Conf) {
   // Start with the compiler revision
   Hasher.update(LLVM_VERSION_STRING);
 #ifdef LLVM_REVISION
@@ -116,11 +102,6 @@ void llvm::computeLTOCacheKey(
     support::endian::write32le(Data, I);
     Hasher.update(Data);
   };
-  auto AddUint64 = [&](uint64_t I) {
-    uint8_t Data[8];
-    support::endian::write64le(Data, I);
-    Hasher.update(Data);
-  };
   AddString(Conf.CPU);
   // FIXME: Hash more of Options. For now all clients initialize Options from
   // command-line flags (which is unsupported in production), but may set
@@ -151,6 +132,40 @@ void llvm::computeLTOCacheKey(
   AddString(Conf.OverrideTriple);
   AddString(Conf.DefaultTriple);
   AddString(Conf.DwoDir);
+}
+
+// Computes a unique hash for the Module considering the current list of
+// export/import and other global analysis results.
+// The hash is produced in \p Key.
+void llvm::computeLTOCacheKey(
+    SmallString<40> &Key, const Config &Conf, const ModuleSummaryIndex &Index,
+    StringRef ModuleID, const FunctionImporter::ImportMapTy &ImportList,
+    const FunctionImporter::ExportSetTy &ExportList,
+    const std::map<GlobalValue::GUID, GlobalValue::LinkageTypes> &ResolvedODR,
+    const GVSummaryMapTy &DefinedGlobals,
+    const std::set<GlobalValue::GUID> &CfiFunctionDefs,
+    const std::set<GlobalValue::GUID> &CfiFunctionDecls) {
+  // Compute the unique hash for this entry.
+  // This is based on the current compiler version, the module itself, the
+  // export list, the hash for every single module in the import list, the
+  // list of ResolvedODR for the module, and the list of preserved symbols.
+  SHA1 Hasher;
+  addLTOConfigToHash(Hasher, Conf);
+
+  auto AddString = [&](StringRef Str) {
+    Hasher.update(Str);
+    Hasher.update(ArrayRef<uint8_t>{0});
+  };
+  auto AddUnsigned = [&](unsigned I) {
+    uint8_t Data[4];
+    support::endian::write32le(Data, I);
+    Hasher.update(Data);
+  };
+  auto AddUint64 = [&](uint64_t I) {
+    uint8_t Data[8];
+    support::endian::write64le(Data, I);
+    Hasher.update(Data);
+  };
 
   // Include the hash for the current module
   auto ModHash = Index.getModuleHash(ModuleID);
@@ -352,6 +367,17 @@ void llvm::computeLTOCacheKey(
   Key = toHex(Hasher.result());
 }
 
+void llvm::computeLTOPartitionCacheKey(SmallString<40> &Key,
+                                       const Config &Conf,
+                                       StringRef PartitionBC) {
+  SHA1 Hasher;
+  addLTOConfigToHash(Hasher, Conf);
+  // Keep partition keys disjoint from ThinLTO module keys.
+  Hasher.update("regular-lto-partition");
+  Hasher.update(PartitionBC);
+  Key = toHex(Hasher.result());
+}
+
 static void thinLTOResolvePrevailingGUID(
     const Config &C, ValueInfo VI,
     DenseSet<GlobalValueSummary *> &GlobalInvolvedWithAlias,
@@ -1177,7 +1203,7 @@ Error LTO::run(AddStreamFn AddStream, FileCache Cache) {
   if (SupportsHotColdNew)
     ThinLTO.CombinedIndex.setWithSupportsHotColdNew();
 
-  Error Result = runRegularLTO(AddStream);
+  Error Result = runRegularLTO(AddStream, Cache);
   if (!Result)
     // This will reset the GlobalResolutions optional once done with it to
     // reduce peak memory before importing.
@@ -1220,7 +1246,7 @@ void lto::updateMemProfAttributes(Module &Mod,
   }
 }
 
-Error LTO::runRegularLTO(AddStreamFn AddStream) {
+Error LTO::runRegularLTO(AddStreamFn AddStream, FileCache Cache) {
   // Setup optimization remarks.
   auto DiagFileOrErr = lto::setupLLVMOptimizationRemarks(
       RegularLTO.CombinedModule->getContext(), Conf.RemarksFilename,
@@ -1345,7 +1371,7 @@ Error LTO::runRegularLTO(AddStreamFn AddStream) {
   if (!RegularLTO.EmptyCombinedModule || Conf.AlwaysEmitRegularLTOObj) {
     if (Error Err =
             backend(Conf, AddStream, RegularLTO.ParallelCodeGenParallelismLevel,
-                    *RegularLTO.CombinedModule, ThinLTO.CombinedIndex))
+                    *RegularLTO.CombinedModule, ThinLTO.CombinedIndex, Cache))
       return Err;
   }
 
@@ -1859,15 +1885,22 @@ Error LTO::runThinLTO(AddStreamFn AddStream, FileCache Cache,
       if (Error E = ProcessOneModule(I))
         return E;
   } else {
-    // When executing in parallel, process largest bitsize modules first to
+    // When executing in parallel, process the most expensive modules first to
     // improve parallelism, and avoid starving the thread pool near the end.
     // This saves about 15 sec on a 36-core machine while link `clang.exe` (out
-    // of 100 sec).
+    // of 100 sec). Bitcode size misses the work done on imported functions, so
+    // order by the instruction counts in the combined index instead.
     std::vector<BitcodeModule *> ModulesVec;
+    std::vector<uint64_t> Costs;
     ModulesVec.reserve(ModuleMap.size());
-    for (auto &Mod : ModuleMap)
+    Costs.reserve(ModuleMap.size());
+    for (auto &Mod : ModuleMap) {
       ModulesVec.push_back(&Mod.second);
-    for (int I : generateModulesOrdering(ModulesVec))
+      Costs.push_back(estimateThinBackendCost(
+          ThinLTO.CombinedIndex, ModuleToDefinedGVSummaries[Mod.first],
+          ImportLists[Mod.first]));
+    }
+    for (int I : generateModulesOrdering(ModulesVec, Costs))
       if (Error E = ProcessOneModule(I))
         return E;
   }
@@ -1918,13 +1951,34 @@ lto::setupStatsFile(StringRef StatsFilename) {
 // Compute the ordering we will process the inputs: the rough heuristic here
 // is to sort them per size so that the largest module get schedule as soon as
 // possible. This is purely a compile-time optimization.
-std::vector<int> lto::generateModulesOrdering(ArrayRef<BitcodeModule *> R) {
+std::vector<int> lto::generateModulesOrdering(ArrayRef<BitcodeModule *> R,
+                                              ArrayRef<uint64_t> Costs) {
+  assert((Costs.empty() || Costs.size() == R.size()) &&
+         "Expected one cost per module");
   auto Seq = llvm::seq<int>(0, R.size());
   std::vector<int> ModulesOrdering(Seq.begin(), Seq.end());
   llvm::sort(ModulesOrdering, [&](int LeftIndex, int RightIndex) {
+    if (!Costs.empty() && Costs[LeftIndex] != Costs[RightIndex])
+      return Costs[LeftIndex] > Costs[RightIndex];
     auto LSize = R[LeftIndex]->getBuffer().size();
     auto RSize = R[RightIndex]->getBuffer().size();
     return LSize > RSize;
   });
   return ModulesOrdering;
 }
+
+uint64_t
+lto::estimateThinBackendCost(const ModuleSummaryIndex &Index,
+                             const GVSummaryMapTy &DefinedGlobals,
+                             const FunctionImporter::ImportMapTy &ImportList) {
+  uint64_t Cost = 0;
+  for (const auto &[GUID, Summary] : DefinedGlobals)
+    if (auto *FS = dyn_cast<FunctionSummary>(Summary))
+      Cost += FS->instCount();
+  for (const auto &[FromModule, GUIDs] : ImportList)
+    for (GlobalValue::GUID GUID : GUIDs)
+      if (auto *FS = dyn_cast_or_null<FunctionSummary>(
+              Index.findSummaryInModule(GUID, FromModule)))
+        Cost += FS->instCount();
+  return Cost;
+}
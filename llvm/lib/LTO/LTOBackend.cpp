@@ -430,7 +430,13 @@ static void codegen(const Config &Conf, TargetMachine *TM,
 static void splitCodeGen(const Config &C, TargetMachine *TM,
                          AddStreamFn AddStream,
                          unsigned ParallelCodeGenParallelismLevel, Module &Mod,
-                         const ModuleSummaryIndex &CombinedIndex) {
+                         const ModuleSummaryIndex &CombinedIndex,
+                         FileCache Cache) {
+  // Split DWARF writes a .dwo file next to each object, which the cache does
+  // not know about, so a cache hit would leave it missing.
+  if (!C.DwoDir.empty() || !C.SplitDwarfOutput.empty())
+    Cache = nullptr;
+
   DefaultThreadPool CodegenThreadPool(
       heavyweight_hardware_concurrency(ParallelCodeGenParallelismLevel));
   unsigned ThreadCount = 0;
@@ -447,10 +453,28 @@ static void splitCodeGen(const Config &C, TargetMachine *TM,
         SmallString<0> BC;
         raw_svector_ostream BCOS(BC);
         WriteBitcodeToFile(*MPart, BCOS);
+        unsigned ThreadId = ThreadCount++;
+
+        // The partitioning is deterministic, so an unchanged partition
+        // produces the same bitcode on a relink and its object can be reused.
+        AddStreamFn PartAddStream = AddStream;
+        if (Cache) {
+          SmallString<40> Key;
+          computeLTOPartitionCacheKey(Key, C, BC);
+          Expected<AddStreamFn> CacheAddStreamOrErr =
+              Cache(ThreadId, Key, MPart->getModuleIdentifier());
+          if (Error Err = CacheAddStreamOrErr.takeError())
+            report_fatal_error(std::move(Err));
+          // On a hit the cache has already added the object to the link.
+          if (!*CacheAddStreamOrErr)
+            return;
+          PartAddStream = std::move(*CacheAddStreamOrErr);
+        }
 
         // Enqueue the task
         CodegenThreadPool.async(
-            [&](const SmallString<0> &BC, unsigned ThreadId) {
+            [&](const SmallString<0> &BC, AddStreamFn AddStream,
+                unsigned ThreadId) {
               LTOLLVMContext Ctx(C);
               Expected<std::unique_ptr<Module>> MOrErr =
                   parseBitcodeFile(MemoryBufferRef(BC.str(), "ld-temp.o"), Ctx);
@@ -466,7 +490,7 @@ static void splitCodeGen(const Config &C, TargetMachine *TM,
             },
             // Pass BC using std::move to ensure that it get moved rather than
             // copied into the thread's context.
-            std::move(BC), ThreadCount++);
+            std::move(BC), std::move(PartAddStream), ThreadId);
       };
 
   // Try target-specific module splitting first, then fallback to the default.
@@ -509,7 +533,7 @@ Error lto::finalizeOptimizationRemarks(
 
 Error lto::backend(const Config &C, AddStreamFn AddStream,
                    unsigned ParallelCodeGenParallelismLevel, Module &Mod,
-                   ModuleSummaryIndex &CombinedIndex) {
+                   ModuleSummaryIndex &CombinedIndex, FileCache Cache) {
   Expected<const Target *> TOrErr = initAndLookupTarget(C, Mod);
   if (!TOrErr)
     return TOrErr.takeError();
@@ -528,7 +552,7 @@ Error lto::backend(const Config &C, AddStreamFn AddStream,
     codegen(C, TM.get(), AddStream, 0, Mod, CombinedIndex);
   } else {
     splitCodeGen(C, TM.get(), AddStream, ParallelCodeGenParallelismLevel, Mod,
-                 CombinedIndex);
+                 CombinedIndex, std::move(Cache));
   }
   return Error::success();
 }
@@ -39,6 +39,7 @@
 #include "llvm/MC/StringTableBuilder.h"
 #include "llvm/Support/Alignment.h"
 #include "llvm/Support/Casting.h"
+#include "llvm/Support/CommandLine.h"
 #include "llvm/Support/Compression.h"
 #include "llvm/Support/Endian.h"
 #include "llvm/Support/EndianStream.h"
@@ -46,6 +47,7 @@
 #include "llvm/Support/ErrorHandling.h"
 #include "llvm/Support/LEB128.h"
 #include "llvm/Support/MathExtras.h"
+#include "llvm/Support/Parallel.h"
 #include "llvm/Support/SMLoc.h"
 #include "llvm/Support/raw_ostream.h"
 #include "llvm/TargetParser/Host.h"
@@ -64,6 +66,16 @@ using namespace llvm;
 #undef  DEBUG_TYPE
 #define DEBUG_TYPE "reloc-info"
 
+static cl::opt<bool> ParallelRelocations(
+    "elf-parallel-relocations", cl::Hidden,
+    cl::desc("Sort and encode ELF relocation sections on multiple threads"),
+    cl::init(false));
+
+static cl::opt<bool> ParallelCompression(
+    "elf-parallel-compression", cl::Hidden,
+    cl::desc("Compress large debug sections on multiple threads"),
+    cl::init(false));
+
 namespace {
 
 using SectionIndexMapTy = DenseMap<const MCSectionELF *, uint32_t>;
@@ -207,7 +219,8 @@ public:
                         uint32_t Link, uint32_t Info, MaybeAlign Alignment,
                         uint64_t EntrySize);
 
-  void writeRelocations(const MCAssembler &Asm, const MCSectionELF &Sec);
+  void writeRelocations(const MCAssembler &Asm, const MCSectionELF &Sec,
+                        support::endian::Writer &RW);
 
   uint64_t writeObject(MCAssembler &Asm, const MCAsmLayout &Layout);
   void writeSection(const SectionIndexMapTy &SectionIndexMap,
@@ -903,8 +916,12 @@ void ELFWriter::writeSectionData(const MCAssembler &Asm, MCSection &Sec,
     ChType = ELF::ELFCOMPRESS_ZSTD;
     break;
   }
-  compression::compress(compression::Params(CompressionType), Uncompressed,
-                        Compressed);
+  if (ParallelCompression)
+    compression::compressInShards(compression::Params(CompressionType),
+                                  Uncompressed, Compressed);
+  else
+    compression::compress(compression::Params(CompressionType), Uncompressed,
+                          Compressed);
   if (!maybeWriteCompression(ChType, UncompressedData.size(), Compressed,
                              Sec.getAlign())) {
     W.OS << UncompressedData;
@@ -935,8 +952,13 @@ void ELFWriter::WriteSecHdrEntry(uint32_t Name, uint32_t Type, uint64_t Flags,
 }
 
 void ELFWriter::writeRelocations(const MCAssembler &Asm,
-                                       const MCSectionELF &Sec) {
-  std::vector<ELFRelocationEntry> &Relocs = OWriter.Relocations[&Sec];
+                                 const MCSectionELF &Sec,
+                                 support::endian::Writer &RW) {
+  // Use find() rather than operator[]: this may run on several threads at
+  // once, and every section that gets here already has an entry.
+  auto RelocsIt = OWriter.Relocations.find(&Sec);
+  assert(RelocsIt != OWriter.Relocations.end() && "no relocations");
+  std::vector<ELFRelocationEntry> &Relocs = RelocsIt->second;
   const bool Rela = OWriter.usesRela(Sec);
 
   // Sort the relocation entries. MIPS needs this.
@@ -946,34 +968,34 @@ void ELFWriter::writeRelocations(const MCAssembler &Asm,
     for (const ELFRelocationEntry &Entry : Relocs) {
       uint32_t Symidx = Entry.Symbol ? Entry.Symbol->getIndex() : 0;
       if (is64Bit()) {
-        write(Entry.Offset);
-        write(uint32_t(Symidx));
-        write(OWriter.TargetObjectWriter->getRSsym(Entry.Type));
-        write(OWriter.TargetObjectWriter->getRType3(Entry.Type));
-        write(OWriter.TargetObjectWriter->getRType2(Entry.Type));
-        write(OWriter.TargetObjectWriter->getRType(Entry.Type));
+        RW.write(Entry.Offset);
+        RW.write(uint32_t(Symidx));
+        RW.write(OWriter.TargetObjectWriter->getRSsym(Entry.Type));
+        RW.write(OWriter.TargetObjectWriter->getRType3(Entry.Type));
+        RW.write(OWriter.TargetObjectWriter->getRType2(Entry.Type));
+        RW.write(OWriter.TargetObjectWriter->getRType(Entry.Type));
         if (Rela)
-          write(Entry.Addend);
+          RW.write(Entry.Addend);
       } else {
-        write(uint32_t(Entry.Offset));
+        RW.write(uint32_t(Entry.Offset));
         ELF::Elf32_Rela ERE32;
         ERE32.setSymbolAndType(Symidx, Entry.Type);
-        write(ERE32.r_info);
+        RW.write(ERE32.r_info);
         if (Rela)
-          write(uint32_t(Entry.Addend));
+          RW.write(uint32_t(Entry.Addend));
         if (uint32_t RType =
                 OWriter.TargetObjectWriter->getRType2(Entry.Type)) {
-          write(uint32_t(Entry.Offset));
+          RW.write(uint32_t(Entry.Offset));
           ERE32.setSymbolAndType(0, RType);
-          write(ERE32.r_info);
-          write(uint32_t(0));
+          RW.write(ERE32.r_info);
+          RW.write(uint32_t(0));
         }
         if (uint32_t RType =
                 OWriter.TargetObjectWriter->getRType3(Entry.Type)) {
-          write(uint32_t(Entry.Offset));
+          RW.write(uint32_t(Entry.Offset));
           ERE32.setSymbolAndType(0, RType);
-          write(ERE32.r_info);
-          write(uint32_t(0));
+          RW.write(ERE32.r_info);
+          RW.write(uint32_t(0));
         }
       }
     }
@@ -982,19 +1004,19 @@ void ELFWriter::writeRelocations(const MCAssembler &Asm,
   for (const ELFRelocationEntry &Entry : Relocs) {
     uint32_t Symidx = Entry.Symbol ? Entry.Symbol->getIndex() : 0;
     if (is64Bit()) {
-      write(Entry.Offset);
+      RW.write(Entry.Offset);
       ELF::Elf64_Rela ERE;
       ERE.setSymbolAndType(Symidx, Entry.Type);
-      write(ERE.r_info);
+      RW.write(ERE.r_info);
       if (Rela)
-        write(Entry.Addend);
+        RW.write(Entry.Addend);
     } else {
-      write(uint32_t(Entry.Offset));
+      RW.write(uint32_t(Entry.Offset));
       ELF::Elf32_Rela ERE;
       ERE.setSymbolAndType(Symidx, Entry.Type);
-      write(ERE.r_info);
+      RW.write(ERE.r_info);
       if (Rela)
-        write(uint32_t(Entry.Addend));
+        RW.write(uint32_t(Entry.Addend));
     }
   }
 }
@@ -1183,12 +1205,31 @@ uint64_t ELFWriter::writeObject(MCAssembler &Asm, const MCAsmLayout &Layout) {
     computeSymbolTable(Asm, Layout, SectionIndexMap, RevGroupMap,
                        SectionOffsets);
 
-    for (MCSectionELF *RelSection : Relocations) {
+    // Once symbol indices are known, relocation sections don't depend on each
+    // other. When enabled, sort and encode them into separate buffers in
+    // parallel and then write those out in order, so the output is the same.
+    std::vector<SmallVector<char, 0>> EncodedRelocations;
+    if (ParallelRelocations && Relocations.size() > 1) {
+      EncodedRelocations.resize(Relocations.size());
+      parallelFor(0, Relocations.size(), [&](size_t I) {
+        raw_svector_ostream OS(EncodedRelocations[I]);
+        support::endian::Writer RW(OS, W.Endian);
+        writeRelocations(
+            Asm, cast<MCSectionELF>(*Relocations[I]->getLinkedToSection()),
+            RW);
+      });
+    }
+
+    for (auto [I, RelSection] : llvm::enumerate(Relocations)) {
       // Remember the offset into the file for this section.
       const uint64_t SecStart = align(RelSection->getAlign());
 
-      writeRelocations(Asm,
-                       cast<MCSectionELF>(*RelSection->getLinkedToSection()));
+      if (EncodedRelocations.empty())
+        writeRelocations(
+            Asm, cast<MCSectionELF>(*RelSection->getLinkedToSection()), W);
+      else
+        W.OS << StringRef(EncodedRelocations[I].data(),
+                          EncodedRelocations[I].size());
 
       uint64_t SecEnd = W.OS.tell();
       SectionOffsets[RelSection] = std::make_pair(SecStart, SecEnd);
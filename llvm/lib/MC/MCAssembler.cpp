@@ -459,15 +459,18 @@ void MCAsmLayout::ensureValid(const MCFragment *Frag) const {
   Sec.setHasLayout(true);
   uint64_t Offset = 0;
   for (MCFragment &F : Sec) {
-    F.Offset = Offset;
-    if (Assembler.isBundlingEnabled() && F.hasInstructions()) {
-      const_cast<MCAsmLayout *>(this)->layoutBundle(&F);
-      Offset = F.Offset;
-    }
+    Offset = const_cast<MCAsmLayout *>(this)->layoutFragment(F, Offset);
     Offset += getAssembler().computeFragmentSize(*this, F);
   }
 }
 
+uint64_t MCAsmLayout::layoutFragment(MCFragment &F, uint64_t Offset) {
+  F.Offset = Offset;
+  if (Assembler.isBundlingEnabled() && F.hasInstructions())
+    layoutBundle(&F);
+  return F.Offset;
+}
+
 bool MCAssembler::registerSymbol(const MCSymbol &Symbol) {
   bool Changed = !Symbol.isRegistered();
   if (Changed) {
@@ -1220,10 +1223,22 @@ bool MCAssembler::layoutOnce(MCAsmLayout &Layout) {
   ++stats::RelaxationSteps;
 
   bool Changed = false;
-  for (MCSection &Sec : *this)
-    for (MCFragment &Frag : Sec)
+  for (MCSection &Sec : *this) {
+    // Place each fragment right before relaxing it, so that it sees the exact
+    // offsets of the fragments before it, including any that grew earlier in
+    // this iteration. Later fragments keep their previous offsets until they
+    // are reached. A chain of relaxations that feed each other through
+    // backward references then settles in one iteration instead of one per
+    // link.
+    uint64_t Offset = 0;
+    for (MCFragment &Frag : Sec) {
+      Offset = Layout.layoutFragment(Frag, Offset);
       if (relaxFragment(Layout, Frag))
         Changed = true;
+      Offset = Layout.getFragmentOffset(&Frag) +
+               computeFragmentSize(Layout, Frag);
+    }
+  }
   return Changed;
 }
 
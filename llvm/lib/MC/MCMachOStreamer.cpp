@@ -7,7 +7,6 @@
 //===----------------------------------------------------------------------===//
 
 #include "llvm/ADT/DenseMap.h"
-#include "llvm/ADT/SmallString.h"
 #include "llvm/ADT/SmallVector.h"
 #include "llvm/ADT/StringRef.h"
 #include "llvm/MC/MCAsmBackend.h"
@@ -484,17 +483,18 @@ void MCMachOStreamer::emitInstToData(const MCInst &Inst,
                                      const MCSubtargetInfo &STI) {
   MCDataFragment *DF = getOrCreateDataFragment();
 
+  // Encode straight into the fragment rather than through a temporary buffer.
   SmallVector<MCFixup, 4> Fixups;
-  SmallString<256> Code;
-  getAssembler().getEmitter().encodeInstruction(Inst, Code, Fixups, STI);
+  const uint32_t CodeOffset = DF->getContents().size();
+  getAssembler().getEmitter().encodeInstruction(Inst, DF->getContents(), Fixups,
+                                                STI);
 
-  // Add the fixups and data.
+  // Add the fixups, which are relative to the start of the instruction.
   for (MCFixup &Fixup : Fixups) {
-    Fixup.setOffset(Fixup.getOffset() + DF->getContents().size());
+    Fixup.setOffset(Fixup.getOffset() + CodeOffset);
     DF->getFixups().push_back(Fixup);
   }
   DF->setHasInstructions(STI);
-  DF->getContents().append(Code.begin(), Code.end());
 }
 
 void MCMachOStreamer::finishImpl() {
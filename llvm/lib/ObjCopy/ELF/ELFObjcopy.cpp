@@ -31,6 +31,7 @@
 #include "llvm/Support/ErrorOr.h"
 #include "llvm/Support/FileSystem.h"
 #include "llvm/Support/Memory.h"
+#include "llvm/Support/Parallel.h"
 #include "llvm/Support/Path.h"
 #include "llvm/Support/raw_ostream.h"
 #include <algorithm>
@@ -220,6 +221,7 @@ Error Object::compressOrDecompressSections(const CommonConfig &Config) {
   // because it would mutate the sections array.
   SmallVector<std::pair<SectionBase *, std::function<SectionBase *()>>, 0>
       ToReplace;
+  SmallVector<std::pair<SectionBase *, DebugCompressionType>, 0> ToCompress;
   for (SectionBase &Sec : sections()) {
     std::optional<DebugCompressionType> CType;
     for (auto &[Matcher, T] : Config.compressSections)
@@ -247,13 +249,23 @@ Error Object::compressOrDecompressSections(const CommonConfig &Config) {
         ToReplace.emplace_back(
             &Sec, [=] { return &addSection<DecompressedSection>(*CS); });
     } else if (*CType != DebugCompressionType::None) {
-      ToReplace.emplace_back(&Sec, [=, S = &Sec] {
-        return &addSection<CompressedSection>(
-            CompressedSection(*S, *CType, Is64Bits));
-      });
+      ToCompress.emplace_back(&Sec, *CType);
     }
   }
 
+  // Compressing dominates the cost, so compress the sections concurrently and
+  // add them afterwards, as adding sections is not thread safe.
+  SmallVector<std::optional<CompressedSection>, 0> Compressed(
+      ToCompress.size());
+  parallelFor(0, ToCompress.size(), [&](size_t I) {
+    auto [S, CType] = ToCompress[I];
+    Compressed[I].emplace(*S, CType, Is64Bits);
+  });
+  for (auto [I, Sec] : enumerate(ToCompress))
+    ToReplace.emplace_back(Sec.first, [&, I = I] {
+      return &addSection<CompressedSection>(std::move(*Compressed[I]));
+    });
+
   DenseMap<SectionBase *, SectionBase *> FromTo;
   for (auto [S, Func] : ToReplace)
     FromTo[S] = Func();
@@ -544,8 +544,8 @@ CompressedSection::CompressedSection(const SectionBase &Sec,
                                      bool Is64Bits)
     : SectionBase(Sec), CompressionType(CompressionType),
       DecompressedSize(Sec.OriginalData.size()), DecompressedAlign(Sec.Align) {
-  compression::compress(compression::Params(CompressionType), OriginalData,
-                        CompressedData);
+  compression::compressInShards(compression::Params(CompressionType),
+                                OriginalData, CompressedData);
 
   Flags |= ELF::SHF_COMPRESSED;
   OriginalFlags |= ELF::SHF_COMPRESSED;
@@ -31,6 +31,7 @@
 #include "llvm/Support/ErrorHandling.h"
 #include "llvm/Support/Format.h"
 #include "llvm/Support/MathExtras.h"
+#include "llvm/Support/Parallel.h"
 #include "llvm/Support/Path.h"
 #include "llvm/Support/SmallVectorMemoryBuffer.h"
 #include "llvm/Support/raw_ostream.h"
@@ -704,10 +705,30 @@ bool isImportDescriptor(StringRef Name) {
           Name.ends_with(NullThunkDataSuffix));
 }
 
-static Expected<std::vector<unsigned>> getSymbols(SymbolicFile *Obj,
-                                                  uint16_t Index,
-                                                  raw_ostream &SymNames,
-                                                  SymMap *SymMap) {
+/// Returns the names of the symbols of \p Obj that belong in the archive
+/// symbol table, in symbol order.
+static Expected<std::vector<std::string>>
+getArchiveSymbolNames(SymbolicFile &Obj) {
+  std::vector<std::string> Names;
+  for (const object::BasicSymbolRef &S : Obj.symbols()) {
+    if (!isArchiveSymbol(S))
+      continue;
+    std::string Name;
+    raw_string_ostream NameStream(Name);
+    if (Error E = S.printName(NameStream))
+      return std::move(E);
+    Names.push_back(std::move(Name));
+  }
+  return Names;
+}
+
+/// Adds \p Names, the archive symbols of member \p Obj, to \p SymNames and
+/// returns their offsets in it. With a \p SymMap, names already in the map
+/// are skipped.
+static std::vector<unsigned> addSymbols(ArrayRef<std::string> Names,
+                                        SymbolicFile *Obj, uint16_t Index,
+                                        raw_ostream &SymNames,
+                                        SymMap *SymMap) {
   std::vector<unsigned> Ret;
 
   if (Obj == nullptr)
@@ -717,14 +738,8 @@ static Expected<std::vector<unsigned>> getSymbols(SymbolicFile *Obj,
   if (SymMap)
     Map = SymMap->UseECMap && isECObject(*Obj) ? &SymMap->ECMap : &SymMap->Map;
 
-  for (const object::BasicSymbolRef &S : Obj->symbols()) {
-    if (!isArchiveSymbol(S))
-      continue;
+  for (const std::string &Name : Names) {
     if (Map) {
-      std::string Name;
-      raw_string_ostream NameStream(Name);
-      if (Error E = S.printName(NameStream))
-        return std::move(E);
       if (Map->find(Name) != Map->end())
         continue; // ignore duplicated symbol
       (*Map)[Name] = Index;
@@ -738,14 +753,24 @@ static Expected<std::vector<unsigned>> getSymbols(SymbolicFile *Obj,
       }
     } else {
       Ret.push_back(SymNames.tell());
-      if (Error E = S.printName(SymNames))
-        return std::move(E);
-      SymNames << '\0';
+      SymNames << Name << '\0';
     }
   }
   return Ret;
 }
 
+static Expected<std::vector<unsigned>> getSymbols(SymbolicFile *Obj,
+                                                  uint16_t Index,
+                                                  raw_ostream &SymNames,
+                                                  SymMap *SymMap) {
+  if (Obj == nullptr)
+    return std::vector<unsigned>();
+  Expected<std::vector<std::string>> NamesOrErr = getArchiveSymbolNames(*Obj);
+  if (!NamesOrErr)
+    return NamesOrErr.takeError();
+  return addSymbols(*NamesOrErr, Obj, Index, SymNames, SymMap);
+}
+
 static Expected<std::vector<MemberData>>
 computeMemberData(raw_ostream &StringTable, raw_ostream &SymNames,
                   object::Archive::Kind Kind, bool Thin, bool Deterministic,
@@ -816,15 +841,59 @@ computeMemberData(raw_ostream &StringTable, raw_ostream &SymNames,
   }
 
   std::vector<std::unique_ptr<SymbolicFile>> SymFiles;
+  std::vector<std::vector<std::string>> SymbolNames;
 
   if (NeedSymbols != SymtabWritingMode::NoSymtab || isAIXBigArchive(Kind)) {
-    for (const NewArchiveMember &M : NewMembers) {
+    SymFiles.resize(NewMembers.size());
+    SymbolNames.resize(NewMembers.size());
+    std::vector<std::optional<Error>> Errs(NewMembers.size());
+    auto IsBitcode = [&](size_t I) {
+      return identify_magic(NewMembers[I].Buf->getBuffer()) ==
+             file_magic::bitcode;
+    };
+    auto Parse = [&](size_t I) {
+      const NewArchiveMember &M = NewMembers[I];
       Expected<std::unique_ptr<SymbolicFile>> SymFileOrErr =
           getSymbolicFile(M.Buf->getMemBufferRef(), Context);
-      if (!SymFileOrErr)
-        return createFileError(M.MemberName, SymFileOrErr.takeError());
-      SymFiles.push_back(std::move(*SymFileOrErr));
+      if (!SymFileOrErr) {
+        Errs[I].emplace(
+            createFileError(M.MemberName, SymFileOrErr.takeError()));
+        return;
+      }
+      SymFiles[I] = std::move(*SymFileOrErr);
+      if (NeedSymbols == SymtabWritingMode::NoSymtab || !SymFiles[I])
+        return;
+      Expected<std::vector<std::string>> NamesOrErr =
+          getArchiveSymbolNames(*SymFiles[I]);
+      if (NamesOrErr)
+        SymbolNames[I] = std::move(*NamesOrErr);
+      else
+        Errs[I].emplace(createFileError(M.MemberName, NamesOrErr.takeError()));
+    };
+    // Parse the members and collect their symbol names. Bitcode members are
+    // read into the shared context, so only the other members are handled
+    // concurrently. Only deduplicating the names and laying out the symbol
+    // table is left for the serial loop below.
+    parallelFor(0, NewMembers.size(), [&](size_t I) {
+      if (!IsBitcode(I))
+        Parse(I);
+    });
+    for (size_t I = 0, E = NewMembers.size(); I != E; ++I)
+      if (IsBitcode(I))
+        Parse(I);
+
+    // Report the error of the first member that failed.
+    Error Err = Error::success();
+    for (std::optional<Error> &MemberErr : Errs) {
+      if (!MemberErr)
+        continue;
+      if (Err)
+        consumeError(std::move(*MemberErr));
+      else
+        Err = std::move(*MemberErr);
     }
+    if (Err)
+      return std::move(Err);
   }
 
   if (SymMap) {
@@ -933,11 +1002,8 @@ computeMemberData(raw_ostream &StringTable, raw_ostream &SymNames,
 
     std::vector<unsigned> Symbols;
     if (NeedSymbols != SymtabWritingMode::NoSymtab) {
-      Expected<std::vector<unsigned>> SymbolsOrErr =
-          getSymbols(CurSymFile.get(), Index + 1, SymNames, SymMap);
-      if (!SymbolsOrErr)
-        return createFileError(M->MemberName, SymbolsOrErr.takeError());
-      Symbols = std::move(*SymbolsOrErr);
+      Symbols = addSymbols(SymbolNames[Index], CurSymFile.get(), Index + 1,
+                           SymNames, SymMap);
       if (CurSymFile)
         HasObject = true;
     }
@@ -27,6 +27,7 @@
 #include "llvm/Support/Error.h"
 #include "llvm/Support/ErrorHandling.h"
 #include "llvm/Support/MemoryBuffer.h"
+#include "llvm/Support/Parallel.h"
 #include "llvm/Support/VirtualFileSystem.h"
 #include "llvm/Support/raw_ostream.h"
 #include <algorithm>
@@ -954,44 +955,106 @@ static Error handleMaybeNoDataFoundError(Error E) {
       });
 }
 
-Error CoverageMapping::loadFromFile(
-    StringRef Filename, StringRef Arch, StringRef CompilationDir,
-    IndexedInstrProfReader &ProfileReader, CoverageMapping &Coverage,
-    bool &DataFound, SmallVectorImpl<object::BuildID> *FoundBinaryIDs) {
+namespace {
+/// A CoverageMappingRecord that owns its arrays. The readers reuse their
+/// storage for every record, so decoded records are copied out of them.
+struct DecodedCoverageRecord {
+  StringRef FunctionName;
+  uint64_t FunctionHash;
+  std::vector<StringRef> Filenames;
+  std::vector<CounterExpression> Expressions;
+  std::vector<CounterMappingRegion> MappingRegions;
+
+  DecodedCoverageRecord(const CoverageMappingRecord &Record)
+      : FunctionName(Record.FunctionName), FunctionHash(Record.FunctionHash),
+        Filenames(Record.Filenames.begin(), Record.Filenames.end()),
+        Expressions(Record.Expressions.begin(), Record.Expressions.end()),
+        MappingRegions(Record.MappingRegions.begin(),
+                       Record.MappingRegions.end()) {}
+
+  CoverageMappingRecord getRecord() const {
+    return {FunctionName, FunctionHash, Filenames, Expressions,
+            MappingRegions};
+  }
+};
+} // namespace
+
+struct CoverageMapping::ObjectFileReaders {
+  std::unique_ptr<MemoryBuffer> CovMappingBuf;
+  SmallVector<std::unique_ptr<MemoryBuffer>, 4> Buffers;
+  SmallVector<std::unique_ptr<CoverageMappingReader>, 4> Readers;
+  SmallVector<object::BuildIDRef> BinaryIDs;
+  /// The records of all readers, in order. They refer to the readers' and
+  /// buffers' data.
+  std::vector<DecodedCoverageRecord> Records;
+};
+
+Expected<CoverageMapping::ObjectFileReaders>
+CoverageMapping::readObjectFile(StringRef Filename, StringRef Arch,
+                                StringRef CompilationDir, bool ReadBinaryIDs) {
   auto CovMappingBufOrErr = MemoryBuffer::getFileOrSTDIN(
       Filename, /*IsText=*/false, /*RequiresNullTerminator=*/false);
   if (std::error_code EC = CovMappingBufOrErr.getError())
     return createFileError(Filename, errorCodeToError(EC));
-  MemoryBufferRef CovMappingBufRef =
-      CovMappingBufOrErr.get()->getMemBufferRef();
-  SmallVector<std::unique_ptr<MemoryBuffer>, 4> Buffers;
+  ObjectFileReaders File;
+  File.CovMappingBuf = std::move(CovMappingBufOrErr.get());
 
-  SmallVector<object::BuildIDRef> BinaryIDs;
   auto CoverageReadersOrErr = BinaryCoverageReader::create(
-      CovMappingBufRef, Arch, Buffers, CompilationDir,
-      FoundBinaryIDs ? &BinaryIDs : nullptr);
+      File.CovMappingBuf->getMemBufferRef(), Arch, File.Buffers,
+      CompilationDir, ReadBinaryIDs ? &File.BinaryIDs : nullptr);
   if (Error E = CoverageReadersOrErr.takeError()) {
     E = handleMaybeNoDataFoundError(std::move(E));
     if (E)
       return createFileError(Filename, std::move(E));
-    return E;
+    return std::move(File);
   }
-
-  SmallVector<std::unique_ptr<CoverageMappingReader>, 4> Readers;
   for (auto &Reader : CoverageReadersOrErr.get())
-    Readers.push_back(std::move(Reader));
-  if (FoundBinaryIDs && !Readers.empty()) {
+    File.Readers.push_back(std::move(Reader));
+
+  // Decoding the mapping regions of each function is most of the work, so do
+  // it here rather than while loading the records against the profile.
+  for (const auto &Reader : File.Readers) {
+    for (auto RecordOrErr : *Reader) {
+      if (Error E = RecordOrErr.takeError())
+        return createFileError(Filename, std::move(E));
+      File.Records.emplace_back(*RecordOrErr);
+    }
+  }
+  return std::move(File);
+}
+
+Error CoverageMapping::loadFromFile(
+    StringRef Filename, Expected<ObjectFileReaders> FileOrErr,
+    IndexedInstrProfReader &ProfileReader, CoverageMapping &Coverage,
+    bool &DataFound, SmallVectorImpl<object::BuildID> *FoundBinaryIDs) {
+  if (!FileOrErr)
+    return FileOrErr.takeError();
+  ObjectFileReaders &File = *FileOrErr;
+  if (FoundBinaryIDs && !File.Readers.empty()) {
     llvm::append_range(*FoundBinaryIDs,
-                       llvm::map_range(BinaryIDs, [](object::BuildIDRef BID) {
-                         return object::BuildID(BID);
-                       }));
+                       llvm::map_range(File.BinaryIDs,
+                                       [](object::BuildIDRef BID) {
+                                         return object::BuildID(BID);
+                                       }));
   }
-  DataFound |= !Readers.empty();
-  if (Error E = loadFromReaders(Readers, ProfileReader, Coverage))
-    return createFileError(Filename, std::move(E));
+  DataFound |= !File.Readers.empty();
+  for (const DecodedCoverageRecord &Record : File.Records)
+    if (Error E =
+            Coverage.loadFunctionRecord(Record.getRecord(), ProfileReader))
+      return createFileError(Filename, std::move(E));
   return Error::success();
 }
 
+Error CoverageMapping::loadFromFile(
+    StringRef Filename, StringRef Arch, StringRef CompilationDir,
+    IndexedInstrProfReader &ProfileReader, CoverageMapping &Coverage,
+    bool &DataFound, SmallVectorImpl<object::BuildID> *FoundBinaryIDs) {
+  return loadFromFile(
+      Filename,
+      readObjectFile(Filename, Arch, CompilationDir, FoundBinaryIDs != nullptr),
+      ProfileReader, Coverage, DataFound, FoundBinaryIDs);
+}
+
 Expected<std::unique_ptr<CoverageMapping>> CoverageMapping::load(
     ArrayRef<StringRef> ObjectFilenames, StringRef ProfileFilename,
     vfs::FileSystem &FS, ArrayRef<StringRef> Arches, StringRef CompilationDir,
@@ -1011,12 +1074,34 @@ Expected<std::unique_ptr<CoverageMapping>> CoverageMapping::load(
     return Arches[Idx];
   };
 
+  // Reading and decoding the coverage mapping of the object files is
+  // independent of the profile, so it is done concurrently for a batch of files
+  // at a time. The records are then loaded in the order of the files, so the
+  // result does not depend on the number of threads. Batching bounds the number
+  // of decoded files that are kept in memory at once.
   SmallVector<object::BuildID> FoundBinaryIDs;
-  for (const auto &File : llvm::enumerate(ObjectFilenames)) {
-    if (Error E =
-            loadFromFile(File.value(), GetArch(File.index()), CompilationDir,
-                         *ProfileReader, *Coverage, DataFound, &FoundBinaryIDs))
-      return std::move(E);
+  const size_t BatchSize =
+      std::max(1u, parallel::strategy.compute_thread_count());
+  for (size_t Begin = 0, E = ObjectFilenames.size(); Begin < E;
+       Begin += BatchSize) {
+    size_t End = std::min(Begin + BatchSize, E);
+    std::vector<std::optional<Expected<ObjectFileReaders>>> Files(End - Begin);
+    parallelFor(Begin, End, [&](size_t I) {
+      Files[I - Begin].emplace(readObjectFile(ObjectFilenames[I], GetArch(I),
+                                              CompilationDir,
+                                              /*ReadBinaryIDs=*/true));
+    });
+    for (size_t I = Begin; I != End; ++I) {
+      if (Error Err = loadFromFile(
+              ObjectFilenames[I], std::move(*Files[I - Begin]), *ProfileReader,
+              *Coverage, DataFound, &FoundBinaryIDs)) {
+        // Consume the remaining files of the batch before failing.
+        for (size_t J = I + 1; J != End; ++J)
+          if (!*Files[J - Begin])
+            consumeError(Files[J - Begin]->takeError());
+        return std::move(Err);
+      }
+    }
   }
 
   if (BIDFetcher) {
@@ -69,9 +69,12 @@ static InstrProfKind getProfileKindFromVersion(uint64_t Version) {
 }
 
 static Expected<std::unique_ptr<MemoryBuffer>>
-setupMemoryBuffer(const Twine &Filename, vfs::FileSystem &FS) {
-  auto BufferOrErr = Filename.str() == "-" ? MemoryBuffer::getSTDIN()
-                                           : FS.getBufferForFile(Filename);
+setupMemoryBuffer(const Twine &Filename, vfs::FileSystem &FS,
+                  bool RequiresNullTerminator = true) {
+  auto BufferOrErr = Filename.str() == "-"
+                         ? MemoryBuffer::getSTDIN()
+                         : FS.getBufferForFile(Filename, /*FileSize=*/-1,
+                                               RequiresNullTerminator);
   if (std::error_code EC = BufferOrErr.getError())
     return errorCodeToError(EC);
   return std::move(BufferOrErr.get());
@@ -192,8 +195,12 @@ InstrProfReader::create(std::unique_ptr<MemoryBuffer> Buffer,
 Expected<std::unique_ptr<IndexedInstrProfReader>>
 IndexedInstrProfReader::create(const Twine &Path, vfs::FileSystem &FS,
                                const Twine &RemappingPath) {
-  // Set up the buffer to read.
-  auto BufferOrError = setupMemoryBuffer(Path, FS);
+  // Set up the buffer to read. The indexed format is binary and does not need
+  // a null terminator. Asking for one would force a large profile to be read
+  // into heap memory whenever its size is a multiple of the page size, instead
+  // of being mapped and shared with other compiles through the page cache.
+  auto BufferOrError =
+      setupMemoryBuffer(Path, FS, /*RequiresNullTerminator=*/false);
   if (Error E = BufferOrError.takeError())
     return std::move(E);
 
@@ -940,6 +940,14 @@ std::error_code SampleProfileReaderExtBinaryBase::readFuncProfiles() {
       }
     }
     Data = End;
+
+    // The offsets are only needed to find the profiles to load for this
+    // section. For a large context-sensitive profile the list holds an entry
+    // per context in the whole program, so release it rather than keep it for
+    // the rest of the compilation.
+    FuncOffsetTable.shrink_and_clear();
+    FuncOffsetList.clear();
+    FuncOffsetList.shrink_to_fit();
   }
   assert((CSProfileCount == 0 || CSProfileCount == Profiles.size()) &&
          "Cannot have both context-sensitive and regular profile");
@@ -11,7 +11,11 @@
 //===----------------------------------------------------------------------===//
 
 #include "llvm/Support/Allocator.h"
+#include "llvm/Support/ErrorHandling.h"
+#include "llvm/Support/Memory.h"
+#include "llvm/Support/Process.h"
 #include "llvm/Support/raw_ostream.h"
+#include <atomic>
 
 namespace llvm {
 
@@ -28,6 +32,35 @@ void printBumpPtrAllocatorStats(unsigned NumSlabs, size_t BytesAllocated,
 
 } // namespace detail
 
+static std::atomic<size_t> MappedBytes{0};
+
+void *MappedMemoryAllocator::Allocate(size_t Size, size_t Alignment) {
+  assert(Alignment <= sys::Process::getPageSizeEstimate() &&
+         "Alignment above the page size is not supported");
+  std::error_code EC;
+  sys::MemoryBlock Block = sys::Memory::allocateMappedMemory(
+      Size, nullptr,
+      sys::Memory::MF_READ | sys::Memory::MF_WRITE |
+          sys::Memory::MF_HUGE_HINT,
+      EC);
+  if (EC || !Block.base())
+    report_bad_alloc_error("Mapping memory failed");
+  MappedBytes.fetch_add(Size, std::memory_order_relaxed);
+  return Block.base();
+}
+
+void MappedMemoryAllocator::Deallocate(const void *Ptr, size_t Size,
+                                       size_t /*Alignment*/) {
+  // The mapping was rounded up to whole pages, and so is the size to unmap.
+  sys::MemoryBlock Block(const_cast<void *>(Ptr), Size);
+  sys::Memory::releaseMappedMemory(Block);
+  MappedBytes.fetch_sub(Size, std::memory_order_relaxed);
+}
+
+size_t MappedMemoryAllocator::getTotalBytesAllocated() {
+  return MappedBytes.load(std::memory_order_relaxed);
+}
+
 void PrintRecyclerStats(size_t Size,
                         size_t Align,
                         size_t FreeListSize) {
@@ -29,7 +29,9 @@ using namespace llvm;
 Expected<FileCache> llvm::localCache(const Twine &CacheNameRef,
                                      const Twine &TempFilePrefixRef,
                                      const Twine &CacheDirectoryPathRef,
-                                     AddBufferFn AddBuffer) {
+                                     AddBufferFn AddBuffer,
+                                     FetchBufferFn Fetch,
+                                     StoreBufferFn Store) {
 
   // Create local copies which are safely captured-by-copy in lambdas
   SmallString<64> CacheName, TempFilePrefix, CacheDirectoryPath;
@@ -73,19 +75,32 @@ Expected<FileCache> llvm::localCache(const Twine &CacheNameRef,
       return createStringError(EC, Twine("Failed to open cache file ") +
                                        EntryPath + ": " + EC.message() + "\n");
 
+    // Then try the shared store, if there is one. A shared hit is not copied
+    // into the local cache; the store is expected to be cheap to query again.
+    if (Fetch) {
+      if (std::unique_ptr<MemoryBuffer> MB = Fetch(Key)) {
+        AddBuffer(Task, ModuleName, std::move(MB));
+        return AddStreamFn();
+      }
+    }
+
     // This file stream is responsible for commiting the resulting file to the
     // cache and calling AddBuffer to add it to the link.
     struct CacheStream : CachedFileStream {
       AddBufferFn AddBuffer;
+      StoreBufferFn Store;
       sys::fs::TempFile TempFile;
+      std::string Key;
       std::string ModuleName;
       unsigned Task;
 
       CacheStream(std::unique_ptr<raw_pwrite_stream> OS, AddBufferFn AddBuffer,
-                  sys::fs::TempFile TempFile, std::string EntryPath,
+                  StoreBufferFn Store, sys::fs::TempFile TempFile,
+                  std::string EntryPath, std::string Key,
                   std::string ModuleName, unsigned Task)
           : CachedFileStream(std::move(OS), std::move(EntryPath)),
-            AddBuffer(std::move(AddBuffer)), TempFile(std::move(TempFile)),
+            AddBuffer(std::move(AddBuffer)), Store(std::move(Store)),
+            TempFile(std::move(TempFile)), Key(std::move(Key)),
             ModuleName(ModuleName), Task(Task) {}
 
       ~CacheStream() {
@@ -135,11 +150,13 @@ Expected<FileCache> llvm::localCache(const Twine &CacheNameRef,
                              TempFile.TmpName + " to " + ObjectPathName + ": " +
                              toString(std::move(E)) + "\n");
 
+        if (Store)
+          Store(Key, (*MBOrErr)->getMemBufferRef());
         AddBuffer(Task, ModuleName, std::move(*MBOrErr));
       }
     };
 
-    return [=](size_t Task, const Twine &ModuleName)
+    return [=, Key = Key.str()](size_t Task, const Twine &ModuleName)
                -> Expected<std::unique_ptr<CachedFileStream>> {
       // Create the cache directory if not already done. Doing this lazily
       // ensures the filesystem isn't mutated until the cache is.
@@ -163,8 +180,8 @@ Expected<FileCache> llvm::localCache(const Twine &CacheNameRef,
       // This CacheStream will move the temporary file into the cache when done.
       return std::make_unique<CacheStream>(
           std::make_unique<raw_fd_ostream>(Temp->FD, /* ShouldClose */ false),
-          AddBuffer, std::move(*Temp), std::string(EntryPath), ModuleName.str(),
-          Task);
+          AddBuffer, Store, std::move(*Temp), std::string(EntryPath), Key,
+          ModuleName.str(), Task);
     };
   };
 }
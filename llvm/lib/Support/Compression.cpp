@@ -11,12 +11,14 @@
 //===----------------------------------------------------------------------===//
 
 #include "llvm/Support/Compression.h"
+#include "llvm/ADT/STLExtras.h"
 #include "llvm/ADT/SmallVector.h"
 #include "llvm/ADT/StringRef.h"
 #include "llvm/Config/config.h"
 #include "llvm/Support/Compiler.h"
 #include "llvm/Support/Error.h"
 #include "llvm/Support/ErrorHandling.h"
+#include "llvm/Support/Parallel.h"
 #if LLVM_ENABLE_ZLIB
 #include <zlib.h>
 #endif
@@ -55,6 +57,39 @@ void compression::compress(Params P, ArrayRef<uint8_t> Input,
   }
 }
 
+static void compressZlibShards(ArrayRef<ArrayRef<uint8_t>> Shards, int Level,
+                               SmallVectorImpl<uint8_t> &Output);
+
+void compression::compressInShards(Params P, ArrayRef<uint8_t> Input,
+                                   SmallVectorImpl<uint8_t> &Output,
+                                   size_t ShardSize) {
+  assert(ShardSize > 0 && "shards must not be empty");
+  if (Input.size() <= ShardSize)
+    return compress(P, Input, Output);
+
+  SmallVector<ArrayRef<uint8_t>, 0> Shards;
+  for (ArrayRef<uint8_t> Rest = Input; !Rest.empty();
+       Rest = Rest.drop_front(Shards.back().size()))
+    Shards.push_back(Rest.take_front(ShardSize));
+
+  switch (P.format) {
+  case compression::Format::Zlib:
+    compressZlibShards(Shards, P.level, Output);
+    break;
+  case compression::Format::Zstd: {
+    // Concatenated zstd frames decompress to the concatenation of their
+    // contents.
+    std::vector<SmallVector<uint8_t, 0>> Frames(Shards.size());
+    parallelFor(0, Shards.size(),
+                [&](size_t I) { compress(P, Shards[I], Frames[I]); });
+    Output.clear();
+    for (const SmallVector<uint8_t, 0> &Frame : Frames)
+      Output.append(Frame.begin(), Frame.end());
+    break;
+  }
+  }
+}
+
 Error compression::decompress(DebugCompressionType T, ArrayRef<uint8_t> Input,
                               uint8_t *Output, size_t UncompressedSize) {
   switch (formatFor(T)) {
@@ -142,7 +177,67 @@ Error zlib::decompress(ArrayRef<uint8_t> Input,
   return E;
 }
 
+static void compressZlibShards(ArrayRef<ArrayRef<uint8_t>> Shards, int Level,
+                               SmallVectorImpl<uint8_t> &Output) {
+  // Deflate each shard into raw deflate data. All shards but the last end with
+  // a sync flush, which pads them to a byte boundary, so that they can be
+  // concatenated into a single stream.
+  std::vector<SmallVector<uint8_t, 0>> Deflated(Shards.size());
+  std::vector<uint32_t> Checksums(Shards.size());
+  parallelFor(0, Shards.size(), [&](size_t I) {
+    z_stream Stream = {};
+    // A negative window size omits the zlib header and trailer.
+    int Res = ::deflateInit2(&Stream, Level, Z_DEFLATED, -MAX_WBITS,
+                             /*memLevel=*/8, Z_DEFAULT_STRATEGY);
+    if (Res == Z_MEM_ERROR)
+      report_bad_alloc_error("Allocation failed");
+    assert(Res == Z_OK);
+    Stream.next_in = const_cast<Bytef *>(Shards[I].data());
+    Stream.avail_in = Shards[I].size();
+
+    int Flush = I + 1 == Shards.size() ? Z_FINISH : Z_SYNC_FLUSH;
+    SmallVector<uint8_t, 0> &Out = Deflated[I];
+    // The bound does not include the empty block a sync flush appends.
+    Out.resize_for_overwrite(::deflateBound(&Stream, Stream.avail_in) + 8);
+    size_t Pos = 0;
+    do {
+      if (Pos == Out.size())
+        Out.resize_for_overwrite(Out.size() * 3 / 2);
+      Stream.next_out = Out.data() + Pos;
+      Stream.avail_out = Out.size() - Pos;
+      Res = ::deflate(&Stream, Flush);
+      assert(Res != Z_STREAM_ERROR);
+      Pos = Stream.next_out - Out.data();
+    } while (Stream.avail_out == 0);
+    assert(Stream.avail_in == 0);
+    ::deflateEnd(&Stream);
+    // Tell MemorySanitizer that zlib output buffer is fully initialized.
+    // This avoids a false report when running LLVM with uninstrumented ZLib.
+    __msan_unpoison(Out.data(), Pos);
+    Out.truncate(Pos);
+    Checksums[I] = ::adler32(1, Shards[I].data(), Shards[I].size());
+  });
+
+  // Wrap the deflate data into a zlib stream: a header for deflate with a 32K
+  // window, and the big endian Adler-32 checksum of the whole input.
+  Output.clear();
+  Output.push_back(0x78);
+  Output.push_back(0x01);
+  uint32_t Checksum = 1;
+  for (auto [Out, Shard, ShardChecksum] :
+       llvm::zip_equal(Deflated, Shards, Checksums)) {
+    Output.append(Out.begin(), Out.end());
+    Checksum = ::adler32_combine(Checksum, ShardChecksum, Shard.size());
+  }
+  for (int Shift = 24; Shift >= 0; Shift -= 8)
+    Output.push_back(Checksum >> Shift);
+}
+
 #else
+static void compressZlibShards(ArrayRef<ArrayRef<uint8_t>> Shards, int Level,
+                               SmallVectorImpl<uint8_t> &Output) {
+  llvm_unreachable("zlib::compress is unavailable");
+}
 bool zlib::isAvailable() { return false; }
 void zlib::compress(ArrayRef<uint8_t> Input,
                     SmallVectorImpl<uint8_t> &CompressedBuffer, int Level) {
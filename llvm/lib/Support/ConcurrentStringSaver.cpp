@@ -0,0 +1,79 @@
+//===-- ConcurrentStringSaver.cpp -----------------------------------------===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+#include "llvm/Support/ConcurrentStringSaver.h"
+
+#include "llvm/ADT/SmallString.h"
+#include "llvm/Support/MathExtras.h"
+#include "llvm/Support/Threading.h"
+#include "llvm/Support/xxhash.h"
+#include <mutex>
+
+using namespace llvm;
+
+ConcurrentUniqueStringSaver::ConcurrentUniqueStringSaver(unsigned NumShards) {
+  // A few shards per thread keep the chance that two threads want the same
+  // shard low.
+  if (NumShards == 0)
+    NumShards =
+        std::min(hardware_concurrency().compute_thread_count() * 4, 256u);
+  ShardBits = Log2_32_Ceil(std::max(NumShards, 1u));
+  Shards = std::make_unique<Shard[]>(size_t(1) << ShardBits);
+}
+
+ConcurrentUniqueStringSaver::~ConcurrentUniqueStringSaver() = default;
+
+StringRef ConcurrentUniqueStringSaver::save(StringRef S) {
+  // The high bits of the hash choose the shard and the low bits are cached
+  // for the shard's set, so that both are well distributed.
+  uint64_t Hash = xxh3_64bits(S);
+  Shard &Sh = Shards[ShardBits ? Hash >> (64 - ShardBits) : 0];
+  CachedHashStringRef Key(S, static_cast<uint32_t>(Hash));
+  {
+    std::shared_lock<std::shared_mutex> Lock(Sh.Mutex);
+    auto It = Sh.Strings.find(Key);
+    if (It != Sh.Strings.end())
+      return It->val();
+  }
+
+  std::unique_lock<std::shared_mutex> Lock(Sh.Mutex);
+  // Another thread may have saved the string since the lookup above.
+  auto [It, Inserted] = Sh.Strings.insert(Key);
+  if (Inserted) {
+    char *P = Sh.Alloc.Allocate<char>(S.size() + 1);
+    if (!S.empty())
+      memcpy(P, S.data(), S.size());
+    P[S.size()] = '\0';
+    // Safe replacement with an equal value.
+    *It = CachedHashStringRef(StringRef(P, S.size()), Key.hash());
+  }
+  return It->val();
+}
+
+StringRef ConcurrentUniqueStringSaver::save(const Twine &S) {
+  SmallString<128> Storage;
+  return save(S.toStringRef(Storage));
+}
+
+size_t ConcurrentUniqueStringSaver::size() const {
+  size_t Size = 0;
+  for (size_t I = 0, E = size_t(1) << ShardBits; I != E; ++I) {
+    std::shared_lock<std::shared_mutex> Lock(Shards[I].Mutex);
+    Size += Shards[I].Strings.size();
+  }
+  return Size;
+}
+
+size_t ConcurrentUniqueStringSaver::getBytesAllocated() const {
+  size_t Bytes = 0;
+  for (size_t I = 0, E = size_t(1) << ShardBits; I != E; ++I) {
+    std::shared_lock<std::shared_mutex> Lock(Shards[I].Mutex);
+    Bytes += Shards[I].Alloc.getBytesAllocated();
+  }
+  return Bytes;
+}
@@ -19,6 +19,9 @@
 
 #if !defined(_MSC_VER) && !defined(__MINGW32__)
 #include <unistd.h>
+#if defined(__linux__)
+#include <fcntl.h>
+#endif
 #else
 #include <io.h>
 #endif
@@ -66,6 +69,15 @@ public:
     consumeError(Temp.discard());
   }
 
+  void writeBack(size_t Offset, size_t Size) override {
+#if defined(__linux__)
+    // Initiate writeback of the dirty pages. Once they are written, they are
+    // clean and can be evicted under memory pressure.
+    if (Temp.FD != -1)
+      ::sync_file_range(Temp.FD, Offset, Size, SYNC_FILE_RANGE_WRITE);
+#endif
+  }
+
 private:
   fs::mapped_file_region Buffer;
   fs::TempFile Temp;
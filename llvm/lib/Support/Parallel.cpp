@@ -14,6 +14,7 @@
 #include <atomic>
 #include <deque>
 #include <future>
+#include <memory>
 #include <thread>
 #include <vector>
 
@@ -31,6 +32,9 @@ unsigned getThreadIndex() { GET_THREAD_INDEX_IMPL; }
 thread_local unsigned threadIndex = UINT_MAX;
 #endif
 
+// The TaskGroup nesting level of the task running on this thread.
+static thread_local unsigned taskDepth = 0;
+
 namespace detail {
 
 namespace {
@@ -39,18 +43,30 @@ namespace {
 class Executor {
 public:
   virtual ~Executor() = default;
-  virtual void add(std::function<void()> func, bool Sequential = false) = 0;
+  virtual void add(std::function<void()> func, bool Sequential = false,
+                   unsigned Depth = 0) = 0;
   virtual size_t getThreadCount() const = 0;
+  // Runs the most recently added task of the calling worker's own queue if its
+  // depth is at least \p MinDepth. Returns false if there was no such task.
+  virtual bool runPendingTask(unsigned MinDepth) = 0;
 
   static Executor *getDefaultExecutor();
 };
 
-/// An implementation of an Executor that runs closures on a thread pool
-///   in filo order.
+/// An implementation of an Executor that runs closures on a thread pool.
+///
+/// Each worker owns a deque of tasks. A worker runs tasks from the back of its
+/// own deque in filo order and, when that is empty, steals from the front of
+/// the deque of a randomly chosen victim. Tasks added from outside the pool
+/// are distributed round-robin over the fronts of the workers' deques, so no
+/// single lock is shared by every add and every pop. The global mutex is only
+/// taken to put idle workers to sleep, to wake them up, and for sequential
+/// tasks.
 class ThreadPoolExecutor : public Executor {
 public:
   explicit ThreadPoolExecutor(ThreadPoolStrategy S = hardware_concurrency()) {
     ThreadCount = S.compute_thread_count();
+    Queues = std::make_unique<WorkerQueue[]>(ThreadCount);
     // Spawn all but one of the threads in another thread as spawning threads
     // can take a while.
     Threads.reserve(ThreadCount);
@@ -98,55 +114,165 @@ public:
     static void call(void *Ptr) { ((ThreadPoolExecutor *)Ptr)->stop(); }
   };
 
-  void add(std::function<void()> F, bool Sequential = false) override {
-    {
-      std::lock_guard<std::mutex> Lock(Mutex);
-      if (Sequential)
+  void add(std::function<void()> F, bool Sequential = false,
+           unsigned Depth = 0) override {
+    if (Sequential) {
+      {
+        std::lock_guard<std::mutex> Lock(Mutex);
         WorkQueueSequential.emplace_front(std::move(F));
+        ++NumSequentialTasks;
+      }
+      Cond.notify_one();
+      return;
+    }
+
+    // Workers push to the back of their own deque. Other threads spread their
+    // tasks over the fronts of all deques, so that the back of a deque only
+    // ever holds tasks spawned by its owner (see runPendingTask).
+    bool IsWorker = threadIndex < ThreadCount;
+    unsigned Index =
+        IsWorker ? threadIndex
+                 : NextQueue.fetch_add(1, std::memory_order_relaxed) %
+                       ThreadCount;
+
+    // Count the task before publishing it so that the counter never drops
+    // below the number of queued tasks. A worker going to sleep increments
+    // NumIdleThreads before it checks NumPendingTasks under Mutex, so either it
+    // sees this task or we see it and wake it up.
+    ++NumPendingTasks;
+    {
+      WorkerQueue &Q = Queues[Index];
+      std::lock_guard<std::mutex> Lock(Q.Mutex);
+      if (IsWorker)
+        Q.Tasks.push_back({std::move(F), Depth});
       else
-        WorkQueue.emplace_back(std::move(F));
+        Q.Tasks.push_front({std::move(F), Depth});
+    }
+    if (NumIdleThreads.load() != 0) {
+      { std::lock_guard<std::mutex> Lock(Mutex); }
+      Cond.notify_one();
     }
-    Cond.notify_one();
   }
 
   size_t getThreadCount() const override { return ThreadCount; }
 
+  bool runPendingTask(unsigned MinDepth) override {
+    if (threadIndex >= ThreadCount)
+      return false;
+    std::function<void()> Task;
+    {
+      WorkerQueue &Q = Queues[threadIndex];
+      std::lock_guard<std::mutex> Lock(Q.Mutex);
+      if (Q.Tasks.empty() || Q.Tasks.back().Depth < MinDepth)
+        return false;
+      Task = std::move(Q.Tasks.back().F);
+      Q.Tasks.pop_back();
+    }
+    --NumPendingTasks;
+    Task();
+    return true;
+  }
+
 private:
+  struct QueuedTask {
+    std::function<void()> F;
+    unsigned Depth;
+  };
+
+  struct WorkerQueue {
+    std::mutex Mutex;
+    std::deque<QueuedTask> Tasks;
+    // Victim selection state, only used by the owning worker.
+    uint32_t Seed;
+  };
+
   bool hasSequentialTasks() const {
     return !WorkQueueSequential.empty() && !SequentialQueueIsLocked;
   }
 
-  bool hasGeneralTasks() const { return !WorkQueue.empty(); }
+  bool hasGeneralTasks() const { return NumPendingTasks.load() != 0; }
+
+  // Pops a task from the back of the worker's own deque, or steals one from
+  // the front of another worker's deque.
+  bool popOrSteal(unsigned ThreadID, std::function<void()> &Task) {
+    {
+      WorkerQueue &Q = Queues[ThreadID];
+      std::lock_guard<std::mutex> Lock(Q.Mutex);
+      if (!Q.Tasks.empty()) {
+        Task = std::move(Q.Tasks.back().F);
+        Q.Tasks.pop_back();
+        return true;
+      }
+    }
+    // xorshift32 to pick the first victim; then scan the others in order.
+    uint32_t &Seed = Queues[ThreadID].Seed;
+    Seed ^= Seed << 13;
+    Seed ^= Seed >> 17;
+    Seed ^= Seed << 5;
+    for (unsigned I = 0, Start = Seed % ThreadCount; I != ThreadCount; ++I) {
+      unsigned Victim = (Start + I) % ThreadCount;
+      if (Victim == ThreadID)
+        continue;
+      WorkerQueue &Q = Queues[Victim];
+      std::lock_guard<std::mutex> Lock(Q.Mutex);
+      if (!Q.Tasks.empty()) {
+        Task = std::move(Q.Tasks.front().F);
+        Q.Tasks.pop_front();
+        return true;
+      }
+    }
+    return false;
+  }
+
+  bool runSequentialTask() {
+    std::function<void()> Task;
+    {
+      std::lock_guard<std::mutex> Lock(Mutex);
+      if (!hasSequentialTasks())
+        return false;
+      SequentialQueueIsLocked = true;
+      Task = std::move(WorkQueueSequential.back());
+      WorkQueueSequential.pop_back();
+      --NumSequentialTasks;
+    }
+    Task();
+    SequentialQueueIsLocked = false;
+    return true;
+  }
 
   void work(ThreadPoolStrategy S, unsigned ThreadID) {
     threadIndex = ThreadID;
     S.apply_thread_strategy(ThreadID);
-    while (true) {
+    Queues[ThreadID].Seed = ThreadID * 2654435761u + 1;
+    std::function<void()> Task;
+    while (!Stop) {
+      if (NumSequentialTasks.load() != 0 && !SequentialQueueIsLocked &&
+          runSequentialTask())
+        continue;
+      if (popOrSteal(ThreadID, Task)) {
+        --NumPendingTasks;
+        Task();
+        Task = nullptr;
+        continue;
+      }
+
       std::unique_lock<std::mutex> Lock(Mutex);
+      ++NumIdleThreads;
       Cond.wait(Lock, [&] {
         return Stop || hasGeneralTasks() || hasSequentialTasks();
       });
-      if (Stop)
-        break;
-      bool Sequential = hasSequentialTasks();
-      if (Sequential)
-        SequentialQueueIsLocked = true;
-      else
-        assert(hasGeneralTasks());
-
-      auto &Queue = Sequential ? WorkQueueSequential : WorkQueue;
-      auto Task = std::move(Queue.back());
-      Queue.pop_back();
-      Lock.unlock();
-      Task();
-      if (Sequential)
-        SequentialQueueIsLocked = false;
+      --NumIdleThreads;
     }
   }
 
   std::atomic<bool> Stop{false};
   std::atomic<bool> SequentialQueueIsLocked{false};
-  std::deque<std::function<void()>> WorkQueue;
+  std::unique_ptr<WorkerQueue[]> Queues;
+  std::atomic<unsigned> NextQueue{0};
+  // The number of tasks in Queues that have not been popped yet.
+  std::atomic<size_t> NumPendingTasks{0};
+  std::atomic<size_t> NumSequentialTasks{0};
+  std::atomic<unsigned> NumIdleThreads{0};
   std::deque<std::function<void()>> WorkQueueSequential;
   std::mutex Mutex;
   std::condition_variable Cond;
@@ -188,33 +314,59 @@ size_t getThreadCount() {
 }
 #endif
 
-// Latch::sync() called by the dtor may cause one thread to block. If is a dead
-// lock if all threads in the default executor are blocked. To prevent the dead
-// lock, only allow the root TaskGroup to run tasks parallelly. In the scenario
-// of nested parallel_for_each(), only the outermost one runs parallelly.
+// A nested TaskGroup, i.e. one created by a task running on a worker of the
+// default executor, is parallel as well. Its tasks are pushed to the back of
+// the worker's own deque, and idle workers steal from the front. sync() first
+// pops tasks off the back of that deque and runs them, as long as they are at
+// least as deep as the group, i.e. belong to it or to groups nested in it. It
+// then blocks until the tasks stolen by other workers have finished, and does
+// not run any other task meanwhile.
 TaskGroup::TaskGroup()
 #if LLVM_ENABLE_THREADS
-    : Parallel((parallel::strategy.ThreadsRequested != 1) &&
-               (threadIndex == UINT_MAX)) {}
+    : Parallel(parallel::strategy.ThreadsRequested != 1),
+      Depth(threadIndex == UINT_MAX ? 0 : taskDepth + 1) {}
 #else
     : Parallel(false) {}
 #endif
 TaskGroup::~TaskGroup() {
   // We must ensure that all the workloads have finished before decrementing the
   // instances count.
+  sync();
+}
+
+void TaskGroup::sync() const {
+#if LLVM_ENABLE_THREADS
+  if (Parallel && Depth != 0) {
+    // Only this thread adds to its own queue, so once there is nothing left to
+    // run there the remaining tasks are running on other threads.
+    detail::Executor *Exec = detail::Executor::getDefaultExecutor();
+    while (Exec->runPendingTask(Depth))
+      ;
+  }
+#endif
   L.sync();
 }
 
 void TaskGroup::spawn(std::function<void()> F, bool Sequential) {
 #if LLVM_ENABLE_THREADS
   if (Parallel) {
+    // The shared sequential queue is drained one task at a time, so a nested
+    // group waiting for its sequential tasks could starve the pool. Run them
+    // in spawn order on the calling thread instead.
+    if (Sequential && Depth != 0) {
+      F();
+      return;
+    }
     L.inc();
     detail::Executor::getDefaultExecutor()->add(
-        [&, F = std::move(F)] {
+        [&, F = std::move(F), D = Depth] {
+          unsigned SavedDepth = taskDepth;
+          taskDepth = D;
           F();
+          taskDepth = SavedDepth;
           L.dec();
         },
-        Sequential);
+        Sequential, Depth);
     return;
   }
 #endif
@@ -36,6 +36,10 @@
 #include <libproc.h>
 #endif
 
+#if defined(HAVE_GETRUSAGE) && defined(HAVE_SYS_RESOURCE_H)
+#include <sys/resource.h>
+#endif
+
 using namespace llvm;
 
 // This ugly hack is brought to you courtesy of constructor/destructor ordering
@@ -154,6 +158,26 @@ static inline size_t getMemUsage() {
   return sys::Process::GetMallocUsage();
 }
 
+// Returns the peak resident set size of the process so far, in bytes. With
+// -track-memory, the difference between the start and the stop of a timer
+// shows how much the timed region raised the high-water mark.
+static size_t getPeakRSS() {
+  if (!*TrackSpace)
+    return 0;
+#if defined(HAVE_GETRUSAGE) && defined(HAVE_SYS_RESOURCE_H) &&                 \
+    !defined(__HAIKU__) && !defined(__MVS__)
+  struct rusage RU;
+  if (::getrusage(RUSAGE_SELF, &RU) == 0) {
+#ifdef __APPLE__
+    return RU.ru_maxrss;
+#else
+    return size_t(RU.ru_maxrss) * 1024;
+#endif
+  }
+#endif
+  return 0;
+}
+
 static uint64_t getCurInstructionsExecuted() {
 #if defined(HAVE_UNISTD_H) && defined(HAVE_PROC_PID_RUSAGE) &&                 \
     defined(RUSAGE_INFO_V4)
@@ -173,11 +197,13 @@ TimeRecord TimeRecord::getCurrentTime(bool Start) {
 
   if (Start) {
     Result.MemUsed = getMemUsage();
+    Result.PeakRSSGrowth = getPeakRSS();
     Result.InstructionsExecuted = getCurInstructionsExecuted();
     sys::Process::GetTimeUsage(now, user, sys);
   } else {
     sys::Process::GetTimeUsage(now, user, sys);
     Result.InstructionsExecuted = getCurInstructionsExecuted();
+    Result.PeakRSSGrowth = getPeakRSS();
     Result.MemUsed = getMemUsage();
   }
 
@@ -227,6 +253,8 @@ void TimeRecord::print(const TimeRecord &Total, raw_ostream &OS) const {
 
   if (Total.getMemUsed())
     OS << format("%9" PRId64 "  ", (int64_t)getMemUsed());
+  if (Total.getPeakRSSGrowth())
+    OS << format("%9" PRId64 "  ", (int64_t)getPeakRSSGrowth());
   if (Total.getInstructionsExecuted())
     OS << format("%9" PRId64 "  ", (int64_t)getInstructionsExecuted());
 }
@@ -388,6 +416,8 @@ void TimerGroup::PrintQueuedTimers(raw_ostream &OS) {
   OS << "   ---Wall Time---";
   if (Total.getMemUsed())
     OS << "  ---Mem---";
+  if (Total.getPeakRSSGrowth())
+    OS << "  ---RSS---";
   if (Total.getInstructionsExecuted())
     OS << "  ---Instr---";
   OS << "  --- Name ---\n";
@@ -483,6 +513,10 @@ const char *TimerGroup::printJSONValues(raw_ostream &OS, const char *delim) {
       OS << delim;
       printJSONValue(OS, R, ".mem", T.getMemUsed());
     }
+    if (T.getPeakRSSGrowth()) {
+      OS << delim;
+      printJSONValue(OS, R, ".rss", T.getPeakRSSGrowth());
+    }
     if (T.getInstructionsExecuted()) {
       OS << delim;
       printJSONValue(OS, R, ".instr", T.getInstructionsExecuted());
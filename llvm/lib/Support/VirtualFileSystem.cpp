@@ -611,6 +611,85 @@ directory_iterator OverlayFileSystem::dir_begin(const Twine &Dir,
 
 void ProxyFileSystem::anchor() {}
 
+//===-----------------------------------------------------------------------===/
+// StatusCachingFileSystem implementation
+//===-----------------------------------------------------------------------===/
+
+std::error_code
+StatusCachingFileSystem::getCacheKey(const Twine &Path,
+                                     SmallVectorImpl<char> &Key) const {
+  Path.toVector(Key);
+  if (std::error_code EC = makeAbsolute(Key))
+    return EC;
+  // Removing ".." would be wrong if the preceding component is a symlink.
+  sys::path::remove_dots(Key, /*remove_dot_dot=*/false);
+  return {};
+}
+
+ErrorOr<Status> StatusCachingFileSystem::status(const Twine &Path) {
+  SmallString<256> Key;
+  if (getCacheKey(Path, Key))
+    return ProxyFileSystem::status(Path);
+  uint64_t QueryGeneration;
+  {
+    std::lock_guard<std::mutex> Lock(Mutex);
+    auto It = Cache.find(Key);
+    if (It != Cache.end()) {
+      if (!It->second)
+        return It->second.getError();
+      // Report the path as it was spelled, as the underlying file system does.
+      return Status::copyWithNewName(*It->second, Path);
+    }
+    QueryGeneration = Generation;
+  }
+
+  // Query without holding the lock, so that other threads are not blocked on
+  // the file system. Two threads may both miss; they store the same result.
+  // If invalidate() ran during the query, the result may predate the change
+  // it reported, so it is returned but not cached.
+  ErrorOr<Status> Result = ProxyFileSystem::status(Key);
+  std::lock_guard<std::mutex> Lock(Mutex);
+  if (QueryGeneration == Generation)
+    Cache.insert({Key, Result});
+  if (!Result)
+    return Result;
+  return Status::copyWithNewName(*Result, Path);
+}
+
+bool StatusCachingFileSystem::exists(const Twine &Path) {
+  return static_cast<bool>(status(Path));
+}
+
+void StatusCachingFileSystem::invalidate(const Twine &Path) {
+  SmallString<256> Key;
+  if (getCacheKey(Path, Key))
+    return;
+  std::lock_guard<std::mutex> Lock(Mutex);
+  Cache.erase(Key);
+  ++Generation;
+}
+
+void StatusCachingFileSystem::invalidate() {
+  std::lock_guard<std::mutex> Lock(Mutex);
+  Cache.clear();
+  ++Generation;
+}
+
+size_t StatusCachingFileSystem::getNumCachedStatuses() const {
+  std::lock_guard<std::mutex> Lock(Mutex);
+  return Cache.size();
+}
+
+void StatusCachingFileSystem::printImpl(raw_ostream &OS, PrintType Type,
+                                        unsigned IndentLevel) const {
+  printIndent(OS, IndentLevel);
+  OS << "StatusCachingFileSystem (" << getNumCachedStatuses()
+     << " cached statuses)\n";
+  if (Type == PrintType::Summary)
+    return;
+  getUnderlyingFS().print(OS, Type, IndentLevel + 1);
+}
+
 namespace llvm {
 namespace vfs {
 
@@ -2947,5 +3026,6 @@ recursive_directory_iterator::increment(std::error_code &EC) {
 const char FileSystem::ID = 0;
 const char OverlayFileSystem::ID = 0;
 const char ProxyFileSystem::ID = 0;
+const char StatusCachingFileSystem::ID = 0;
 const char InMemoryFileSystem::ID = 0;
 const char RedirectingFileSystem::ID = 0;
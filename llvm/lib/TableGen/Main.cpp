@@ -57,6 +57,12 @@ static cl::list<std::string>
 MacroNames("D", cl::desc("Name of the macro to be defined"),
             cl::value_desc("macro name"), cl::Prefix);
 
+static cl::list<std::string> ExtraActions(
+    "extra-action",
+    cl::desc("Also run <action>, e.g. gen-register-info, on the parsed "
+             "records and write its output to <filename>. Can be repeated"),
+    cl::value_desc("action=filename"));
+
 static cl::opt<bool>
 WriteIfChanged("write-if-changed", cl::desc("Only write output if it changed"));
 
@@ -95,6 +101,64 @@ static int createDependencyFile(const TGParser &Parser, const char *argv0) {
   return 0;
 }
 
+/// Write \p Contents to \p Filename, honoring `-write-if-changed`.
+static int writeOutput(StringRef Filename, StringRef Contents,
+                       const char *argv0) {
+  if (WriteIfChanged) {
+    // Only updates the real output file if there are any differences.
+    // This prevents recompilation of all the files depending on it if there
+    // aren't any.
+    if (auto ExistingOrErr = MemoryBuffer::getFile(Filename, /*IsText=*/true))
+      if (std::move(ExistingOrErr.get())->getBuffer() == Contents)
+        return 0;
+  }
+  std::error_code EC;
+  ToolOutputFile OutFile(Filename, EC, sys::fs::OF_Text);
+  if (EC)
+    return reportError(argv0, "error opening " + Filename + ": " +
+                                  EC.message() + "\n");
+  OutFile.os() << Contents;
+  if (ErrorsPrinted == 0)
+    OutFile.keep();
+  return 0;
+}
+
+/// Run the backends requested with `-extra-action` and write their outputs.
+/// They share the records parsed for the main action, so that several outputs
+/// of the same .td file do not each need a separate tablegen invocation.
+static int runExtraActions(RecordKeeper &Records, const char *argv0) {
+  for (StringRef ExtraAction : ExtraActions) {
+    auto [Name, Filename] = ExtraAction.split('=');
+    if (Name.empty() || Filename.empty())
+      return reportError(argv0, "-extra-action expects <action>=<filename>, "
+                                "got '" + ExtraAction + "'\n");
+    // Look the action up without parsing it as a value of the main action,
+    // which would report unknown names as an error of that option.
+    auto &Parser = TableGen::Emitter::Action->getParser();
+    unsigned I = Parser.findOption(Name.ltrim('-'));
+    TableGen::Emitter::FnT ActionFn = nullptr;
+    if (I != Parser.getNumOptions())
+      ActionFn = static_cast<const cl::OptionValue<TableGen::Emitter::FnT> &>(
+                     Parser.getOptionValue(I))
+                     .getValue();
+    if (!ActionFn)
+      return reportError(argv0, "unknown action '" + Name + "'\n");
+
+    Records.startBackendTimer(("Backend " + Name).str());
+    std::string OutString;
+    raw_string_ostream Out(OutString);
+    ActionFn(Records, Out);
+    Records.stopBackendTimer();
+
+    Records.startTimer("Write output");
+    int Ret = writeOutput(Filename, Out.str(), argv0);
+    Records.stopTimer();
+    if (Ret)
+      return Ret;
+  }
+  return 0;
+}
+
 int llvm::TableGenMain(const char *argv0,
                        std::function<TableGenMainFn> MainFn) {
   RecordKeeper Records;
@@ -152,28 +216,12 @@ int llvm::TableGenMain(const char *argv0,
   }
 
   Records.startTimer("Write output");
-  bool WriteFile = true;
-  if (WriteIfChanged) {
-    // Only updates the real output file if there are any differences.
-    // This prevents recompilation of all the files depending on it if there
-    // aren't any.
-    if (auto ExistingOrErr =
-            MemoryBuffer::getFile(OutputFilename, /*IsText=*/true))
-      if (std::move(ExistingOrErr.get())->getBuffer() == Out.str())
-        WriteFile = false;
-  }
-  if (WriteFile) {
-    std::error_code EC;
-    ToolOutputFile OutFile(OutputFilename, EC, sys::fs::OF_Text);
-    if (EC)
-      return reportError(argv0, "error opening " + OutputFilename + ": " +
-                                    EC.message() + "\n");
-    OutFile.os() << Out.str();
-    if (ErrorsPrinted == 0)
-      OutFile.keep();
-  }
-  
+  if (int Ret = writeOutput(OutputFilename, Out.str(), argv0))
+    return Ret;
   Records.stopTimer();
+
+  if (int Ret = runExtraActions(Records, argv0))
+    return Ret;
   Records.stopPhaseTiming();
 
   if (ErrorsPrinted > 0)
@@ -23,16 +23,25 @@
 #include "X86InstrInfo.h"
 #include "X86MachineFunctionInfo.h"
 #include "X86Subtarget.h"
+#include "llvm/ADT/Statistic.h"
 #include "llvm/CodeGen/MachineFunctionPass.h"
 #include "llvm/CodeGen/MachineModuleInfo.h"
 #include "llvm/IR/DebugInfoMetadata.h"
 #include "llvm/ProfileData/SampleProf.h"
 #include "llvm/ProfileData/SampleProfReader.h"
+#include "llvm/Support/MathExtras.h"
 #include "llvm/Support/VirtualFileSystem.h"
 #include "llvm/Transforms/IPO/SampleProfile.h"
+#include <optional>
 using namespace llvm;
 using namespace sampleprof;
 
+#define DEBUG_TYPE "x86-insert-prefetch"
+
+STATISTIC(NumPrefetchesInserted, "Number of prefetches inserted");
+STATISTIC(NumPrefetchesDropped,
+          "Number of prefetch hints whose address could not be encoded");
+
 static cl::opt<std::string>
     PrefetchHintsFile("prefetch-hints-file",
                       cl::desc("Path to the prefetch hints profile. See also "
@@ -91,6 +100,33 @@ bool IsMemOpCompatibleWithPrefetch(const MachineInstr &MI, int Op) {
           X86MCRegisterClasses[X86::GR32RegClassID].contains(IndexReg));
 }
 
+// Return the displacement operand of the memory operand at \p Op, offset by
+// \p Delta, or std::nullopt if the result cannot be encoded.
+std::optional<MachineOperand> getPrefetchDisp(const MachineInstr &MI, int Op,
+                                              int64_t Delta) {
+  MachineOperand Disp = MI.getOperand(Op + X86::AddrDisp);
+  if (Disp.isImm()) {
+    int64_t NewDisp;
+    if (AddOverflow(Disp.getImm(), Delta, NewDisp) || !isInt<32>(NewDisp))
+      return std::nullopt;
+    Disp.setImm(NewDisp);
+    return Disp;
+  }
+  // Symbolic displacements, e.g. for RIP-relative accesses to globals. With a
+  // target flag, such as for a GOT entry, the address is not the symbol's.
+  if ((Disp.isGlobal() || Disp.isSymbol() || Disp.isMCSymbol() ||
+       Disp.isCPI() || Disp.isBlockAddress() || Disp.isTargetIndex()) &&
+      Disp.getTargetFlags() == X86II::MO_NO_FLAG) {
+    int64_t NewOffset;
+    if (AddOverflow(Disp.getOffset(), Delta, NewOffset) ||
+        !isInt<32>(NewOffset))
+      return std::nullopt;
+    Disp.setOffset(NewOffset);
+    return Disp;
+  }
+  return std::nullopt;
+}
+
 } // end anonymous namespace
 
 //===----------------------------------------------------------------------===//
@@ -190,6 +226,9 @@ bool X86InsertPrefetch::runOnMachineFunction(MachineFunction &MF) {
   const FunctionSamples *Samples = Reader->getSamplesFor(MF.getFunction());
   if (!Samples)
     return false;
+  // The hints are for the SSE prefetch instructions.
+  if (!MF.getSubtarget<X86Subtarget>().hasSSEPrefetch())
+    return false;
 
   bool Changed = false;
 
@@ -217,6 +256,14 @@ bool X86InsertPrefetch::runOnMachineFunction(MachineFunction &MF) {
       for (auto &PrefInfo : Prefetches) {
         unsigned PFetchInstrID = PrefInfo.InstructionID;
         int64_t Delta = PrefInfo.Delta;
+        std::optional<MachineOperand> Disp =
+            getPrefetchDisp(*Current, MemOpOffset, Delta);
+        if (!Disp) {
+          LLVM_DEBUG(dbgs() << "Dropping prefetch hint with delta " << Delta
+                            << " for " << *Current);
+          ++NumPrefetchesDropped;
+          continue;
+        }
         const MCInstrDesc &Desc = TII->get(PFetchInstrID);
         MachineInstr *PFetch =
             MF.CreateMachineInstr(Desc, Current->getDebugLoc(), true);
@@ -235,8 +282,7 @@ bool X86InsertPrefetch::runOnMachineFunction(MachineFunction &MF) {
                 Current->getOperand(MemOpOffset + X86::AddrScaleAmt).getImm())
             .addReg(
                 Current->getOperand(MemOpOffset + X86::AddrIndexReg).getReg())
-            .addImm(Current->getOperand(MemOpOffset + X86::AddrDisp).getImm() +
-                    Delta)
+            .add(*Disp)
             .addReg(Current->getOperand(MemOpOffset + X86::AddrSegmentReg)
                         .getReg());
 
@@ -249,6 +295,7 @@ bool X86InsertPrefetch::runOnMachineFunction(MachineFunction &MF) {
         // Insert before Current. This is because Current may clobber some of
         // the registers used to describe the input memory operand.
         MBB.insert(Current, PFetch);
+        ++NumPrefetchesInserted;
         Changed = true;
       }
     }
@@ -95,6 +95,12 @@ static cl::opt<unsigned>
                           cl::desc("Maximal number of fixpoint iterations."),
                           cl::init(32));
 
+static cl::opt<unsigned> SetFixpointUpdates(
+    "attributor-max-updates", cl::Hidden,
+    cl::desc("Maximal number of abstract attribute updates during fixpoint "
+             "iteration, 0 means unlimited."),
+    cl::init(0));
+
 static cl::opt<unsigned>
     MaxSpecializationPerCB("attributor-max-specializations-per-call-base",
                            cl::Hidden,
@@ -2128,6 +2134,9 @@ void Attributor::runTillFixpoint() {
   unsigned IterationCounter = 1;
   unsigned MaxIterations =
       Configuration.MaxFixpointIterations.value_or(SetFixpointIterations);
+  unsigned MaxUpdates =
+      Configuration.MaxFixpointUpdates.value_or(SetFixpointUpdates);
+  unsigned NumUpdates = 0;
 
   SmallVector<AbstractAttribute *, 32> ChangedAAs;
   SetVector<AbstractAttribute *> Worklist, InvalidAAs;
@@ -2190,9 +2199,11 @@ void Attributor::runTillFixpoint() {
     // changed.
     for (AbstractAttribute *AA : Worklist) {
       const auto &AAState = AA->getState();
-      if (!AAState.isAtFixpoint())
+      if (!AAState.isAtFixpoint()) {
+        ++NumUpdates;
         if (updateAA(*AA) == ChangeStatus::CHANGED)
           ChangedAAs.push_back(AA);
+      }
 
       // Use the InvalidAAs vector to propagate invalid states fast transitively
       // without requiring updates.
@@ -2213,6 +2224,14 @@ void Attributor::runTillFixpoint() {
                     QueryAAsAwaitingUpdate.end());
     QueryAAsAwaitingUpdate.clear();
 
+    // Like the iteration limit, the update budget is only checked between
+    // iterations so that the pessimistic reset below sees a consistent set of
+    // changed abstract attributes.
+    if (MaxUpdates && NumUpdates >= MaxUpdates && !Worklist.empty()) {
+      LLVM_DEBUG(dbgs() << "[Attributor] Update budget of " << MaxUpdates
+                        << " exhausted after " << NumUpdates << " updates\n");
+      break;
+    }
   } while (!Worklist.empty() && (IterationCounter++ < MaxIterations));
 
   if (IterationCounter > MaxIterations && !Functions.empty()) {
@@ -2222,6 +2241,13 @@ void Attributor::runTillFixpoint() {
     };
     Function *F = Functions.front();
     emitRemark<OptimizationRemarkMissed>(F, "FixedPoint", Remark);
+  } else if (!Worklist.empty() && !Functions.empty()) {
+    auto Remark = [&](OptimizationRemarkMissed ORM) {
+      return ORM << "Attributor did not reach a fixpoint after "
+                 << ore::NV("Updates", NumUpdates) << " updates.";
+    };
+    Function *F = Functions.front();
+    emitRemark<OptimizationRemarkMissed>(F, "FixedPointUpdates", Remark);
   }
 
   LLVM_DEBUG(dbgs() << "\n[Attributor] Fixpoint iteration done after: "
@@ -55,6 +55,7 @@
 #include "llvm/Support/Compiler.h"
 #include "llvm/Support/Debug.h"
 #include "llvm/Support/ErrorHandling.h"
+#include "llvm/Support/TimeProfiler.h"
 #include "llvm/Support/raw_ostream.h"
 #include "llvm/Transforms/IPO.h"
 #include "llvm/Transforms/Utils/Local.h"
@@ -409,6 +410,8 @@ bool llvm::thinLTOPropagateFunctionAttrs(
   if (DisableThinLTOPropagation)
     return false;
 
+  TimeTraceScope TimeScope("thinLTOPropagateFunctionAttrs");
+
   DenseMap<ValueInfo, FunctionSummary *> CachedPrevailingSummary;
   bool Changed = false;
 
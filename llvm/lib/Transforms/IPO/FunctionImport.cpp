@@ -38,7 +38,9 @@
 #include "llvm/Support/ErrorHandling.h"
 #include "llvm/Support/FileSystem.h"
 #include "llvm/Support/JSON.h"
+#include "llvm/Support/Parallel.h"
 #include "llvm/Support/SourceMgr.h"
+#include "llvm/Support/TimeProfiler.h"
 #include "llvm/Support/raw_ostream.h"
 #include "llvm/Transforms/IPO/Internalize.h"
 #include "llvm/Transforms/Utils/Cloning.h"
@@ -996,8 +998,11 @@ void llvm::ComputeCrossModuleImport(
         isPrevailing,
     DenseMap<StringRef, FunctionImporter::ImportMapTy> &ImportLists,
     DenseMap<StringRef, FunctionImporter::ExportSetTy> &ExportLists) {
+  TimeTraceScope TimeScope("ComputeCrossModuleImport");
   auto MIS = ModuleImportsManager::create(isPrevailing, Index, &ExportLists);
   // For each module that has function defined, compute the import/export lists.
+  // This stays serial: every module adds to the shared export lists, and
+  // isPrevailing is not required to be thread-safe.
   for (const auto &DefinedGVSummaries : ModuleToDefinedGVSummaries) {
     auto &ImportList = ImportLists[DefinedGVSummaries.first];
     LLVM_DEBUG(dbgs() << "Computing import for Module '"
@@ -1010,12 +1015,24 @@ void llvm::ComputeCrossModuleImport(
   // imported to the export list. We also need to mark any references and calls
   // they make as exported as well. We do this here, as it is more efficient
   // since we may import the same values multiple times into different modules
-  // during the import computation.
-  for (auto &ELI : ExportLists) {
+  // during the import computation. Each module's export list only depends on
+  // the (read-only) index and the module's own definitions, so the modules can
+  // be processed in parallel.
+  SmallVector<std::pair<StringRef, FunctionImporter::ExportSetTy *>, 0>
+      ExportListsVec;
+  ExportListsVec.reserve(ExportLists.size());
+  for (auto &ELI : ExportLists)
+    ExportListsVec.emplace_back(ELI.first, &ELI.second);
+  parallelFor(0, ExportListsVec.size(), [&](size_t I) {
+    auto [ModName, ExportList] = ExportListsVec[I];
+    auto DefinedIt = ModuleToDefinedGVSummaries.find(ModName);
+    if (DefinedIt == ModuleToDefinedGVSummaries.end()) {
+      assert(ExportList->empty() && "Exporting module has no definitions");
+      return;
+    }
+    const GVSummaryMapTy &DefinedGVSummaries = DefinedIt->second;
     FunctionImporter::ExportSetTy NewExports;
-    const auto &DefinedGVSummaries =
-        ModuleToDefinedGVSummaries.lookup(ELI.first);
-    for (auto &EI : ELI.second) {
+    for (auto &EI : *ExportList) {
       // Find the copy defined in the exporting module so that we can mark the
       // values it references in that specific definition as exported.
       // Below we will add all references and called values, without regard to
@@ -1054,8 +1071,8 @@ void llvm::ComputeCrossModuleImport(
       else
         ++EI;
     }
-    ELI.second.insert(NewExports.begin(), NewExports.end());
-  }
+    ExportList->insert(NewExports.begin(), NewExports.end());
+  });
 
   assert(checkVariableImport(Index, ImportLists, ExportLists));
 #ifndef NDEBUG
@@ -61,6 +61,8 @@
 
 STATISTIC(NumColdRegionsFound, "Number of cold regions found.");
 STATISTIC(NumColdRegionsOutlined, "Number of cold regions outlined.");
+STATISTIC(NumColdCodeSizeOutlined,
+          "Estimated code size of cold regions outlined.");
 
 using namespace llvm;
 
@@ -72,6 +74,12 @@ static cl::opt<int>
                        cl::desc("Base penalty for splitting cold code (as a "
                                 "multiple of TCC_Basic)"));
 
+static cl::opt<int> HotFunctionSplittingThreshold(
+    "hotcoldsplit-hot-function-threshold", cl::init(1), cl::Hidden,
+    cl::desc("Base penalty for splitting cold code out of functions that the "
+             "profile reports as hot (as a multiple of TCC_Basic). Defaults "
+             "to -hotcoldsplit-threshold if only that is given"));
+
 static cl::opt<bool> EnableColdSection(
     "enable-cold-section", cl::init(false), cl::Hidden,
     cl::desc("Enable placement of extracted cold functions"
@@ -278,13 +286,14 @@ static InstructionCost getOutliningBenefit(ArrayRef<BasicBlock *> Region,
 
 /// Get the penalty score for outlining \p Region.
 static int getOutliningPenalty(ArrayRef<BasicBlock *> Region,
-                               unsigned NumInputs, unsigned NumOutputs) {
-  int Penalty = SplittingThreshold;
+                               unsigned NumInputs, unsigned NumOutputs,
+                               int Threshold) {
+  int Penalty = Threshold;
   LLVM_DEBUG(dbgs() << "Applying penalty for splitting: " << Penalty << "\n");
 
   // If the splitting threshold is set at or below zero, skip the usual
   // profitability check.
-  if (SplittingThreshold <= 0)
+  if (Threshold <= 0)
     return Penalty;
 
   // Find the number of distinct exit blocks for the region. Use a conservative
@@ -368,18 +377,28 @@ static int getOutliningPenalty(ArrayRef<BasicBlock *> Region,
 }
 
 // Determine if it is beneficial to split the \p Region.
-bool HotColdSplitting::isSplittingBeneficial(CodeExtractor &CE,
-                                             const BlockSequence &Region,
-                                             TargetTransformInfo &TTI) {
+bool HotColdSplitting::isSplittingBeneficial(
+    CodeExtractor &CE, const BlockSequence &Region, TargetTransformInfo &TTI,
+    bool IsHotFunction, InstructionCost &OutliningBenefit) {
   assert(!Region.empty());
 
+  // Cold code left inside a hot function dilutes the i-cache and i-TLB lines
+  // that the hot path uses, so accept a smaller benefit when the profile says
+  // the function is hot. An explicit -hotcoldsplit-threshold applies to all
+  // functions unless the hot function threshold is given as well.
+  bool UseHotThreshold =
+      IsHotFunction && (HotFunctionSplittingThreshold.getNumOccurrences() ||
+                        !SplittingThreshold.getNumOccurrences());
+  int Threshold =
+      UseHotThreshold ? HotFunctionSplittingThreshold : SplittingThreshold;
+
   // Perform a simple cost/benefit analysis to decide whether or not to permit
   // splitting.
   SetVector<Value *> Inputs, Outputs, Sinks;
   CE.findInputsOutputs(Inputs, Outputs, Sinks);
-  InstructionCost OutliningBenefit = getOutliningBenefit(Region, TTI);
+  OutliningBenefit = getOutliningBenefit(Region, TTI);
   int OutliningPenalty =
-      getOutliningPenalty(Region, Inputs.size(), Outputs.size());
+      getOutliningPenalty(Region, Inputs.size(), Outputs.size(), Threshold);
   LLVM_DEBUG(dbgs() << "Split profitability: benefit = " << OutliningBenefit
                     << ", penalty = " << OutliningPenalty << "\n");
   if (!OutliningBenefit.isValid() || OutliningBenefit <= OutliningPenalty)
@@ -631,6 +650,9 @@ bool HotColdSplitting::outlineColdRegions(Function &F, bool HasProfileSummary) {
   // of the pair is the entry point into the region to be outlined.
   SmallVector<std::pair<BasicBlock *, CodeExtractor>, 2> OutliningWorklist;
 
+  // Estimated code size of the regions in the worklist, for reporting.
+  InstructionCost OutlinedCodeSize = 0;
+
   // Set up an RPO traversal. Experimentally, this performs better (outlines
   // more) than a PO traversal, because we prevent region overlap by keeping
   // the first region to contain a block.
@@ -651,6 +673,7 @@ bool HotColdSplitting::outlineColdRegions(Function &F, bool HasProfileSummary) {
   OptimizationRemarkEmitter &ORE = (*GetORE)(F);
   AssumptionCache *AC = LookupAC(F);
   auto ColdProbThresh = TTI.getPredictableBranchThreshold().getCompl();
+  bool IsHotFunction = HasProfileSummary && PSI->isFunctionEntryHot(&F);
 
   if (ColdBranchProbDenom.getNumOccurrences())
     ColdProbThresh = BranchProbability(1, ColdBranchProbDenom.getValue());
@@ -704,7 +727,10 @@ bool HotColdSplitting::outlineColdRegions(Function &F, bool HasProfileSummary) {
             /* AllowAlloca */ false, /* AllocaBlock */ nullptr,
             /* Suffix */ "cold." + std::to_string(OutlinedFunctionID));
 
-        if (CE.isEligible() && isSplittingBeneficial(CE, SubRegion, TTI) &&
+        InstructionCost Benefit = 0;
+        if (CE.isEligible() &&
+            isSplittingBeneficial(CE, SubRegion, TTI, IsHotFunction,
+                                  Benefit) &&
             // If this outlining region intersects with another, drop the new
             // region.
             //
@@ -723,6 +749,7 @@ bool HotColdSplitting::outlineColdRegions(Function &F, bool HasProfileSummary) {
 
           OutliningWorklist.emplace_back(
               std::make_pair(SubRegion[0], std::move(CE)));
+          OutlinedCodeSize += Benefit;
           ++OutlinedFunctionID;
         } else {
           // The cold block region cannot be outlined.
@@ -751,6 +778,16 @@ bool HotColdSplitting::outlineColdRegions(Function &F, bool HasProfileSummary) {
     (void)Outlined;
   }
 
+  if (auto Size = OutlinedCodeSize.getValue())
+    NumColdCodeSizeOutlined += *Size;
+  ORE.emit([&]() {
+    return OptimizationRemarkAnalysis(DEBUG_TYPE, "HotColdSplitSummary", &F)
+           << "outlined " << ore::NV("NumRegions", OutliningWorklist.size())
+           << " cold regions with estimated code size "
+           << ore::NV("CodeSize", OutlinedCodeSize) << " from "
+           << ore::NV("Function", &F);
+  });
+
   return true;
 }
 
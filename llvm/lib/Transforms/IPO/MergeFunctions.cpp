@@ -86,6 +86,18 @@
 // Though possibility to detect complex cross-referencing (e.g.: A->B->C->D->A)
 // could cover much more cases.
 //
+// * merging across ThinLTO modules.
+//
+// The pass only sees one module, so identical template instantiations in
+// different ThinLTO modules survive until linker ICF, which cannot fold
+// address-taken functions. A summary-based mode would record StructuralHash
+// of each eligible function in the module summary, pick one canonical copy
+// per hash class in the thin link (confirmed by a FunctionComparator check in
+// the backend that imports it, since the hash ignores operands), and turn the
+// other copies into thunks or aliases in their own backends. The summary
+// needs a new per-function field for this, and the thin link must treat the
+// canonical copy as exported even if nothing references it directly.
+//
 //===----------------------------------------------------------------------===//
 
 #include "llvm/Transforms/IPO/MergeFunctions.h"
@@ -36,8 +36,10 @@
 #include "llvm/IR/GlobalVariable.h"
 #include "llvm/IR/IRBuilder.h"
 #include "llvm/IR/Instruction.h"
+#include "llvm/IR/InstIterator.h"
 #include "llvm/IR/Instructions.h"
 #include "llvm/IR/IntrinsicInst.h"
+#include "llvm/IR/MDBuilder.h"
 #include "llvm/IR/Module.h"
 #include "llvm/IR/Type.h"
 #include "llvm/InitializePasses.h"
@@ -169,6 +171,28 @@ cl::opt<bool> SkipRetExitBlock(
     "skip-ret-exit-block", cl::init(true),
     cl::desc("Suppress counter promotion if exit blocks contain ret."));
 
+// Sampled instrumentation only updates counters during the first
+// SampledInstrBurstDuration of every SampledInstrPeriod executed counter
+// updates on a thread, trading profile precision for a much lower runtime
+// overhead. Counts are scaled down uniformly, so the relative block and edge
+// weights the profile is used for are preserved.
+cl::opt<bool> SampledInstr("sampled-instrumentation", cl::ZeroOrMore,
+                           cl::init(false),
+                           cl::desc("Do PGO instrumentation sampling"));
+
+cl::opt<unsigned> SampledInstrPeriod(
+    "sampled-instr-period", cl::init(65535),
+    cl::desc("Set the profile instrumentation sample period. For each sample "
+             "period, a fixed number of consecutive samples will be recorded. "
+             "The number is controlled by 'sampled-instr-burst-duration' "
+             "flag."));
+
+cl::opt<unsigned> SampledInstrBurstDuration(
+    "sampled-instr-burst-duration", cl::init(200),
+    cl::desc("Set the profile instrumentation burst duration, which must be "
+             "less than the sample period. This is the number of consecutive "
+             "counter updates recorded in each sample period."));
+
 using LoadStorePair = std::pair<Instruction *, Instruction *>;
 
 static uint64_t getIntModuleFlagOrZero(const Module &M, StringRef Flag) {
@@ -242,10 +266,20 @@ private:
 
   int64_t TotalCountersPromoted = 0;
 
+  /// The per-thread countdown that gates sampled counter updates.
+  GlobalVariable *SamplingVar = nullptr;
+
   /// Lower instrumentation intrinsics in the function. Returns true if there
   /// any lowering.
   bool lowerIntrinsics(Function *F);
 
+  /// Get the sampling variable, creating it if necessary.
+  GlobalVariable *getOrCreateSamplingVar();
+
+  /// Guard every counter increment in the function with a check of the
+  /// sampling variable, so that only increments inside a burst are executed.
+  void doSampling(Function &F);
+
   /// Register-promote counter loads and stores in loops.
   void promoteCounterLoadStores(Function *F);
 
@@ -622,9 +656,73 @@ PreservedAnalyses InstrProfilingLoweringPass::run(Module &M,
   return PreservedAnalyses::none();
 }
 
+GlobalVariable *InstrLowerer::getOrCreateSamplingVar() {
+  if (SamplingVar)
+    return SamplingVar;
+
+  if (SampledInstrBurstDuration >= SampledInstrPeriod)
+    report_fatal_error("sampled-instr-burst-duration must be less than "
+                       "sampled-instr-period");
+
+  // Each thread counts its own updates, which keeps the check free of
+  // contention. Like the counter bias, every instrumented TU defines the
+  // variable and the COMDAT keeps a single copy of it in the link.
+  constexpr StringRef VarName = "__llvm_profile_sampling";
+  Type *Int32Ty = Type::getInt32Ty(M.getContext());
+  SamplingVar = M.getGlobalVariable(VarName);
+  if (!SamplingVar) {
+    SamplingVar = new GlobalVariable(
+        M, Int32Ty, false, GlobalValue::LinkOnceODRLinkage,
+        Constant::getNullValue(Int32Ty), VarName, nullptr,
+        GlobalValue::GeneralDynamicTLSModel);
+    SamplingVar->setVisibility(GlobalVariable::HiddenVisibility);
+    if (TT.supportsCOMDAT())
+      SamplingVar->setComdat(M.getOrInsertComdat(VarName));
+  }
+  return SamplingVar;
+}
+
+void InstrLowerer::doSampling(Function &F) {
+  SmallVector<InstrProfIncrementInst *, 16> Increments;
+  for (Instruction &I : instructions(F))
+    if (auto *Inc = dyn_cast<InstrProfIncrementInst>(&I))
+      Increments.push_back(Inc);
+  if (Increments.empty())
+    return;
+
+  GlobalVariable *Var = getOrCreateSamplingVar();
+  auto *Ty = cast<IntegerType>(Var->getValueType());
+  auto *Burst = ConstantInt::get(Ty, SampledInstrBurstDuration);
+  auto *Period = ConstantInt::get(Ty, SampledInstrPeriod);
+  MDNode *Weights = MDBuilder(M.getContext())
+                        .createBranchWeights(SampledInstrBurstDuration,
+                                             SampledInstrPeriod -
+                                                 SampledInstrBurstDuration);
+  for (InstrProfIncrementInst *Inc : Increments) {
+    //  %cnt = load i32, ptr @__llvm_profile_sampling
+    //  %next = add i32 %cnt, 1
+    //  %wrap = icmp uge i32 %next, Period
+    //  store (select %wrap, 0, %next), ptr @__llvm_profile_sampling
+    //  br (icmp ult i32 %cnt, Burst), label %sampled, label %cont
+    IRBuilder<> Builder(Inc);
+    Value *Count = Builder.CreateLoad(Ty, Var, "sampling.count");
+    Value *Next = Builder.CreateAdd(Count, ConstantInt::get(Ty, 1));
+    Value *Wrap = Builder.CreateICmpUGE(Next, Period);
+    Builder.CreateStore(
+        Builder.CreateSelect(Wrap, ConstantInt::getNullValue(Ty), Next), Var);
+    Value *InBurst = Builder.CreateICmpULT(Count, Burst, "sampling.burst");
+    Instruction *ThenTerm =
+        SplitBlockAndInsertIfThen(InBurst, Inc, /*Unreachable=*/false, Weights);
+    Inc->moveBefore(ThenTerm);
+  }
+}
+
 bool InstrLowerer::lowerIntrinsics(Function *F) {
   bool MadeChange = false;
   PromotionCandidates.clear();
+  // Split blocks before the lowering loop below walks them.
+  if (SampledInstr)
+    doSampling(*F);
   for (BasicBlock &BB : *F) {
     for (Instruction &Instr : llvm::make_early_inc_range(BB)) {
       if (auto *IPIS = dyn_cast<InstrProfIncrementInstStep>(&Instr)) {
@@ -675,6 +773,10 @@ bool InstrLowerer::isRuntimeCounterRelocationEnabled() const {
 }
 
 bool InstrLowerer::isCounterPromotionEnabled() const {
+  // Promotion would move the guarded updates out of their sampled blocks.
+  if (SampledInstr)
+    return false;
+
   if (DoCounterPromotion.getNumOccurrences() > 0)
     return DoCounterPromotion;
 
@@ -1439,6 +1439,50 @@ bool LoopVectorizationLegality::canVectorizeLoopNestCFG(
   return Result;
 }
 
+bool LoopVectorizationLegality::isVectorizableEarlyExitLoop() {
+  BasicBlock *LatchBB = TheLoop->getLoopLatch();
+  if (!LatchBB || !TheLoop->isLoopExiting(LatchBB))
+    return false;
+
+  // The latch exit bounds the number of iterations, so that a vector loop
+  // knows how far it may read ahead.
+  ScalarEvolution &SE = *PSE.getSE();
+  if (isa<SCEVCouldNotCompute>(SE.getExitCount(TheLoop, LatchBB)))
+    return false;
+
+  SmallVector<BasicBlock *, 4> ExitingBlocks;
+  TheLoop->getExitingBlocks(ExitingBlocks);
+  BasicBlock *EarlyExitingBB = nullptr;
+  for (BasicBlock *BB : ExitingBlocks) {
+    if (BB == LatchBB ||
+        !isa<SCEVCouldNotCompute>(SE.getExitCount(TheLoop, BB)))
+      continue;
+    if (EarlyExitingBB)
+      return false;
+    EarlyExitingBB = BB;
+  }
+  if (!EarlyExitingBB)
+    return false;
+
+  // Iterations past the early exit are evaluated speculatively, so they must
+  // have no side effects and all their loads must be safe to execute.
+  for (BasicBlock *BB : TheLoop->blocks()) {
+    for (Instruction &I : *BB) {
+      if (I.mayWriteToMemory() || I.mayThrow())
+        return false;
+      if (auto *LI = dyn_cast<LoadInst>(&I))
+        if (!LI->isSimple() ||
+            !isDereferenceableAndAlignedInLoop(LI, TheLoop, SE, *DT, AC))
+          return false;
+    }
+  }
+
+  LLVM_DEBUG(dbgs() << "LV: Found an uncountable early exit in "
+                    << EarlyExitingBB->getName() << ".\n");
+  UncountableExitingBB = EarlyExitingBB;
+  return true;
+}
+
 bool LoopVectorizationLegality::canVectorize(bool UseVPlanNativePath) {
   // Store the result and return it at the end instead of exiting early, in case
   // allowExtraAnalysis is used to report multiple reasons for not vectorizing.
@@ -1507,9 +1551,20 @@ bool LoopVectorizationLegality::canVectorize(bool UseVPlanNativePath) {
   }
 
   if (isa<SCEVCouldNotCompute>(PSE.getBackedgeTakenCount())) {
-    reportVectorizationFailure("could not determine number of loop iterations",
-                               "could not determine number of loop iterations",
-                               "CantComputeNumberOfIterations", ORE, TheLoop);
+    // Search loops are recognized so that they are reported distinctly, but
+    // the vectorizer cannot generate code for them yet.
+    if (isVectorizableEarlyExitLoop())
+      reportVectorizationFailure(
+          "Vectorization of loops with an uncountable early exit is not yet "
+          "supported",
+          "loop has a data-dependent early exit",
+          "UncountableEarlyExitLoop", ORE, TheLoop,
+          UncountableExitingBB->getTerminator());
+    else
+      reportVectorizationFailure(
+          "could not determine number of loop iterations",
+          "could not determine number of loop iterations",
+          "CantComputeNumberOfIterations", ORE, TheLoop);
     if (DoExtraAnalysis)
       Result = false;
     else
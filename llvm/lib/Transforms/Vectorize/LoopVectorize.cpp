@@ -193,6 +193,13 @@ static cl::opt<unsigned> EpilogueVectorizationMinVF(
     cl::desc("Only loops with vectorization factor equal to or larger than "
              "the specified value are considered for epilogue vectorization."));
 
+static cl::opt<bool> EpilogueVectorizationUseProfile(
+    "epilogue-vectorization-use-profile", cl::init(false), cl::Hidden,
+    cl::desc("Skip epilogue vectorization factors that the trip count "
+             "estimated from profile data leaves no iterations for. The "
+             "estimate is an average, so this is only sound for loops whose "
+             "trip count hardly varies between executions."));
+
 /// Loops with a known constant trip count below this number are vectorized only
 /// if no scalar iteration overheads are incurred.
 static cl::opt<unsigned> TinyTripCountVectorThreshold(
@@ -5072,6 +5079,19 @@ VectorizationFactor LoopVectorizationPlanner::selectEpilogueVectorizationFactor(
   ScalarEvolution &SE = *PSE.getSE();
   Type *TCType = Legal->getWidestInductionType();
   const SCEV *RemainingIterations = nullptr;
+
+  // When the trip count is unknown at compile time but profile data says the
+  // hot trip count is, e.g., a multiple of the main loop's step, a vector
+  // epilogue would only add code and checks on the hot path. The estimate is
+  // the average trip count, so its remainder says nothing about loops whose
+  // trip count varies; this is opt-in for that reason.
+  std::optional<unsigned> EstimatedRemainingIterations;
+  if (EpilogueVectorizationUseProfile && !MainLoopVF.isScalable())
+    if (std::optional<unsigned> EstimatedTC =
+            getLoopEstimatedTripCount(OrigLoop))
+      EstimatedRemainingIterations =
+          *EstimatedTC % (MainLoopVF.getKnownMinValue() * IC);
+
   for (auto &NextVF : ProfitableVFs) {
     // Skip candidate VFs without a corresponding VPlan.
     if (!hasPlanWithVF(NextVF.Width))
@@ -5098,6 +5118,14 @@ VectorizationFactor LoopVectorizationPlanner::selectEpilogueVectorizationFactor(
               SE.getConstant(TCType, NextVF.Width.getKnownMinValue()),
               RemainingIterations))
         continue;
+      if (EstimatedRemainingIterations &&
+          NextVF.Width.getKnownMinValue() > *EstimatedRemainingIterations) {
+        LLVM_DEBUG(dbgs() << "LEV: Skipping epilogue VF " << NextVF.Width
+                          << ", profile estimates "
+                          << *EstimatedRemainingIterations
+                          << " remaining iterations.\n");
+        continue;
+      }
     }
 
     if (Result.Width.isScalar() || isMoreProfitable(NextVF, Result))
@@ -7157,7 +7185,10 @@ static ElementCount determineVPlanVF(const TargetTransformInfo &TTI,
           : TargetTransformInfo::RGK_FixedWidthVector;
 
   TypeSize RegSize = TTI.getRegisterBitWidth(RegKind);
-  unsigned N = RegSize.getKnownMinValue() / WidestType;
+  // Round down so the VF is a power of two even for odd register widths. A
+  // target without vector registers, or a widest type that does not fit into
+  // one, yields a scalar VF that the caller rejects.
+  unsigned N = llvm::bit_floor(RegSize.getKnownMinValue() / WidestType);
   return ElementCount::get(N, RegSize.isScalable());
 }
 
@@ -7180,6 +7211,15 @@ LoopVectorizationPlanner::planInVPlanNativePath(ElementCount UserVF) {
         LLVM_DEBUG(dbgs() << "LV: VPlan stress testing: "
                           << "overriding computed VF.\n");
         VF = ElementCount::getFixed(4);
+      } else if (VF.isScalar() || VF.isZero()) {
+        LLVM_DEBUG(dbgs() << "LV: Not vectorizing. No vector VF for the "
+                          << "widest type in the outer loop.\n");
+        reportVectorizationFailure(
+            "Outer loop types do not fit a vector register",
+            "cannot vectorize the outer loop because its widest type does "
+            "not fit into a vector register of the target",
+            "NoVectorVFForOuterLoop", ORE, OrigLoop);
+        return VectorizationFactor::Disabled();
       }
     } else if (UserVF.isScalable() && !TTI.supportsScalableVectors() &&
                !ForceTargetSupportsScalableVectors) {
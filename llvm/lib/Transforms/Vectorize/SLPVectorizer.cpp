@@ -16209,7 +16209,12 @@ bool SLPVectorizerPass::tryToVectorizeList(ArrayRef<Value *> VL, BoUpSLP &R,
     for (unsigned I = NextInst; I < MaxInst; ++I) {
       unsigned ActualVF = std::min(MaxInst - I, VF);
 
-      if (!isPowerOf2_32(ActualVF))
+      // As for store chains, with non-power-of-2 vectorization enabled also
+      // try a tail that fills all but one lane, e.g. the components of a
+      // vec3. Build vectors are excluded since their root is already a vector.
+      bool IsNonPowerOf2Tail = VectorizeNonPowerOf2 && ActualVF + 1 == VF &&
+                               !isa<InsertElementInst>(VL[I]);
+      if (!isPowerOf2_32(ActualVF) && !IsNonPowerOf2Tail)
         continue;
 
       if (MaxVFOnly && ActualVF < MaxVF)
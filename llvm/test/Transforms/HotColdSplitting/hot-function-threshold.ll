@@ -0,0 +1,89 @@
+; REQUIRES: asserts
+; RUN: opt -passes=hotcoldsplit -debug-only=hotcoldsplit -S < %s -o /dev/null 2>&1 \
+; RUN:   | FileCheck %s --check-prefix=DEFAULT
+; RUN: opt -passes=hotcoldsplit -debug-only=hotcoldsplit -hotcoldsplit-threshold=3 \
+; RUN:   -S < %s -o /dev/null 2>&1 | FileCheck %s --check-prefix=BASE
+; RUN: opt -passes=hotcoldsplit -debug-only=hotcoldsplit \
+; RUN:   -hotcoldsplit-hot-function-threshold=0 -S < %s -o /dev/null 2>&1 \
+; RUN:   | FileCheck %s --check-prefix=HOT
+; RUN: opt -passes=hotcoldsplit -debug-only=hotcoldsplit -hotcoldsplit-threshold=3 \
+; RUN:   -hotcoldsplit-hot-function-threshold=0 -S < %s -o /dev/null 2>&1 \
+; RUN:   | FileCheck %s --check-prefix=BOTH
+; RUN: opt -passes=hotcoldsplit -debug-only=hotcoldsplit \
+; RUN:   -hotcoldsplit-hot-function-threshold=0 -hotcoldsplit-threshold=3 \
+; RUN:   -S < %s -o /dev/null 2>&1 | FileCheck %s --check-prefix=BOTH
+
+; Functions whose entry the profile reports as hot use
+; -hotcoldsplit-hot-function-threshold, unless only -hotcoldsplit-threshold is
+; given, which then applies to all functions.
+
+; DEFAULT-LABEL: Outlining in hot
+; DEFAULT: Applying penalty for splitting: 1
+; DEFAULT-LABEL: Outlining in warm
+; DEFAULT: Applying penalty for splitting: 2
+
+; BASE-LABEL: Outlining in hot
+; BASE: Applying penalty for splitting: 3
+; BASE-LABEL: Outlining in warm
+; BASE: Applying penalty for splitting: 3
+
+; HOT-LABEL: Outlining in hot
+; HOT: Applying penalty for splitting: 0
+; HOT-LABEL: Outlining in warm
+; HOT: Applying penalty for splitting: 2
+
+; BOTH-LABEL: Outlining in hot
+; BOTH: Applying penalty for splitting: 0
+; BOTH-LABEL: Outlining in warm
+; BOTH: Applying penalty for splitting: 3
+
+declare void @sink(i32) cold
+
+define void @hot(i32 %x) !prof !14 {
+entry:
+  %c = icmp eq i32 %x, 0
+  br i1 %c, label %cold, label %exit, !prof !15
+
+cold:
+  call void @sink(i32 %x)
+  call void @sink(i32 1)
+  call void @sink(i32 2)
+  br label %exit
+
+exit:
+  ret void
+}
+
+define void @warm(i32 %x) !prof !16 {
+entry:
+  %c = icmp eq i32 %x, 0
+  br i1 %c, label %cold, label %exit, !prof !15
+
+cold:
+  call void @sink(i32 %x)
+  call void @sink(i32 1)
+  call void @sink(i32 2)
+  br label %exit
+
+exit:
+  ret void
+}
+
+!llvm.module.flags = !{!0}
+!0 = !{i32 1, !"ProfileSummary", !1}
+!1 = !{!2, !3, !4, !5, !6, !7, !8, !9}
+!2 = !{!"ProfileFormat", !"InstrProf"}
+!3 = !{!"TotalCount", i64 10000}
+!4 = !{!"MaxCount", i64 1000}
+!5 = !{!"MaxInternalCount", i64 1}
+!6 = !{!"MaxFunctionCount", i64 1000}
+!7 = !{!"NumCounts", i64 3}
+!8 = !{!"NumFunctions", i64 3}
+!9 = !{!"DetailedSummary", !10}
+!10 = !{!11, !12, !13}
+!11 = !{i32 10000, i64 100, i32 1}
+!12 = !{i32 999000, i64 100, i32 1}
+!13 = !{i32 999999, i64 1, i32 2}
+!14 = !{!"function_entry_count", i64 1000}
+!15 = !{!"branch_weights", i32 0, i32 1000}
+!16 = !{!"function_entry_count", i64 10}
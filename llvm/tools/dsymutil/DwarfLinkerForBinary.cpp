@@ -591,6 +591,18 @@ void DwarfLinkerForBinary::copySwiftReflectionMetadata(
   }
 }
 
+// FIXME: Every invocation relinks the debug info of every object file in the
+// debug map, even when only one of them changed since the previous .dSYM was
+// produced. Reusing earlier output would need a cache, keyed per object file
+// by its contents and by the ranges the debug map keeps live, holding:
+//  - the cloned DIEs of each compile unit, with the offsets into the common
+//    string, line and range tables left as patches to apply later;
+//  - the ODR type candidates each unit contributed, so that type
+//    deduplication gives the same result as a full link;
+//  - per-unit accelerator table entries, since the tables are rebuilt in full.
+// The parallel linker already clones every unit into its own sections and
+// patches offsets in a separate pass (see glueCompileUnitsAndWriteToTheOutput),
+// so that is the natural place to serialize and restore units.
 bool DwarfLinkerForBinary::link(const DebugMap &Map) {
   if (Options.DWARFLinkerType == DsymutilDWARFLinkerType::Parallel)
     return linkImpl<parallel::DWARFLinker>(Map, Options.FileType);
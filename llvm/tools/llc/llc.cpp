@@ -22,6 +22,7 @@
 #include "llvm/CodeGen/MIRParser/MIRParser.h"
 #include "llvm/CodeGen/MachineFunctionPass.h"
 #include "llvm/CodeGen/MachineModuleInfo.h"
+#include "llvm/CodeGen/ParallelCG.h"
 #include "llvm/CodeGen/TargetPassConfig.h"
 #include "llvm/CodeGen/TargetSubtargetInfo.h"
 #include "llvm/IR/AutoUpgrade.h"
@@ -56,6 +57,7 @@
 #include "llvm/TargetParser/SubtargetFeature.h"
 #include "llvm/TargetParser/Triple.h"
 #include "llvm/Transforms/Utils/Cloning.h"
+#include <atomic>
 #include <memory>
 #include <optional>
 using namespace llvm;
@@ -85,6 +87,11 @@ TimeCompilations("time-compilations", cl::Hidden, cl::init(1u),
                  cl::value_desc("N"),
                  cl::desc("Repeat compilation N times for timing"));
 
+static cl::opt<unsigned> CodeGenPartitions(
+    "codegen-partitions", cl::init(1u), cl::value_desc("N"),
+    cl::desc("Split the module into N partitions and generate code for them "
+             "in parallel. Partition I > 0 is written to <output>.I"));
+
 static cl::opt<bool> TimeTrace("time-trace", cl::desc("Record time trace"));
 
 static cl::opt<unsigned> TimeTraceGranularity(
@@ -226,6 +233,18 @@ struct RunPassOption {
       getRunPassNames().push_back(std::string(PassName));
   }
 };
+
+/// Diagnostic handler for the contexts -codegen-partitions compiles in.
+struct PartitionDiagnosticHandler : public LLCDiagnosticHandler {
+  std::atomic<bool> &AnyErrors;
+  PartitionDiagnosticHandler(std::atomic<bool> &AnyErrors)
+      : AnyErrors(AnyErrors) {}
+  bool handleDiagnostics(const DiagnosticInfo &DI) override {
+    if (DI.getSeverity() == DS_Error)
+      AnyErrors = true;
+    return LLCDiagnosticHandler::handleDiagnostics(DI);
+  }
+};
 } // namespace
 
 static RunPassOption RunPassOpt;
@@ -647,6 +666,69 @@ static int compileModule(char **argv, LLVMContext &Context) {
     WithColor::warning(errs(), argv[0])
         << ": warning: ignoring -mc-relax-all because filetype != obj";
 
+  if (CodeGenPartitions > 1) {
+    if (MIR || !getRunPassNames().empty() || DwoOut || CompileTwice ||
+        EnableNewPassManager || !PassPipeline.empty()) {
+      WithColor::error(errs(), argv[0])
+          << "-codegen-partitions cannot be used with MIR input, -run-pass, "
+             "-split-dwarf-output, -compile-twice or the new pass manager\n";
+      return 1;
+    }
+    if (!Out->os().supportsSeeking()) {
+      WithColor::error(errs(), argv[0])
+          << "-codegen-partitions requires a seekable output file\n";
+      return 1;
+    }
+    if (TargetPassConfig::hasLimitedCodeGenPipeline()) {
+      WithColor::error(errs(), argv[0])
+          << "-codegen-partitions cannot be used with "
+          << TargetPassConfig::getLimitedCodeGenPipelineReason() << "\n";
+      return 1;
+    }
+
+    std::vector<std::unique_ptr<ToolOutputFile>> PartOuts;
+    SmallVector<raw_pwrite_stream *, 8> OSs = {&Out->os()};
+    for (unsigned I = 1; I != CodeGenPartitions; ++I) {
+      std::error_code EC;
+      std::string Name = (Out->outputFilename() + "." + Twine(I)).str();
+      PartOuts.push_back(std::make_unique<ToolOutputFile>(
+          Name, EC,
+          codegen::getFileType() == CodeGenFileType::AssemblyFile
+              ? sys::fs::OF_TextWithCRLF
+              : sys::fs::OF_None));
+      if (EC)
+        reportError(EC.message(), Name);
+      OSs.push_back(&PartOuts.back()->os());
+    }
+
+    // Each partition is compiled in its own context by its own target machine.
+    // Those contexts do not outlive the worker tasks, so errors reported in
+    // them are recorded in a flag owned by this thread.
+    std::atomic<bool> PartitionHasErrors(false);
+    cl::PrintOptionValues();
+    splitCodeGen(
+        *M, OSs, {},
+        [&]() {
+          return std::unique_ptr<TargetMachine>(TheTarget->createTargetMachine(
+              TheTriple.getTriple(), CPUStr, FeaturesStr, Target->Options, RM,
+              CM, OLvl));
+        },
+        codegen::getFileType(), /*PreserveLocals=*/false,
+        [&](LLVMContext &PartCtx, legacy::PassManager &PartPM) {
+          PartCtx.setDiscardValueNames(DiscardValueNames);
+          PartCtx.setDiagnosticHandler(
+              std::make_unique<PartitionDiagnosticHandler>(PartitionHasErrors));
+          PartPM.add(new TargetLibraryInfoWrapperPass(TLII));
+        });
+
+    if (Context.getDiagHandlerPtr()->HasErrors || PartitionHasErrors)
+      return 1;
+    Out->keep();
+    for (std::unique_ptr<ToolOutputFile> &PartOut : PartOuts)
+      PartOut->keep();
+    return 0;
+  }
+
   if (EnableNewPassManager || !PassPipeline.empty()) {
     return compileModuleWithNewPM(argv[0], std::move(M), std::move(MIR),
                                   std::move(Target), std::move(Out),
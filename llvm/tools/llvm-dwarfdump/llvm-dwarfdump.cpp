@@ -304,6 +304,11 @@ static opt<std::string> JsonErrSummaryFile(
     value_desc("filename.json"), cat(DwarfDumpCategory));
 static opt<bool> Quiet("quiet", desc("Use with -verify to not emit to STDOUT."),
                        cat(DwarfDumpCategory));
+static opt<unsigned> VerifyThreads(
+    "verify-threads", init(1),
+    desc("Use with -verify to parse units and line tables on this many "
+         "threads before checking them (0 = one per hardware thread)."),
+    value_desc("n"), cat(DwarfDumpCategory));
 static opt<bool> DumpUUID("uuid", desc("Show the UUID for each architecture."),
                           cat(DwarfDumpCategory));
 static alias DumpUUIDAlias("u", desc("Alias for --uuid."), aliasopt(DumpUUID),
@@ -357,6 +362,7 @@ static DIDumpOptions getDumpOpts(DWARFContext &C) {
     DumpOpts.ShowAggregateErrors = ErrorDetails != OnlyDetailsNoSummary &&
                                    ErrorDetails != NoDetailsOnlySummary;
     DumpOpts.JsonErrSummaryFile = JsonErrSummaryFile;
+    DumpOpts.VerifyThreads = VerifyThreads;
     return DumpOpts.noImplicitRecursion();
   }
   return DumpOpts;
@@ -255,10 +255,12 @@ static cl::opt<bool>
                                cl::desc("Show FailedToMaterialize errors"),
                                cl::init(false), cl::cat(JITLinkCategory));
 
-static cl::opt<bool> UseSharedMemory(
+static cl::opt<cl::boolOrDefault> UseSharedMemory(
     "use-shared-memory",
-    cl::desc("Use shared memory to transfer generated code and data"),
-    cl::init(false), cl::cat(JITLinkCategory));
+    cl::desc("Use shared memory to transfer generated code and data (default: "
+             "on for -oop-executor where the host supports it, off for "
+             "-oop-executor-connect)"),
+    cl::cat(JITLinkCategory));
 
 static ExitOnError ExitOnErr;
 
@@ -803,7 +805,16 @@ static Expected<std::unique_ptr<ExecutorProcessControl>> launchExecutor() {
   close(FromExecutor[WriteEnd]);
 
   auto S = SimpleRemoteEPC::Setup();
-  if (UseSharedMemory)
+  // The executor runs on this host, so code and data can be written straight
+  // into memory it has mapped rather than being copied over the pipe. This
+  // needs shm_open, which Android does not provide.
+#if defined(__ANDROID__)
+  bool SharedMemoryByDefault = false;
+#else
+  bool SharedMemoryByDefault = true;
+#endif
+  if (UseSharedMemory == cl::BOU_TRUE ||
+      (UseSharedMemory == cl::BOU_UNSET && SharedMemoryByDefault))
     S.CreateMemoryManager = createSharedMemoryManager;
 
   return SimpleRemoteEPC::Create<FDSimpleRemoteEPCTransport>(
@@ -893,7 +904,7 @@ static Expected<std::unique_ptr<ExecutorProcessControl>> connectToExecutor() {
     return SockFD.takeError();
 
   auto S = SimpleRemoteEPC::Setup();
-  if (UseSharedMemory)
+  if (UseSharedMemory == cl::BOU_TRUE)
     S.CreateMemoryManager = createSharedMemoryManager;
 
   return SimpleRemoteEPC::Create<FDSimpleRemoteEPCTransport>(
@@ -55,8 +55,10 @@
 #include "llvm/Support/FileSystem.h"
 #include "llvm/Support/InitLLVM.h"
 #include "llvm/Support/MemoryBuffer.h"
+#include "llvm/Support/Parallel.h"
 #include "llvm/Support/SourceMgr.h"
 #include "llvm/Support/TargetSelect.h"
+#include "llvm/Support/Threading.h"
 #include "llvm/Support/ToolOutputFile.h"
 #include "llvm/Support/WithColor.h"
 #include "llvm/TargetParser/Host.h"
@@ -225,6 +227,13 @@ static cl::opt<unsigned> StoreQueueSize("squeue",
                                         cl::desc("Size of the store queue"),
                                         cl::cat(ToolOptions), cl::init(0));
 
+static cl::opt<unsigned>
+    NumThreads("j",
+               cl::desc("Number of threads used to simulate code regions "
+                        "concurrently, or 0 to use all available cores. "
+                        "Reports are printed in the order of the regions"),
+               cl::cat(ToolOptions), cl::init(1));
+
 static cl::opt<bool>
     PrintInstructionTables("instruction-tables",
                            cl::desc("Print instruction tables"),
@@ -336,6 +345,24 @@ static void processViewOptions(bool IsOutOfOrder) {
     processOptionImpl(PrintRetireStats, Default);
 }
 
+namespace {
+/// The objects that the simulation and the report of one code region use. They
+/// are owned together so that regions can be simulated concurrently and
+/// reported in order afterwards.
+struct RegionAnalysis {
+  std::unique_ptr<mca::InstrBuilder> IB;
+  std::unique_ptr<mca::Context> MCA;
+  SmallVector<std::unique_ptr<mca::Instruction>> LoweredSequence;
+  DenseMap<const MCInst *, SmallVector<mca::Instrument *>> InstToInstruments;
+  std::unique_ptr<mca::CodeEmitter> CE;
+  std::unique_ptr<mca::CircularSourceMgr> S;
+  std::unique_ptr<mca::CustomBehaviour> CB;
+  std::unique_ptr<mca::Pipeline> P;
+  std::unique_ptr<mca::PipelinePrinter> Printer;
+  bool Succeeded = false;
+};
+} // namespace
+
 // Returns true on success.
 static bool runPipeline(mca::Pipeline &P) {
   // Handle pipeline errors here.
@@ -572,12 +599,6 @@ int main(int argc, char **argv) {
     IPP = std::make_unique<mca::InstrPostProcess>(*STI, *MCII);
   }
 
-  // Create an instruction builder.
-  mca::InstrBuilder IB(*STI, *MCII, *MRI, MCIA.get(), *IM, CallLatency);
-
-  // Create a context to control ownership of the pipeline hardware.
-  mca::Context MCA(*MRI, *STI);
-
   mca::PipelineOptions PO(MicroOpQueue, DecoderThroughput, DispatchWidth,
                           RegisterFileSize, LoadQueueSize, StoreQueueSize,
                           AssumeNoAlias, EnableBottleneckAnalysis);
@@ -594,22 +615,54 @@ int main(int argc, char **argv) {
   assert(MAB && "Unable to create asm backend!");
 
   json::Object JSONOutput;
+
+  // Regions are lowered and set up in order, then simulated in batches of
+  // concurrent pipelines, and reported in order.
+  parallel::strategy = hardware_concurrency(NumThreads);
+  size_t BatchSize =
+      NumThreads == 1 ? 1 : parallel::strategy.compute_thread_count() * 4;
+  std::vector<std::unique_ptr<RegionAnalysis>> Batch;
+  // Returns false if any pipeline failed, after printing the reports of the
+  // regions before it.
+  auto RunBatch = [&]() {
+    parallelFor(0, Batch.size(), [&](size_t I) {
+      Batch[I]->Succeeded = runPipeline(*Batch[I]->P);
+    });
+    bool Succeeded = true;
+    for (const std::unique_ptr<RegionAnalysis> &RA : Batch) {
+      if (!(Succeeded = RA->Succeeded))
+        break;
+      if (PrintJson)
+        RA->Printer->printReport(JSONOutput);
+      else
+        RA->Printer->printReport(TOF->os());
+    }
+    Batch.clear();
+    return Succeeded;
+  };
+
   int NonEmptyRegions = 0;
   for (const std::unique_ptr<mca::AnalysisRegion> &Region : Regions) {
     // Skip empty code regions.
     if (Region->empty())
       continue;
 
-    IB.clear();
+    auto RA = std::make_unique<RegionAnalysis>();
+
+    // Create an instruction builder.
+    RA->IB = std::make_unique<mca::InstrBuilder>(*STI, *MCII, *MRI, MCIA.get(),
+                                                 *IM, CallLatency);
+    mca::InstrBuilder &IB = *RA->IB;
 
     // Lower the MCInst sequence into an mca::Instruction sequence.
     ArrayRef<MCInst> Insts = Region->getInstructions();
-    mca::CodeEmitter CE(*STI, *MAB, *MCE, Insts);
+    RA->CE = std::make_unique<mca::CodeEmitter>(*STI, *MAB, *MCE, Insts);
+    mca::CodeEmitter &CE = *RA->CE;
 
     IPP->resetState();
 
-    DenseMap<const MCInst *, SmallVector<mca::Instrument *>> InstToInstruments;
-    SmallVector<std::unique_ptr<mca::Instruction>> LoweredSequence;
+    auto &InstToInstruments = RA->InstToInstruments;
+    auto &LoweredSequence = RA->LoweredSequence;
     SmallPtrSet<const MCInst *, 16> DroppedInsts;
     for (const MCInst &MCI : Insts) {
       SMLoc Loc = MCI.getLoc();
@@ -646,6 +699,8 @@ int main(int argc, char **argv) {
           DroppedInsts.insert(&MCI);
           continue;
         }
+        // Report the regions before this one, as if run one by one.
+        RunBatch();
         return 1;
       }
 
@@ -661,16 +716,19 @@ int main(int argc, char **argv) {
       continue;
     NonEmptyRegions++;
 
-    mca::CircularSourceMgr S(LoweredSequence,
-                             PrintInstructionTables ? 1 : Iterations);
+    RA->S = std::make_unique<mca::CircularSourceMgr>(
+        LoweredSequence, PrintInstructionTables ? 1 : Iterations);
+    mca::CircularSourceMgr &S = *RA->S;
 
     if (PrintInstructionTables) {
       //  Create a pipeline, stages, and a printer.
-      auto P = std::make_unique<mca::Pipeline>();
-      P->appendStage(std::make_unique<mca::EntryStage>(S));
-      P->appendStage(std::make_unique<mca::InstructionTables>(SM));
+      RA->P = std::make_unique<mca::Pipeline>();
+      RA->P->appendStage(std::make_unique<mca::EntryStage>(S));
+      RA->P->appendStage(std::make_unique<mca::InstructionTables>(SM));
 
-      mca::PipelinePrinter Printer(*P, *Region, RegionIdx, *STI, PO);
+      RA->Printer = std::make_unique<mca::PipelinePrinter>(*RA->P, *Region,
+                                                           RegionIdx, *STI, PO);
+      mca::PipelinePrinter &Printer = *RA->Printer;
       if (PrintJson) {
         Printer.addView(
             std::make_unique<mca::InstructionView>(*STI, *IP, Insts));
@@ -685,15 +743,10 @@ int main(int argc, char **argv) {
       Printer.addView(
           std::make_unique<mca::ResourcePressureView>(*STI, *IP, Insts));
 
-      if (!runPipeline(*P))
+      Batch.push_back(std::move(RA));
+      if (Batch.size() == BatchSize && !RunBatch())
         return 1;
 
-      if (PrintJson) {
-        Printer.printReport(JSONOutput);
-      } else {
-        Printer.printReport(TOF->os());
-      }
-
       ++RegionIdx;
       continue;
     }
@@ -704,7 +757,7 @@ int main(int argc, char **argv) {
     // the source code (but it can depend on the list of
     // mca::Instruction or any objects that can be reconstructed
     // from the target information).
-    std::unique_ptr<mca::CustomBehaviour> CB;
+    std::unique_ptr<mca::CustomBehaviour> &CB = RA->CB;
     if (!DisableCustomBehaviour)
       CB = std::unique_ptr<mca::CustomBehaviour>(
           TheTarget->createCustomBehaviour(*STI, S, *MCII));
@@ -713,10 +766,15 @@ int main(int argc, char **argv) {
       // flag is set) then we use the base class (which does nothing).
       CB = std::make_unique<mca::CustomBehaviour>(*STI, S, *MCII);
 
+    // Create a context to control ownership of the pipeline hardware.
+    RA->MCA = std::make_unique<mca::Context>(*MRI, *STI);
+
     // Create a basic pipeline simulating an out-of-order backend.
-    auto P = MCA.createDefaultPipeline(PO, S, *CB);
+    RA->P = RA->MCA->createDefaultPipeline(PO, S, *CB);
 
-    mca::PipelinePrinter Printer(*P, *Region, RegionIdx, *STI, PO);
+    RA->Printer = std::make_unique<mca::PipelinePrinter>(*RA->P, *Region,
+                                                         RegionIdx, *STI, PO);
+    mca::PipelinePrinter &Printer = *RA->Printer;
 
     // Targets can define their own custom Views that exist within their
     // /lib/Target/ directory so that the View can utilize their CustomBehaviour
@@ -803,18 +861,16 @@ int main(int argc, char **argv) {
         Printer.addView(std::move(CBView));
     }
 
-    if (!runPipeline(*P))
+    Batch.push_back(std::move(RA));
+    if (Batch.size() == BatchSize && !RunBatch())
       return 1;
 
-    if (PrintJson) {
-      Printer.printReport(JSONOutput);
-    } else {
-      Printer.printReport(TOF->os());
-    }
-
     ++RegionIdx;
   }
 
+  if (!RunBatch())
+    return 1;
+
   if (NonEmptyRegions == 0) {
     WithColor::error() << "no assembly instructions found.\n";
     return 1;
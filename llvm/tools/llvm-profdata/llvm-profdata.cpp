@@ -952,12 +952,27 @@ static void mergeInstrProfile(const WeightedFileVector &Inputs,
   } else {
     DefaultThreadPool Pool(hardware_concurrency(NumThreads));
 
-    // Load the inputs in parallel (N/NumThreads serial steps).
-    unsigned Ctx = 0;
+    // Load the inputs in parallel (N/NumThreads serial steps). Each input is
+    // loaded into whichever writer context is free when its task starts. With
+    // a fixed round-robin assignment, the tasks queued behind a large input
+    // would block on that context's lock while other threads run out of work.
+    // There are as many contexts as threads, so one is always free.
+    std::mutex FreeContextsLock;
+    SmallVector<WriterContext *, 4> FreeContexts;
+    for (std::unique_ptr<WriterContext> &WC : Contexts)
+      FreeContexts.push_back(WC.get());
     for (const auto &Input : Inputs) {
-      Pool.async(loadInput, Input, Remapper, Correlator.get(), ProfiledBinary,
-                 Contexts[Ctx].get());
-      Ctx = (Ctx + 1) % NumThreads;
+      Pool.async([&, Input]() {
+        WriterContext *WC;
+        {
+          std::lock_guard<std::mutex> Guard(FreeContextsLock);
+          assert(!FreeContexts.empty() && "More tasks than writer contexts");
+          WC = FreeContexts.pop_back_val();
+        }
+        loadInput(Input, Remapper, Correlator.get(), ProfiledBinary, WC);
+        std::lock_guard<std::mutex> Guard(FreeContextsLock);
+        FreeContexts.push_back(WC);
+      });
     }
     Pool.wait();
 
@@ -11,6 +11,7 @@
 #include "llvm/DebugInfo/Symbolize/SymbolizableModule.h"
 #include "llvm/Support/FileSystem.h"
 #include "llvm/Support/Process.h"
+#include "llvm/Support/ThreadPool.h"
 #include "llvm/Support/ToolOutputFile.h"
 
 #define DEBUG_TYPE "perf-reader"
@@ -39,6 +40,13 @@ static cl::opt<bool>
     IgnoreStackSamples("ignore-stack-samples",
                        cl::desc("Ignore call stack samples for hybrid samples "
                                 "and produce context-insensitive profile."));
+
+static cl::opt<unsigned>
+    UnwindThreads("unwind-threads", cl::init(1),
+                  cl::desc("Number of threads used to unwind samples of a "
+                           "binary with pseudo probes (0 = use all hardware "
+                           "threads)."));
+
 cl::opt<bool> ShowDetailedWarning("show-detailed-warning",
                                   cl::desc("Show detailed warning message."));
 
@@ -319,6 +327,18 @@ bool VirtualUnwinder::unwind(const PerfSample *Sample, uint64_t Repeat) {
   return true;
 }
 
+void VirtualUnwinder::mergeStats(const VirtualUnwinder &Other) {
+  NumTotalBranches += Other.NumTotalBranches;
+  NumExtCallBranch += Other.NumExtCallBranch;
+  NumMissingExternalFrame += Other.NumMissingExternalFrame;
+  NumMismatchedProEpiBranch += Other.NumMismatchedProEpiBranch;
+  NumMismatchedExtCallBranch += Other.NumMismatchedExtCallBranch;
+  NumUnpairedExtAddr += Other.NumUnpairedExtAddr;
+  NumPairedExtAddr += Other.NumPairedExtAddr;
+  UntrackedCallsites.insert(Other.UntrackedCallsites.begin(),
+                            Other.UntrackedCallsites.end());
+}
+
 std::unique_ptr<PerfReaderBase>
 PerfReaderBase::create(ProfiledBinary *Binary, PerfInputFile &PerfInput,
                        std::optional<uint32_t> PIDFilter) {
@@ -503,9 +523,45 @@ static std::string getContextKeyStr(ContextKey *K,
 
 void HybridPerfReader::unwindSamples() {
   VirtualUnwinder Unwinder(&SampleCounters, Binary);
-  for (const auto &Item : AggregatedSamples) {
-    const PerfSample *Sample = Item.first.getPtr();
-    Unwinder.unwind(Sample, Item.second);
+
+  // With pseudo probes the unwinder only reads the binary, so the samples can
+  // be split across threads that each have their own unwinder and counters,
+  // merged once all are done. Without probes the unwinder symbolizes through
+  // caches in the binary and has to stay serial.
+  unsigned NumThreads = 1;
+  if (Binary->usePseudoProbes() && AggregatedSamples.size() > 1)
+    NumThreads = UnwindThreads ? UnwindThreads.getValue()
+                               : hardware_concurrency().compute_thread_count();
+  if (NumThreads <= 1) {
+    for (const auto &Item : AggregatedSamples) {
+      const PerfSample *Sample = Item.first.getPtr();
+      Unwinder.unwind(Sample, Item.second);
+    }
+  } else {
+    std::vector<const AggregatedCounter::value_type *> Samples;
+    Samples.reserve(AggregatedSamples.size());
+    for (const auto &Item : AggregatedSamples)
+      Samples.push_back(&Item);
+
+    std::vector<ContextSampleCounterMap> Counters(NumThreads);
+    std::vector<VirtualUnwinder> Unwinders;
+    Unwinders.reserve(NumThreads);
+    for (ContextSampleCounterMap &Counter : Counters)
+      Unwinders.emplace_back(&Counter, Binary);
+
+    DefaultThreadPool Pool(hardware_concurrency(NumThreads));
+    for (unsigned I = 0; I < NumThreads; ++I)
+      Pool.async([&, I]() {
+        for (size_t J = I; J < Samples.size(); J += NumThreads)
+          Unwinders[I].unwind(Samples[J]->first.getPtr(), Samples[J]->second);
+      });
+    Pool.wait();
+
+    for (unsigned I = 0; I < NumThreads; ++I) {
+      for (const auto &[Key, Counter] : Counters[I])
+        SampleCounters[Key].merge(Counter);
+      Unwinder.mergeStats(Unwinders[I]);
+    }
   }
 
   // Warn about untracked frames due to missing probes.
@@ -37,12 +37,14 @@
 #include "llvm/Support/LLVMDriver.h"
 #include "llvm/Support/Path.h"
 #include "llvm/Support/StringSaver.h"
+#include "llvm/Support/ThreadPool.h"
 #include "llvm/Support/WithColor.h"
 #include "llvm/Support/raw_ostream.h"
 #include <algorithm>
 #include <cstdio>
 #include <cstring>
 #include <iostream>
+#include <mutex>
 #include <string>
 
 using namespace llvm;
@@ -80,7 +82,11 @@ public:
 
 static std::string ToolName;
 
+// Serializes error reporting when symbolizing with --threads.
+static std::mutex ErrorMutex;
+
 static void printError(const ErrorInfoBase &EI, StringRef AuxInfo) {
+  std::lock_guard<std::mutex> Lock(ErrorMutex);
   WithColor::error(errs(), ToolName);
   if (!AuxInfo.empty())
     errs() << "'" << AuxInfo << "': ";
@@ -460,6 +466,53 @@ static void filterMarkup(const opt::InputArgList &Args, LLVMSymbolizer &Symboliz
   Filter.finish();
 }
 
+static std::unique_ptr<DIPrinter>
+createPrinter(OutputStyle Style, raw_ostream &OS, const PrinterConfig &Config) {
+  if (Style == OutputStyle::GNU)
+    return std::make_unique<GNUPrinter>(OS, printError, Config);
+  if (Style == OutputStyle::JSON)
+    return std::make_unique<JSONPrinter>(OS, Config);
+  return std::make_unique<LLVMPrinter>(OS, printError, Config);
+}
+
+// Symbolize Inputs on up to Threads threads. Each thread symbolizes a
+// contiguous slice of the inputs with its own LLVMSymbolizer, so no module
+// state is shared, and prints into a buffer. The buffers are written out in
+// input order, which makes the output identical to a serial run.
+static void symbolizeInParallel(const opt::InputArgList &Args,
+                                const LLVMSymbolizer::Options &Opts,
+                                const PrinterConfig &Config,
+                                object::BuildIDRef BuildID, uint64_t AdjustVMA,
+                                bool IsAddr2Line, OutputStyle Style,
+                                ArrayRef<std::string> Inputs,
+                                unsigned Threads) {
+  const size_t SliceSize = divideCeil(Inputs.size(), Threads);
+  std::vector<std::string> Outputs(Threads);
+  DefaultThreadPool Pool(hardware_concurrency(Threads));
+  for (unsigned I = 0; I < Threads; ++I) {
+    const size_t Begin = I * SliceSize;
+    if (Begin >= Inputs.size())
+      break;
+    ArrayRef<std::string> Slice =
+        Inputs.slice(Begin, std::min(SliceSize, Inputs.size() - Begin));
+    Pool.async([&, Slice, I] {
+      LLVMSymbolizer Symbolizer(Opts);
+      if (!Args.hasArg(OPT_no_debuginfod))
+        Symbolizer.setBuildIDFetcher(std::make_unique<DebuginfodFetcher>(
+            Args.getAllArgValues(OPT_debug_file_directory_EQ)));
+      raw_string_ostream OS(Outputs[I]);
+      std::unique_ptr<DIPrinter> Printer = createPrinter(Style, OS, Config);
+      for (const std::string &Input : Slice)
+        symbolizeInput(Args, BuildID, AdjustVMA, IsAddr2Line, Style, Input,
+                       Symbolizer, *Printer);
+    });
+  }
+  Pool.wait();
+
+  for (const std::string &Output : Outputs)
+    outs() << Output;
+}
+
 int llvm_symbolizer_main(int argc, char **argv, const llvm::ToolContext &) {
   sys::InitializeCOMRAII COM(sys::COMThreadingMode::MultiThreaded);
 
@@ -485,9 +538,11 @@ int llvm_symbolizer_main(int argc, char **argv, const llvm::ToolContext &) {
   Opts.DebugFileDirectory = Args.getAllArgValues(OPT_debug_file_directory_EQ);
   Opts.DefaultArch = Args.getLastArgValue(OPT_default_arch_EQ).str();
   Opts.Demangle = Args.hasFlag(OPT_demangle, OPT_no_demangle, !IsAddr2Line);
+  Opts.DisableGsym = Args.hasArg(OPT_disable_gsym);
   Opts.DWPName = Args.getLastArgValue(OPT_dwp_EQ).str();
   Opts.FallbackDebugPath =
       Args.getLastArgValue(OPT_fallback_debug_path_EQ).str();
+  Opts.GsymFileDirectory = Args.getAllArgValues(OPT_gsym_file_directory_EQ);
   Opts.PrintFunctions = decideHowToPrintFunctions(Args, IsAddr2Line);
   parseIntArg(Args, OPT_print_source_context_lines_EQ,
               Config.SourceContextLines);
@@ -545,13 +600,7 @@ int llvm_symbolizer_main(int argc, char **argv, const llvm::ToolContext &) {
   }
   object::BuildID BuildID = parseBuildIDArg(Args, OPT_build_id_EQ);
 
-  std::unique_ptr<DIPrinter> Printer;
-  if (Style == OutputStyle::GNU)
-    Printer = std::make_unique<GNUPrinter>(outs(), printError, Config);
-  else if (Style == OutputStyle::JSON)
-    Printer = std::make_unique<JSONPrinter>(outs(), Config);
-  else
-    Printer = std::make_unique<LLVMPrinter>(outs(), printError, Config);
+  std::unique_ptr<DIPrinter> Printer = createPrinter(Style, outs(), Config);
 
   // When an input file is specified, exit immediately if the file cannot be
   // read. If getOrCreateModuleInfo succeeds, symbolizeInput will reuse the
@@ -567,8 +616,16 @@ int llvm_symbolizer_main(int argc, char **argv, const llvm::ToolContext &) {
     }
   }
 
+  unsigned Threads = 1;
+  if (Args.hasArg(OPT_threads_EQ))
+    parseIntArg(Args, OPT_threads_EQ, Threads);
+  // JSON output of several inputs is a single list, which cannot be assembled
+  // from independently printed pieces.
+  const bool Parallel = Threads > 1 && Style != OutputStyle::JSON;
+
   std::vector<std::string> InputAddresses = Args.getAllArgValues(OPT_INPUT);
-  if (InputAddresses.empty()) {
+  const bool ReadStdin = InputAddresses.empty();
+  if (ReadStdin) {
     const int kMaxInputStringLength = 1024;
     char InputString[kMaxInputStringLength];
 
@@ -577,11 +634,24 @@ int llvm_symbolizer_main(int argc, char **argv, const llvm::ToolContext &) {
       std::string StrippedInputString(InputString);
       llvm::erase_if(StrippedInputString,
                      [](char c) { return c == '\r' || c == '\n'; });
+      if (Parallel) {
+        InputAddresses.push_back(std::move(StrippedInputString));
+        continue;
+      }
       symbolizeInput(Args, BuildID, AdjustVMA, IsAddr2Line, Style,
                      StrippedInputString, Symbolizer, *Printer);
       outs().flush();
     }
-  } else {
+  }
+
+  if (Parallel) {
+    // Make sure the debuginfod client is set up before the worker threads
+    // could race to do so.
+    if (!Args.hasArg(OPT_no_debuginfod))
+      enableDebuginfod(Symbolizer, Args);
+    symbolizeInParallel(Args, Opts, Config, BuildID, AdjustVMA, IsAddr2Line,
+                        Style, InputAddresses, Threads);
+  } else if (!ReadStdin) {
     Printer->listBegin();
     for (StringRef Address : InputAddresses)
       symbolizeInput(Args, BuildID, AdjustVMA, IsAddr2Line, Style, Address,
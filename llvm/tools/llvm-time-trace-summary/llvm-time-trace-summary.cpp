@@ -0,0 +1,296 @@
+//===- llvm-time-trace-summary.cpp ----------------------------------------===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+//
+// llvm-time-trace-summary aggregates the traces written by -ftime-trace over
+// many compilations, and reports the events, e.g. the headers, templates or
+// passes, that take the most time over all of them.
+//
+//===----------------------------------------------------------------------===//
+
+#include "llvm/ADT/DenseMap.h"
+#include "llvm/ADT/STLExtras.h"
+#include "llvm/ADT/StringMap.h"
+#include "llvm/ADT/StringSet.h"
+#include "llvm/Support/CommandLine.h"
+#include "llvm/Support/FileSystem.h"
+#include "llvm/Support/Format.h"
+#include "llvm/Support/InitLLVM.h"
+#include "llvm/Support/JSON.h"
+#include "llvm/Support/MemoryBuffer.h"
+#include "llvm/Support/Parallel.h"
+#include "llvm/Support/Threading.h"
+#include "llvm/Support/ToolOutputFile.h"
+#include "llvm/Support/WithColor.h"
+#include "llvm/Support/raw_ostream.h"
+#include <map>
+#include <optional>
+
+using namespace llvm;
+
+static cl::OptionCategory SummaryCategory("Time Trace Summary Options");
+
+static cl::list<std::string> InputFilenames(cl::Positional, cl::OneOrMore,
+                                            cl::desc("<trace files>"),
+                                            cl::cat(SummaryCategory));
+
+static cl::opt<std::string> OutputFilename("o", cl::init("-"),
+                                           cl::desc("Output file"),
+                                           cl::value_desc("filename"),
+                                           cl::cat(SummaryCategory));
+
+static cl::list<std::string>
+    EventNames("event",
+               cl::desc("Only report events with this name, e.g. Source, "
+                        "InstantiateFunction or RunPass (can be repeated)"),
+               cl::value_desc("name"), cl::cat(SummaryCategory));
+
+static cl::opt<unsigned> Top("top", cl::init(50),
+                             cl::desc("Number of entries to report, or 0 to "
+                                      "report all of them"),
+                             cl::cat(SummaryCategory));
+
+enum class SortKey { Inclusive, Exclusive, Count };
+static cl::opt<SortKey> SortBy(
+    "sort", cl::desc("Order of the reported entries"),
+    cl::init(SortKey::Inclusive),
+    cl::values(clEnumValN(SortKey::Inclusive, "inclusive",
+                          "Time including nested events (default)"),
+               clEnumValN(SortKey::Exclusive, "exclusive",
+                          "Time excluding nested events"),
+               clEnumValN(SortKey::Count, "count", "Number of events")),
+    cl::cat(SummaryCategory));
+
+static cl::opt<unsigned>
+    NumThreads("j", cl::init(0),
+               cl::desc("Number of threads used to read the traces, or 0 to "
+                        "use all available cores"),
+               cl::cat(SummaryCategory));
+
+namespace {
+/// The time spent in one kind of event, identified by its name and detail.
+struct EventTotals {
+  /// The time in microseconds including nested events. Nested events with
+  /// the same name and detail, such as recursive instantiations, are only
+  /// counted once.
+  int64_t InclusiveUs = 0;
+  /// The time in microseconds excluding the time of nested events.
+  int64_t ExclusiveUs = 0;
+  uint64_t Count = 0;
+  /// The number of traces containing the event.
+  uint64_t NumTraces = 0;
+};
+
+/// Totals keyed by event name and detail, separated by a null character.
+using TotalsMap = StringMap<EventTotals>;
+
+struct TraceEvent {
+  int64_t StartUs;
+  int64_t DurUs;
+  EventTotals *Totals;
+};
+} // namespace
+
+static std::string makeKey(StringRef Name, StringRef Detail) {
+  return (Name + Twine('\0') + Detail).str();
+}
+
+/// Adds the complete events of one thread of a trace to their totals. Events
+/// are nested by their time ranges, as the time profiler records them.
+static void aggregateThread(std::vector<TraceEvent> &Events) {
+  // Outer events first: by start time, then by decreasing duration.
+  llvm::stable_sort(Events, [](const TraceEvent &A, const TraceEvent &B) {
+    if (A.StartUs != B.StartUs)
+      return A.StartUs < B.StartUs;
+    return A.DurUs > B.DurUs;
+  });
+
+  struct ActiveEvent {
+    const TraceEvent *Event;
+    int64_t ChildrenUs = 0;
+  };
+  SmallVector<ActiveEvent, 16> Stack;
+  DenseMap<EventTotals *, unsigned> ActiveCount;
+  auto Pop = [&] {
+    ActiveEvent &Last = Stack.back();
+    Last.Event->Totals->ExclusiveUs +=
+        std::max<int64_t>(0, Last.Event->DurUs - Last.ChildrenUs);
+    --ActiveCount[Last.Event->Totals];
+    Stack.pop_back();
+  };
+
+  for (const TraceEvent &E : Events) {
+    while (!Stack.empty() &&
+           Stack.back().Event->StartUs + Stack.back().Event->DurUs <=
+               E.StartUs)
+      Pop();
+    if (!Stack.empty())
+      Stack.back().ChildrenUs += E.DurUs;
+    if (ActiveCount[E.Totals]++ == 0)
+      E.Totals->InclusiveUs += E.DurUs;
+    ++E.Totals->Count;
+    Stack.push_back({&E});
+  }
+  while (!Stack.empty())
+    Pop();
+}
+
+/// Reads the trace in \p Filename and aggregates its events.
+static Expected<TotalsMap> readTrace(StringRef Filename,
+                                     const StringSet<> &Filter) {
+  ErrorOr<std::unique_ptr<MemoryBuffer>> Buffer =
+      MemoryBuffer::getFileOrSTDIN(Filename, /*IsText=*/true);
+  if (std::error_code EC = Buffer.getError())
+    return createFileError(Filename, EC);
+  Expected<json::Value> Trace = json::parse((*Buffer)->getBuffer());
+  if (!Trace)
+    return createFileError(Filename, Trace.takeError());
+  const json::Object *Root = Trace->getAsObject();
+  const json::Array *TraceEvents =
+      Root ? Root->getArray("traceEvents") : nullptr;
+  if (!TraceEvents)
+    return createFileError(Filename,
+                           createStringError(inconvertibleErrorCode(),
+                                             "no traceEvents array"));
+
+  TotalsMap Totals;
+  std::map<std::pair<int64_t, int64_t>, std::vector<TraceEvent>> Threads;
+  for (const json::Value &Value : *TraceEvents) {
+    const json::Object *Event = Value.getAsObject();
+    if (!Event || Event->getString("ph") != "X")
+      continue;
+    std::optional<StringRef> Name = Event->getString("name");
+    std::optional<double> Start = Event->getNumber("ts");
+    std::optional<double> Dur = Event->getNumber("dur");
+    // The summary events that the time profiler appends are not nested in
+    // the others.
+    if (!Name || !Start || !Dur || Name->starts_with("Total "))
+      continue;
+    if (!Filter.empty() && !Filter.contains(*Name))
+      continue;
+    StringRef Detail;
+    if (const json::Object *Args = Event->getObject("args"))
+      Detail = Args->getString("detail").value_or("");
+    EventTotals &EventTotal = Totals[makeKey(*Name, Detail)];
+    EventTotal.NumTraces = 1;
+    std::pair<int64_t, int64_t> Thread(Event->getInteger("pid").value_or(0),
+                                       Event->getInteger("tid").value_or(0));
+    Threads[Thread].push_back(
+        {static_cast<int64_t>(*Start), static_cast<int64_t>(*Dur),
+         &EventTotal});
+  }
+  for (auto &Thread : Threads)
+    aggregateThread(Thread.second);
+  return std::move(Totals);
+}
+
+static void merge(TotalsMap &Into, const TotalsMap &From) {
+  for (const auto &Entry : From) {
+    EventTotals &Totals = Into[Entry.getKey()];
+    Totals.InclusiveUs += Entry.getValue().InclusiveUs;
+    Totals.ExclusiveUs += Entry.getValue().ExclusiveUs;
+    Totals.Count += Entry.getValue().Count;
+    Totals.NumTraces += Entry.getValue().NumTraces;
+  }
+}
+
+static void printSummary(raw_ostream &OS, const TotalsMap &Totals,
+                         size_t NumTraces) {
+  std::vector<const StringMapEntry<EventTotals> *> Entries;
+  for (const auto &Entry : Totals)
+    Entries.push_back(&Entry);
+  auto GetSortKey = [](const EventTotals &T) -> int64_t {
+    switch (SortBy) {
+    case SortKey::Inclusive:
+      return T.InclusiveUs;
+    case SortKey::Exclusive:
+      return T.ExclusiveUs;
+    case SortKey::Count:
+      return T.Count;
+    }
+    llvm_unreachable("unknown sort key");
+  };
+  llvm::sort(Entries, [&](const StringMapEntry<EventTotals> *A,
+                          const StringMapEntry<EventTotals> *B) {
+    int64_t KeyA = GetSortKey(A->getValue());
+    int64_t KeyB = GetSortKey(B->getValue());
+    if (KeyA != KeyB)
+      return KeyA > KeyB;
+    return A->getKey() < B->getKey();
+  });
+  if (Top && Entries.size() > Top)
+    Entries.resize(Top);
+
+  OS << "Summary of " << NumTraces << " traces\n";
+  OS << right_justify("Inclusive(ms)", 14) << " "
+     << right_justify("Exclusive(ms)", 14) << " " << right_justify("Count", 10)
+     << " " << right_justify("Traces", 8) << "  Event\n";
+  for (const StringMapEntry<EventTotals> *Entry : Entries) {
+    const EventTotals &T = Entry->getValue();
+    auto [Name, Detail] = Entry->getKey().split('\0');
+    OS << format("%14.1f %14.1f %10" PRIu64 " %8" PRIu64 "  ",
+                 T.InclusiveUs / 1000.0, T.ExclusiveUs / 1000.0, T.Count,
+                 T.NumTraces)
+       << Name;
+    if (!Detail.empty())
+      OS << " " << Detail;
+    OS << "\n";
+  }
+}
+
+int main(int argc, char **argv) {
+  InitLLVM X(argc, argv);
+  cl::HideUnrelatedOptions({&SummaryCategory, &getColorCategory()});
+  cl::ParseCommandLineOptions(
+      argc, argv,
+      "Summarize the -ftime-trace traces of many compilations\n\n"
+      "  Aggregates the events of all traces by name and detail, e.g. by\n"
+      "  header for Source events and by template for InstantiateFunction\n"
+      "  events. Use a response file (@file) to pass many traces.\n");
+
+  if (NumThreads)
+    parallel::strategy = hardware_concurrency(NumThreads);
+
+  StringSet<> Filter;
+  for (const std::string &Name : EventNames)
+    Filter.insert(Name);
+
+  // Read the traces in parallel in batches, merging each batch in input order
+  // so that the output does not depend on scheduling and memory stays bounded.
+  TotalsMap Totals;
+  size_t NumTraces = 0;
+  bool HadError = false;
+  size_t BatchSize = parallel::strategy.compute_thread_count() * 4;
+  for (size_t Begin = 0, E = InputFilenames.size(); Begin < E;
+       Begin += BatchSize) {
+    size_t End = std::min(Begin + BatchSize, E);
+    std::vector<std::optional<Expected<TotalsMap>>> Results(End - Begin);
+    parallelFor(Begin, End, [&](size_t I) {
+      Results[I - Begin].emplace(readTrace(InputFilenames[I], Filter));
+    });
+    for (std::optional<Expected<TotalsMap>> &Result : Results) {
+      if (Error Err = (*Result).takeError()) {
+        WithColor::error(errs(), argv[0]) << toString(std::move(Err)) << "\n";
+        HadError = true;
+        continue;
+      }
+      merge(Totals, **Result);
+      ++NumTraces;
+    }
+  }
+
+  std::error_code EC;
+  ToolOutputFile Out(OutputFilename, EC, sys::fs::OF_TextWithCRLF);
+  if (EC) {
+    WithColor::error(errs(), argv[0])
+        << OutputFilename << ": " << EC.message() << "\n";
+    return 1;
+  }
+  printSummary(Out.os(), Totals, NumTraces);
+  Out.keep();
+  return HadError ? 1 : 0;
+}
@@ -233,6 +233,11 @@ static cl::opt<bool> DiscardValueNames(
     cl::desc("Discard names from Value (other than GlobalValue)."),
     cl::init(false), cl::Hidden);
 
+static cl::opt<bool> PrintIRMemoryStats(
+    "print-ir-memory-stats",
+    cl::desc("Print an approximate breakdown of the memory used by the IR of "
+             "the module to stderr after running the passes"));
+
 static cl::opt<bool> TimeTrace("time-trace", cl::desc("Record time trace"));
 
 static cl::opt<unsigned> TimeTraceGranularity(
@@ -735,14 +740,15 @@ extern "C" int optMain(
     // The user has asked to use the new pass manager and provided a pipeline
     // string. Hand off the rest of the functionality to the new code for that
     // layer.
-    return runPassPipeline(
-               argv[0], *M, TM.get(), &TLII, Out.get(), ThinLinkOut.get(),
-               RemarksFile.get(), Pipeline, PluginList, PassBuilderCallbacks,
-               OK, VK, PreserveAssemblyUseListOrder,
-               PreserveBitcodeUseListOrder, EmitSummaryIndex, EmitModuleHash,
-               EnableDebugify, VerifyDebugInfoPreserve, UnifiedLTO)
-               ? 0
-               : 1;
+    bool Succeeded = runPassPipeline(
+        argv[0], *M, TM.get(), &TLII, Out.get(), ThinLinkOut.get(),
+        RemarksFile.get(), Pipeline, PluginList, PassBuilderCallbacks, OK, VK,
+        PreserveAssemblyUseListOrder, PreserveBitcodeUseListOrder,
+        EmitSummaryIndex, EmitModuleHash, EnableDebugify,
+        VerifyDebugInfoPreserve, UnifiedLTO);
+    if (PrintIRMemoryStats)
+      M->printMemoryStats(errs());
+    return Succeeded ? 0 : 1;
   }
 
   if (OptLevelO0 || OptLevelO1 || OptLevelO2 || OptLevelOs || OptLevelOz ||
@@ -906,6 +912,9 @@ extern "C" int optMain(
   if (DebugifyEach && !DebugifyExport.empty())
     exportDebugifyStats(DebugifyExport, Passes.getDebugifyStatsMap());
 
+  if (PrintIRMemoryStats)
+    M->printMemoryStats(errs());
+
   // Declare success.
   if (!NoOutput)
     Out->keep();
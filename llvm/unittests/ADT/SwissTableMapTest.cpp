@@ -0,0 +1,160 @@
+//===- llvm/unittest/ADT/SwissTableMapTest.cpp - SwissTableMap tests ------===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+#include "llvm/ADT/SwissTableMap.h"
+#include "llvm/ADT/DenseMap.h"
+#include "gtest/gtest.h"
+#include <memory>
+#include <random>
+#include <string>
+
+using namespace llvm;
+
+namespace {
+
+TEST(SwissTableMapTest, EmptyMap) {
+  SwissTableMap<int, int> M;
+  EXPECT_TRUE(M.empty());
+  EXPECT_EQ(0u, M.size());
+  EXPECT_TRUE(M.begin() == M.end());
+  EXPECT_FALSE(M.contains(0));
+  EXPECT_TRUE(M.find(0) == M.end());
+  EXPECT_EQ(0, M.lookup(0));
+  EXPECT_FALSE(M.erase(0));
+  M.clear();
+  EXPECT_TRUE(M.empty());
+}
+
+TEST(SwissTableMapTest, InsertFindErase) {
+  SwissTableMap<int, std::string> M;
+  auto [It, Inserted] = M.insert({1, "one"});
+  EXPECT_TRUE(Inserted);
+  EXPECT_EQ(1, It->first);
+  EXPECT_EQ("one", It->second);
+
+  // Inserting an existing key keeps the old value.
+  std::tie(It, Inserted) = M.insert({1, "uno"});
+  EXPECT_FALSE(Inserted);
+  EXPECT_EQ("one", It->second);
+
+  EXPECT_TRUE(M.try_emplace(2, "two").second);
+  M[3] = "three";
+  EXPECT_EQ(3u, M.size());
+  EXPECT_EQ("two", M.at(2));
+  EXPECT_EQ("three", M.lookup(3));
+  EXPECT_EQ("", M.lookup(4));
+  EXPECT_EQ(1u, M.count(1));
+  EXPECT_EQ(0u, M.count(4));
+
+  EXPECT_TRUE(M.erase(2));
+  EXPECT_FALSE(M.erase(2));
+  EXPECT_FALSE(M.contains(2));
+  M.erase(M.find(1));
+  EXPECT_EQ(1u, M.size());
+  EXPECT_EQ("three", M.begin()->second);
+}
+
+TEST(SwissTableMapTest, MatchesDenseMap) {
+  // Interleave insertions and erasures so that tables grow, reuse deleted
+  // slots and get rehashed, and check against a DenseMap throughout.
+  SwissTableMap<uint64_t, uint64_t> M;
+  DenseMap<uint64_t, uint64_t> Expected;
+  std::mt19937_64 Rand(42);
+  for (unsigned I = 0; I != 20000; ++I) {
+    uint64_t Key = Rand() % 4096;
+    if (Rand() % 3 == 0) {
+      EXPECT_EQ(Expected.erase(Key), M.erase(Key));
+    } else {
+      EXPECT_EQ(Expected.try_emplace(Key, I).second,
+                M.try_emplace(Key, I).second);
+    }
+    ASSERT_EQ(Expected.size(), M.size());
+  }
+  for (const auto &KV : Expected)
+    EXPECT_EQ(KV.second, M.lookup(KV.first));
+  unsigned NumIterated = 0;
+  for (const auto &KV : M) {
+    EXPECT_EQ(Expected.lookup(KV.first), KV.second);
+    ++NumIterated;
+  }
+  EXPECT_EQ(Expected.size(), NumIterated);
+}
+
+TEST(SwissTableMapTest, PointerKeys) {
+  // DenseMapInfo hashes pointers weakly; all keys must still be found.
+  std::vector<int> Storage(1000);
+  SwissTableMap<int *, unsigned> M;
+  for (unsigned I = 0; I != Storage.size(); ++I)
+    M[&Storage[I]] = I;
+  EXPECT_EQ(Storage.size(), M.size());
+  for (unsigned I = 0; I != Storage.size(); ++I)
+    EXPECT_EQ(I, M.lookup(&Storage[I]));
+}
+
+TEST(SwissTableMapTest, CopyAndMove) {
+  SwissTableMap<int, std::string> M;
+  for (int I = 0; I != 100; ++I)
+    M[I] = std::to_string(I);
+
+  SwissTableMap<int, std::string> Copy(M);
+  EXPECT_EQ(100u, Copy.size());
+  EXPECT_EQ("42", Copy.lookup(42));
+
+  SwissTableMap<int, std::string> Moved(std::move(Copy));
+  EXPECT_EQ(100u, Moved.size());
+  EXPECT_TRUE(Copy.empty());
+
+  SwissTableMap<int, std::string> Assigned;
+  Assigned[1000] = "x";
+  Assigned = M;
+  EXPECT_EQ(100u, Assigned.size());
+  EXPECT_FALSE(Assigned.contains(1000));
+
+  Assigned = std::move(Moved);
+  EXPECT_EQ("99", Assigned.lookup(99));
+
+  Assigned.swap(M);
+  M.clear();
+  EXPECT_TRUE(M.empty());
+  EXPECT_EQ(100u, Assigned.size());
+}
+
+TEST(SwissTableMapTest, NonTrivialValues) {
+  // Moving the elements on growth must keep owned values intact.
+  SwissTableMap<unsigned, std::unique_ptr<unsigned>> M;
+  for (unsigned I = 0; I != 1000; ++I)
+    M.try_emplace(I, std::make_unique<unsigned>(I));
+  for (unsigned I = 0; I != 1000; I += 2)
+    M.erase(I);
+  for (unsigned I = 1; I < 1000; I += 2)
+    EXPECT_EQ(I, *M.find(I)->second);
+}
+
+TEST(SwissTableMapTest, Reserve) {
+  SwissTableMap<int, int> M;
+  M.reserve(1000);
+  size_t MemorySize = M.getMemorySize();
+  EXPECT_GT(MemorySize, 0u);
+  for (int I = 0; I != 1000; ++I)
+    M[I] = I;
+  EXPECT_EQ(MemorySize, M.getMemorySize());
+}
+
+TEST(SwissTableMapTest, ConstIterator) {
+  SwissTableMap<int, int> M = {{1, 2}, {3, 4}};
+  const SwissTableMap<int, int> &CM = M;
+  SwissTableMap<int, int>::const_iterator It = M.find(1);
+  EXPECT_TRUE(It == CM.find(1));
+  EXPECT_EQ(2, It->second);
+  int Sum = 0;
+  for (const auto &KV : CM)
+    Sum += KV.first + KV.second;
+  EXPECT_EQ(10, Sum);
+}
+
+} // namespace
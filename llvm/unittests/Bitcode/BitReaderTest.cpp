@@ -8,6 +8,7 @@
 
 #include "BitReaderTestCode.h"
 #include "llvm/ADT/STLExtras.h"
+#include "llvm/ADT/ScopeExit.h"
 #include "llvm/ADT/SmallString.h"
 #include "llvm/AsmParser/Parser.h"
 #include "llvm/Bitcode/BitcodeReader.h"
@@ -16,10 +17,13 @@
 #include "llvm/IR/InstrTypes.h"
 #include "llvm/IR/LLVMContext.h"
 #include "llvm/IR/Module.h"
+#include "llvm/IR/PassManager.h"
 #include "llvm/IR/Verifier.h"
+#include "llvm/Support/CommandLine.h"
 #include "llvm/Support/Debug.h"
 #include "llvm/Support/Error.h"
 #include "llvm/Support/MemoryBuffer.h"
+#include "llvm/Support/Parallel.h"
 #include "llvm/Support/SourceMgr.h"
 #include "gtest/gtest.h"
 
@@ -433,4 +437,112 @@ TEST(BitReaderTest, AccessMetadataTypeInfo) {
             "!{0, i32}}}}");
 }
 
+// Tests that encoding function blocks on multiple threads produces the same
+// bitcode as encoding them serially.
+TEST(BitReaderTest, ParallelFunctionBlocksAreIdentical) {
+  LLVMContext Context;
+  std::unique_ptr<Module> M = parseAssembly(
+      Context, "@g = global i32 0\n"
+               "define i32 @f(i32 %a) {\n"
+               "entry:\n"
+               "  %x = add i32 %a, 42, !range !0\n"
+               "  br label %exit\n"
+               "exit:\n"
+               "  ret i32 %x\n"
+               "}\n"
+               "define void @g.store(i64 %v) {\n"
+               "  %t = trunc i64 %v to i32\n"
+               "  store i32 %t, ptr @g\n"
+               "  ret void\n"
+               "}\n"
+               "declare void @ext()\n"
+               "define void @h() {\n"
+               "  call void @ext()\n"
+               "  call void @g.store(i64 1234567890123)\n"
+               "  ret void\n"
+               "}\n"
+               "define ptr @j() {\n"
+               "  ret ptr blockaddress(@k, %bb)\n"
+               "}\n"
+               "define void @k() {\n"
+               "  br label %bb\n"
+               "bb:\n"
+               "  ret void\n"
+               "}\n"
+               "!0 = !{i32 0, i32 100}\n");
+
+  SmallString<1024> Serial;
+  {
+    raw_svector_ostream OS(Serial);
+    WriteBitcodeToFile(*M, OS);
+  }
+
+  auto &Opts = cl::getRegisteredOptions();
+  auto *Parallel =
+      static_cast<cl::opt<bool> *>(Opts["bitcode-parallel-function-blocks"]);
+  ASSERT_NE(Parallel, nullptr);
+  ThreadPoolStrategy SavedStrategy = parallel::strategy;
+  auto Restore = make_scope_exit([&] {
+    parallel::strategy = SavedStrategy;
+    *Parallel = false;
+  });
+  parallel::strategy = hardware_concurrency(3);
+  *Parallel = true;
+  SmallString<1024> Concurrent;
+  {
+    raw_svector_ostream OS(Concurrent);
+    WriteBitcodeToFile(*M, OS);
+  }
+
+  EXPECT_EQ(Serial.str(), Concurrent.str());
+}
+
+// Tests that function passes run on a lazily loaded module materialize each
+// function right before visiting it, and not before.
+TEST(BitReaderTest, FunctionPassesMaterializeOnDemand) {
+  SmallString<1024> Mem;
+  LLVMContext Context;
+  std::unique_ptr<Module> M = getLazyModuleFromAssembly(
+      Context, Mem, "define void @f() {\n"
+                    "  ret void\n"
+                    "}\n"
+                    "define void @g() {\n"
+                    "  unreachable\n"
+                    "}\n");
+  Function *F = M->getFunction("f");
+  Function *G = M->getFunction("g");
+  ASSERT_TRUE(F->isMaterializable());
+  ASSERT_TRUE(G->isMaterializable());
+
+  struct CheckPass : PassInfoMixin<CheckPass> {
+    Function *G;
+    std::vector<std::string> *Visited;
+    PreservedAnalyses run(Function &Fn, FunctionAnalysisManager &) {
+      EXPECT_FALSE(Fn.isMaterializable());
+      EXPECT_FALSE(Fn.empty());
+      // @g is only read once its own passes are about to run.
+      if (Fn.getName() == "f")
+        EXPECT_TRUE(G->isMaterializable());
+      Visited->push_back(Fn.getName().str());
+      return PreservedAnalyses::all();
+    }
+  };
+
+  FunctionAnalysisManager FAM;
+  ModuleAnalysisManager MAM;
+  MAM.registerPass([&] { return FunctionAnalysisManagerModuleProxy(FAM); });
+  MAM.registerPass([&] { return PassInstrumentationAnalysis(); });
+  FAM.registerPass([&] { return ModuleAnalysisManagerFunctionProxy(MAM); });
+  FAM.registerPass([&] { return PassInstrumentationAnalysis(); });
+
+  std::vector<std::string> Visited;
+  ModulePassManager MPM;
+  MPM.addPass(createModuleToFunctionPassAdaptor(CheckPass{{}, G, &Visited}));
+  MPM.run(*M, MAM);
+
+  EXPECT_EQ(Visited, (std::vector<std::string>{"f", "g"}));
+  EXPECT_FALSE(G->isMaterializable());
+  EXPECT_FALSE(verifyModule(*M, &dbgs()));
+}
+
 } // end namespace
@@ -2187,4 +2187,115 @@ TEST(DWARFDebugInfo, TestDWARF64UnitLength) {
   });
 }
 
+TEST(DWARFDebugInfo, TestPrefetchUnits) {
+  // Two units with one subprogram each. The line table of the second unit
+  // has an unsupported version and fails to parse.
+  const char *yamldata = R"(
+  debug_abbrev:
+    - Table:
+        - Code:            0x1
+          Tag:             DW_TAG_compile_unit
+          Children:        DW_CHILDREN_yes
+          Attributes:
+            - Attribute:       DW_AT_stmt_list
+              Form:            DW_FORM_sec_offset
+        - Code:            0x2
+          Tag:             DW_TAG_subprogram
+          Children:        DW_CHILDREN_no
+          Attributes:
+            - Attribute:       DW_AT_decl_file
+              Form:            DW_FORM_data1
+  debug_info:
+    - Version:         4
+      AddrSize:        8
+      Entries:
+        - AbbrCode:        0x1
+          Values:
+            - Value:           0x0
+        - AbbrCode:        0x2
+          Values:
+            - Value:           0x1
+        - AbbrCode:        0x0
+    - Version:         4
+      AddrSize:        8
+      Entries:
+        - AbbrCode:        0x1
+          Values:
+            - Value:           0x2e
+        - AbbrCode:        0x2
+          Values:
+            - Value:           0x1
+        - AbbrCode:        0x0
+  debug_line:
+    - Length:          42
+      Version:         2
+      PrologueLength:  36
+      MinInstLength:   1
+      DefaultIsStmt:   1
+      LineBase:        251
+      LineRange:       14
+      OpcodeBase:      13
+      StandardOpcodeLengths: [ 0, 1, 1, 1, 1, 0, 0, 0, 1, 0, 0, 1 ]
+      IncludeDirs:
+        - '/tmp'
+      Files:
+        - Name:            main.cpp
+          DirIdx:          1
+          ModTime:         0
+          Length:          0
+    - Length:          42
+      Version:         1
+      PrologueLength:  36
+      MinInstLength:   1
+      DefaultIsStmt:   1
+      LineBase:        251
+      LineRange:       14
+      OpcodeBase:      13
+      StandardOpcodeLengths: [ 0, 1, 1, 1, 1, 0, 0, 0, 1, 0, 0, 1 ]
+      IncludeDirs:
+        - '/tmp'
+      Files:
+        - Name:            other.cpp
+          DirIdx:          1
+          ModTime:         0
+          Length:          0
+  )";
+  Expected<StringMap<std::unique_ptr<MemoryBuffer>>> Sections =
+      DWARFYAML::emitDebugSections(StringRef(yamldata),
+                                   /*IsLittleEndian=*/true,
+                                   /*Is64BitAddrSize=*/true);
+  ASSERT_THAT_EXPECTED(Sections, Succeeded());
+
+  // Runs the same queries with and without prefetching and returns what they
+  // found, followed by the errors in the order they were reported.
+  auto Query = [&](bool Prefetch) {
+    std::vector<std::string> Result;
+    std::vector<std::string> Errors;
+    auto Handler = [&](Error E) { Errors.push_back(toString(std::move(E))); };
+    std::unique_ptr<DWARFContext> Ctx = DWARFContext::create(
+        *Sections, 8, /*isLittleEndian=*/true, Handler, Handler);
+    if (Prefetch) {
+      Ctx->prefetchUnits(/*NumThreads=*/2);
+      // The failed line table is reported when it is queried, not here.
+      EXPECT_TRUE(Errors.empty());
+    }
+    for (const std::unique_ptr<DWARFUnit> &CU : Ctx->compile_units()) {
+      Result.push_back("DIEs: " + std::to_string(CU->getNumDIEs()));
+      const DWARFDebugLine::LineTable *LT = Ctx->getLineTableForUnit(CU.get());
+      Result.push_back(LT ? "files: " +
+                                std::to_string(LT->Prologue.FileNames.size())
+                          : "no line table");
+    }
+    llvm::append_range(Result, Errors);
+    return Result;
+  };
+
+  std::vector<std::string> Serial = Query(/*Prefetch=*/false);
+  ASSERT_GT(Serial.size(), 4u);
+  EXPECT_EQ(Serial[0], "DIEs: 3");
+  EXPECT_EQ(Serial[1], "files: 1");
+  EXPECT_EQ(Serial[2], "DIEs: 3");
+  EXPECT_EQ(Query(/*Prefetch=*/true), Serial);
+}
+
 } // end anonymous namespace
@@ -14,6 +14,7 @@
 #include "llvm/DebugInfo/GSYM/FileEntry.h"
 #include "llvm/DebugInfo/GSYM/FileWriter.h"
 #include "llvm/DebugInfo/GSYM/FunctionInfo.h"
+#include "llvm/DebugInfo/GSYM/GsymContext.h"
 #include "llvm/DebugInfo/GSYM/GsymCreator.h"
 #include "llvm/DebugInfo/GSYM/GsymReader.h"
 #include "llvm/DebugInfo/GSYM/Header.h"
@@ -1281,6 +1282,70 @@ TEST(GSYMTest, TestGsymLookups) {
 }
 
 
+TEST(GSYMTest, TestGsymContext) {
+  // Test that a GsymContext answers DIContext queries from the GSYM data.
+  GsymCreator GC;
+  FunctionInfo FI(0x1000, 0x100, GC.insertString("main"));
+  FI.OptLineTable = LineTable();
+  const uint32_t MainFileIndex = GC.insertFile("/tmp/main.c");
+  const uint32_t FooFileIndex = GC.insertFile("/tmp/foo.h");
+  FI.OptLineTable->push(LineEntry(0x1000, MainFileIndex, 5));
+  FI.OptLineTable->push(LineEntry(0x1010, FooFileIndex, 10));
+  FI.OptLineTable->push(LineEntry(0x1020, MainFileIndex, 8));
+  FI.Inline = InlineInfo();
+  FI.Inline->Name = GC.insertString("inline1");
+  FI.Inline->CallFile = MainFileIndex;
+  FI.Inline->CallLine = 6;
+  FI.Inline->Ranges.insert(AddressRange(0x1010, 0x1020));
+  GC.addFunctionInfo(std::move(FI));
+  OutputAggregator Null(nullptr);
+  ASSERT_FALSE((bool)GC.finalize(Null));
+  SmallString<512> Str;
+  raw_svector_ostream OutStrm(Str);
+  FileWriter FW(OutStrm, llvm::endianness::native);
+  ASSERT_FALSE((bool)GC.encode(FW));
+  Expected<GsymReader> GR = GsymReader::copyBuffer(OutStrm.str());
+  ASSERT_THAT_EXPECTED(GR, Succeeded());
+
+  GsymContext Ctx(std::make_unique<GsymReader>(std::move(*GR)));
+  DILineInfo LI = Ctx.getLineInfoForAddress({0x1004});
+  EXPECT_EQ(LI.FunctionName, "main");
+  EXPECT_EQ(LI.FileName, "/tmp/main.c");
+  EXPECT_EQ(LI.Line, 5u);
+  EXPECT_EQ(LI.StartAddress, 0x1000u);
+
+  DIInliningInfo II = Ctx.getInliningInfoForAddress({0x1010});
+  ASSERT_EQ(II.getNumberOfFrames(), 2u);
+  EXPECT_EQ(II.getFrame(0).FunctionName, "inline1");
+  EXPECT_EQ(II.getFrame(0).FileName, "/tmp/foo.h");
+  EXPECT_EQ(II.getFrame(0).Line, 10u);
+  EXPECT_EQ(II.getFrame(1).FunctionName, "main");
+  EXPECT_EQ(II.getFrame(1).Line, 6u);
+
+  DILineInfoSpecifier BaseNames(
+      DILineInfoSpecifier::FileLineInfoKind::BaseNameOnly);
+  DILineInfoTable Table = Ctx.getLineInfoForAddressRange({0x1000}, 0x20,
+                                                         BaseNames);
+  ASSERT_EQ(Table.size(), 2u);
+  EXPECT_EQ(Table[0].first, 0x1000u);
+  EXPECT_EQ(Table[0].second.FileName, "main.c");
+  EXPECT_EQ(Table[1].first, 0x1010u);
+  EXPECT_EQ(Table[1].second.FileName, "foo.h");
+
+  // A range that starts in the middle of a row still reports that row first.
+  Table = Ctx.getLineInfoForAddressRange({0x1008}, 0x10, BaseNames);
+  ASSERT_EQ(Table.size(), 2u);
+  EXPECT_EQ(Table[0].first, 0x1000u);
+  EXPECT_EQ(Table[0].second.Line, 5u);
+  EXPECT_EQ(Table[1].first, 0x1010u);
+  EXPECT_EQ(Table[1].second.Line, 10u);
+
+  // Addresses outside of the GSYM file, with no fallback context, yield the
+  // same empty answers a DWARFContext would.
+  EXPECT_EQ(Ctx.getLineInfoForAddress({0x2000}), DILineInfo());
+  EXPECT_TRUE(Ctx.getLocalsForAddress({0x1004}).empty());
+}
+
 TEST(GSYMTest, TestDWARFFunctionWithAddresses) {
   // Create a single compile unit with a single function and make sure it gets
   // converted to DWARF correctly. The function's address range is in where
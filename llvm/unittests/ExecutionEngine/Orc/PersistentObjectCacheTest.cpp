@@ -0,0 +1,87 @@
+//===- PersistentObjectCacheTest.cpp - Unit tests for the object cache ----===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+#include "llvm/ExecutionEngine/Orc/PersistentObjectCache.h"
+#include "llvm/ExecutionEngine/Orc/JITTargetMachineBuilder.h"
+#include "llvm/IR/LLVMContext.h"
+#include "llvm/IR/Module.h"
+#include "llvm/Support/FileSystem.h"
+#include "llvm/Support/MemoryBuffer.h"
+#include "llvm/Support/Path.h"
+#include "llvm/Testing/Support/Error.h"
+#include "llvm/Testing/Support/SupportHelpers.h"
+#include "gtest/gtest.h"
+
+using namespace llvm;
+using namespace llvm::orc;
+
+namespace {
+
+TEST(PersistentObjectCacheTest, StoreAndReload) {
+  unittest::TempDir Dir("orc-object-cache", /*Unique=*/true);
+  JITTargetMachineBuilder JTMB(Triple("x86_64-unknown-linux-gnu"));
+
+  LLVMContext Ctx;
+  Module M("test", Ctx);
+  M.setTargetTriple("x86_64-unknown-linux-gnu");
+  StringRef Obj = "not really an object file";
+
+  {
+    auto Cache = PersistentObjectCache::Create(Dir.path(), JTMB);
+    ASSERT_THAT_EXPECTED(Cache, Succeeded());
+    EXPECT_EQ((*Cache)->getObject(&M), nullptr);
+    (*Cache)->notifyObjectCompiled(&M, MemoryBufferRef(Obj, "test"));
+  }
+
+  // A new cache for the same configuration, as in a later process, finds
+  // the object.
+  auto Cache = PersistentObjectCache::Create(Dir.path(), JTMB);
+  ASSERT_THAT_EXPECTED(Cache, Succeeded());
+  auto Hit = (*Cache)->getObject(&M);
+  ASSERT_NE(Hit, nullptr);
+  EXPECT_EQ(Hit->getBuffer(), Obj);
+
+  // Objects are not shared between configurations.
+  JTMB.setCodeGenOptLevel(CodeGenOptLevel::Aggressive);
+  auto OtherCache = PersistentObjectCache::Create(Dir.path(), JTMB);
+  ASSERT_THAT_EXPECTED(OtherCache, Succeeded());
+  EXPECT_EQ((*OtherCache)->getObject(&M), nullptr);
+
+  // Nor between different target options.
+  JTMB.setCodeGenOptLevel(CodeGenOptLevel::Default);
+  JTMB.getOptions().FunctionSections = true;
+  auto SectionsCache = PersistentObjectCache::Create(Dir.path(), JTMB);
+  ASSERT_THAT_EXPECTED(SectionsCache, Succeeded());
+  EXPECT_EQ((*SectionsCache)->getObject(&M), nullptr);
+}
+
+TEST(PersistentObjectCacheTest, PruneOrphanedTempFiles) {
+  unittest::TempDir Dir("orc-object-cache", /*Unique=*/true);
+  JITTargetMachineBuilder JTMB(Triple("x86_64-unknown-linux-gnu"));
+
+  // Temporary files of a process that died while storing an entry.
+  auto MakeTempFile = [&](StringRef Name, std::chrono::hours Age) {
+    SmallString<128> Path(Dir.path());
+    sys::path::append(Path, Name);
+    int FD;
+    ASSERT_FALSE(sys::fs::openFileForWrite(Path, FD));
+    ASSERT_FALSE(sys::fs::setLastAccessAndModificationTime(
+        FD, std::chrono::system_clock::now() - Age));
+    sys::fs::closeFile(FD);
+  };
+  MakeTempFile("orcjit-aaaaaa.tmp.o", std::chrono::hours(2));
+  MakeTempFile("orcjit-bbbbbb.tmp.o", std::chrono::hours(0));
+
+  auto Cache = PersistentObjectCache::Create(Dir.path(), JTMB);
+  ASSERT_THAT_EXPECTED(Cache, Succeeded());
+  EXPECT_FALSE(sys::fs::exists(Dir.path("orcjit-aaaaaa.tmp.o")));
+  // A recent one may still be written by a live process.
+  EXPECT_TRUE(sys::fs::exists(Dir.path("orcjit-bbbbbb.tmp.o")));
+}
+
+} // end anonymous namespace
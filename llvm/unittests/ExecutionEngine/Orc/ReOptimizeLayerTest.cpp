@@ -0,0 +1,229 @@
+//===- ReOptimizeLayerTest.cpp - Unit tests for the re-optimization layer -===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+#include "llvm/ExecutionEngine/Orc/ReOptimizeLayer.h"
+#include "OrcTestCommon.h"
+#include "llvm/AsmParser/Parser.h"
+#include "llvm/ExecutionEngine/Orc/LLJIT.h"
+#include "llvm/Support/SourceMgr.h"
+#include "gtest/gtest.h"
+
+using namespace llvm;
+using namespace llvm::orc;
+
+namespace {
+
+const char *TestModule = R"(
+  @calls = internal global i32 0
+
+  define internal i32 @inc(i32 %x) {
+    %r = add i32 %x, 1
+    ret i32 %r
+  }
+
+  define i32 @foo(i32 %x) {
+    %c = load i32, ptr @calls
+    %c1 = add i32 %c, 1
+    store i32 %c1, ptr @calls
+    %r = call i32 @bar(i32 %x)
+    ret i32 %r
+  }
+
+  define i32 @bar(i32 %x) {
+    %r = call i32 @inc(i32 %x)
+    ret i32 %r
+  }
+
+  define i32 @getCalls() {
+    %c = load i32, ptr @calls
+    ret i32 %c
+  }
+)";
+
+TEST(ReOptimizeLayerTest, RecompilesHotModule) {
+  OrcNativeTarget::initialize();
+
+  auto J = LLJITBuilder().create();
+  if (!J) {
+    consumeError(J.takeError());
+    GTEST_SKIP();
+  }
+
+  auto ISMBuilder =
+      createLocalIndirectStubsManagerBuilder((*J)->getTargetTriple());
+  if (!ISMBuilder)
+    GTEST_SKIP();
+
+  unsigned OptimizeCalls = 0;
+  ReOptimizeLayer RL(
+      (*J)->getExecutionSession(), (*J)->getIRCompileLayer(), ISMBuilder,
+      [&](ThreadSafeModule &TSM) {
+        ++OptimizeCalls;
+        TSM.withModuleDo([](Module &M) {
+          EXPECT_NE(M.getFunction("foo"), nullptr);
+          EXPECT_FALSE(M.getFunction("foo")->isDeclaration());
+        });
+        return Error::success();
+      },
+      /*CallCountThreshold=*/4);
+
+  auto Ctx = std::make_unique<LLVMContext>();
+  SMDiagnostic Err;
+  auto M = parseAssemblyString(TestModule, Err, *Ctx);
+  ASSERT_TRUE(M) << Err.getMessage();
+  M->setDataLayout((*J)->getDataLayout());
+  cantFail(RL.add((*J)->getMainJITDylib(),
+                  ThreadSafeModule(std::move(M), std::move(Ctx))));
+
+  auto *Foo = cantFail((*J)->lookup("foo")).toPtr<int32_t (*)(int32_t)>();
+  auto *GetCalls =
+      cantFail((*J)->lookup("getCalls")).toPtr<int32_t (*)()>();
+
+  // Each call to foo enters foo and bar; the first tier reaches the
+  // threshold on the second call to foo.
+  for (int32_t I = 0; I != 8; ++I)
+    EXPECT_EQ(Foo(I), I + 1);
+
+  EXPECT_EQ(OptimizeCalls, 1U);
+  EXPECT_EQ(RL.getNumReOptimized(), 1U);
+  // Both tiers update the same variable.
+  EXPECT_EQ(GetCalls(), 8);
+}
+
+TEST(ReOptimizeLayerTest, RemovingTrackerRemovesBothTiers) {
+  OrcNativeTarget::initialize();
+
+  auto J = LLJITBuilder().create();
+  if (!J) {
+    consumeError(J.takeError());
+    GTEST_SKIP();
+  }
+
+  auto ISMBuilder =
+      createLocalIndirectStubsManagerBuilder((*J)->getTargetTriple());
+  if (!ISMBuilder)
+    GTEST_SKIP();
+
+  ReOptimizeLayer RL(
+      (*J)->getExecutionSession(), (*J)->getIRCompileLayer(), ISMBuilder,
+      [](ThreadSafeModule &TSM) { return Error::success(); },
+      /*CallCountThreshold=*/4);
+
+  auto Ctx = std::make_unique<LLVMContext>();
+  SMDiagnostic Err;
+  auto M = parseAssemblyString(TestModule, Err, *Ctx);
+  ASSERT_TRUE(M) << Err.getMessage();
+  M->setDataLayout((*J)->getDataLayout());
+  auto &JD = (*J)->getMainJITDylib();
+  auto RT = JD.createResourceTracker();
+  cantFail(RL.add(RT, ThreadSafeModule(std::move(M), std::move(Ctx))));
+
+  auto *Foo = cantFail((*J)->lookup("foo")).toPtr<int32_t (*)(int32_t)>();
+  for (int32_t I = 0; I != 4; ++I)
+    EXPECT_EQ(Foo(I), I + 1);
+  EXPECT_EQ(RL.getNumReOptimized(), 1U);
+
+  cantFail(RT->remove());
+  for (auto *Name : {"foo", "foo.__reopt.0", "foo.__reopt.1"}) {
+    auto Sym = (*J)->lookup(Name);
+    EXPECT_FALSE(!!Sym) << Name << " should have been removed";
+    if (!Sym)
+      consumeError(Sym.takeError());
+  }
+}
+
+static Expected<ThreadSafeModule> parseTestModule(const DataLayout &DL) {
+  auto Ctx = std::make_unique<LLVMContext>();
+  SMDiagnostic Err;
+  auto M = parseAssemblyString(TestModule, Err, *Ctx);
+  if (!M)
+    return make_error<StringError>(Err.getMessage(), inconvertibleErrorCode());
+  M->setDataLayout(DL);
+  return ThreadSafeModule(std::move(M), std::move(Ctx));
+}
+
+TEST(ReOptimizeLayerTest, StubsArePerJITDylib) {
+  OrcNativeTarget::initialize();
+
+  auto J = LLJITBuilder().create();
+  if (!J) {
+    consumeError(J.takeError());
+    GTEST_SKIP();
+  }
+
+  auto ISMBuilder =
+      createLocalIndirectStubsManagerBuilder((*J)->getTargetTriple());
+  if (!ISMBuilder)
+    GTEST_SKIP();
+
+  ReOptimizeLayer RL(
+      (*J)->getExecutionSession(), (*J)->getIRCompileLayer(), ISMBuilder,
+      [](ThreadSafeModule &TSM) { return Error::success(); },
+      /*CallCountThreshold=*/4);
+
+  // The same module in two JITDylibs defines stubs with the same names.
+  auto &JD1 = (*J)->getMainJITDylib();
+  auto &JD2 = cantFail((*J)->createJITDylib("second"));
+  cantFail(RL.add(JD1, cantFail(parseTestModule((*J)->getDataLayout()))));
+  cantFail(RL.add(JD2, cantFail(parseTestModule((*J)->getDataLayout()))));
+
+  auto *Foo1 =
+      cantFail((*J)->lookup(JD1, "foo")).toPtr<int32_t (*)(int32_t)>();
+  auto *Foo2 =
+      cantFail((*J)->lookup(JD2, "foo")).toPtr<int32_t (*)(int32_t)>();
+  EXPECT_NE(Foo1, Foo2);
+  auto *GetCalls1 =
+      cantFail((*J)->lookup(JD1, "getCalls")).toPtr<int32_t (*)()>();
+  auto *GetCalls2 =
+      cantFail((*J)->lookup(JD2, "getCalls")).toPtr<int32_t (*)()>();
+
+  for (int32_t I = 0; I != 8; ++I)
+    EXPECT_EQ(Foo1(I), I + 1);
+  EXPECT_EQ(RL.getNumReOptimized(), 1U);
+  EXPECT_EQ(Foo2(1), 2);
+
+  // Recompiling the module of the first JITDylib must not redirect the stubs
+  // of the second one.
+  EXPECT_EQ(GetCalls1(), 8);
+  EXPECT_EQ(GetCalls2(), 1);
+}
+
+TEST(ReOptimizeLayerTest, ReAddAfterRemove) {
+  OrcNativeTarget::initialize();
+
+  auto J = LLJITBuilder().create();
+  if (!J) {
+    consumeError(J.takeError());
+    GTEST_SKIP();
+  }
+
+  auto ISMBuilder =
+      createLocalIndirectStubsManagerBuilder((*J)->getTargetTriple());
+  if (!ISMBuilder)
+    GTEST_SKIP();
+
+  ReOptimizeLayer RL(
+      (*J)->getExecutionSession(), (*J)->getIRCompileLayer(), ISMBuilder,
+      [](ThreadSafeModule &TSM) { return Error::success(); },
+      /*CallCountThreshold=*/4);
+
+  // Removing the tracker releases the stubs, so the module can be added again
+  // under the same names.
+  auto &JD = (*J)->getMainJITDylib();
+  for (unsigned Round = 0; Round != 2; ++Round) {
+    auto RT = JD.createResourceTracker();
+    cantFail(RL.add(RT, cantFail(parseTestModule((*J)->getDataLayout()))));
+    auto *Foo = cantFail((*J)->lookup("foo")).toPtr<int32_t (*)(int32_t)>();
+    for (int32_t I = 0; I != 4; ++I)
+      EXPECT_EQ(Foo(I), I + 1);
+    EXPECT_EQ(RL.getNumReOptimized(), Round + 1);
+    cantFail(RT->remove());
+  }
+}
+
+} // end anonymous namespace
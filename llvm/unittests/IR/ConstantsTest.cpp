@@ -9,6 +9,7 @@
 #include "llvm/IR/Constants.h"
 #include "llvm-c/Core.h"
 #include "llvm/AsmParser/Parser.h"
+#include "llvm/Config/llvm-config.h"
 #include "llvm/IR/ConstantFold.h"
 #include "llvm/IR/DerivedTypes.h"
 #include "llvm/IR/InstrTypes.h"
@@ -17,6 +18,7 @@
 #include "llvm/IR/Module.h"
 #include "llvm/Support/SourceMgr.h"
 #include "gtest/gtest.h"
+#include <thread>
 
 namespace llvm {
 namespace {
@@ -799,5 +801,34 @@ TEST(ConstantsTest, BlockAddressCAPITest) {
   EXPECT_EQ(&BB, OutBB);
 }
 
+#if LLVM_ENABLE_THREADS
+TEST(ConstantsTest, ConcurrentConstantUniquing) {
+  LLVMContext Context;
+  ConstantInt *Before = ConstantInt::get(Context, APInt(32, 42));
+  EXPECT_FALSE(Context.hasConcurrentConstantUniquing());
+  Context.enableConcurrentConstantUniquing();
+  EXPECT_TRUE(Context.hasConcurrentConstantUniquing());
+
+  // Constants created before switching modes are still found.
+  EXPECT_EQ(Before, ConstantInt::get(Context, APInt(32, 42)));
+
+  std::vector<std::vector<Constant *>> Results(4);
+  std::vector<std::thread> Threads;
+  for (std::vector<Constant *> &R : Results)
+    Threads.emplace_back([&Context, &R] {
+      for (uint64_t V = 0; V != 1000; ++V) {
+        R.push_back(ConstantInt::get(Context, APInt(17 + V % 3, V)));
+        R.push_back(ConstantFP::get(Context, APFloat(double(V))));
+      }
+    });
+  for (std::thread &T : Threads)
+    T.join();
+
+  for (std::vector<Constant *> &R : Results)
+    EXPECT_EQ(R, Results[0]);
+  EXPECT_EQ(Results[0][0], ConstantInt::get(IntegerType::get(Context, 17), 0));
+}
+#endif
+
 } // end anonymous namespace
 } // end namespace llvm
@@ -9,10 +9,13 @@
 #include "llvm/IR/Module.h"
 #include "llvm/AsmParser/Parser.h"
 #include "llvm/IR/GlobalVariable.h"
+#include "llvm/IR/InstrTypes.h"
+#include "llvm/IR/Instructions.h"
 #include "llvm/IR/ModuleSummaryIndex.h"
 #include "llvm/Pass.h"
 #include "llvm/Support/RandomNumberGenerator.h"
 #include "llvm/Support/SourceMgr.h"
+#include "llvm/Support/raw_ostream.h"
 #include "gtest/gtest.h"
 
 #include <random>
@@ -310,4 +313,74 @@ TEST(ModuleTest, GlobalList) {
   EXPECT_EQ(M->global_size(), 1u);
 }
 
+TEST(ModuleTest, printMemoryStats) {
+  SMDiagnostic Err;
+  LLVMContext Context;
+  std::unique_ptr<Module> M = parseAssemblyString(R"(
+@g = global i32 0
+
+define i32 @f(i32 %a, i1 %c) {
+entry:
+  %x = add i32 %a, 1
+  %y = add i32 %x, 2
+  br i1 %c, label %then, label %exit
+then:
+  br label %exit
+exit:
+  %p = phi i32 [ %x, %entry ], [ %y, %then ]
+  ret i32 %p
+}
+)",
+                                                  Err, Context);
+  ASSERT_TRUE(M);
+
+  std::string Out;
+  raw_string_ostream OS(Out);
+  M->printMemoryStats(OS);
+
+  SmallVector<StringRef> Lines;
+  StringRef(Out).split(Lines, '\n', -1, /*KeepEmpty=*/false);
+  ASSERT_GT(Lines.size(), 2u);
+  EXPECT_EQ(Lines[0],
+            "IR memory statistics for module '<string>' (approximate):");
+
+  // Each line after the column headers is "<count> <bytes>  <kind>", and the
+  // last one holds the total bytes only.
+  StringMap<std::pair<uint64_t, uint64_t>> Stats;
+  uint64_t Sum = 0;
+  for (StringRef Line : ArrayRef(Lines).slice(2, Lines.size() - 3)) {
+    SmallVector<StringRef, 3> Fields;
+    Line.split(Fields, ' ', -1, /*KeepEmpty=*/false);
+    ASSERT_EQ(Fields.size(), 3u) << Line;
+    uint64_t Count, Bytes;
+    ASSERT_FALSE(Fields[0].getAsInteger(10, Count));
+    ASSERT_FALSE(Fields[1].getAsInteger(10, Bytes));
+    Stats[Fields[2]] = {Count, Bytes};
+    Sum += Bytes;
+  }
+  SmallVector<StringRef, 2> Total;
+  Lines.back().split(Total, ' ', -1, /*KeepEmpty=*/false);
+  ASSERT_EQ(Total.size(), 2u);
+  EXPECT_EQ(Total[0], std::to_string(Sum));
+  EXPECT_EQ(Total[1], "Total");
+
+  EXPECT_EQ(Stats["GlobalVariable"].first, 1u);
+  EXPECT_EQ(Stats["Function"].first, 1u);
+  EXPECT_EQ(Stats["Argument"].first, 2u);
+  EXPECT_EQ(Stats["BasicBlock"].first, 3u);
+  EXPECT_EQ(Stats["br"].first, 2u);
+  EXPECT_EQ(Stats["ret"].first, 1u);
+  EXPECT_EQ(Stats["add"],
+            std::make_pair(uint64_t(2),
+                           uint64_t(2 * (sizeof(BinaryOperator) +
+                                         2 * sizeof(Use)))));
+  // PHI nodes also hold an array of incoming blocks.
+  EXPECT_EQ(Stats["phi"],
+            std::make_pair(uint64_t(1),
+                           uint64_t(sizeof(PHINode) +
+                                    2 * (sizeof(Use) + sizeof(BasicBlock *)))));
+  // @g, @f, %a, %c, %entry, %x, %y, %then, %exit and %p.
+  EXPECT_EQ(Stats["ValueName"].first, 10u);
+}
+
 } // end namespace
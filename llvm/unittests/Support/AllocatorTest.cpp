@@ -258,4 +258,25 @@ TEST(AllocatorTest, TestBigAlignment) {
   EXPECT_GT(MockSlabAllocator::GetLastSlabSize(), 4096u);
 }
 
+// Test that a bump allocator over mapped slabs allocates, including objects
+// too large for a slab, and unmaps everything when reset.
+TEST(AllocatorTest, TestHugePageAllocator) {
+  size_t Before = MappedMemoryAllocator::getTotalBytesAllocated();
+  {
+    HugePageBumpPtrAllocator Alloc;
+    char *Small = Alloc.Allocate<char>(100);
+    memset(Small, 1, 100);
+    char *Big = Alloc.Allocate<char>(5 * 1024 * 1024);
+    memset(Big, 2, 5 * 1024 * 1024);
+    EXPECT_EQ(2U, Alloc.GetNumSlabs());
+    EXPECT_EQ(Before + 7 * 1024 * 1024,
+              MappedMemoryAllocator::getTotalBytesAllocated());
+
+    Alloc.Reset();
+    EXPECT_EQ(Before + 2 * 1024 * 1024,
+              MappedMemoryAllocator::getTotalBytesAllocated());
+  }
+  EXPECT_EQ(Before, MappedMemoryAllocator::getTotalBytesAllocated());
+}
+
 }  // anonymous namespace
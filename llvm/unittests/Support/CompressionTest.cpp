@@ -65,6 +65,25 @@ TEST(CompressionTest, Zlib) {
   testZlibCompression(BinaryDataStr, zlib::BestSpeedCompression);
   testZlibCompression(BinaryDataStr, zlib::DefaultCompression);
 }
+
+TEST(CompressionTest, ZlibInShards) {
+  const size_t kSize = 4096;
+  char BinaryData[kSize];
+  for (size_t i = 0; i < kSize; ++i)
+    BinaryData[i] = (i * 7) & 63;
+  StringRef Input(BinaryData, kSize);
+
+  // Inputs that are not a multiple of the shard size have a short last shard.
+  for (size_t ShardSize : {size_t(1000), size_t(1024), kSize}) {
+    SmallVector<uint8_t, 0> Compressed;
+    SmallVector<uint8_t, 0> Uncompressed;
+    compressInShards(Format::Zlib, arrayRefFromStringRef(Input), Compressed,
+                     ShardSize);
+    Error E = zlib::decompress(Compressed, Uncompressed, Input.size());
+    EXPECT_FALSE(std::move(E));
+    EXPECT_EQ(Input, toStringRef(Uncompressed));
+  }
+}
 #endif
 
 #if LLVM_ENABLE_ZSTD
@@ -110,5 +129,23 @@ TEST(CompressionTest, Zstd) {
   testZstdCompression(BinaryDataStr, zstd::BestSpeedCompression);
   testZstdCompression(BinaryDataStr, zstd::DefaultCompression);
 }
+
+TEST(CompressionTest, ZstdInShards) {
+  const size_t kSize = 4096;
+  char BinaryData[kSize];
+  for (size_t i = 0; i < kSize; ++i)
+    BinaryData[i] = (i * 7) & 63;
+  StringRef Input(BinaryData, kSize);
+
+  for (size_t ShardSize : {size_t(1000), size_t(1024), kSize}) {
+    SmallVector<uint8_t, 0> Compressed;
+    SmallVector<uint8_t, 0> Uncompressed;
+    compressInShards(Format::Zstd, arrayRefFromStringRef(Input), Compressed,
+                     ShardSize);
+    Error E = zstd::decompress(Compressed, Uncompressed, Input.size());
+    EXPECT_FALSE(std::move(E));
+    EXPECT_EQ(Input, toStringRef(Uncompressed));
+  }
+}
 #endif
 }
@@ -0,0 +1,78 @@
+//===- llvm/unittest/Support/ConcurrentStringSaverTest.cpp ----------------===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+#include "llvm/Support/ConcurrentStringSaver.h"
+#include "llvm/Config/llvm-config.h"
+#include "gtest/gtest.h"
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace llvm;
+
+namespace {
+
+TEST(ConcurrentStringSaverTest, SaveUnique) {
+  ConcurrentUniqueStringSaver Saver(4);
+  std::string Str = "hello";
+  StringRef Saved = Saver.save(Str);
+  EXPECT_EQ("hello", Saved);
+  EXPECT_NE(Str.data(), Saved.data());
+  EXPECT_EQ('\0', *Saved.end());
+
+  EXPECT_EQ(Saved.data(), Saver.save("hello").data());
+  EXPECT_EQ(Saved.data(), Saver.save(Twine("hel") + "lo").data());
+  EXPECT_NE(Saved.data(), Saver.save("world").data());
+
+  StringRef Empty = Saver.save(StringRef());
+  EXPECT_TRUE(Empty.empty());
+  EXPECT_EQ('\0', *Empty.end());
+  EXPECT_EQ(Empty.data(), Saver.save("").data());
+
+  EXPECT_EQ(3u, Saver.size());
+  EXPECT_GT(Saver.getBytesAllocated(), 0u);
+}
+
+TEST(ConcurrentStringSaverTest, OneShard) {
+  ConcurrentUniqueStringSaver Saver(1);
+  for (unsigned I = 0; I != 1000; ++I)
+    Saver.save(std::to_string(I % 100));
+  EXPECT_EQ(100u, Saver.size());
+}
+
+#if LLVM_ENABLE_THREADS
+TEST(ConcurrentStringSaverTest, SaveFromThreads) {
+  // Threads save overlapping strings in different orders; each string must be
+  // saved exactly once.
+  constexpr unsigned NumThreads = 8;
+  constexpr unsigned NumStrings = 10000;
+  ConcurrentUniqueStringSaver Saver;
+  std::vector<std::vector<const char *>> Results(NumThreads);
+  std::vector<std::thread> Threads;
+  for (unsigned T = 0; T != NumThreads; ++T) {
+    Threads.emplace_back([&, T] {
+      Results[T].resize(NumStrings);
+      for (unsigned I = 0; I != NumStrings; ++I) {
+        unsigned N = (I * 7919 + T * 104729) % NumStrings;
+        Results[T][N] = Saver.save("string" + std::to_string(N)).data();
+      }
+    });
+  }
+  for (std::thread &Thread : Threads)
+    Thread.join();
+
+  EXPECT_EQ(NumStrings, Saver.size());
+  for (unsigned N = 0; N != NumStrings; ++N) {
+    EXPECT_EQ("string" + std::to_string(N), Results[0][N]);
+    for (unsigned T = 1; T != NumThreads; ++T)
+      EXPECT_EQ(Results[0][N], Results[T][N]);
+  }
+}
+#endif
+
+} // namespace
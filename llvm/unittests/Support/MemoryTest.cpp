@@ -10,6 +10,7 @@
 #include "llvm/Support/Process.h"
 #include "gtest/gtest.h"
 #include <cstdlib>
+#include <cstring>
 
 #if defined(__NetBSD__)
 // clang-format off
@@ -122,6 +123,27 @@ TEST_P(MappedMemoryTest, AllocAndReleaseHuge) {
   EXPECT_FALSE(Memory::releaseMappedMemory(M1));
 }
 
+#if defined(__linux__)
+TEST_P(MappedMemoryTest, AllocHugeIsAligned) {
+  CHECK_UNSUPPORTED();
+  // Transparent huge pages need 2 MiB aligned memory, so large requests for
+  // huge pages are aligned whether or not the kernel provides them.
+  const size_t HugePageSize = 2 * 1024 * 1024;
+  std::error_code EC;
+  MemoryBlock M1 = Memory::allocateMappedMemory(
+      3 * HugePageSize, nullptr, Flags | Memory::MF_HUGE_HINT, EC);
+  EXPECT_EQ(std::error_code(), EC);
+
+  ASSERT_NE((void *)nullptr, M1.base());
+  EXPECT_EQ(0u, reinterpret_cast<uintptr_t>(M1.base()) % HugePageSize);
+  EXPECT_EQ(3 * HugePageSize, M1.allocatedSize());
+  if (Flags & Memory::MF_WRITE)
+    memset(M1.base(), 1, M1.allocatedSize());
+
+  EXPECT_FALSE(Memory::releaseMappedMemory(M1));
+}
+#endif
+
 TEST_P(MappedMemoryTest, MultipleAllocAndRelease) {
   CHECK_UNSUPPORTED();
   std::error_code EC;
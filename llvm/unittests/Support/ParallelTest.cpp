@@ -15,6 +15,7 @@
 #include "llvm/Support/ThreadPool.h"
 #include "gtest/gtest.h"
 #include <array>
+#include <atomic>
 #include <random>
 
 uint32_t array[1024 * 1024];
@@ -103,11 +104,29 @@ TEST(Parallel, TaskGroupSequentialFor) {
   EXPECT_EQ(Count, 500ul);
 }
 
+TEST(Parallel, TaskGroupManySmallTasks) {
+  // Many tiny tasks mixed with sequential ones exercise stealing between the
+  // workers' queues.
+  std::atomic<size_t> Count{0};
+  size_t SequentialCount = 0;
+  {
+    parallel::TaskGroup tg;
+    for (size_t Idx = 0; Idx < 10000; Idx++) {
+      if (Idx % 10 == 0)
+        tg.spawn([&SequentialCount]() { ++SequentialCount; }, true);
+      else
+        tg.spawn([&Count]() { ++Count; });
+    }
+  }
+  EXPECT_EQ(Count, 9000ul);
+  EXPECT_EQ(SequentialCount, 1000ul);
+}
+
 #if LLVM_ENABLE_THREADS
 TEST(Parallel, NestedTaskGroup) {
   // This test checks:
   // 1. Root TaskGroup is in Parallel mode.
-  // 2. Nested TaskGroup is not in Parallel mode.
+  // 2. Nested TaskGroup is in Parallel mode as well.
   parallel::TaskGroup tg;
 
   tg.spawn([&]() {
@@ -116,17 +135,31 @@ TEST(Parallel, NestedTaskGroup) {
 
   tg.spawn([&]() {
     parallel::TaskGroup nestedTG;
-    EXPECT_FALSE(nestedTG.isParallel());
+    EXPECT_TRUE(nestedTG.isParallel() ||
+                (parallel::strategy.ThreadsRequested == 1));
 
     nestedTG.spawn([&]() {
       // Check that root TaskGroup is in Parallel mode.
       EXPECT_TRUE(tg.isParallel() ||
                   (parallel::strategy.ThreadsRequested == 1));
 
-      // Check that nested TaskGroup is not in Parallel mode.
-      EXPECT_FALSE(nestedTG.isParallel());
+      // Check that nested TaskGroup is in Parallel mode.
+      EXPECT_TRUE(nestedTG.isParallel() ||
+                  (parallel::strategy.ThreadsRequested == 1));
+    });
+  });
+}
+
+TEST(Parallel, NestedParallelFor) {
+  // Nested parallel loops share the pool; waiting threads help run pending
+  // tasks, so this must neither deadlock nor lose iterations.
+  std::atomic<size_t> Count{0};
+  parallelFor(0, 64, [&](size_t) {
+    parallelFor(0, 64, [&](size_t) {
+      parallelFor(0, 16, [&](size_t) { ++Count; });
     });
   });
+  EXPECT_EQ(Count, 64ul * 64 * 16);
 }
 
 TEST(Parallel, ParallelNestedTaskGroup) {
@@ -143,9 +176,10 @@ TEST(Parallel, ParallelNestedTaskGroup) {
         EXPECT_TRUE(tg.isParallel() ||
                     (parallel::strategy.ThreadsRequested == 1));
 
-        // Check that nested TaskGroup is not in Parallel mode.
+        // Check that nested TaskGroup is in Parallel mode.
         parallel::TaskGroup nestedTG;
-        EXPECT_FALSE(nestedTG.isParallel());
+        EXPECT_TRUE(nestedTG.isParallel() ||
+                    (parallel::strategy.ThreadsRequested == 1));
         ++Count;
 
         nestedTG.spawn([&]() {
@@ -153,8 +187,9 @@ TEST(Parallel, ParallelNestedTaskGroup) {
           EXPECT_TRUE(tg.isParallel() ||
                       (parallel::strategy.ThreadsRequested == 1));
 
-          // Check that nested TaskGroup is not in Parallel mode.
-          EXPECT_FALSE(nestedTG.isParallel());
+          // Check that nested TaskGroup is in Parallel mode.
+          EXPECT_TRUE(nestedTG.isParallel() ||
+                      (parallel::strategy.ThreadsRequested == 1));
           ++Count;
         });
       });
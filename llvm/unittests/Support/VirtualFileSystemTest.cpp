@@ -1044,6 +1044,73 @@ TEST(ProxyFileSystemTest, Basic) {
   EXPECT_FALSE(Local);
 }
 
+TEST(StatusCachingFileSystemTest, Basic) {
+  IntrusiveRefCntPtr<DummyFileSystem> D(new DummyFileSystem());
+  ASSERT_FALSE(D->setCurrentWorkingDirectory("/"));
+  IntrusiveRefCntPtr<vfs::StatusCachingFileSystem> FS(
+      new vfs::StatusCachingFileSystem(D));
+
+  // Failures are cached too.
+  EXPECT_FALSE(FS->exists("/foo"));
+  D->addRegularFile("/foo");
+  EXPECT_FALSE(FS->exists("/foo"));
+  EXPECT_EQ(1u, FS->getNumCachedStatuses());
+
+  FS->invalidate("/foo");
+  ErrorOr<vfs::Status> Status = FS->status("/foo");
+  ASSERT_FALSE(Status.getError());
+  EXPECT_TRUE(Status->isRegularFile());
+
+  // Equivalent spellings share an entry, and keep their own name.
+  ErrorOr<vfs::Status> RelStatus = FS->status("./foo");
+  ASSERT_FALSE(RelStatus.getError());
+  EXPECT_EQ("./foo", RelStatus->getName());
+  EXPECT_TRUE(Status->equivalent(*RelStatus));
+  EXPECT_EQ(1u, FS->getNumCachedStatuses());
+
+  D->addDirectory("/bar");
+  EXPECT_TRUE(FS->exists("/bar"));
+  EXPECT_EQ(2u, FS->getNumCachedStatuses());
+  FS->invalidate();
+  EXPECT_EQ(0u, FS->getNumCachedStatuses());
+  EXPECT_TRUE(FS->exists("foo"));
+  EXPECT_TRUE(isa<vfs::ProxyFileSystem>(*FS));
+}
+
+TEST(StatusCachingFileSystemTest, InvalidateDuringQuery) {
+  // Runs a callback while a status query is in flight.
+  class HookedFileSystem : public vfs::ProxyFileSystem {
+  public:
+    using ProxyFileSystem::ProxyFileSystem;
+    std::function<void()> OnStatus;
+    ErrorOr<vfs::Status> status(const Twine &Path) override {
+      ErrorOr<vfs::Status> Result = ProxyFileSystem::status(Path);
+      if (OnStatus)
+        OnStatus();
+      return Result;
+    }
+  };
+
+  IntrusiveRefCntPtr<DummyFileSystem> D(new DummyFileSystem());
+  ASSERT_FALSE(D->setCurrentWorkingDirectory("/"));
+  IntrusiveRefCntPtr<HookedFileSystem> Hooked(new HookedFileSystem(D));
+  IntrusiveRefCntPtr<vfs::StatusCachingFileSystem> FS(
+      new vfs::StatusCachingFileSystem(Hooked));
+
+  // The file appears, and is reported, after the underlying query saw it
+  // missing. The stale answer must not stay in the cache.
+  Hooked->OnStatus = [&] {
+    D->addRegularFile("/foo");
+    FS->invalidate("/foo");
+  };
+  EXPECT_FALSE(FS->exists("/foo"));
+  EXPECT_EQ(0u, FS->getNumCachedStatuses());
+
+  Hooked->OnStatus = nullptr;
+  EXPECT_TRUE(FS->exists("/foo"));
+  EXPECT_EQ(1u, FS->getNumCachedStatuses());
+}
+
 class InMemoryFileSystemTest : public ::testing::Test {
 protected:
   llvm::vfs::InMemoryFileSystem FS;
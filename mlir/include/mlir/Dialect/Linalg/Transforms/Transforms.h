@@ -21,6 +21,7 @@
 #include "mlir/Dialect/Vector/Transforms/VectorTransforms.h"
 #include "mlir/Dialect/X86Vector/Transforms.h"
 #include "mlir/IR/PatternMatch.h"
+#include "mlir/Interfaces/LoopLikeInterface.h"
 #include "mlir/Interfaces/TilingInterface.h"
 #include "mlir/Support/LogicalResult.h"
 #include "mlir/Transforms/DialectConversion.h"
@@ -870,6 +871,55 @@ tileToForallOpUsingTileSizes(RewriterBase &builder, TilingInterface op,
                              ArrayRef<OpFoldResult> tileSizes,
                              std::optional<ArrayAttr> mapping);
 
+/// Options for tiling a structured op for the cache hierarchy of a target.
+struct CacheTilingOptions {
+  /// The cache sizes in bytes, from the innermost (smallest) level outwards.
+  SmallVector<int64_t> cacheSizes;
+  CacheTilingOptions &setCacheSizes(ArrayRef<int64_t> sizes) {
+    cacheSizes.assign(sizes.begin(), sizes.end());
+    return *this;
+  }
+  /// The fraction of each cache that the operand slices of one tile may
+  /// occupy, leaving room for other data.
+  double cacheUtilization = 0.75;
+  /// Whether to fuse the producers of the op into the outermost tile loops.
+  /// Only ops with tensor semantics are fused.
+  bool fuseProducers = true;
+};
+
+/// Returns the cache sizes that `op` should be tiled for, as read from the
+/// closest data layout spec. The sizes are given as integer entries keyed by
+/// "l1_cache_size_in_bytes", "l2_cache_size_in_bytes" and
+/// "l3_cache_size_in_bytes"; the result stops at the first missing level.
+SmallVector<int64_t> getCacheSizesFromDataLayout(Operation *op);
+
+/// Returns one tile size per loop of `op` such that the slices of all operands
+/// accessed by a tile fit in `budgetInBytes`. Dynamic loop ranges are assumed
+/// to be large. Tile sizes are halved, largest (then outermost) first, but are
+/// kept at multiples of `minTileSizes`, if given, and never go below them.
+/// Reduction loops are left untiled unless `tileReductions` is set.
+SmallVector<int64_t> computeCacheTileSizes(LinalgOp op, int64_t budgetInBytes,
+                                           ArrayRef<int64_t> minTileSizes = {},
+                                           bool tileReductions = true);
+
+/// Transformation information returned by `tileForCacheHierarchy`.
+struct CacheTilingResult {
+  /// The tile loops, from the outermost inwards.
+  SmallVector<LoopLikeOpInterface> loops;
+  /// The innermost tiled op.
+  Operation *tiledOp;
+};
+
+/// Tiles `op` once per cache level in `options`, outermost level first, with
+/// the tile sizes of `computeCacheTileSizes`, so that each level of tiles
+/// reuses its operand slices from the corresponding cache. When fusing
+/// producers, the outermost level only tiles the parallel loops, so that
+/// producers of the outputs (e.g. fills) can be fused as well. Levels whose
+/// tiles cover the whole iteration space are skipped.
+FailureOr<CacheTilingResult>
+tileForCacheHierarchy(RewriterBase &rewriter, LinalgOp op,
+                      const CacheTilingOptions &options);
+
 /// Transformation information returned after reduction tiling.
 struct ForallReductionTilingResult {
   /// The partial reduction tiled op generated.
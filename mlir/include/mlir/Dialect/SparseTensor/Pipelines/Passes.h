@@ -78,6 +78,11 @@ struct SparsifierOptions : public PassPipelineOptions<SparsifierOptions> {
   PassOptions::Option<int32_t> vectorLength{
       *this, "vl", desc("Set the vector length (0 disables vectorization)"),
       init(0)};
+  PassOptions::Option<int32_t> vectorBits{
+      *this, "vector-bits",
+      desc("Set the vector register width in bits, to choose the vector "
+           "length of each loop from its widest element type (overrides vl)"),
+      init(0)};
 
   // These options must be kept in sync with the `ConvertVectorToLLVM`
   // (defined in include/mlir/Dialect/SparseTensor/Pipelines/Passes.h).
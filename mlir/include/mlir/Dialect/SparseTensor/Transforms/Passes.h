@@ -195,15 +195,20 @@ createSparseBufferRewritePass(bool enableBufferInitialization);
 // The SparseVectorization pass.
 //===----------------------------------------------------------------------===//
 
+/// Populates the given patterns list with vectorization rules. A nonzero
+/// `vectorBits` overrides `vectorLength`: the vector length of each loop is
+/// then chosen so that vectors of its widest element type have that many bits.
 void populateSparseVectorizationPatterns(RewritePatternSet &patterns,
                                          unsigned vectorLength,
                                          bool enableVLAVectorization,
-                                         bool enableSIMDIndex32);
+                                         bool enableSIMDIndex32,
+                                         unsigned vectorBits = 0);
 
 std::unique_ptr<Pass> createSparseVectorizationPass();
 std::unique_ptr<Pass> createSparseVectorizationPass(unsigned vectorLength,
                                                     bool enableVLAVectorization,
-                                                    bool enableSIMDIndex32);
+                                                    bool enableSIMDIndex32,
+                                                    unsigned vectorBits = 0);
 
 //===----------------------------------------------------------------------===//
 // The SparseGPU pass.
@@ -246,7 +251,8 @@ std::unique_ptr<Pass> createSparsificationAndBufferizationPass(
     const SparsificationOptions &sparsificationOptions,
     bool createSparseDeallocs, bool enableRuntimeLibrary,
     bool enableBufferInitialization, unsigned vectorLength,
-    bool enableVLAVectorization, bool enableSIMDIndex32, bool enableGPULibgen);
+    bool enableVLAVectorization, bool enableSIMDIndex32, bool enableGPULibgen,
+    unsigned vectorBits = 0);
 
 //===----------------------------------------------------------------------===//
 // Registration.
@@ -364,6 +364,13 @@ public:
   /// Invalidate any non preserved analyses,
   void invalidate(const PreservedAnalyses &pa) { impl->invalidate(pa); }
 
+  /// Invalidate any non preserved analyses of the current operation, keeping
+  /// the analyses of nested operations.
+  void invalidateNonNested(const PreservedAnalyses &pa) {
+    if (!pa.isAll())
+      impl->analyses.invalidate(pa);
+  }
+
   /// Clear any held analyses.
   void clear() {
     impl->analyses.clear();
@@ -275,6 +275,14 @@ public:
   /// Runs the verifier after each individual pass.
   void enableVerifier(bool enabled = true);
 
+  /// Invoke `materialize` on each operation right before a pass, other than
+  /// the adaptors that run nested pipelines, is run on it. This allows for
+  /// the bodies of operations to be loaded on demand, e.g. from lazily read
+  /// bytecode, so that only the part of the IR a pipeline is running on needs
+  /// to be in memory. The callback may be invoked concurrently when
+  /// multi-threading is enabled, and it is responsible for reporting errors.
+  void enableOpMaterialization(std::function<void(Operation *)> materialize);
+
   //===--------------------------------------------------------------------===//
   // Instrumentations
   //===--------------------------------------------------------------------===//
@@ -463,6 +471,17 @@ public:
   void
   enableStatistics(PassDisplayMode displayMode = PassDisplayMode::Pipeline);
 
+  //===--------------------------------------------------------------------===//
+  // Pass IR Size Tracking
+
+  /// Add an instrumentation that records, for each pass, the number of
+  /// operations per dialect before and after it ran, the number of attributes
+  /// and types it created in the context, and the change in heap usage. A JSON
+  /// report is written to `os`, or to stderr if null, when the pass manager is
+  /// destroyed. Context and heap measurements are process wide, so they are
+  /// only attributed precisely when multi-threading is disabled.
+  void enableIRSizeTracking(std::unique_ptr<raw_ostream> os = nullptr);
+
 private:
   /// Dump the statistics of the passes within this pass manager.
   void dumpStatistics();
@@ -143,6 +143,10 @@ public:
   /// Set the flag specifying if multi-threading is disabled within the uniquer.
   void disableMultithreading(bool disable = true);
 
+  /// Returns the number of parametric storage instances created so far. This
+  /// can be used to track the growth of the uniqued objects of a context.
+  size_t getNumParametricStorageInstances() const;
+
   /// Register a new parametric storage class, this is necessary to create
   /// instances of this class type. `id` is the type identifier that will be
   /// used to identify this type when creating instances of it via 'get'.
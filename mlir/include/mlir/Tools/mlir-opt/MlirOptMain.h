@@ -103,6 +103,14 @@ public:
     return emitBytecodeVersion;
   }
 
+  /// Lazily load the bodies of isolated operations of bytecode inputs: their
+  /// regions are only read when a pass is about to run on them.
+  MlirOptMainConfig &lazyLoadBytecode(bool lazy) {
+    lazyLoadBytecodeFlag = lazy;
+    return *this;
+  }
+  bool shouldLazyLoadBytecode() const { return lazyLoadBytecodeFlag; }
+
   /// Set the callback to populate the pass manager.
   MlirOptMainConfig &
   setPassPipelineSetupFn(std::function<LogicalResult(PassManager &)> callback) {
@@ -217,6 +225,9 @@ protected:
   /// Emit bytecode at given version.
   std::optional<int64_t> emitBytecodeVersion = std::nullopt;
 
+  /// Lazily load isolated operations from bytecode inputs.
+  bool lazyLoadBytecodeFlag = false;
+
   /// The callback to populate the pass manager.
   std::function<LogicalResult(PassManager &)> passPipelineCallback;
 
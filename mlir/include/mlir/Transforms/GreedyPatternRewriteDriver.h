@@ -54,6 +54,18 @@ public:
   /// Note: Only applicable when simplifying entire regions.
   int64_t maxIterations = 10;
 
+  /// When set to true, iterations after the first one do not start from all
+  /// operations of the region, but only from the operations that were
+  /// inserted or modified during the previous iteration, together with the
+  /// producers of their operands and the users of their results (and the
+  /// producers of the operands of erased operations). This avoids rescanning
+  /// the whole region just to find out that a fixpoint was reached, but
+  /// misses opportunities that patterns expose without notifying the
+  /// rewriter.
+  ///
+  /// Note: Only applicable when simplifying entire regions.
+  bool changeDrivenIterations = false;
+
   /// This specifies the maximum number of rewrites within an iteration. Use
   /// `kNoLimit` to disable this limit.
   int64_t maxNumRewrites = kNoLimit;
@@ -0,0 +1,210 @@
+//===- CacheTiling.cpp - Tile Linalg ops for the cache hierarchy ----------===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+//
+// This file implements multi-level tiling of structured ops with tile sizes
+// derived from the operand footprint of a tile and the cache sizes of the
+// target.
+//
+//===----------------------------------------------------------------------===//
+
+#include "mlir/Dialect/Linalg/IR/Linalg.h"
+#include "mlir/Dialect/Linalg/Transforms/Transforms.h"
+#include "mlir/Dialect/SCF/Transforms/TileUsingInterface.h"
+#include "mlir/IR/AffineExpr.h"
+#include "mlir/IR/BuiltinAttributes.h"
+#include "mlir/IR/TypeUtilities.h"
+#include "mlir/Interfaces/DataLayoutInterfaces.h"
+#include "llvm/Support/Debug.h"
+#include "llvm/Support/MathExtras.h"
+
+#define DEBUG_TYPE "linalg-cache-tiling"
+#define DBGS() (llvm::dbgs() << "[" DEBUG_TYPE "]: ")
+
+using namespace mlir;
+using namespace mlir::linalg;
+
+/// The range assumed for loops whose range is not known statically.
+static constexpr int64_t kDynamicLoopRangeEstimate = 1024;
+
+SmallVector<int64_t> mlir::linalg::getCacheSizesFromDataLayout(Operation *op) {
+  SmallVector<int64_t> cacheSizes;
+  for (StringRef key : {"l1_cache_size_in_bytes", "l2_cache_size_in_bytes",
+                        "l3_cache_size_in_bytes"}) {
+    IntegerAttr size;
+    StringAttr identifier = StringAttr::get(op->getContext(), key);
+    for (Operation *parent = op; parent && !size;
+         parent = parent->getParentOp()) {
+      auto iface = dyn_cast<DataLayoutOpInterface>(parent);
+      if (!iface)
+        continue;
+      DataLayoutSpecInterface spec = iface.getDataLayoutSpec();
+      if (!spec)
+        continue;
+      if (DataLayoutEntryInterface entry =
+              spec.getSpecForIdentifier(identifier))
+        size = dyn_cast<IntegerAttr>(entry.getValue());
+    }
+    if (!size || size.getInt() <= 0)
+      break;
+    cacheSizes.push_back(size.getInt());
+  }
+  return cacheSizes;
+}
+
+/// Returns the number of elements along result `expr` of an indexing map that a
+/// tile with the given sizes accesses. Indexing expressions are assumed to be
+/// increasing in each dimension, as for strided and dilated convolutions.
+static uint64_t getAccessedExtent(AffineExpr expr, ArrayRef<int64_t> tileSizes,
+                                  MLIRContext *ctx) {
+  SmallVector<AffineExpr> lower, upper;
+  for (int64_t size : tileSizes) {
+    lower.push_back(getAffineConstantExpr(0, ctx));
+    upper.push_back(getAffineConstantExpr(size - 1, ctx));
+  }
+  auto first = dyn_cast<AffineConstantExpr>(expr.replaceDims(lower));
+  auto last = dyn_cast<AffineConstantExpr>(expr.replaceDims(upper));
+  if (!first || !last || last.getValue() < first.getValue())
+    return kDynamicLoopRangeEstimate;
+  return last.getValue() - first.getValue() + 1;
+}
+
+/// Returns the size in bytes of the operand slices accessed by one tile.
+static uint64_t getTileFootprint(LinalgOp op, ArrayRef<int64_t> tileSizes,
+                                 const DataLayout &layout) {
+  uint64_t footprint = 0;
+  for (OpOperand &operand : op->getOpOperands()) {
+    if (!isa<ShapedType>(operand.get().getType()))
+      continue;
+    uint64_t bytes =
+        layout.getTypeSize(getElementTypeOrSelf(operand.get().getType()))
+            .getFixedValue();
+    AffineMap map = op.getMatchingIndexingMap(&operand);
+    for (AffineExpr expr : map.getResults()) {
+      bytes = llvm::SaturatingMultiply(
+          bytes, getAccessedExtent(expr, tileSizes, op->getContext()));
+    }
+    footprint = llvm::SaturatingAdd(footprint, bytes);
+  }
+  return footprint;
+}
+
+SmallVector<int64_t>
+mlir::linalg::computeCacheTileSizes(LinalgOp op, int64_t budgetInBytes,
+                                    ArrayRef<int64_t> minTileSizes,
+                                    bool tileReductions) {
+  SmallVector<int64_t> tileSizes = op.getStaticLoopRanges();
+  for (int64_t &size : tileSizes)
+    if (ShapedType::isDynamic(size))
+      size = kDynamicLoopRangeEstimate;
+  SmallVector<utils::IteratorType> iterators = op.getIteratorTypesArray();
+  auto getMinTileSize = [&](unsigned dim) -> int64_t {
+    return minTileSizes.empty() ? 1 : std::max<int64_t>(minTileSizes[dim], 1);
+  };
+
+  DataLayout layout = DataLayout::closest(op);
+  uint64_t budget = std::max<int64_t>(budgetInBytes, 0);
+  while (getTileFootprint(op, tileSizes, layout) > budget) {
+    // Shrink the largest tile, so that tiles stay square-ish. On ties, shrink
+    // the outermost one, which keeps the innermost accesses contiguous.
+    std::optional<unsigned> shrinkDim;
+    for (auto [dim, size] : llvm::enumerate(tileSizes)) {
+      if (!tileReductions && linalg::isReductionIterator(iterators[dim]))
+        continue;
+      if (size <= getMinTileSize(dim))
+        continue;
+      if (!shrinkDim || size > tileSizes[*shrinkDim])
+        shrinkDim = dim;
+    }
+    if (!shrinkDim)
+      break;
+    int64_t minSize = getMinTileSize(*shrinkDim);
+    int64_t &size = tileSizes[*shrinkDim];
+    size = std::max(minSize, size / 2 / minSize * minSize);
+  }
+  LLVM_DEBUG({
+    DBGS() << "tile sizes for a budget of " << budgetInBytes << " bytes:";
+    for (int64_t size : tileSizes)
+      llvm::dbgs() << " " << size;
+    llvm::dbgs() << "\n";
+  });
+  return tileSizes;
+}
+
+FailureOr<CacheTilingResult>
+mlir::linalg::tileForCacheHierarchy(RewriterBase &rewriter, LinalgOp op,
+                                    const CacheTilingOptions &options) {
+  if (options.cacheSizes.empty())
+    return rewriter.notifyMatchFailure(op, "no cache sizes");
+  bool fuse = options.fuseProducers && op.hasPureTensorSemantics();
+
+  // Compute the tile sizes from the innermost level outwards, so that outer
+  // tiles are multiples of inner tiles.
+  unsigned numLevels = options.cacheSizes.size();
+  SmallVector<SmallVector<int64_t>> levelTileSizes;
+  for (auto [level, cacheSize] : llvm::enumerate(options.cacheSizes)) {
+    auto budget = static_cast<int64_t>(cacheSize * options.cacheUtilization);
+    bool outermost = level == numLevels - 1;
+    levelTileSizes.push_back(computeCacheTileSizes(
+        op, budget,
+        level == 0 ? ArrayRef<int64_t>() : ArrayRef(levelTileSizes.back()),
+        /*tileReductions=*/!(outermost && fuse)));
+  }
+
+  // Tile from the outermost level inwards, each level tiling the tiled op of
+  // the previous one. A tile size that covers its whole range is not tiled.
+  CacheTilingResult result;
+  result.tiledOp = op;
+  SmallVector<int64_t> ranges = op.getStaticLoopRanges();
+  for (int level = numLevels - 1; level >= 0; --level) {
+    ArrayRef<int64_t> tileSizes = levelTileSizes[level];
+    SmallVector<int64_t> sizes;
+    for (auto [size, range] : llvm::zip_equal(tileSizes, ranges)) {
+      bool coversRange = !ShapedType::isDynamic(range) && size >= range;
+      sizes.push_back(coversRange ? 0 : size);
+    }
+    ranges.assign(tileSizes.begin(), tileSizes.end());
+    if (llvm::all_of(sizes, [](int64_t size) { return size == 0; }))
+      continue;
+
+    scf::SCFTilingOptions tilingOptions;
+    tilingOptions.setTileSizes(
+        getAsIndexOpFoldResult(rewriter.getContext(), sizes));
+    auto target = cast<TilingInterface>(result.tiledOp);
+    rewriter.setInsertionPoint(target);
+    if (fuse && level == static_cast<int>(numLevels) - 1) {
+      scf::SCFTileAndFuseOptions tileAndFuseOptions;
+      tileAndFuseOptions.setTilingOptions(tilingOptions);
+      FailureOr<scf::SCFTileAndFuseResult> tiled =
+          scf::tileConsumerAndFuseProducersUsingSCF(rewriter, target,
+                                                    tileAndFuseOptions);
+      if (failed(tiled))
+        return failure();
+      SmallVector<Operation *> opsToReplace{target};
+      llvm::append_range(opsToReplace, tiled->fusedProducers);
+      for (Operation *toReplace : opsToReplace) {
+        for (OpResult res : toReplace->getResults())
+          if (Value replacement = tiled->replacements.lookup(res))
+            rewriter.replaceAllUsesWith(res, replacement);
+        if (toReplace->use_empty())
+          rewriter.eraseOp(toReplace);
+      }
+      result.tiledOp = tiled->tiledAndFusedOps.front();
+      llvm::append_range(result.loops, tiled->loops);
+      continue;
+    }
+
+    FailureOr<scf::SCFTilingResult> tiled =
+        scf::tileUsingSCF(rewriter, target, tilingOptions);
+    if (failed(tiled))
+      return failure();
+    rewriter.replaceOp(target, tiled->replacements);
+    result.tiledOp = tiled->tiledOps.back();
+    llvm::append_range(result.loops, tiled->loops);
+  }
+  return result;
+}
@@ -313,19 +313,21 @@ struct SparseVectorizationPass
     : public impl::SparseVectorizationBase<SparseVectorizationPass> {
   SparseVectorizationPass() = default;
   SparseVectorizationPass(const SparseVectorizationPass &pass) = default;
-  SparseVectorizationPass(unsigned vl, bool vla, bool sidx32) {
+  SparseVectorizationPass(unsigned vl, bool vla, bool sidx32, unsigned vbits) {
     vectorLength = vl;
     enableVLAVectorization = vla;
     enableSIMDIndex32 = sidx32;
+    vectorBits = vbits;
   }
 
   void runOnOperation() override {
-    if (vectorLength == 0)
+    if (vectorLength == 0 && vectorBits == 0)
       return signalPassFailure();
     auto *ctx = &getContext();
     RewritePatternSet patterns(ctx);
-    populateSparseVectorizationPatterns(
-        patterns, vectorLength, enableVLAVectorization, enableSIMDIndex32);
+    populateSparseVectorizationPatterns(patterns, vectorLength,
+                                        enableVLAVectorization,
+                                        enableSIMDIndex32, vectorBits);
     vector::populateVectorToVectorCanonicalizationPatterns(patterns);
     (void)applyPatternsAndFoldGreedily(getOperation(), std::move(patterns));
   }
@@ -470,9 +472,10 @@ std::unique_ptr<Pass> mlir::createSparseVectorizationPass() {
 std::unique_ptr<Pass>
 mlir::createSparseVectorizationPass(unsigned vectorLength,
                                     bool enableVLAVectorization,
-                                    bool enableSIMDIndex32) {
+                                    bool enableSIMDIndex32,
+                                    unsigned vectorBits) {
   return std::make_unique<SparseVectorizationPass>(
-      vectorLength, enableVLAVectorization, enableSIMDIndex32);
+      vectorLength, enableVLAVectorization, enableSIMDIndex32, vectorBits);
 }
 
 std::unique_ptr<Pass> mlir::createSparseGPUCodegenPass() {
@@ -609,15 +609,39 @@ static bool vectorizeStmt(PatternRewriter &rewriter, scf::ForOp forOp, VL vl,
   return false;
 }
 
+/// Returns the bitwidth of the widest scalar loaded, stored or reduced by the
+/// given for-loop, or 0 if there are none. Indices count as 64-bit, or 32-bit
+/// when i32 indexing into vectors is enabled.
+static unsigned getWidestElementBitWidth(scf::ForOp forOp, VL vl) {
+  unsigned widest = 0;
+  auto update = [&](Type etp) {
+    if (etp.isIndex())
+      widest = std::max(widest, vl.enableSIMDIndex32 ? 32u : 64u);
+    else if (etp.isIntOrFloat())
+      widest = std::max(widest, etp.getIntOrFloatBitWidth());
+  };
+  for (Value init : forOp.getInitArgs())
+    update(init.getType());
+  forOp.getBody()->walk([&](Operation *op) {
+    if (auto load = dyn_cast<memref::LoadOp>(op))
+      update(load.getType());
+    else if (auto store = dyn_cast<memref::StoreOp>(op))
+      update(store.getValue().getType());
+  });
+  return widest;
+}
+
 /// Basic for-loop vectorizer.
 struct ForOpRewriter : public OpRewritePattern<scf::ForOp> {
 public:
   using OpRewritePattern<scf::ForOp>::OpRewritePattern;
 
   ForOpRewriter(MLIRContext *context, unsigned vectorLength,
-                bool enableVLAVectorization, bool enableSIMDIndex32)
+                bool enableVLAVectorization, bool enableSIMDIndex32,
+                unsigned vectorBits)
       : OpRewritePattern(context), vl{vectorLength, enableVLAVectorization,
-                                      enableSIMDIndex32} {}
+                                      enableSIMDIndex32},
+        vectorBits(vectorBits) {}
 
   LogicalResult matchAndRewrite(scf::ForOp op,
                                 PatternRewriter &rewriter) const override {
@@ -627,15 +651,27 @@ public:
     if (!op.getRegion().hasOneBlock() || !isConstantIntValue(op.getStep(), 1) ||
         !op->hasAttr(LoopEmitter::getLoopEmitterLoopAttrName()))
       return failure();
+    // Pick the vector length that fills the vector registers with the widest
+    // elements of the loop, if requested.
+    VL loopVL = vl;
+    if (vectorBits > 0) {
+      unsigned widest = getWidestElementBitWidth(op, vl);
+      if (widest == 0)
+        return failure();
+      loopVL.vectorLength = std::max(1u, vectorBits / widest);
+    }
     // Analyze (!codegen) and rewrite (codegen) loop-body.
-    if (vectorizeStmt(rewriter, op, vl, /*codegen=*/false) &&
-        vectorizeStmt(rewriter, op, vl, /*codegen=*/true))
+    if (vectorizeStmt(rewriter, op, loopVL, /*codegen=*/false) &&
+        vectorizeStmt(rewriter, op, loopVL, /*codegen=*/true))
       return success();
     return failure();
   }
 
 private:
   const VL vl;
+  /// The width of the vector registers, in bits, or 0 to always use the
+  /// vector length of `vl`.
+  const unsigned vectorBits;
 };
 
 /// Reduction chain cleanup.
@@ -673,10 +709,12 @@ public:
 void mlir::populateSparseVectorizationPatterns(RewritePatternSet &patterns,
                                                unsigned vectorLength,
                                                bool enableVLAVectorization,
-                                               bool enableSIMDIndex32) {
-  assert(vectorLength > 0);
+                                               bool enableSIMDIndex32,
+                                               unsigned vectorBits) {
+  assert((vectorLength > 0 || vectorBits > 0) && "vectorization disabled");
   patterns.add<ForOpRewriter>(patterns.getContext(), vectorLength,
-                              enableVLAVectorization, enableSIMDIndex32);
+                              enableVLAVectorization, enableSIMDIndex32,
+                              vectorBits);
   patterns.add<ReducChainRewriter<vector::InsertElementOp>,
                ReducChainRewriter<vector::BroadcastOp>>(patterns.getContext());
 }
@@ -66,7 +66,8 @@ public:
       const SparsificationOptions &sparsificationOptions,
       bool createSparseDeallocs, bool enableRuntimeLibrary,
       bool enableBufferInitialization, unsigned vectorLength,
-      bool enableVLAVectorization, bool enableSIMDIndex32, bool enableGPULibgen)
+      bool enableVLAVectorization, bool enableSIMDIndex32, bool enableGPULibgen,
+      unsigned vectorBits)
       : bufferizationOptions(bufferizationOptions),
         sparsificationOptions(sparsificationOptions),
         createSparseDeallocs(createSparseDeallocs),
@@ -74,8 +75,8 @@ public:
         enableBufferInitialization(enableBufferInitialization),
         vectorLength(vectorLength),
         enableVLAVectorization(enableVLAVectorization),
-        enableSIMDIndex32(enableSIMDIndex32), enableGPULibgen(enableGPULibgen) {
-  }
+        enableSIMDIndex32(enableSIMDIndex32), enableGPULibgen(enableGPULibgen),
+        vectorBits(vectorBits) {}
 
   /// Bufferize all dense ops. This assumes that no further analysis is needed
   /// and that all required buffer copies were already inserted by
@@ -152,9 +153,10 @@ public:
           createSparseReinterpretMapPass(ReinterpretMapScope::kExceptGeneric));
       pm.addNestedPass<func::FuncOp>(createLowerForeachToSCFPass());
       pm.addPass(mlir::createLoopInvariantCodeMotionPass());
-      if (vectorLength > 0) {
+      if (vectorLength > 0 || vectorBits > 0) {
         pm.addPass(createSparseVectorizationPass(
-            vectorLength, enableVLAVectorization, enableSIMDIndex32));
+            vectorLength, enableVLAVectorization, enableSIMDIndex32,
+            vectorBits));
       }
       if (enableRuntimeLibrary) {
         pm.addPass(createSparseTensorConversionPass());
@@ -182,6 +184,7 @@ private:
   bool enableVLAVectorization;
   bool enableSIMDIndex32;
   bool enableGPULibgen;
+  unsigned vectorBits;
 };
 
 } // namespace sparse_tensor
@@ -230,10 +233,11 @@ std::unique_ptr<mlir::Pass> mlir::createSparsificationAndBufferizationPass(
     const SparsificationOptions &sparsificationOptions,
     bool createSparseDeallocs, bool enableRuntimeLibrary,
     bool enableBufferInitialization, unsigned vectorLength,
-    bool enableVLAVectorization, bool enableSIMDIndex32, bool enableGPULibgen) {
+    bool enableVLAVectorization, bool enableSIMDIndex32, bool enableGPULibgen,
+    unsigned vectorBits) {
   return std::make_unique<
       mlir::sparse_tensor::SparsificationAndBufferizationPass>(
       bufferizationOptions, sparsificationOptions, createSparseDeallocs,
       enableRuntimeLibrary, enableBufferInitialization, vectorLength,
-      enableVLAVectorization, enableSIMDIndex32, enableGPULibgen);
+      enableVLAVectorization, enableSIMDIndex32, enableGPULibgen, vectorBits);
 }
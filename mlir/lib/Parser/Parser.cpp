@@ -13,6 +13,7 @@
 #include "mlir/Parser/Parser.h"
 #include "mlir/AsmParser/AsmParser.h"
 #include "mlir/Bytecode/BytecodeReader.h"
+#include "mlir/Support/FileUtilities.h"
 #include "llvm/Support/SourceMgr.h"
 
 using namespace mlir;
@@ -61,13 +62,15 @@ static LogicalResult loadSourceFileBuffer(llvm::StringRef filename,
     return emitError(mlir::UnknownLoc::get(ctx),
                      "only main buffer parsed at the moment");
   }
-  auto fileOrErr = llvm::MemoryBuffer::getFileOrSTDIN(filename);
-  if (fileOrErr.getError())
+  // Bytecode files are mapped without a null terminator, which allows their
+  // resources to be referenced in place when the source manager is shared.
+  std::unique_ptr<llvm::MemoryBuffer> file = openInputFile(filename);
+  if (!file)
     return emitError(mlir::UnknownLoc::get(ctx),
                      "could not open input file " + filename);
 
   // Load the MLIR source file.
-  sourceMgr.AddNewSourceBuffer(std::move(*fileOrErr), SMLoc());
+  sourceMgr.AddNewSourceBuffer(std::move(file), SMLoc());
   return success();
 }
 
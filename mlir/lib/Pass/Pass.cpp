@@ -529,8 +529,14 @@ LogicalResult OpToOpPassAdaptor::run(Pass *pass, Operation *op,
       },
       {op}, *pass);
 
-  // Invalidate any non preserved analyses.
-  am.invalidate(pass->passState->preservedAnalyses);
+  // Invalidate any non preserved analyses. The pipelines run by an adaptor
+  // have already invalidated the analyses of the operations they ran on, pass
+  // by pass, and can't have changed other nested operations, so the analyses
+  // those passes preserved are kept.
+  if (isa<OpToOpPassAdaptor>(pass))
+    am.invalidateNonNested(pass->passState->preservedAnalyses);
+  else
+    am.invalidate(pass->passState->preservedAnalyses);
 
   // When verifyPasses is specified, we run the verifier (unless the pass
   // failed).
@@ -900,6 +906,29 @@ void PassManager::addInstrumentation(std::unique_ptr<PassInstrumentation> pi) {
   instrumentor->addInstrumentation(std::move(pi));
 }
 
+namespace {
+/// An instrumentation that materializes operations before passes run on them.
+struct OpMaterializerInstrumentation : public PassInstrumentation {
+  OpMaterializerInstrumentation(std::function<void(Operation *)> materialize)
+      : materialize(std::move(materialize)) {}
+
+  void runBeforePass(Pass *pass, Operation *op) override {
+    // Adaptors only dispatch to the nested pipelines, which materialize the
+    // operations they run on.
+    if (!isa<OpToOpPassAdaptor>(pass))
+      materialize(op);
+  }
+
+  std::function<void(Operation *)> materialize;
+};
+} // namespace
+
+void PassManager::enableOpMaterialization(
+    std::function<void(Operation *)> materialize) {
+  addInstrumentation(
+      std::make_unique<OpMaterializerInstrumentation>(std::move(materialize)));
+}
+
 LogicalResult PassManager::runPasses(Operation *op, AnalysisManager am) {
   return OpToOpPassAdaptor::runPipeline(*this, op, am, verifyPasses,
                                         impl->initializationGeneration);
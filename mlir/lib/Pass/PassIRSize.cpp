@@ -0,0 +1,166 @@
+//===- PassIRSize.cpp - IR size tracking for passes -----------------------===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+#include "PassDetail.h"
+#include "mlir/IR/MLIRContext.h"
+#include "mlir/Pass/PassManager.h"
+#include "llvm/ADT/DenseMap.h"
+#include "llvm/ADT/StringMap.h"
+#include "llvm/Support/JSON.h"
+#include "llvm/Support/Process.h"
+
+#include <mutex>
+
+using namespace mlir;
+using namespace mlir::detail;
+
+//===----------------------------------------------------------------------===//
+// PassIRSizeTracking
+//===----------------------------------------------------------------------===//
+
+namespace {
+/// The size of the IR and of the context at one point in time.
+struct IRSizeSnapshot {
+  IRSizeSnapshot() = default;
+  IRSizeSnapshot(Operation *op) {
+    op->walk([&](Operation *nested) {
+      ++numOpsPerDialect[nested->getName().getDialectNamespace()];
+    });
+    MLIRContext *ctx = op->getContext();
+    numAttributes =
+        ctx->getAttributeUniquer().getNumParametricStorageInstances();
+    numTypes = ctx->getTypeUniquer().getNumParametricStorageInstances();
+    heapBytes = llvm::sys::Process::GetMallocUsage();
+  }
+
+  llvm::StringMap<uint64_t> numOpsPerDialect;
+  size_t numAttributes = 0;
+  size_t numTypes = 0;
+  size_t heapBytes = 0;
+};
+
+/// The measurements accumulated over all runs of a pass.
+struct PassIRSizeRecord {
+  std::string passName;
+  uint64_t numRuns = 0;
+  llvm::StringMap<uint64_t> numOpsBefore, numOpsAfter;
+  uint64_t numAttributesCreated = 0;
+  uint64_t numTypesCreated = 0;
+  int64_t heapBytesDelta = 0;
+  size_t maxHeapBytes = 0;
+};
+
+struct PassIRSizeTracking : public PassInstrumentation {
+  PassIRSizeTracking(std::unique_ptr<raw_ostream> os)
+      : ownedOS(std::move(os)) {}
+  ~PassIRSizeTracking() override { print(ownedOS ? *ownedOS : llvm::errs()); }
+
+  void runBeforePass(Pass *pass, Operation *op) override {
+    // Adaptors are only containers of the passes that do the work.
+    if (isa<OpToOpPassAdaptor>(pass))
+      return;
+    IRSizeSnapshot snapshot(op);
+    std::lock_guard<std::mutex> lock(mutex);
+    activeRuns.try_emplace({pass, op}, std::move(snapshot));
+  }
+  void runAfterPass(Pass *pass, Operation *op) override {
+    if (isa<OpToOpPassAdaptor>(pass))
+      return;
+    IRSizeSnapshot after(op);
+    std::lock_guard<std::mutex> lock(mutex);
+    auto it = activeRuns.find({pass, op});
+    if (it == activeRuns.end())
+      return;
+    record(pass, it->second, after);
+    activeRuns.erase(it);
+  }
+  void runAfterPassFailed(Pass *pass, Operation *op) override {
+    std::lock_guard<std::mutex> lock(mutex);
+    activeRuns.erase({pass, op});
+  }
+
+private:
+  /// Accumulate the difference between the given snapshots into the record of
+  /// `pass`. Threading siblings share a record.
+  void record(Pass *pass, const IRSizeSnapshot &before,
+              const IRSizeSnapshot &after) {
+    auto [it, inserted] =
+        recordIndices.try_emplace(pass->getThreadingSiblingOrThis(),
+                                  records.size());
+    if (inserted) {
+      records.emplace_back();
+      records.back().passName = pass->getName().str();
+    }
+    PassIRSizeRecord &rec = records[it->second];
+    ++rec.numRuns;
+    for (const auto &entry : before.numOpsPerDialect)
+      rec.numOpsBefore[entry.getKey()] += entry.getValue();
+    for (const auto &entry : after.numOpsPerDialect)
+      rec.numOpsAfter[entry.getKey()] += entry.getValue();
+    rec.numAttributesCreated += after.numAttributes - before.numAttributes;
+    rec.numTypesCreated += after.numTypes - before.numTypes;
+    rec.heapBytesDelta += static_cast<int64_t>(after.heapBytes) -
+                          static_cast<int64_t>(before.heapBytes);
+    rec.maxHeapBytes = std::max(rec.maxHeapBytes, after.heapBytes);
+  }
+
+  /// Print the collected records as JSON, in the order passes first finished.
+  void print(raw_ostream &os) {
+    auto printOpCounts = [](llvm::json::OStream &j, StringRef key,
+                            const llvm::StringMap<uint64_t> &counts) {
+      SmallVector<StringRef> dialects;
+      for (const auto &entry : counts)
+        dialects.push_back(entry.getKey());
+      llvm::sort(dialects);
+      j.attributeObject(key, [&] {
+        for (StringRef dialect : dialects)
+          j.attribute(dialect, counts.lookup(dialect));
+      });
+    };
+
+    llvm::json::OStream j(os, /*IndentSize=*/2);
+    j.object([&] {
+      j.attributeArray("passes", [&] {
+        for (const PassIRSizeRecord &rec : records) {
+          j.object([&] {
+            j.attribute("pass", rec.passName);
+            j.attribute("runs", rec.numRuns);
+            printOpCounts(j, "opsBefore", rec.numOpsBefore);
+            printOpCounts(j, "opsAfter", rec.numOpsAfter);
+            j.attribute("attributesCreated", rec.numAttributesCreated);
+            j.attribute("typesCreated", rec.numTypesCreated);
+            j.attribute("heapBytesDelta", rec.heapBytesDelta);
+            j.attribute("maxHeapBytes",
+                        static_cast<uint64_t>(rec.maxHeapBytes));
+          });
+        }
+      });
+    });
+    os << "\n";
+    os.flush();
+  }
+
+  /// The stream to print to, or null to print to stderr.
+  std::unique_ptr<raw_ostream> ownedOS;
+
+  /// A mutex guarding the state below, as passes may run concurrently.
+  std::mutex mutex;
+
+  /// The snapshots taken before the passes that are currently running.
+  DenseMap<std::pair<Pass *, Operation *>, IRSizeSnapshot> activeRuns;
+
+  /// The records of all passes that ran, and the index of the record of each
+  /// pass.
+  std::vector<PassIRSizeRecord> records;
+  DenseMap<const Pass *, size_t> recordIndices;
+};
+} // namespace
+
+void PassManager::enableIRSizeTracking(std::unique_ptr<raw_ostream> os) {
+  addInstrumentation(std::make_unique<PassIRSizeTracking>(std::move(os)));
+}
@@ -12,6 +12,7 @@
 #include "mlir/Support/Timing.h"
 #include "llvm/Support/CommandLine.h"
 #include "llvm/Support/ManagedStatic.h"
+#include "llvm/Support/raw_ostream.h"
 
 using namespace mlir;
 
@@ -82,6 +83,19 @@ struct PassManagerOptions {
               "display the results in a merged list sorted by pass name"),
           clEnumValN(PassDisplayMode::Pipeline, "pipeline",
                      "display the results with a nested pipeline view"))};
+
+  //===--------------------------------------------------------------------===//
+  // Pass IR Size Tracking
+  //===--------------------------------------------------------------------===//
+  llvm::cl::opt<bool> passIRSize{
+      "mlir-pass-ir-size",
+      llvm::cl::desc("Report the op counts, context growth and heap usage of "
+                     "each pass as JSON")};
+  llvm::cl::opt<std::string> passIRSizeFile{
+      "mlir-pass-ir-size-file",
+      llvm::cl::desc("File to write the pass IR size report to ('-' for "
+                     "stderr)"),
+      llvm::cl::init("-")};
 };
 } // namespace
 
@@ -154,6 +168,22 @@ LogicalResult mlir::applyPassManagerCLOptions(PassManager &pm) {
   if (options->passStatistics)
     pm.enableStatistics(options->passStatisticsDisplayMode);
 
+  // Enable IR size tracking.
+  if (options->passIRSize) {
+    std::unique_ptr<raw_ostream> os;
+    if (options->passIRSizeFile != "-") {
+      std::error_code ec;
+      os = std::make_unique<llvm::raw_fd_ostream>(options->passIRSizeFile, ec);
+      if (ec) {
+        emitError(UnknownLoc::get(pm.getContext()))
+            << "could not open pass IR size file '" << options->passIRSizeFile
+            << "': " << ec.message();
+        return failure();
+      }
+    }
+    pm.enableIRSizeTracking(std::move(os));
+  }
+
   if (options->printModuleScope && pm.getContext()->isMultithreadingEnabled()) {
     emitError(UnknownLoc::get(pm.getContext()))
         << "IR print for module scope can't be setup on a pass-manager "
@@ -15,15 +15,25 @@
 #include "llvm/Support/Alignment.h"
 #include "llvm/Support/FileUtilities.h"
 #include "llvm/Support/MemoryBuffer.h"
+#include "llvm/Support/Process.h"
 #include "llvm/Support/ToolOutputFile.h"
 
 using namespace mlir;
 
+/// Returns true if `buffer` starts with the magic number of MLIR bytecode (see
+/// `mlir::isBytecode`).
+static bool isBytecodeBuffer(const llvm::MemoryBuffer &buffer) {
+  return buffer.getBuffer().starts_with("ML\xefR");
+}
+
 static std::unique_ptr<llvm::MemoryBuffer>
 openInputFileImpl(StringRef inputFilename, std::string *errorMessage,
                   std::optional<llvm::Align> alignment) {
+  // Don't require a null terminator, so that large files are always memory
+  // mapped and the resource blobs of bytecode files can be used in place, at
+  // any alignment up to the page size, instead of being read to the heap.
   auto fileOrErr = llvm::MemoryBuffer::getFileOrSTDIN(
-      inputFilename, /*IsText=*/false, /*RequiresNullTerminator=*/true,
+      inputFilename, /*IsText=*/false, /*RequiresNullTerminator=*/false,
       alignment);
   if (std::error_code error = fileOrErr.getError()) {
     if (errorMessage)
@@ -31,8 +41,27 @@ openInputFileImpl(StringRef inputFilename, std::string *errorMessage,
                       "': " + error.message();
     return nullptr;
   }
+  std::unique_ptr<llvm::MemoryBuffer> file = std::move(*fileOrErr);
 
-  return std::move(*fileOrErr);
+  // Only the textual format needs the null terminator. Heap buffers always
+  // have one, and a mapped file that does not end on a page boundary is
+  // followed by the zeroes that fill its last page. Only a mapped text file
+  // whose size is a multiple of the page size has to be copied.
+  if (file->getBufferKind() != llvm::MemoryBuffer::MemoryBuffer_MMap ||
+      isBytecodeBuffer(*file) ||
+      file->getBufferSize() % llvm::sys::Process::getPageSizeEstimate() != 0)
+    return file;
+  std::unique_ptr<llvm::WritableMemoryBuffer> copy =
+      llvm::WritableMemoryBuffer::getNewUninitMemBuffer(
+          file->getBufferSize(), file->getBufferIdentifier(), alignment);
+  if (!copy) {
+    if (errorMessage)
+      *errorMessage = "cannot open input file '" + inputFilename.str() +
+                      "': not enough memory";
+    return nullptr;
+  }
+  llvm::copy(file->getBuffer(), copy->getBufferStart());
+  return copy;
 }
 std::unique_ptr<llvm::MemoryBuffer>
 mlir::openInputFile(StringRef inputFilename, std::string *errorMessage) {
@@ -11,7 +11,11 @@
 #include "mlir/Support/LLVM.h"
 #include "mlir/Support/ThreadLocalCache.h"
 #include "mlir/Support/TypeID.h"
+#include "llvm/Support/MathExtras.h"
 #include "llvm/Support/RWMutex.h"
+#include "llvm/Support/Threading.h"
+#include <algorithm>
+#include <atomic>
 
 using namespace mlir;
 using namespace mlir::detail;
@@ -77,8 +81,9 @@ private:
 
   /// This class represents a single shard of the uniquer. The uniquer uses a
   /// set of shards to allow for multiple threads to create instances with less
-  /// lock contention.
-  struct Shard {
+  /// lock contention. Shards are cache line aligned so that threads using
+  /// different shards don't contend on the lock state.
+  struct alignas(64) Shard {
     /// The set containing the allocated storage instances.
     StorageTypeSet instances;
 
@@ -113,7 +118,7 @@ public:
   /// use. The provided shard number is required to be a valid power of 2. The
   /// destructor function is used to destroy any allocated storage instances.
   ParametricStorageUniquer(function_ref<void(BaseStorage *)> destructorFn,
-                           size_t numShards = 8)
+                           size_t numShards = getDefaultNumShards())
       : shards(new std::atomic<Shard *>[numShards]), numShards(numShards),
         destructorFn(destructorFn) {
     assert(llvm::isPowerOf2_64(numShards) &&
@@ -175,10 +180,21 @@ public:
   }
 
 private:
+  /// Return the default number of shards: enough for the threads of the host
+  /// to rarely share one. Shards are allocated on first use, so unused ones
+  /// only cost a pointer.
+  static size_t getDefaultNumShards() {
+    static const size_t numShards = llvm::PowerOf2Ceil(std::clamp<unsigned>(
+        2 * llvm::hardware_concurrency().compute_thread_count(), 8, 256));
+    return numShards;
+  }
+
   /// Return the shard used for the given hash value.
   Shard &getShard(unsigned hashValue) {
-    // Get a shard number from the provided hashvalue.
-    unsigned shardNum = hashValue & (numShards - 1);
+    // Get a shard number from the high bits of the provided hashvalue. The
+    // low bits select the buckets of the instance sets, which would otherwise
+    // only use a fraction of their buckets.
+    unsigned shardNum = (uint64_t(hashValue) * numShards) >> 32;
 
     // Try to acquire an already initialized shard.
     Shard *shard = shards[shardNum].load(std::memory_order_acquire);
@@ -268,8 +284,10 @@ struct StorageUniquerImpl {
            "creating unregistered storage instance");
     ParametricStorageUniquer &storageUniquer = *parametricUniquers[id];
     return storageUniquer.getOrCreate(
-        threadingIsEnabled, hashValue, isEqual,
-        [&] { return ctorFn(getThreadSafeAllocator()); });
+        threadingIsEnabled, hashValue, isEqual, [&] {
+          numParametricInstances.fetch_add(1, std::memory_order_relaxed);
+          return ctorFn(getThreadSafeAllocator());
+        });
   }
 
   /// Run a mutation function on the provided storage object in a thread-safe
@@ -352,6 +370,9 @@ struct StorageUniquerImpl {
   /// singleton.
   DenseMap<TypeID, BaseStorage *> singletonInstances;
 
+  /// The number of parametric storage instances created so far.
+  std::atomic<size_t> numParametricInstances = 0;
+
   /// Flag specifying if multi-threading is enabled within the uniquer.
   bool threadingIsEnabled = true;
 };
@@ -366,6 +387,10 @@ void StorageUniquer::disableMultithreading(bool disable) {
   impl->threadingIsEnabled = !disable;
 }
 
+size_t StorageUniquer::getNumParametricStorageInstances() const {
+  return impl->numParametricInstances.load(std::memory_order_relaxed);
+}
+
 /// Implementation for getting/creating an instance of a derived type with
 /// parametric storage.
 auto StorageUniquer::getParametricStorageTypeImpl(
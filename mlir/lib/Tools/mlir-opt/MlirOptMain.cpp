@@ -12,6 +12,7 @@
 //===----------------------------------------------------------------------===//
 
 #include "mlir/Tools/mlir-opt/MlirOptMain.h"
+#include "mlir/Bytecode/BytecodeReader.h"
 #include "mlir/Bytecode/BytecodeWriter.h"
 #include "mlir/Debug/CLOptionsSetup.h"
 #include "mlir/Debug/Counter.h"
@@ -27,6 +28,7 @@
 #include "mlir/IR/Dialect.h"
 #include "mlir/IR/Location.h"
 #include "mlir/IR/MLIRContext.h"
+#include "mlir/IR/Verifier.h"
 #include "mlir/Parser/Parser.h"
 #include "mlir/Pass/Pass.h"
 #include "mlir/Pass/PassManager.h"
@@ -37,6 +39,7 @@
 #include "mlir/Tools/ParseUtilities.h"
 #include "mlir/Tools/Plugins/DialectPlugin.h"
 #include "mlir/Tools/Plugins/PassPlugin.h"
+#include "llvm/ADT/ScopeExit.h"
 #include "llvm/ADT/StringRef.h"
 #include "llvm/Support/CommandLine.h"
 #include "llvm/Support/FileUtilities.h"
@@ -48,6 +51,8 @@
 #include "llvm/Support/StringSaver.h"
 #include "llvm/Support/ThreadPool.h"
 #include "llvm/Support/ToolOutputFile.h"
+#include <atomic>
+#include <mutex>
 
 using namespace mlir;
 using namespace llvm;
@@ -103,6 +108,12 @@ struct MlirOptMainConfigCLOptions : public MlirOptMainConfig {
             cl::desc("Use specified bytecode when generating output"),
             cl::location(emitBytecodeVersion), cl::init(std::nullopt));
 
+    static cl::opt<bool, /*ExternalStorage=*/true> lazyLoadBytecode(
+        "lazy-load-bytecode",
+        cl::desc("Materialize the isolated operations of a bytecode input "
+                 "only when a pass runs on them"),
+        cl::location(lazyLoadBytecodeFlag), cl::init(false));
+
     static cl::opt<std::string, /*ExternalStorage=*/true> irdlFile(
         "irdl-file",
         cl::desc("IRDL file to register before processing the input"),
@@ -349,6 +360,53 @@ static LogicalResult doVerifyRoundTrip(Operation *op,
   return success(succeeded(txtStatus) && succeeded(bcStatus));
 }
 
+/// Read the bytecode in `buffer` with `reader`, leaving the regions of isolated
+/// operations to be materialized later, into a top-level operation as
+/// parseSourceFileForTool does.
+static OwningOpRef<Operation *>
+readLazyBytecode(BytecodeReader &reader, llvm::MemoryBufferRef buffer,
+                 MLIRContext *context, bool insertImplicitModule) {
+  Location loc = FileLineColLoc::get(context, buffer.getBufferIdentifier(),
+                                     /*line=*/0, /*column=*/0);
+  Block block;
+  if (failed(reader.readTopLevel(&block)))
+    return nullptr;
+  if (insertImplicitModule)
+    return detail::constructContainerOpForParserIfNecessary<ModuleOp>(
+        &block, context, loc);
+  if (!llvm::hasSingleElement(block)) {
+    emitError(loc)
+        << "source must contain a single top-level operation, found: "
+        << block.getOperations().size();
+    return nullptr;
+  }
+  Operation *op = &block.front();
+  op->remove();
+  return op;
+}
+
+/// Materialize `op` and all the operations nested under it that `reader` has
+/// not loaded yet.
+static LogicalResult materializeNested(BytecodeReader &reader, Operation *op,
+                                       const ParserConfig &parseConfig) {
+  bool materialized = false;
+  // Materializing an operation exposes the lazy operations in its body, which
+  // a pre-order walk visits next.
+  WalkResult result = op->walk<WalkOrder::PreOrder>([&](Operation *nested) {
+    if (!reader.isMaterializable(nested))
+      return WalkResult::advance();
+    materialized = true;
+    if (failed(reader.materialize(nested)))
+      return WalkResult::interrupt();
+    return WalkResult::advance();
+  });
+  if (result.wasInterrupted())
+    return failure();
+  if (materialized && parseConfig.shouldVerifyAfterParse())
+    return verify(op);
+  return success();
+}
+
 /// Perform the actions on the input file indicated by the command line flags
 /// within the specified context.
 ///
@@ -379,18 +437,40 @@ performActions(raw_ostream &os,
   if (config.shouldRunReproducer())
     reproOptions.attachResourceParser(parseConfig);
 
-  // Parse the input file and reset the context threading state.
+  // Parse the input file and reset the context threading state. Bytecode may
+  // be read lazily, in which case the bodies of isolated operations are only
+  // loaded once a pass is about to run on them.
   TimingScope parserTiming = timing.nest("Parser");
-  OwningOpRef<Operation *> op = parseSourceFileForTool(
-      sourceMgr, parseConfig, !config.shouldUseExplicitModule());
+  llvm::MemoryBufferRef inputBuffer =
+      *sourceMgr->getMemoryBuffer(sourceMgr->getMainFileID());
+  std::unique_ptr<BytecodeReader> lazyReader;
+  OwningOpRef<Operation *> op;
+  if (config.shouldLazyLoadBytecode() && isBytecode(inputBuffer)) {
+    lazyReader = std::make_unique<BytecodeReader>(
+        inputBuffer, parseConfig, /*lazyLoad=*/true, sourceMgr);
+    op = readLazyBytecode(*lazyReader, inputBuffer, context,
+                          !config.shouldUseExplicitModule());
+  } else {
+    op = parseSourceFileForTool(sourceMgr, parseConfig,
+                                !config.shouldUseExplicitModule());
+  }
+  // The reader must not be left with pending operations; the ones that are
+  // still lazy when bailing out are dropped before the IR is destroyed.
+  auto dropLazyOps = llvm::make_scope_exit([&] {
+    if (lazyReader)
+      (void)lazyReader->finalize([](Operation *) { return false; });
+  });
   parserTiming.stop();
   if (!op)
     return failure();
 
   // Perform round-trip verification if requested
-  if (config.shouldVerifyRoundtrip() &&
-      failed(doVerifyRoundTrip(op.get(), config)))
-    return failure();
+  if (config.shouldVerifyRoundtrip()) {
+    if (lazyReader && failed(lazyReader->finalize()))
+      return failure();
+    if (failed(doVerifyRoundTrip(op.get(), config)))
+      return failure();
+  }
 
   context->enableMultithreading(wasThreadingEnabled);
 
@@ -405,8 +485,27 @@ performActions(raw_ostream &os,
   if (failed(config.setupPassPipeline(pm)))
     return failure();
 
+  // Materialize lazily loaded operations right before the passes that run on
+  // them. Passes other than the nested pipeline adaptors see the whole IR
+  // under the operation they run on, so they never erase operations that are
+  // still pending in the reader. The reader itself isn't thread-safe.
+  std::mutex lazyReaderMutex;
+  std::atomic<bool> materializationFailed = false;
+  if (lazyReader) {
+    pm.enableOpMaterialization([&](Operation *target) {
+      std::lock_guard<std::mutex> lock(lazyReaderMutex);
+      if (lazyReader->getNumOpsToMaterialize() != 0 &&
+          failed(materializeNested(*lazyReader, target, parseConfig)))
+        materializationFailed = true;
+    });
+  }
+
   // Run the pipeline.
-  if (failed(pm.run(*op)))
+  if (failed(pm.run(*op)) || materializationFailed)
+    return failure();
+
+  // Load whatever the pipeline didn't touch before producing the output.
+  if (lazyReader && failed(lazyReader->finalize()))
     return failure();
 
   // Generate reproducers if requested
@@ -24,6 +24,31 @@ namespace mlir {
 using namespace mlir;
 
 namespace {
+#if LLVM_ENABLE_STATS
+/// A listener that counts the patterns that are tried and applied.
+struct PatternStatisticsListener : public RewriterBase::ForwardingListener {
+  PatternStatisticsListener(RewriterBase::Listener *listener,
+                            Pass::Statistic &numAttempts,
+                            Pass::Statistic &numSuccesses)
+      : ForwardingListener(listener), numAttempts(numAttempts),
+        numSuccesses(numSuccesses) {}
+
+  void notifyPatternBegin(const Pattern &pattern, Operation *op) override {
+    ++numAttempts;
+    ForwardingListener::notifyPatternBegin(pattern, op);
+  }
+  void notifyPatternEnd(const Pattern &pattern,
+                        LogicalResult status) override {
+    if (succeeded(status))
+      ++numSuccesses;
+    ForwardingListener::notifyPatternEnd(pattern, status);
+  }
+
+  Pass::Statistic &numAttempts;
+  Pass::Statistic &numSuccesses;
+};
+#endif // LLVM_ENABLE_STATS
+
 /// Canonicalize operations in nested regions.
 struct Canonicalizer : public impl::CanonicalizerBase<Canonicalizer> {
   Canonicalizer() = default;
@@ -35,6 +60,7 @@ struct Canonicalizer : public impl::CanonicalizerBase<Canonicalizer> {
     this->enableRegionSimplification = config.enableRegionSimplification;
     this->maxIterations = config.maxIterations;
     this->maxNumRewrites = config.maxNumRewrites;
+    this->changeDrivenIterations = config.changeDrivenIterations;
     this->disabledPatterns = disabledPatterns;
     this->enabledPatterns = enabledPatterns;
   }
@@ -47,6 +73,7 @@ struct Canonicalizer : public impl::CanonicalizerBase<Canonicalizer> {
     config.enableRegionSimplification = enableRegionSimplification;
     config.maxIterations = maxIterations;
     config.maxNumRewrites = maxNumRewrites;
+    config.changeDrivenIterations = changeDrivenIterations;
 
     RewritePatternSet owningPatterns(context);
     for (auto *dialect : context->getLoadedDialects())
@@ -59,8 +86,19 @@ struct Canonicalizer : public impl::CanonicalizerBase<Canonicalizer> {
     return success();
   }
   void runOnOperation() override {
+    GreedyRewriteConfig runConfig = config;
+#if LLVM_ENABLE_STATS
+    // Count the pattern applications, forwarding notifications to the
+    // listener of the config, if any. Without statistics, keep the driver's
+    // fast path for rewrites without a listener.
+    RewriterBase::Listener noListener;
+    PatternStatisticsListener statisticsListener(
+        config.listener ? config.listener : &noListener, numMatchAttempts,
+        numMatchSuccesses);
+    runConfig.listener = &statisticsListener;
+#endif // LLVM_ENABLE_STATS
     LogicalResult converged =
-        applyPatternsAndFoldGreedily(getOperation(), *patterns, config);
+        applyPatternsAndFoldGreedily(getOperation(), *patterns, runConfig);
     // Canonicalization is best-effort. Non-convergence is not a pass failure.
     if (testConvergence && failed(converged))
       signalPassFailure();
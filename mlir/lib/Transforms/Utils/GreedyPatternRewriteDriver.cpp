@@ -22,6 +22,7 @@
 #include "mlir/Transforms/RegionUtils.h"
 #include "llvm/ADT/BitVector.h"
 #include "llvm/ADT/DenseMap.h"
+#include "llvm/ADT/DenseSet.h"
 #include "llvm/ADT/ScopeExit.h"
 #include "llvm/Support/CommandLine.h"
 #include "llvm/Support/Debug.h"
@@ -354,6 +355,17 @@ protected:
   /// reached. Return `true` if any IR was changed.
   bool processWorklist();
 
+  /// Return `true` if a pattern of the pattern set may match `op`, i.e., if
+  /// the patterns must be tried when `op` is neither dead nor folded.
+  bool mayMatchPatterns(Operation *op) const {
+    return hasMatchAnyOpPatterns || patternRootOps.contains(op->getName());
+  }
+
+  /// Record that `op` was inserted or modified, so that `op`, the producers
+  /// of its operands and the users of its results are revisited by the next
+  /// iteration of a change-driven rewrite.
+  void recordChange(Operation *op);
+
   /// The pattern rewriter that is used for making IR modifications and is
   /// passed to rewrite patterns.
   PatternRewriter rewriter;
@@ -375,6 +387,10 @@ protected:
   /// `config.strictMode` is GreedyRewriteStrictness::AnyOp.
   llvm::SmallDenseSet<Operation *, 4> strictModeFilteredOps;
 
+  /// The ops to revisit in the next iteration. This set is only maintained
+  /// when `config.changeDrivenIterations` is set.
+  DenseSet<Operation *> changedOps;
+
 private:
   /// Look over the provided operands for any defining operations that should
   /// be re-added to the worklist. This function should be called when an
@@ -402,6 +418,11 @@ private:
   /// The low-level pattern applicator.
   PatternApplicator matcher;
 
+  /// The names of the ops that the patterns are rooted on, and whether some
+  /// patterns may match any op.
+  DenseSet<OperationName> patternRootOps;
+  bool hasMatchAnyOpPatterns = false;
+
 #if MLIR_ENABLE_EXPENSIVE_PATTERN_API_CHECKS
   ExpensiveChecks expensiveChecks;
 #endif // MLIR_ENABLE_EXPENSIVE_PATTERN_API_CHECKS
@@ -423,6 +444,13 @@ GreedyPatternRewriteDriver::GreedyPatternRewriteDriver(
   // Apply a simple cost model based solely on pattern benefit.
   matcher.applyDefaultCostModel();
 
+  // Index the root ops of the patterns, so that the ops that no pattern can
+  // match bypass the pattern applicator. PDL patterns are not indexed.
+  for (const auto &it : patterns.getOpSpecificNativePatterns())
+    patternRootOps.insert(it.first);
+  hasMatchAnyOpPatterns = !patterns.getMatchAnyOpNativePatterns().empty() ||
+                          patterns.getPDLByteCode();
+
   // Set up listener.
 #if MLIR_ENABLE_EXPENSIVE_PATTERN_API_CHECKS
   // Send IR notifications to the debug handler. This handler will then forward
@@ -562,6 +590,12 @@ bool GreedyPatternRewriteDriver::processWorklist() {
       }
     }
 
+    // Skip the pattern applicator if no pattern is rooted on this op.
+    if (!mayMatchPatterns(op)) {
+      LLVM_DEBUG(logResultWithLine("failure", "no patterns for operation"));
+      continue;
+    }
+
     // Try to match one of the patterns. The rewriter is automatically
     // notified of any necessary changes, so there is nothing else to do
     // here.
@@ -651,6 +685,18 @@ void GreedyPatternRewriteDriver::addToWorklist(Operation *op) {
   } while ((op = region->getParentOp()));
 }
 
+void GreedyPatternRewriteDriver::recordChange(Operation *op) {
+  if (!config.changeDrivenIterations)
+    return;
+  changedOps.insert(op);
+  for (Value operand : op->getOperands())
+    if (operand)
+      if (Operation *defOp = operand.getDefiningOp())
+        changedOps.insert(defOp);
+  for (Operation *user : op->getUsers())
+    changedOps.insert(user);
+}
+
 void GreedyPatternRewriteDriver::addSingleOpToWorklist(Operation *op) {
   if (config.strictMode == GreedyRewriteStrictness::AnyOp ||
       strictModeFilteredOps.contains(op))
@@ -678,6 +724,7 @@ void GreedyPatternRewriteDriver::notifyOperationInserted(
     config.listener->notifyOperationInserted(op, previous);
   if (config.strictMode == GreedyRewriteStrictness::ExistingAndNewOps)
     strictModeFilteredOps.insert(op);
+  recordChange(op);
   addToWorklist(op);
 }
 
@@ -688,6 +735,7 @@ void GreedyPatternRewriteDriver::notifyOperationModified(Operation *op) {
   });
   if (config.listener)
     config.listener->notifyOperationModified(op);
+  recordChange(op);
   addToWorklist(op);
 }
 
@@ -747,6 +795,14 @@ void GreedyPatternRewriteDriver::notifyOperationErased(Operation *op) {
   addOperandsToWorklist(op);
   worklist.remove(op);
 
+  if (config.changeDrivenIterations) {
+    changedOps.erase(op);
+    for (Value operand : op->getOperands())
+      if (operand)
+        if (Operation *defOp = operand.getDefiningOp())
+          changedOps.insert(defOp);
+  }
+
   if (config.strictMode != GreedyRewriteStrictness::AnyOp)
     strictModeFilteredOps.erase(op);
 }
@@ -836,6 +892,17 @@ LogicalResult RegionPatternRewriteDriver::simplify(bool *changed) && {
     // New iteration: start with an empty worklist.
     worklist.clear();
 
+    // In change-driven mode, only the ops affected by the previous iteration
+    // are revisited. Changes made while seeding the worklist are recorded for
+    // the next iteration.
+    bool seedAllOps = iteration == 1 || !config.changeDrivenIterations;
+    DenseSet<Operation *> seedOps = std::move(changedOps);
+    changedOps.clear();
+    auto seedOp = [&](Operation *op) {
+      if (seedAllOps || seedOps.contains(op))
+        addToWorklist(op);
+    };
+
     // `OperationFolder` CSE's constant ops (and may move them into parents
     // regions to enable more aggressive CSE'ing).
     OperationFolder folder(ctx, this);
@@ -853,13 +920,13 @@ LogicalResult RegionPatternRewriteDriver::simplify(bool *changed) && {
       // Add operations to the worklist in postorder.
       region.walk([&](Operation *op) {
         if (!insertKnownConstant(op))
-          addToWorklist(op);
+          seedOp(op);
       });
     } else {
       // Add all nested operations to the worklist in preorder.
       region.walk<WalkOrder::PreOrder>([&](Operation *op) {
         if (!insertKnownConstant(op)) {
-          addToWorklist(op);
+          seedOp(op);
           return WalkResult::advance();
         }
         return WalkResult::skip();
@@ -0,0 +1,77 @@
+// RUN: mlir-opt %s -split-input-file -test-linalg-cache-tiling="cache-sizes=16384 fuse-producers=false" | FileCheck %s --check-prefix=L1
+// RUN: mlir-opt %s -split-input-file -test-linalg-cache-tiling="cache-sizes=16384,65536 fuse-producers=false" | FileCheck %s --check-prefix=L2
+// RUN: mlir-opt %s -split-input-file -test-linalg-cache-tiling="cache-sizes=16384" | FileCheck %s --check-prefix=FUSE
+// RUN: mlir-opt %s -split-input-file -test-linalg-cache-tiling="fuse-producers=false" | FileCheck %s --check-prefix=DL
+
+// A 128x128x128 f32 matmul touches 4 * (m*k + k*n + m*n) bytes per tile. The
+// default 75% utilization gives budgets of 12288 bytes for 16 KiB, which
+// 32x32x32 tiles fill, and 49152 bytes for 64 KiB, which 64x64x64 tiles fill.
+
+// L1-LABEL: func @matmul(
+// L1-COUNT-3: scf.for
+// L1-NOT:     scf.for
+// L1:         linalg.matmul ins(%{{.+}}, %{{.+}} : tensor<32x32xf32>, tensor<32x32xf32>) outs(%{{.+}} : tensor<32x32xf32>) -> tensor<32x32xf32>
+
+// The outer tiles are multiples of the inner ones.
+// L2-LABEL: func @matmul(
+// L2-COUNT-3: scf.for
+// L2:         tensor.extract_slice %{{.+}} : tensor<128x128xf32> to tensor<64x64xf32>
+// L2-COUNT-3: scf.for
+// L2-NOT:     scf.for
+// L2:         linalg.matmul ins(%{{.+}}, %{{.+}} : tensor<32x32xf32>, tensor<32x32xf32>) outs(%{{.+}} : tensor<32x32xf32>) -> tensor<32x32xf32>
+
+// Without cache sizes in the options or the data layout, nothing is tiled.
+// DL-LABEL: func @matmul(
+// DL-NOT:     scf.for
+// DL:         linalg.matmul ins(%{{.+}}, %{{.+}} : tensor<128x128xf32>, tensor<128x128xf32>)
+func.func @matmul(%a: tensor<128x128xf32>, %b: tensor<128x128xf32>,
+                  %c: tensor<128x128xf32>) -> tensor<128x128xf32> {
+  %0 = linalg.matmul ins(%a, %b : tensor<128x128xf32>, tensor<128x128xf32>)
+                     outs(%c : tensor<128x128xf32>) -> tensor<128x128xf32>
+  return %0 : tensor<128x128xf32>
+}
+
+// -----
+
+// With fusion, the single level only tiles the parallel loops, so a tile
+// touches 4 * (m*128 + 128*n + m*n) bytes and 8x8 tiles fit 12288 bytes. The
+// fill of the output is fused into the tile loops.
+
+// FUSE-LABEL: func @matmul_fill(
+// FUSE-COUNT-2: scf.for
+// FUSE-NOT:     scf.for
+// FUSE:         linalg.fill ins(%{{.+}} : f32) outs(%{{.+}} : tensor<8x8xf32>) -> tensor<8x8xf32>
+// FUSE:         linalg.matmul ins(%{{.+}}, %{{.+}} : tensor<8x128xf32>, tensor<128x8xf32>) outs(%{{.+}} : tensor<8x8xf32>) -> tensor<8x8xf32>
+func.func @matmul_fill(%a: tensor<128x128xf32>, %b: tensor<128x128xf32>)
+    -> tensor<128x128xf32> {
+  %cst = arith.constant 0.0 : f32
+  %empty = tensor.empty() : tensor<128x128xf32>
+  %fill = linalg.fill ins(%cst : f32) outs(%empty : tensor<128x128xf32>)
+      -> tensor<128x128xf32>
+  %0 = linalg.matmul ins(%a, %b : tensor<128x128xf32>, tensor<128x128xf32>)
+                     outs(%fill : tensor<128x128xf32>) -> tensor<128x128xf32>
+  return %0 : tensor<128x128xf32>
+}
+
+// -----
+
+// The cache sizes are read from the data layout.
+
+// DL-LABEL: func @matmul_data_layout(
+// DL-COUNT-3: scf.for
+// DL:         tensor.extract_slice %{{.+}} : tensor<128x128xf32> to tensor<64x64xf32>
+// DL-COUNT-3: scf.for
+// DL-NOT:     scf.for
+// DL:         linalg.matmul ins(%{{.+}}, %{{.+}} : tensor<32x32xf32>, tensor<32x32xf32>) outs(%{{.+}} : tensor<32x32xf32>) -> tensor<32x32xf32>
+module attributes {dlti.dl_spec = #dlti.dl_spec<
+    #dlti.dl_entry<"l1_cache_size_in_bytes", 16384 : i64>,
+    #dlti.dl_entry<"l2_cache_size_in_bytes", 65536 : i64>>} {
+  func.func @matmul_data_layout(%a: tensor<128x128xf32>,
+                                %b: tensor<128x128xf32>,
+                                %c: tensor<128x128xf32>)
+      -> tensor<128x128xf32> {
+    %0 = linalg.matmul ins(%a, %b : tensor<128x128xf32>, tensor<128x128xf32>)
+                       outs(%c : tensor<128x128xf32>) -> tensor<128x128xf32>
+    return %0 : tensor<128x128xf32>
+  }
+}
@@ -0,0 +1,87 @@
+//===- TestLinalgCacheTiling.cpp - Test Linalg cache-aware tiling ---------===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+//
+// This file implements a pass for testing the tiling of Linalg ops for the
+// cache hierarchy of a target.
+//
+//===----------------------------------------------------------------------===//
+
+#include "mlir/Dialect/Arith/IR/Arith.h"
+#include "mlir/Dialect/Func/IR/FuncOps.h"
+#include "mlir/Dialect/Linalg/IR/Linalg.h"
+#include "mlir/Dialect/Linalg/Transforms/Transforms.h"
+#include "mlir/Dialect/SCF/IR/SCF.h"
+#include "mlir/Dialect/Tensor/IR/Tensor.h"
+#include "mlir/IR/PatternMatch.h"
+#include "mlir/Pass/Pass.h"
+
+using namespace mlir;
+
+namespace {
+
+struct TestLinalgCacheTiling
+    : public PassWrapper<TestLinalgCacheTiling, OperationPass<func::FuncOp>> {
+  MLIR_DEFINE_EXPLICIT_INTERNAL_INLINE_TYPE_ID(TestLinalgCacheTiling)
+
+  TestLinalgCacheTiling() = default;
+  TestLinalgCacheTiling(const TestLinalgCacheTiling &pass)
+      : PassWrapper(pass) {}
+
+  void getDependentDialects(DialectRegistry &registry) const override {
+    registry.insert<arith::ArithDialect, linalg::LinalgDialect,
+                    scf::SCFDialect, tensor::TensorDialect>();
+  }
+
+  StringRef getArgument() const final { return "test-linalg-cache-tiling"; }
+
+  StringRef getDescription() const final {
+    return "Test tiling of Linalg ops for the cache hierarchy";
+  }
+
+  ListOption<int64_t> cacheSizes{
+      *this, "cache-sizes",
+      llvm::cl::desc("Cache sizes in bytes, innermost level first. Read from "
+                     "the data layout if not given")};
+  Option<bool> fuseProducers{
+      *this, "fuse-producers",
+      llvm::cl::desc("Fuse producers into the outermost tile loops"),
+      llvm::cl::init(true)};
+  Option<std::string> anchorOp{
+      *this, "anchor-op",
+      llvm::cl::desc("Name of the ops to tile, e.g. linalg.matmul"),
+      llvm::cl::init("linalg.matmul")};
+
+  void runOnOperation() override {
+    SmallVector<linalg::LinalgOp> ops;
+    getOperation().walk([&](linalg::LinalgOp op) {
+      if (op->getName().getStringRef() == anchorOp)
+        ops.push_back(op);
+    });
+
+    IRRewriter rewriter(&getContext());
+    for (linalg::LinalgOp op : ops) {
+      linalg::CacheTilingOptions options;
+      if (cacheSizes.empty())
+        options.setCacheSizes(linalg::getCacheSizesFromDataLayout(op));
+      else
+        options.setCacheSizes(cacheSizes);
+      options.fuseProducers = fuseProducers;
+      (void)linalg::tileForCacheHierarchy(rewriter, op, options);
+    }
+  }
+};
+
+} // namespace
+
+namespace mlir {
+namespace test {
+void registerTestLinalgCacheTiling() {
+  PassRegistration<TestLinalgCacheTiling>();
+}
+} // namespace test
+} // namespace mlir
@@ -104,6 +104,7 @@ void registerTestGenericIRVisitorsPass();
 void registerTestInterfaces();
 void registerTestIRVisitorsPass();
 void registerTestLastModifiedPass();
+void registerTestLinalgCacheTiling();
 void registerTestLinalgDecomposeOps();
 void registerTestLinalgDropUnitDims();
 void registerTestLinalgElementwiseFusion();
@@ -235,6 +236,7 @@ void registerTestPasses() {
   mlir::test::registerTestInterfaces();
   mlir::test::registerTestIRVisitorsPass();
   mlir::test::registerTestLastModifiedPass();
+  mlir::test::registerTestLinalgCacheTiling();
   mlir::test::registerTestLinalgDecomposeOps();
   mlir::test::registerTestLinalgDropUnitDims();
   mlir::test::registerTestLinalgElementwiseFusion();
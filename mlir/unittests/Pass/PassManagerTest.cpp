@@ -14,6 +14,7 @@
 #include "mlir/IR/BuiltinOps.h"
 #include "mlir/IR/Diagnostics.h"
 #include "mlir/Pass/Pass.h"
+#include "llvm/Support/JSON.h"
 #include "gtest/gtest.h"
 
 #include <memory>
@@ -88,6 +89,98 @@ TEST(PassManagerTest, OpSpecificAnalysis) {
   }
 }
 
+/// Simple pass that computes an analysis of a func::FuncOp and preserves it.
+struct PreserveAnalysisFunctionPass
+    : public PassWrapper<PreserveAnalysisFunctionPass,
+                         OperationPass<func::FuncOp>> {
+  MLIR_DEFINE_EXPLICIT_INTERNAL_INLINE_TYPE_ID(PreserveAnalysisFunctionPass)
+
+  void runOnOperation() override {
+    getAnalysis<GenericAnalysis>();
+    markAnalysesPreserved<GenericAnalysis>();
+  }
+};
+
+/// Simple pass that counts the functions of a module with a cached analysis.
+struct CountCachedAnalysesModulePass
+    : public PassWrapper<CountCachedAnalysesModulePass,
+                         OperationPass<ModuleOp>> {
+  MLIR_DEFINE_EXPLICIT_INTERNAL_INLINE_TYPE_ID(CountCachedAnalysesModulePass)
+
+  CountCachedAnalysesModulePass(unsigned &numCached) : numCached(numCached) {}
+
+  void runOnOperation() override {
+    for (func::FuncOp func : getOperation().getOps<func::FuncOp>())
+      if (getCachedChildAnalysis<GenericAnalysis>(func))
+        ++numCached;
+    markAllAnalysesPreserved();
+  }
+
+  unsigned &numCached;
+};
+
+TEST(PassManagerTest, NestedPipelineKeepsPreservedAnalyses) {
+  MLIRContext context;
+  context.loadDialect<func::FuncDialect>();
+  Builder builder(&context);
+
+  // Create a module with 2 functions.
+  OwningOpRef<ModuleOp> module(ModuleOp::create(UnknownLoc::get(&context)));
+  for (StringRef name : {"foo", "bar"}) {
+    auto func = func::FuncOp::create(
+        builder.getUnknownLoc(), name,
+        builder.getFunctionType(std::nullopt, std::nullopt));
+    func.setPrivate();
+    module->push_back(func);
+  }
+
+  // The analyses preserved by the nested pipeline are still cached when the
+  // next module pass runs.
+  unsigned numCached = 0;
+  auto pm = PassManager::on<ModuleOp>(&context);
+  pm.addNestedPass<func::FuncOp>(
+      std::make_unique<PreserveAnalysisFunctionPass>());
+  pm.addPass(std::make_unique<CountCachedAnalysesModulePass>(numCached));
+  EXPECT_TRUE(succeeded(pm.run(module.get())));
+  EXPECT_EQ(numCached, 2u);
+}
+
+TEST(PassManagerTest, IRSizeTracking) {
+  MLIRContext context;
+  context.loadDialect<func::FuncDialect>();
+  context.disableMultithreading();
+  Builder builder(&context);
+
+  // Create a module with 2 functions.
+  OwningOpRef<ModuleOp> module(ModuleOp::create(UnknownLoc::get(&context)));
+  for (StringRef name : {"secret", "not_secret"}) {
+    auto func = func::FuncOp::create(
+        builder.getUnknownLoc(), name,
+        builder.getFunctionType(std::nullopt, std::nullopt));
+    func.setPrivate();
+    module->push_back(func);
+  }
+
+  // The report is written when the pass manager is destroyed.
+  std::string report;
+  {
+    auto pm = PassManager::on<ModuleOp>(&context);
+    pm.enableIRSizeTracking(std::make_unique<llvm::raw_string_ostream>(report));
+    pm.addNestedPass<func::FuncOp>(std::make_unique<AnnotateFunctionPass>());
+    EXPECT_TRUE(succeeded(pm.run(module.get())));
+  }
+
+  llvm::Expected<llvm::json::Value> json = llvm::json::parse(report);
+  ASSERT_TRUE(bool(json)) << llvm::toString(json.takeError());
+  const llvm::json::Array *passes = json->getAsObject()->getArray("passes");
+  ASSERT_TRUE(passes);
+  ASSERT_EQ(passes->size(), 1u);
+  const llvm::json::Object *record = (*passes)[0].getAsObject();
+  EXPECT_EQ(record->getInteger("runs"), 2);
+  EXPECT_EQ(record->getObject("opsBefore")->getInteger("func"), 2);
+  EXPECT_EQ(record->getObject("opsAfter")->getInteger("func"), 2);
+}
+
 /// Simple pass to annotate a func::FuncOp with a single attribute `didProcess`.
 struct AddAttrFunctionPass
     : public PassWrapper<AddAttrFunctionPass, OperationPass<func::FuncOp>> {
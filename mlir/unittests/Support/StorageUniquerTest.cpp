@@ -7,7 +7,10 @@
 //===----------------------------------------------------------------------===//
 
 #include "mlir/Support/StorageUniquer.h"
+#include "llvm/Config/llvm-config.h"
 #include "gmock/gmock.h"
+#include <thread>
+#include <vector>
 
 using namespace mlir;
 
@@ -58,3 +61,38 @@ TEST(StorageUniquerTest, NonTrivialDestructor) {
 
   EXPECT_TRUE(wasDestructed);
 }
+
+#if LLVM_ENABLE_THREADS != 0
+TEST(StorageUniquerTest, ConcurrentUniquing) {
+  struct IntStorage : public SimpleStorage<IntStorage, int> {
+    using Base::Base;
+  };
+
+  StorageUniquer uniquer;
+  uniquer.registerParametricStorageType<IntStorage>();
+
+  // Have every thread create the same instances, in different orders, and
+  // check that they all got the same ones.
+  constexpr int numThreads = 16;
+  constexpr int numKeys = 2048;
+  std::vector<std::vector<IntStorage *>> instances(
+      numThreads, std::vector<IntStorage *>(numKeys));
+  std::vector<std::thread> threads;
+  for (int t = 0; t != numThreads; ++t) {
+    threads.emplace_back([&, t] {
+      for (int i = 0; i != numKeys; ++i) {
+        int key = (i * (2 * t + 1)) % numKeys;
+        instances[t][key] = IntStorage::get(uniquer, key);
+      }
+    });
+  }
+  for (std::thread &thread : threads)
+    thread.join();
+
+  for (int i = 0; i != numKeys; ++i) {
+    EXPECT_EQ(std::get<0>(instances[0][i]->key), i);
+    for (int t = 1; t != numThreads; ++t)
+      EXPECT_EQ(instances[t][i], instances[0][i]);
+  }
+}
+#endif // LLVM_ENABLE_THREADS != 0
@@ -52,12 +52,23 @@ class Profiler {
   /// is stored in.
   StringEnvar ProfileTraceFile = StringEnvar("LIBOMPTARGET_PROFILE");
 
+  /// Flag to make the sections of kernel launches and data transfers wait for
+  /// the device.
+  BoolEnvar ProfileSync = BoolEnvar("LIBOMPTARGET_PROFILE_SYNC", false);
+
 public:
   static Profiler &get() {
     static Profiler P;
     return P;
   }
 
+  /// Returns whether the time sections of kernel launches and data transfers
+  /// should wait for the device work they issue, so that they measure its
+  /// execution time rather than only the time to enqueue it.
+  bool isSynchronous() const {
+    return ProfileTraceFile.isPresent() && ProfileSync;
+  }
+
   /// Manually begin a time section, with the given \p Name and \p Detail.
   /// Profiler copies the string data, so the pointers can be given into
   /// temporaries. Time sections can be hierarchical; every Begin must have a
@@ -2091,6 +2091,19 @@ struct AMDGPUDeviceTy : public GenericDeviceTy, AMDGenericDeviceTy {
     return std::move(*BufferOrErr);
   }
 
+  /// See GenericDeviceTy::getJITPostProcessingToolVersion().
+  std::string getJITPostProcessingToolVersion() const override {
+    // Only run 'lld' once per process.
+    static const std::string Version = []() -> std::string {
+      const auto &ErrorOrPath = sys::findProgramByName("lld");
+      if (!ErrorOrPath)
+        return "";
+      StringRef Args[] = {*ErrorOrPath, "-flavor", "gnu", "--version"};
+      return JITEngine::getToolVersion(Args);
+    }();
+    return Version;
+  }
+
   /// See GenericDeviceTy::getComputeUnitKind().
   std::string getComputeUnitKind() const override { return ComputeUnitKind; }
 
@@ -46,6 +46,10 @@ struct JITEngine {
       std::function<Expected<std::unique_ptr<MemoryBuffer>>(
           std::unique_ptr<MemoryBuffer>)>;
 
+  /// Function type for a callback returning the identity of the tool run by
+  /// the post processing, which is part of the JIT cache key.
+  using PostProcessingToolVersionFn = std::function<std::string()>;
+
   JITEngine(Triple::ArchType TA);
 
   /// Run jit compilation if \p Image is a bitcode image, otherwise simply
@@ -55,14 +59,21 @@ struct JITEngine {
   process(const __tgt_device_image &Image,
           target::plugin::GenericDeviceTy &Device);
 
+  /// Run the tool \p Args[0] with the arguments \p Args, which should make it
+  /// print its version, and return the path of the tool followed by the
+  /// output. Only the path is returned if the tool cannot be run.
+  static std::string getToolVersion(ArrayRef<StringRef> Args);
+
 private:
   /// Compile the bitcode image \p Image and generate the binary image that can
   /// be loaded to the target device of the triple \p Triple architecture \p
   /// MCpu. \p PostProcessing will be called after codegen to handle cases such
-  /// as assember as an external tool.
+  /// as assember as an external tool. \p PostProcessingToolVersion is only
+  /// called if the persistent JIT cache is enabled.
   Expected<const __tgt_device_image *>
   compile(const __tgt_device_image &Image, const std::string &ComputeUnitKind,
-          PostProcessingFn PostProcessing);
+          PostProcessingFn PostProcessing,
+          PostProcessingToolVersionFn PostProcessingToolVersion);
 
   /// Create or retrieve the object image file from the file system or via
   /// compilation of the \p Image.
@@ -70,6 +81,19 @@ private:
   getOrCreateObjFile(const __tgt_device_image &Image, LLVMContext &Ctx,
                      const std::string &ComputeUnitKind);
 
+  /// Return the path of the entry for \p Image in the persistent JIT cache, or
+  /// an empty string if the cache is disabled. The entry is keyed by the
+  /// image, the target, the compute unit kind, the JIT options and the version
+  /// of the post processing tool.
+  std::string
+  getCacheEntryPath(const __tgt_device_image &Image,
+                    const std::string &ComputeUnitKind,
+                    PostProcessingToolVersionFn PostProcessingToolVersion);
+
+  /// Store \p ImageMB as the persistent JIT cache entry \p Path. Failing to
+  /// store an entry is not an error, the image is simply compiled again.
+  void storeCacheEntry(StringRef Path, const MemoryBuffer &ImageMB);
+
   /// Run backend, which contains optimization and code generation.
   Expected<std::unique_ptr<MemoryBuffer>>
   backend(Module &M, const std::string &ComputeUnitKind, unsigned OptLevel);
@@ -112,6 +136,7 @@ private:
       StringEnvar("LIBOMPTARGET_JIT_POST_OPT_IR_MODULE");
   UInt32Envar JITOptLevel = UInt32Envar("LIBOMPTARGET_JIT_OPT_LEVEL", 3);
   BoolEnvar JITSkipOpt = BoolEnvar("LIBOMPTARGET_JIT_SKIP_OPT", false);
+  StringEnvar JITCacheDir = StringEnvar("LIBOMPTARGET_JIT_CACHE_DIR");
 };
 
 } // namespace target
@@ -816,6 +816,11 @@ struct GenericDeviceTy : public DeviceAllocatorTy {
     return std::move(MB);
   }
 
+  /// Return the identity of the external tool run by doJITPostProcessing, e.g.
+  /// the output of its --version, so that persistent JIT cache entries are not
+  /// reused after the tool changed.
+  virtual std::string getJITPostProcessingToolVersion() const { return ""; }
+
   /// The minimum number of threads we use for a low-trip count combined loop.
   /// Instead of using more threads we increase the outer (block/team)
   /// parallelism.
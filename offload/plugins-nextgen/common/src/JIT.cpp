@@ -17,8 +17,10 @@
 #include "omptarget.h"
 
 #include "llvm/ADT/SmallVector.h"
+#include "llvm/ADT/StringExtras.h"
 #include "llvm/CodeGen/CommandFlags.h"
 #include "llvm/CodeGen/MachineModuleInfo.h"
+#include "llvm/Config/llvm-config.h"
 #include "llvm/IR/LLVMContext.h"
 #include "llvm/IR/LLVMRemarkStreamer.h"
 #include "llvm/IR/LegacyPassManager.h"
@@ -28,12 +30,16 @@
 #include "llvm/Object/IRObjectFile.h"
 #include "llvm/Passes/OptimizationLevel.h"
 #include "llvm/Passes/PassBuilder.h"
+#include "llvm/Support/FileSystem.h"
 #include "llvm/Support/MemoryBuffer.h"
+#include "llvm/Support/Path.h"
+#include "llvm/Support/Program.h"
 #include "llvm/Support/SourceMgr.h"
 #include "llvm/Support/TargetSelect.h"
 #include "llvm/Support/TimeProfiler.h"
 #include "llvm/Support/ToolOutputFile.h"
 #include "llvm/Support/raw_ostream.h"
+#include "llvm/Support/raw_sha1_ostream.h"
 #include "llvm/Target/TargetMachine.h"
 #include "llvm/Target/TargetOptions.h"
 #include "llvm/TargetParser/SubtargetFeature.h"
@@ -276,10 +282,65 @@ JITEngine::getOrCreateObjFile(const __tgt_device_image &Image, LLVMContext &Ctx,
   return backend(*Mod, ComputeUnitKind, JITOptLevel);
 }
 
+std::string JITEngine::getCacheEntryPath(
+    const __tgt_device_image &Image, const std::string &ComputeUnitKind,
+    PostProcessingToolVersionFn PostProcessingToolVersion) {
+  // Replaced or dumped modules must go through the JIT.
+  if (!JITCacheDir.isPresent() || JITCacheDir.get().empty() ||
+      ReplacementObjectFileName.isPresent() ||
+      ReplacementModuleFileName.isPresent() ||
+      PreOptIRModuleFileName.isPresent() || PostOptIRModuleFileName.isPresent())
+    return "";
+
+  StringRef Binary(reinterpret_cast<const char *>(Image.ImageStart),
+                   target::getPtrDiff(Image.ImageEnd, Image.ImageStart));
+  raw_sha1_ostream Hash;
+  Hash << LLVM_VERSION_STRING << '\0' << TT.str() << '\0' << ComputeUnitKind
+       << '\0' << JITOptLevel.get() << '\0' << JITSkipOpt.get() << '\0'
+       << PostProcessingToolVersion() << '\0' << Binary;
+
+  SmallString<128> Path(JITCacheDir.get());
+  sys::path::append(Path, "llvmcache-" + toHex(Hash.sha1()));
+  return std::string(Path);
+}
+
+void JITEngine::storeCacheEntry(StringRef Path, const MemoryBuffer &ImageMB) {
+  // Write to a temporary file and rename it into place, so that concurrent
+  // processes never see a partial entry.
+  SmallString<128> TempPath(sys::path::parent_path(Path));
+  auto Fail = [&](Error Err) {
+    std::string Msg = toString(std::move(Err));
+    DP("Could not store JIT cache entry %s: %s\n", Path.str().c_str(),
+       Msg.c_str());
+  };
+  if (std::error_code EC = sys::fs::create_directories(TempPath))
+    return Fail(errorCodeToError(EC));
+  sys::path::append(TempPath, "jit-%%%%%%.tmp");
+  auto Temp = sys::fs::TempFile::create(TempPath);
+  if (!Temp)
+    return Fail(Temp.takeError());
+  {
+    raw_fd_ostream OS(Temp->FD, /*shouldClose=*/false);
+    OS << ImageMB.getBuffer();
+    OS.flush();
+    if (OS.has_error()) {
+      std::error_code EC = OS.error();
+      OS.clear_error();
+      consumeError(Temp->discard());
+      return Fail(errorCodeToError(EC));
+    }
+  }
+  if (Error Err = Temp->keep(Path)) {
+    consumeError(Temp->discard());
+    return Fail(std::move(Err));
+  }
+}
+
 Expected<const __tgt_device_image *>
 JITEngine::compile(const __tgt_device_image &Image,
                    const std::string &ComputeUnitKind,
-                   PostProcessingFn PostProcessing) {
+                   PostProcessingFn PostProcessing,
+                   PostProcessingToolVersionFn PostProcessingToolVersion) {
   std::lock_guard<std::mutex> Lock(ComputeUnitMapMutex);
 
   // Check if we JITed this image for the given compute unit kind before.
@@ -287,23 +348,44 @@ JITEngine::compile(const __tgt_device_image &Image,
   if (__tgt_device_image *JITedImage = CUI.TgtImageMap.lookup(&Image))
     return JITedImage;
 
-  auto ObjMBOrErr = getOrCreateObjFile(Image, CUI.Context, ComputeUnitKind);
-  if (!ObjMBOrErr)
-    return ObjMBOrErr.takeError();
+  // Check if a previous process JITed this image.
+  std::string CachePath =
+      getCacheEntryPath(Image, ComputeUnitKind, PostProcessingToolVersion);
+  std::unique_ptr<MemoryBuffer> ImageMB;
+  if (!CachePath.empty()) {
+    auto MBOrErr =
+        MemoryBuffer::getFile(CachePath, /*IsText=*/false,
+                              /*RequiresNullTerminator=*/false);
+    if (MBOrErr) {
+      DP("Loaded JIT image for %s from %s\n", ComputeUnitKind.c_str(),
+         CachePath.c_str());
+      ImageMB = std::move(*MBOrErr);
+    }
+  }
+
+  if (!ImageMB) {
+    auto ObjMBOrErr = getOrCreateObjFile(Image, CUI.Context, ComputeUnitKind);
+    if (!ObjMBOrErr)
+      return ObjMBOrErr.takeError();
 
-  auto ImageMBOrErr = PostProcessing(std::move(*ObjMBOrErr));
-  if (!ImageMBOrErr)
-    return ImageMBOrErr.takeError();
+    auto ImageMBOrErr = PostProcessing(std::move(*ObjMBOrErr));
+    if (!ImageMBOrErr)
+      return ImageMBOrErr.takeError();
+    ImageMB = std::move(*ImageMBOrErr);
+
+    if (!CachePath.empty())
+      storeCacheEntry(CachePath, *ImageMB);
+  }
 
-  CUI.JITImages.push_back(std::move(*ImageMBOrErr));
+  CUI.JITImages.push_back(std::move(ImageMB));
   __tgt_device_image *&JITedImage = CUI.TgtImageMap[&Image];
   JITedImage = new __tgt_device_image();
   *JITedImage = Image;
 
-  auto &ImageMB = CUI.JITImages.back();
+  const MemoryBuffer &JITedMB = *CUI.JITImages.back();
 
-  JITedImage->ImageStart = const_cast<char *>(ImageMB->getBufferStart());
-  JITedImage->ImageEnd = const_cast<char *>(ImageMB->getBufferEnd());
+  JITedImage->ImageStart = const_cast<char *>(JITedMB.getBufferStart());
+  JITedImage->ImageEnd = const_cast<char *>(JITedMB.getBufferEnd());
 
   return JITedImage;
 }
@@ -317,9 +399,29 @@ JITEngine::process(const __tgt_device_image &Image,
       -> Expected<std::unique_ptr<MemoryBuffer>> {
     return Device.doJITPostProcessing(std::move(MB));
   };
+  PostProcessingToolVersionFn PostProcessingToolVersion = [&Device]() {
+    return Device.getJITPostProcessingToolVersion();
+  };
 
   if (isImageBitcode(Image))
-    return compile(Image, ComputeUnitKind, PostProcessing);
+    return compile(Image, ComputeUnitKind, PostProcessing,
+                   PostProcessingToolVersion);
 
   return &Image;
 }
+
+std::string JITEngine::getToolVersion(ArrayRef<StringRef> Args) {
+  std::string Version = Args[0].str();
+  SmallString<128> OutputPath;
+  if (sys::fs::createTemporaryFile("jit-tool-version", "txt", OutputPath))
+    return Version;
+
+  std::optional<StringRef> Redirects[] = {std::nullopt, StringRef(OutputPath),
+                                          std::nullopt};
+  if (!sys::ExecuteAndWait(Args[0], Args, std::nullopt, Redirects)) {
+    if (auto MBOrErr = MemoryBuffer::getFile(OutputPath, /*IsText=*/true))
+      Version += '\0' + (*MBOrErr)->getBuffer().str();
+  }
+  sys::fs::remove(OutputPath);
+  return Version;
+}
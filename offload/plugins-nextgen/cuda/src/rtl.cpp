@@ -468,6 +468,19 @@ struct CUDADeviceTy : public GenericDeviceTy {
     return std::move(*BufferOrErr);
   }
 
+  /// See GenericDeviceTy::getJITPostProcessingToolVersion().
+  std::string getJITPostProcessingToolVersion() const override {
+    // Only run 'ptxas' once per process.
+    static const std::string Version = []() -> std::string {
+      const auto ErrorOrPath = sys::findProgramByName("ptxas");
+      if (!ErrorOrPath)
+        return "";
+      StringRef Args[] = {*ErrorOrPath, "--version"};
+      return JITEngine::getToolVersion(Args);
+    }();
+    return Version;
+  }
+
   /// Allocate and construct a CUDA kernel.
   Expected<GenericKernelTy &> constructKernel(const char *Name) override {
     // Allocate and construct the CUDA kernel.
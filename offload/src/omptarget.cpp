@@ -544,6 +544,15 @@ int targetDataMapper(ident_t *Loc, DeviceTy &Device, void *ArgBase, void *Arg,
   return Rc;
 }
 
+/// Wait for the work queued on \p AsyncInfo if the profiler measures device
+/// execution times, so that the enclosing time section includes it. Pending
+/// post-processing functions still run when \p AsyncInfo is synchronized.
+static int waitForProfiledWork(DeviceTy &Device, AsyncInfoTy &AsyncInfo) {
+  if (!Profiler::get().isSynchronous() || AsyncInfo.isDone())
+    return OFFLOAD_SUCCESS;
+  return Device.synchronize(AsyncInfo);
+}
+
 /// Internal function to do the mapping and transfer the data to the device
 int targetDataBegin(ident_t *Loc, DeviceTy &Device, int32_t ArgNum,
                     void **ArgsBase, void **Args, int64_t *ArgSizes,
@@ -682,6 +691,8 @@ int targetDataBegin(ident_t *Loc, DeviceTy &Device, int32_t ArgNum,
     DP("There are %" PRId64 " bytes allocated at target address " DPxMOD
        " - is%s new\n",
        DataSize, DPxPTR(TgtPtrBegin), (TPR.Flags.IsNewEntry ? "" : " not"));
+    if (waitForProfiledWork(Device, AsyncInfo) != OFFLOAD_SUCCESS)
+      return OFFLOAD_FAIL;
 
     if (ArgTypes[I] & OMP_TGT_MAPTYPE_RETURN_PARAM) {
       uintptr_t Delta = (uintptr_t)HstPtrBegin - (uintptr_t)HstPtrBase;
@@ -948,6 +959,8 @@ int targetDataEnd(ident_t *Loc, DeviceTy &Device, int32_t ArgNum,
         REPORT("Copying data from device failed.\n");
         return OFFLOAD_FAIL;
       }
+      if (waitForProfiledWork(Device, AsyncInfo) != OFFLOAD_SUCCESS)
+        return OFFLOAD_FAIL;
 
       // As we are expecting to delete the entry the d2h copy might race
       // with another one that also tries to delete the entry. This happens
@@ -1677,6 +1690,8 @@ int target(ident_t *Loc, DeviceTy &Device, void *HostPtr,
 
     Ret = Device.launchKernel(TgtEntryPtr, TgtArgs.data(), TgtOffsets.data(),
                               KernelArgs, AsyncInfo);
+    if (Ret == OFFLOAD_SUCCESS)
+      Ret = waitForProfiledWork(Device, AsyncInfo);
   }
 
   if (Ret != OFFLOAD_SUCCESS) {
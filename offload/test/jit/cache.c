@@ -0,0 +1,59 @@
+// clang-format off
+//
+// RUN: %libomptarget-compileopt-generic -fopenmp-target-jit
+// RUN: rm -rf %t.cache
+//
+// The first run compiles the image and stores it in the cache.
+// RUN: env LIBOMPTARGET_DEBUG=1 LIBOMPTARGET_JIT_CACHE_DIR=%t.cache \
+// RUN:     %libomptarget-run-generic 2>&1                            \
+// RUN:   | %fcheck-plain-generic %s --check-prefix=MISS
+// RUN: ls %t.cache | %fcheck-plain-generic %s --check-prefix=ONE
+//
+// The second run loads it from the cache and does not add an entry.
+// RUN: env LIBOMPTARGET_DEBUG=1 LIBOMPTARGET_JIT_CACHE_DIR=%t.cache \
+// RUN:     %libomptarget-run-generic 2>&1                            \
+// RUN:   | %fcheck-plain-generic %s --check-prefix=HIT
+// RUN: ls %t.cache | %fcheck-plain-generic %s --check-prefix=ONE
+//
+// A different optimization level is a different key.
+// RUN: env LIBOMPTARGET_DEBUG=1 LIBOMPTARGET_JIT_CACHE_DIR=%t.cache \
+// RUN:     LIBOMPTARGET_JIT_OPT_LEVEL=1                              \
+// RUN:     %libomptarget-run-generic 2>&1                            \
+// RUN:   | %fcheck-plain-generic %s --check-prefix=MISS
+// RUN: ls %t.cache | %fcheck-plain-generic %s --check-prefix=TWO
+//
+// clang-format on
+
+// REQUIRES: libomptarget-debug
+
+// UNSUPPORTED: aarch64-unknown-linux-gnu
+// UNSUPPORTED: aarch64-unknown-linux-gnu-LTO
+// UNSUPPORTED: x86_64-pc-linux-gnu
+// UNSUPPORTED: x86_64-pc-linux-gnu-LTO
+// UNSUPPORTED: s390x-ibm-linux-gnu
+// UNSUPPORTED: s390x-ibm-linux-gnu-LTO
+
+// MISS-NOT: Loaded JIT image
+// MISS: PASS
+
+// HIT: Loaded JIT image for {{.*}} from {{.*}}llvmcache-
+// HIT: PASS
+
+// ONE: llvmcache-
+// ONE-NOT: llvmcache-
+
+// TWO: llvmcache-
+// TWO: llvmcache-
+// TWO-NOT: llvmcache-
+
+#include <stdio.h>
+
+int main() {
+  int A = 0;
+#pragma omp target map(tofrom : A)
+  { A = 42; }
+
+  if (A == 42)
+    printf("PASS\n");
+  return 0;
+}
@@ -354,6 +354,9 @@ KMP_BUILD_ASSERT(sizeof(kmp_tasking_flags_t) == 4);
 
 int __kmp_task_stealing_constraint = 1; /* Constrain task stealing by default */
 int __kmp_enable_task_throttling = 1;
+#if KMP_AFFINITY_SUPPORTED
+int __kmp_task_stealing_locality = 1; /* Prefer nearby victims when stealing */
+#endif
 
 #ifdef DEBUG_SUSPEND
 int __kmp_suspend_count = 0;
@@ -11,6 +11,7 @@
 //===----------------------------------------------------------------------===//
 
 #include "kmp.h"
+#include "kmp_affinity.h"
 #include "kmp_i18n.h"
 #include "kmp_itt.h"
 #include "kmp_stats.h"
@@ -3359,6 +3360,57 @@ static kmp_task_t *__kmp_steal_task(kmp_int32 victim_tid, kmp_int32 gtid,
   return task;
 }
 
+#if KMP_AFFINITY_SUPPORTED
+// __kmp_get_shared_topology_levels: return the number of topology levels,
+// from the outermost one, that the places of two threads have in common.
+// Threads that are not bound to a place share no levels.
+static int __kmp_get_shared_topology_levels(const kmp_info_t *a,
+                                            const kmp_info_t *b) {
+  if (!KMP_AFFINITY_CAPABLE() || __kmp_topology == NULL)
+    return 0;
+  int depth = __kmp_topology->get_depth();
+  int level = 0;
+  for (; level < depth; ++level) {
+    kmp_hw_t type = __kmp_topology->get_type(level);
+    int id = a->th.th_topology_ids.ids[type];
+    if (id < 0 || id != b->th.th_topology_ids.ids[type])
+      break;
+  }
+  return level;
+}
+
+// __kmp_select_near_victim: given a randomly chosen victim, draw a few more
+// random victims and return the one closest to the thief in the machine
+// topology, i.e. prefer a thread on the same core, then the same socket.
+// Victims are still chosen at random, so remote threads are only stolen from
+// less often, not starved.
+static kmp_int32 __kmp_select_near_victim(kmp_info_t *thread,
+                                          kmp_thread_data_t *threads_data,
+                                          kmp_int32 nthreads, kmp_int32 tid,
+                                          kmp_int32 victim_tid) {
+  const int max_tries = 4;
+  // Nothing to prefer if the thief itself is not bound to a place.
+  if (__kmp_get_shared_topology_levels(thread, thread) == 0)
+    return victim_tid;
+  // Sharing all levels above the hardware thread means sharing the core.
+  int core_levels = __kmp_topology->get_depth() - 1;
+  int best_levels = __kmp_get_shared_topology_levels(
+      thread, threads_data[victim_tid].td.td_thr);
+  for (int i = 1; i < max_tries && best_levels < core_levels; ++i) {
+    kmp_int32 candidate = __kmp_get_random(thread) % (nthreads - 1);
+    if (candidate >= tid)
+      ++candidate; // Exclude self, as in __kmp_execute_tasks_template
+    int levels = __kmp_get_shared_topology_levels(
+        thread, threads_data[candidate].td.td_thr);
+    if (levels > best_levels) {
+      best_levels = levels;
+      victim_tid = candidate;
+    }
+  }
+  return victim_tid;
+}
+#endif // KMP_AFFINITY_SUPPORTED
+
 // __kmp_execute_tasks_template: Choose and execute tasks until either the
 // condition is statisfied (return true) or there are none left (return false).
 //
@@ -3433,6 +3485,11 @@ static inline int __kmp_execute_tasks_template(
             if (victim_tid >= tid) {
               ++victim_tid; // Adjusts random distribution to exclude self
             }
+#if KMP_AFFINITY_SUPPORTED
+            if (__kmp_task_stealing_locality && nthreads > 2)
+              victim_tid = __kmp_select_near_victim(thread, threads_data,
+                                                    nthreads, tid, victim_tid);
+#endif
             // Found a potential victim
             other_thread = threads_data[victim_tid].td.td_thr;
             // There is a slight chance that __kmp_enable_tasking() did not wake
@@ -83,6 +83,13 @@ static cl::opt<bool> DetectParallel("polly-ast-detect-parallel",
                                     cl::desc("Detect parallelism"), cl::Hidden,
                                     cl::cat(PollyCategory));
 
+static cl::opt<unsigned> AstComputeOut(
+    "polly-ast-computeout",
+    cl::desc("Bound the AST generation of a SCoP by a maximal amount of "
+             "computational steps, and skip the code generation of SCoPs that "
+             "exceed it (0 means no limit)"),
+    cl::Hidden, cl::init(0), cl::cat(PollyCategory));
+
 STATISTIC(ScopsProcessed, "Number of SCoPs processed");
 STATISTIC(ScopsBeneficial, "Number of beneficial SCoPs");
 STATISTIC(BeneficialAffineLoops, "Number of beneficial affine loops");
@@ -95,6 +102,7 @@ STATISTIC(NumOutermostParallel, "Number of outermost parallel for-loops");
 STATISTIC(NumReductionParallel, "Number of reduction-parallel for-loops");
 STATISTIC(NumExecutedInParallel, "Number of for-loops executed in parallel");
 STATISTIC(NumIfConditions, "Number of if-conditions");
+STATISTIC(AstComputeOuts, "Number of SCoPs whose AST generation timed out");
 
 namespace polly {
 
@@ -541,11 +549,22 @@ void IslAst::init(const Dependences &D) {
                                               &BuildInfo);
   }
 
-  RunCondition = buildRunCondition(S, isl::manage_copy(Build));
-
-  Root = isl::manage(
-      isl_ast_build_node_from_schedule(Build, S.getScheduleTree().release()));
-  walkAstForStatistics(Root);
+  {
+    IslMaxOperationsGuard MaxOpGuard(Ctx.get(), AstComputeOut);
+    RunCondition = buildRunCondition(S, isl::manage_copy(Build));
+    Root = isl::manage(
+        isl_ast_build_node_from_schedule(Build, S.getScheduleTree().release()));
+
+    // Leave the SCoP as it is rather than generate code from a partial AST.
+    if (MaxOpGuard.hasQuotaExceeded()) {
+      POLLY_DEBUG(dbgs() << "AST generation exceeds ISL quota\n");
+      AstComputeOuts++;
+      RunCondition = {};
+      Root = {};
+    }
+  }
+  if (!Root.is_null())
+    walkAstForStatistics(Root);
 
   isl_ast_build_free(Build);
 }
@@ -729,7 +748,7 @@ void IslAstInfo::print(raw_ostream &OS) {
           "(use -polly-process-unprofitable to enforce code generation) or "
           "because earlier passes such as dependence analysis timed out (use "
           "-polly-dependences-computeout=0 to set dependence analysis timeout "
-          "to infinity)\n\n";
+          "to infinity) or AST generation exceeded -polly-ast-computeout\n\n";
     return;
   }
 